@@ -0,0 +1,100 @@
+//
+//  BDBBatchLoader.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequest.h"
+
+
+typedef BDBRequest *(^BDBBatchRequestBlock)(NSArray *identifiers, void (^success)(NSArray *objects), void (^failure)(NSError *error));
+
+
+#pragma mark -
+@interface BDBBatchLoader : NSObject
+
+/**
+ *  Create a loader that turns single-ID lookups into batched list requests.
+ *
+ *  @param batchRequest        Block that fetches every object in identifiers with one request.
+ *  @param identifierForObject Block returning the ID of a fetched object, used to match results to callers.
+ *
+ *  @return A new batch loader.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithBatchRequest:(BDBBatchRequestBlock)batchRequest
+       identifierForObject:(NSString *(^)(id object))identifierForObject;
+
+/**
+ *  How long the first lookup of a batch waits for others to join it.
+ *  Defaults to 10 milliseconds.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSTimeInterval batchWindow;
+
+/**
+ *  Number of IDs that sends a batch immediately, without waiting for the
+ *  window to close. Defaults to 50, one page of list results, which is also the
+ *  largest batch the API answers in full; larger values are clamped to it.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSUInteger maxBatchSize;
+
+/**
+ *  Queue the failure block of a cancelled lookup runs on. Defaults to the main queue.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic) dispatch_queue_t callbackQueue;
+
+/**
+ *  Load one object. Lookups for the same ID within a batch share one slot.
+ *
+ *  @param identifier ID of the object to load.
+ *  @param success    Called with the object.
+ *  @param failure    Called with the batch request's error, or BDB_ERRNO_OBJECT_NOT_FOUND if the
+ *                    batch succeeded without this ID.
+ *
+ *  @return A handle for the lookup. Cancelling it drops the ID from a pending
+ *          batch, and cancels a sent batch once every lookup in it is cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)loadObjectWithId:(NSString *)identifier
+                         success:(void (^)(id object))success
+                         failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Send the pending batch now.
+ *
+ *  @since 1.1.0
+ */
+- (void)flush;
+
+#pragma mark Statistics
+@property (nonatomic, readonly) NSUInteger batchCount;
+@property (nonatomic, readonly) NSUInteger loadCount;
+
+@end
@@ -0,0 +1,289 @@
+//
+//  BDBBatchLoader.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBBatchLoader.h"
+#import "BDBErrors.h"
+#import "BDBRequest_Private.h"
+
+
+static NSTimeInterval const BDBBatchLoaderDefaultBatchWindow = 0.01;
+static NSUInteger const BDBBatchLoaderDefaultMaxBatchSize = 50;
+
+// The ids= filter returns at most one page, so larger batches would lose the objects past it.
+static NSUInteger const BDBBatchLoaderLimitMaxBatchSize = 50;
+
+
+#pragma mark -
+@interface BDBBatchLoader ()
+{
+    BDBBatchRequestBlock _batchRequest;
+    NSString *(^_identifierForObject)(id object);
+
+    NSMutableArray *_pendingIdentifiers;
+    NSMutableDictionary *_pendingCallbacks;
+    NSUInteger _generation;
+    BOOL _windowScheduled;
+}
+
+@property (nonatomic, readwrite) NSUInteger batchCount;
+@property (nonatomic, readwrite) NSUInteger loadCount;
+
+- (void)flushGeneration:(NSUInteger)generation;
+- (void)closeWindowForGeneration:(NSUInteger)generation;
+- (void)removeCallbackForRequest:(BDBRequest *)request identifier:(NSString *)identifier;
+- (void)sendBatch:(NSArray *)identifiers callbacks:(NSDictionary *)callbacks;
+
+@end
+
+
+#pragma mark -
+@implementation BDBBatchLoader
+
+- (id)initWithBatchRequest:(BDBBatchRequestBlock)batchRequest
+       identifierForObject:(NSString *(^)(id))identifierForObject
+{
+    NSParameterAssert(batchRequest);
+    NSParameterAssert(identifierForObject);
+
+    self = [super init];
+    if (self)
+    {
+        _batchRequest = [batchRequest copy];
+        _identifierForObject = [identifierForObject copy];
+        _pendingIdentifiers = [NSMutableArray array];
+        _pendingCallbacks = [NSMutableDictionary dictionary];
+        _batchWindow = BDBBatchLoaderDefaultBatchWindow;
+        _maxBatchSize = BDBBatchLoaderDefaultMaxBatchSize;
+        _callbackQueue = dispatch_get_main_queue();
+    }
+    return self;
+}
+
+@synthesize maxBatchSize = _maxBatchSize;
+
+#pragma mark Configuration
+- (void)setMaxBatchSize:(NSUInteger)maxBatchSize
+{
+    @synchronized(self)
+    {
+        _maxBatchSize = MIN(MAX(maxBatchSize, (NSUInteger)1), BDBBatchLoaderLimitMaxBatchSize);
+    }
+}
+
+- (NSUInteger)maxBatchSize
+{
+    @synchronized(self)
+    {
+        return _maxBatchSize;
+    }
+}
+
+#pragma mark Loading
+- (BDBRequest *)loadObjectWithId:(NSString *)identifier
+                         success:(void (^)(id))success
+                         failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(identifier);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    BDBRequest *request = [[BDBRequest alloc] init];
+    BOOL startWindow = NO;
+    BOOL batchFull = NO;
+    NSUInteger generation = 0;
+
+    @synchronized(self)
+    {
+        self.loadCount++;
+
+        NSMutableArray *callbacks = _pendingCallbacks[identifier];
+        if (!callbacks)
+        {
+            callbacks = [NSMutableArray array];
+            _pendingCallbacks[identifier] = callbacks;
+            [_pendingIdentifiers addObject:identifier];
+        }
+        [callbacks addObject:@[[success copy], [failure copy], request]];
+
+        // Cancelled waiters can empty a batch while its window is still open, so the window is tracked
+        // explicitly rather than inferred from the first pending ID.
+        batchFull = (_pendingIdentifiers.count >= _maxBatchSize);
+        startWindow = (!batchFull && !_windowScheduled);
+        if (startWindow)
+            _windowScheduled = YES;
+        generation = _generation;
+    }
+
+    if (batchFull)
+        [self flushGeneration:generation];
+    else if (startWindow)
+    {
+        dispatch_time_t deadline = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.batchWindow * NSEC_PER_SEC));
+        dispatch_after(deadline, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [self closeWindowForGeneration:generation];
+        });
+    }
+
+    __weak BDBRequest *weakRequest = request;
+    [request addCancellationHandler:^{
+        [self removeCallbackForRequest:weakRequest identifier:identifier];
+        dispatch_async(self.callbackQueue, ^{
+            failure([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+        });
+    }];
+
+    return request;
+}
+
+- (void)removeCallbackForRequest:(BDBRequest *)request identifier:(NSString *)identifier
+{
+    @synchronized(self)
+    {
+        NSMutableArray *callbacks = _pendingCallbacks[identifier];
+        NSUInteger index = [callbacks indexOfObjectPassingTest:^BOOL(NSArray *callback, NSUInteger idx, BOOL *stop) {
+            return (callback[2] == request);
+        }];
+        if (index == NSNotFound)
+            return;
+
+        [callbacks removeObjectAtIndex:index];
+        if (callbacks.count == 0)
+        {
+            [_pendingCallbacks removeObjectForKey:identifier];
+            [_pendingIdentifiers removeObject:identifier];
+        }
+    }
+}
+
+- (void)flush
+{
+    NSUInteger generation = 0;
+    @synchronized(self)
+    {
+        generation = _generation;
+    }
+    [self flushGeneration:generation];
+}
+
+- (void)flushGeneration:(NSUInteger)generation
+{
+    NSArray *identifiers = nil;
+    NSDictionary *callbacks = nil;
+
+    @synchronized(self)
+    {
+        // A window timer firing after its batch was already sent by size must not send the next one early.
+        if (generation != _generation || _pendingIdentifiers.count == 0)
+            return;
+
+        identifiers = [_pendingIdentifiers copy];
+        callbacks = [_pendingCallbacks copy];
+        [_pendingIdentifiers removeAllObjects];
+        [_pendingCallbacks removeAllObjects];
+        _generation++;
+        _windowScheduled = NO;
+        self.batchCount++;
+    }
+
+    [self sendBatch:identifiers callbacks:callbacks];
+}
+
+- (void)closeWindowForGeneration:(NSUInteger)generation
+{
+    @synchronized(self)
+    {
+        if (generation != _generation)
+            return;
+        _windowScheduled = NO;
+    }
+    [self flushGeneration:generation];
+}
+
+- (void)sendBatch:(NSArray *)identifiers callbacks:(NSDictionary *)callbacks
+{
+    BDBRequest *batchRequest = _batchRequest(identifiers,
+                                             ^(NSArray *objects) {
+                                                 NSMutableDictionary *objectsByIdentifier = [NSMutableDictionary dictionary];
+                                                 for (id object in objects)
+                                                 {
+                                                     NSString *identifier = _identifierForObject(object);
+                                                     if (identifier)
+                                                         objectsByIdentifier[identifier] = object;
+                                                 }
+
+                                                 for (NSString *identifier in identifiers)
+                                                 {
+                                                     id object = objectsByIdentifier[identifier];
+                                                     NSError *error = nil;
+                                                     if (!object)
+                                                         error = [NSError errorWithDomain:BreweryDBErrorDomain
+                                                                                     code:BDB_ERRNO_OBJECT_NOT_FOUND
+                                                                                 userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_OBJECT_NOT_FOUND}];
+
+                                                     for (NSArray *callback in callbacks[identifier])
+                                                     {
+                                                         if (![callback[2] markFinished])
+                                                             continue;
+                                                         if (object)
+                                                             ((void (^)(id))callback[0])(object);
+                                                         else
+                                                             ((void (^)(NSError *))callback[1])(error);
+                                                     }
+                                                 }
+                                             },
+                                             ^(NSError *error) {
+                                                 for (NSString *identifier in identifiers)
+                                                 {
+                                                     for (NSArray *callback in callbacks[identifier])
+                                                     {
+                                                         if ([callback[2] markFinished])
+                                                             ((void (^)(NSError *))callback[1])(error);
+                                                     }
+                                                 }
+                                             });
+
+    // The batch is only worth finishing while someone is still waiting on it.
+    NSMutableArray *waitingRequests = [NSMutableArray array];
+    for (NSArray *identifierCallbacks in callbacks.allValues)
+    {
+        for (NSArray *callback in identifierCallbacks)
+            [waitingRequests addObject:callback[2]];
+    }
+
+    for (BDBRequest *request in [waitingRequests copy])
+    {
+        __weak BDBRequest *weakRequest = request;
+        [request addCancellationHandler:^{
+            BOOL lastRequest = NO;
+            @synchronized(waitingRequests)
+            {
+                [waitingRequests removeObjectIdenticalTo:weakRequest];
+                lastRequest = (waitingRequests.count == 0);
+            }
+            if (lastRequest)
+                [batchRequest cancel];
+        }];
+    }
+}
+
+@end
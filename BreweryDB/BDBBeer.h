@@ -31,6 +31,9 @@
 @property (nonatomic, copy) NSString *name;
 @property (nonatomic, copy) NSString *descriptionString;
 @property (nonatomic) NSArray *breweries;
+@property (nonatomic) NSArray *hops;
+@property (nonatomic) NSArray *fermentables;
+@property (nonatomic) NSArray *yeasts;
 @property (nonatomic, copy) NSString *foodPairings;
 @property (nonatomic, copy) NSString *originalGravity;
 @property (nonatomic) NSNumber *abv;
@@ -51,5 +54,6 @@
 @property (nonatomic, copy, readonly) NSString *status;
 
 - (id)initWithDictionary:(NSDictionary *)dictionary;
+- (NSDictionary *)dictionaryRepresentation;
 
 @end
@@ -21,13 +21,37 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBBeer.h"
+#import "BDBGeneratedDecoders.h"
 #import "BDBBrewery.h"
 #import "BDBStyle.h"
+#import "BDBHop.h"
+#import "BDBFermentable.h"
+#import "BDBYeast.h"
+
+
+#pragma mark -
+@interface BDBBeer ()
+{
+    // In lazy mode, nested objects and the trimmed description are decoded on first access from the parts
+    // of the dictionary kept here, each released once decoded. Otherwise they are decoded up front and
+    // _lazy is cleared, so the accessors take no lock.
+    BOOL _lazy;
+    NSMutableDictionary *_lazyValues;
+}
+
+@end
 
 
 #pragma mark -
 @implementation BDBBeer
 
+@synthesize descriptionString = _descriptionString;
+@synthesize breweries = _breweries;
+@synthesize hops = _hops;
+@synthesize fermentables = _fermentables;
+@synthesize yeasts = _yeasts;
+@synthesize style = _style;
+
 - (id)initWithDictionary:(NSDictionary *)dictionary
 {
     self = [super init];
@@ -37,52 +61,210 @@
     if (!dictionary)
         return self;
 
-    @try
-    {
-        _beerId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-
-        NSMutableArray *mutableBreweries = [NSMutableArray array];
-        for (NSDictionary *breweryDictionary in dictionary[NSStringFromSelector(@selector(breweries))])
-        {
-            BDBBrewery *brewery = [[BDBBrewery alloc] initWithDictionary:breweryDictionary];
-            if (brewery)
-                [mutableBreweries addObject:brewery];
-            else
-                NSLog(@"Could not parse brewery: %@", brewery);
-        }
-        _breweries = mutableBreweries;
-
-        _foodPairings = dictionary[NSStringFromSelector(@selector(foodPairings))];
-        _originalGravity = dictionary[NSStringFromSelector(@selector(originalGravity))];
-        _abv = dictionary[NSStringFromSelector(@selector(abv))];
-        _ibu = dictionary[NSStringFromSelector(@selector(ibu))];
-        _glasswareId = dictionary[NSStringFromSelector(@selector(glasswareId))];
-        _glass = dictionary[NSStringFromSelector(@selector(glass))];
-        _styleId = dictionary[NSStringFromSelector(@selector(styleId))];
-
-        NSDictionary* styleDictionary = dictionary[NSStringFromSelector(@selector(style))];
-        _style = [[BDBStyle alloc] initWithDictionary:styleDictionary];
-
-        _organic = [dictionary[NSStringFromSelector(@selector(isOrganic))] boolValue];
-        _labels = dictionary[NSStringFromSelector(@selector(labels))];
-        _servingTemperature = dictionary[NSStringFromSelector(@selector(servingTemperature))];
-        _servingTemperatureDisplay = dictionary[NSStringFromSelector(@selector(servingTemperatureDisplay))];
-        _availableId = dictionary[NSStringFromSelector(@selector(availableId))];
-        _available = dictionary[NSStringFromSelector(@selector(available))];
-        _beerVariationId = dictionary[NSStringFromSelector(@selector(beerVariationId))];
-        _year = dictionary[NSStringFromSelector(@selector(year))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse beer: %@", exception);
+    if (![dictionary isKindOfClass:[NSDictionary class]])
+    {
+        NSLog(@"Could not parse beer: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_BEER(dictionary);
+
+    _lazy = YES;
+    _lazyValues = [[dictionary dictionaryWithValuesForKeys:BDB_LAZY_KEYS_BEER] mutableCopy];
+    if (!BDBLazyDecodingEnabled)
+    {
+        [self descriptionString];
+        [self breweries];
+        [self hops];
+        [self fermentables];
+        [self yeasts];
+        [self style];
+        _lazy = NO;
+    }
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_BEER(dictionary);
+    return dictionary;
+}
+
+#pragma mark Lazy Decoding
+- (NSString *)descriptionString
+{
+    if (!_lazy)
+        return _descriptionString;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        if (value)
+            _descriptionString = BDBTrimmedStringValue(value);
+        return _descriptionString;
+    }
+}
+
+- (void)setDescriptionString:(NSString *)descriptionString
+{
+    if (!_lazy)
+    {
+        _descriptionString = [descriptionString copy];
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        _descriptionString = [descriptionString copy];
+    }
+}
+
+- (NSArray *)breweries
+{
+    if (!_lazy)
+        return _breweries;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyBreweries);
+        if (value)
+            _breweries = BDBModelArrayValue(value, [BDBBrewery class]);
+        return _breweries;
+    }
+}
+
+- (void)setBreweries:(NSArray *)breweries
+{
+    if (!_lazy)
+    {
+        _breweries = breweries;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyBreweries);
+        _breweries = breweries;
+    }
+}
+
+- (NSArray *)hops
+{
+    if (!_lazy)
+        return _hops;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyHops);
+        if (value)
+            _hops = BDBModelArrayValue(value, [BDBHop class]);
+        return _hops;
+    }
+}
+
+- (void)setHops:(NSArray *)hops
+{
+    if (!_lazy)
+    {
+        _hops = hops;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyHops);
+        _hops = hops;
+    }
+}
+
+- (NSArray *)fermentables
+{
+    if (!_lazy)
+        return _fermentables;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyFermentables);
+        if (value)
+            _fermentables = BDBModelArrayValue(value, [BDBFermentable class]);
+        return _fermentables;
+    }
+}
+
+- (void)setFermentables:(NSArray *)fermentables
+{
+    if (!_lazy)
+    {
+        _fermentables = fermentables;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyFermentables);
+        _fermentables = fermentables;
+    }
+}
+
+- (NSArray *)yeasts
+{
+    if (!_lazy)
+        return _yeasts;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyYeasts);
+        if (value)
+            _yeasts = BDBModelArrayValue(value, [BDBYeast class]);
+        return _yeasts;
+    }
+}
+
+- (void)setYeasts:(NSArray *)yeasts
+{
+    if (!_lazy)
+    {
+        _yeasts = yeasts;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyYeasts);
+        _yeasts = yeasts;
+    }
+}
+
+- (BDBStyle *)style
+{
+    if (!_lazy)
+        return _style;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyStyle);
+        if (value)
+            _style = [[BDBIdentityMap sharedMap] objectOfClass:[BDBStyle class] withDictionary:BDBDictionaryValue(value)];
+        return _style;
+    }
+}
+
+- (void)setStyle:(BDBStyle *)style
+{
+    if (!_lazy)
+    {
+        _style = style;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyStyle);
+        _style = style;
+    }
+}
+
 @end
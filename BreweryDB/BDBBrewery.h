@@ -39,5 +39,6 @@
 @property (nonatomic, copy, readonly) NSString *status;
 
 - (id)initWithDictionary:(NSDictionary *)dictionary;
+- (NSDictionary *)dictionaryRepresentation;
 
 @end
@@ -21,12 +21,29 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBBrewery.h"
+#import "BDBGeneratedDecoders.h"
 #import "BDBLocation.h"
 
 
+#pragma mark -
+@interface BDBBrewery ()
+{
+    // In lazy mode, locations and the trimmed description are decoded on first access from the parts of
+    // the dictionary kept here, each released once decoded. Otherwise they are decoded up front and _lazy
+    // is cleared, so the accessors take no lock.
+    BOOL _lazy;
+    NSMutableDictionary *_lazyValues;
+}
+
+@end
+
+
 #pragma mark -
 @implementation BDBBrewery
 
+@synthesize descriptionString = _descriptionString;
+@synthesize locations = _locations;
+
 - (id)initWithDictionary:(NSDictionary *)dictionary
 {
     self = [super init];
@@ -36,37 +53,90 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _breweryId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-        _website = dictionary[NSStringFromSelector(@selector(website))];
-        _established = dictionary[NSStringFromSelector(@selector(established))];
-        _mailingListURL = dictionary[NSStringFromSelector(@selector(mailingListURL))];
-        _organic = [dictionary[NSStringFromSelector(@selector(isOrganic))] boolValue];
-        _images = dictionary[NSStringFromSelector(@selector(images))];
-
-        NSMutableArray *mutableLocations = [NSMutableArray array];
-        for (NSDictionary *locationDictionary in dictionary[NSStringFromSelector(@selector(locations))])
-        {
-            BDBLocation *location = [[BDBLocation alloc] initWithDictionary:locationDictionary];
-            if (location)
-                [mutableLocations addObject:location];
-            else
-                NSLog(@"Could not parse location: %@", location);
-        }
-        _locations = mutableLocations;
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
+        NSLog(@"Could not parse brewery: %@", dictionary);
+        return nil;
     }
-    @catch (NSException *exception)
+
+    BDB_DECODE_BREWERY(dictionary);
+
+    _lazy = YES;
+    _lazyValues = [[dictionary dictionaryWithValuesForKeys:BDB_LAZY_KEYS_BREWERY] mutableCopy];
+    if (!BDBLazyDecodingEnabled)
     {
-        NSLog(@"Could not parse brewery: %@", exception);
-        return nil;
+        [self descriptionString];
+        [self locations];
+        _lazy = NO;
     }
 
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_BREWERY(dictionary);
+    return dictionary;
+}
+
+#pragma mark Lazy Decoding
+- (NSString *)descriptionString
+{
+    if (!_lazy)
+        return _descriptionString;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        if (value)
+            _descriptionString = BDBTrimmedStringValue(value);
+        return _descriptionString;
+    }
+}
+
+- (void)setDescriptionString:(NSString *)descriptionString
+{
+    if (!_lazy)
+    {
+        _descriptionString = [descriptionString copy];
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        _descriptionString = [descriptionString copy];
+    }
+}
+
+- (NSArray *)locations
+{
+    if (!_lazy)
+        return _locations;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyLocations);
+        if (value)
+            _locations = BDBModelArrayValue(value, [BDBLocation class]);
+        return _locations;
+    }
+}
+
+- (void)setLocations:(NSArray *)locations
+{
+    if (!_lazy)
+    {
+        _locations = locations;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyLocations);
+        _locations = locations;
+    }
+}
+
 @end
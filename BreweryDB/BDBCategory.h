@@ -33,5 +33,6 @@
 @property (nonatomic, copy, readonly) NSString *status;
 
 - (id)initWithDictionary:(NSDictionary *)dictionary;
+- (NSDictionary *)dictionaryRepresentation;
 
 @end
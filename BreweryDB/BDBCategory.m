@@ -21,6 +21,7 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBCategory.h"
+#import "BDBGeneratedDecoders.h"
 
 
 #pragma mark -
@@ -35,21 +36,22 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _categoryId         = dictionary[@"id"];
-        _createDate         = dictionary[NSStringFromSelector(@selector(createDate))];
-        _name               = dictionary[NSStringFromSelector(@selector(name))];
-
-        _status             = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse category: %@", exception);
+        NSLog(@"Could not parse category: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_CATEGORY(dictionary);
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_CATEGORY(dictionary);
+    return dictionary;
+}
+
 @end
@@ -0,0 +1,151 @@
+//
+//  BDBColumnarResultSet.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBColumnarResultSet : NSObject
+
+#pragma mark Building
+/**
+ *  Copy fields of model objects into typed columns. Numeric fields are stored
+ *  as contiguous doubles, with numeric strings from the API converted; string
+ *  fields are dictionary-encoded. Each column has a bitmap of the rows that
+ *  have a value. Filtering, sorting and grouping return result sets that share
+ *  the columns, so none of them read the objects again.
+ *
+ *  @param objects     Model objects, e.g. BDBBeer.
+ *  @param numericKeys Key paths of numeric fields, e.g. "abv".
+ *  @param stringKeys  Key paths of string fields, e.g. "style.name".
+ *
+ *  @return A result set with a row per object, in order.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithObjects:(NSArray *)objects numericKeys:(NSArray *)numericKeys stringKeys:(NSArray *)stringKeys;
+
+/**
+ *  Result sets with the numeric and string fields of each model: abv, ibu,
+ *  year, styleId... for beers, the abv, ibu, srm, og and fg ranges for styles,
+ *  and the acid and oil ranges for hops.
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)resultSetWithBeers:(NSArray *)beers;
++ (instancetype)resultSetWithBreweries:(NSArray *)breweries;
++ (instancetype)resultSetWithStyles:(NSArray *)styles;
++ (instancetype)resultSetWithHops:(NSArray *)hops;
+
+@property (nonatomic, readonly) NSArray *numericKeys;
+@property (nonatomic, readonly) NSArray *stringKeys;
+
+#pragma mark Rows
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  @return The model objects of the rows, in order.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)objects;
+- (id)objectAtIndex:(NSUInteger)index;
+
+/**
+ *  @return The row's value, or NAN (nil for strings) if it has none.
+ *
+ *  @since 1.1.0
+ */
+- (double)doubleForKey:(NSString *)key atIndex:(NSUInteger)index;
+- (NSString *)stringForKey:(NSString *)key atIndex:(NSUInteger)index;
+
+#pragma mark Filtering
+/**
+ *  Rows whose value lies within a range. Rows without a value never match.
+ *
+ *  @param key     A numeric key.
+ *  @param minimum Inclusive lower bound, or -INFINITY.
+ *  @param maximum Inclusive upper bound, or INFINITY.
+ *
+ *  @return A result set of the matching rows, in order.
+ *
+ *  @since 1.1.0
+ */
+- (instancetype)resultSetFilteredByKey:(NSString *)key minimum:(double)minimum maximum:(double)maximum;
+
+/**
+ *  Rows whose value is one of a set of strings.
+ *
+ *  @param key    A string key.
+ *  @param values Strings to match.
+ *
+ *  @return A result set of the matching rows, in order.
+ *
+ *  @since 1.1.0
+ */
+- (instancetype)resultSetFilteredByKey:(NSString *)key values:(NSSet *)values;
+
+#pragma mark Sorting
+/**
+ *  Sort rows by several keys. Only the key and direction of each descriptor
+ *  are used: numbers compare numerically and strings with
+ *  localizedStandardCompare:. Rows without a value sort last in either
+ *  direction, and rows that compare equal keep their order.
+ *
+ *  @param sortDescriptors NSSortDescriptors on numeric and string keys.
+ *
+ *  @return A sorted result set.
+ *
+ *  @since 1.1.0
+ */
+- (instancetype)resultSetSortedByDescriptors:(NSArray *)sortDescriptors;
+
+#pragma mark Grouping
+/**
+ *  Split rows by the value of a key.
+ *
+ *  @param key A numeric or string key.
+ *
+ *  @return Result sets keyed by NSNumber or NSString value, with rows that have
+ *          no value under NSNull. Rows keep their order within each group.
+ *
+ *  @since 1.1.0
+ */
+- (NSDictionary *)resultSetsGroupedByKey:(NSString *)key;
+
+#pragma mark Aggregates
+/**
+ *  Aggregates of a numeric key over the rows that have a value.
+ *
+ *  @return The number of values, and their minimum, maximum, sum and mean; NAN
+ *          (0 for the sum) if there are none.
+ *
+ *  @since 1.1.0
+ */
+- (NSUInteger)countForKey:(NSString *)key;
+- (double)minimumForKey:(NSString *)key;
+- (double)maximumForKey:(NSString *)key;
+- (double)sumForKey:(NSString *)key;
+- (double)meanForKey:(NSString *)key;
+
+@end
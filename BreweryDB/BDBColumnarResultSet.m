@@ -0,0 +1,638 @@
+//
+//  BDBColumnarResultSet.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBColumnarResultSet.h"
+#import "BDBModelCoercion.h"
+
+#import <Accelerate/Accelerate.h>
+
+
+static inline BOOL BDBColumnHasValue(const uint64_t *validity, uint32_t row)
+{
+    return (validity[row >> 6] >> (row & 63)) & 1;
+}
+
+static inline uint32_t BDBColumnarRow(const uint32_t *rows, NSUInteger index)
+{
+    return rows ? rows[index] : (uint32_t)index;
+}
+
+typedef struct
+{
+    const uint32_t *rows;
+    NSUInteger keyCount;
+    const double **numbers;
+    const uint32_t **codes;
+    const uint64_t **validity;
+    const BOOL *ascending;
+} BDBColumnarSortContext;
+
+static int BDBColumnarCompareRows(void *thunk, const void *a, const void *b)
+{
+    const BDBColumnarSortContext *context = thunk;
+    uint32_t lhsIndex = *(const uint32_t *)a;
+    uint32_t rhsIndex = *(const uint32_t *)b;
+    uint32_t lhs = BDBColumnarRow(context->rows, lhsIndex);
+    uint32_t rhs = BDBColumnarRow(context->rows, rhsIndex);
+
+    for (NSUInteger key = 0; key < context->keyCount; key++)
+    {
+        BOOL lhsHasValue = BDBColumnHasValue(context->validity[key], lhs);
+        BOOL rhsHasValue = BDBColumnHasValue(context->validity[key], rhs);
+        if (lhsHasValue != rhsHasValue)
+            return lhsHasValue ? -1 : 1;
+        if (!lhsHasValue)
+            continue;
+
+        int order = 0;
+        if (context->numbers[key])
+        {
+            double lhsValue = context->numbers[key][lhs];
+            double rhsValue = context->numbers[key][rhs];
+            order = (lhsValue < rhsValue) ? -1 : (lhsValue > rhsValue) ? 1 : 0;
+        }
+        else
+        {
+            // Codes are assigned in string order, so they compare like the strings.
+            uint32_t lhsCode = context->codes[key][lhs];
+            uint32_t rhsCode = context->codes[key][rhs];
+            order = (lhsCode < rhsCode) ? -1 : (lhsCode > rhsCode) ? 1 : 0;
+        }
+        if (order != 0)
+            return context->ascending[key] ? order : -order;
+    }
+
+    // Positions are unique, so ties fall back to the order in this result set and the sort is stable.
+    return (lhsIndex < rhsIndex) ? -1 : (lhsIndex > rhsIndex) ? 1 : 0;
+}
+
+typedef struct
+{
+    double value;
+    uint32_t index;
+} BDBColumnarGroupEntry;
+
+static int BDBColumnarCompareGroupEntries(const void *a, const void *b)
+{
+    const BDBColumnarGroupEntry *lhs = a;
+    const BDBColumnarGroupEntry *rhs = b;
+    if (lhs->value != rhs->value)
+        return (lhs->value < rhs->value) ? -1 : 1;
+    return (lhs->index < rhs->index) ? -1 : (lhs->index > rhs->index) ? 1 : 0;
+}
+
+
+#pragma mark -
+@interface BDBColumnarColumn : NSObject
+
+- (id)initWithNumbersOfObjects:(NSArray *)objects keyPath:(NSString *)keyPath;
+- (id)initWithStringsOfObjects:(NSArray *)objects keyPath:(NSString *)keyPath;
+
+// Doubles, NAN where a row has no value; nil for string columns.
+@property (nonatomic, readonly) NSData *numbers;
+
+// Dictionary codes and the distinct strings they index, in localizedStandardCompare: order; nil for numeric columns.
+@property (nonatomic, readonly) NSData *codes;
+@property (nonatomic, readonly) NSArray *strings;
+
+// One bit per row, set when the row has a value.
+@property (nonatomic, readonly) NSData *validity;
+@property (nonatomic, readonly) NSUInteger nullCount;
+
+@end
+
+
+#pragma mark -
+@implementation BDBColumnarColumn
+
+- (id)initWithNumbersOfObjects:(NSArray *)objects keyPath:(NSString *)keyPath
+{
+    self = [super init];
+    if (self)
+    {
+        NSUInteger count = objects.count;
+        NSMutableData *numbers = [NSMutableData dataWithLength:count * sizeof(double)];
+        NSMutableData *validity = [NSMutableData dataWithLength:((count + 63) / 64) * sizeof(uint64_t)];
+        double *values = numbers.mutableBytes;
+        uint64_t *bits = validity.mutableBytes;
+
+        NSUInteger row = 0;
+        for (id object in objects)
+        {
+            NSNumber *number = BDBNumberValue([object valueForKeyPath:keyPath]);
+            double value = number ? number.doubleValue : NAN;
+            values[row] = value;
+            if (!isnan(value))
+                bits[row >> 6] |= (uint64_t)1 << (row & 63);
+            else
+                _nullCount++;
+            row++;
+        }
+
+        _numbers = numbers;
+        _validity = validity;
+    }
+    return self;
+}
+
+- (id)initWithStringsOfObjects:(NSArray *)objects keyPath:(NSString *)keyPath
+{
+    self = [super init];
+    if (self)
+    {
+        NSUInteger count = objects.count;
+        NSMutableData *codes = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+        NSMutableData *validity = [NSMutableData dataWithLength:((count + 63) / 64) * sizeof(uint64_t)];
+        uint32_t *rowCodes = codes.mutableBytes;
+        uint64_t *bits = validity.mutableBytes;
+
+        // Codes are first handed out as strings appear, then renumbered in sorted order.
+        NSMutableDictionary *firstCodes = [NSMutableDictionary dictionary];
+        NSMutableArray *strings = [NSMutableArray array];
+        NSUInteger row = 0;
+        for (id object in objects)
+        {
+            NSString *string = BDBStringValue([object valueForKeyPath:keyPath]);
+            if (string)
+            {
+                NSNumber *code = firstCodes[string];
+                if (!code)
+                {
+                    code = @(strings.count);
+                    firstCodes[string] = code;
+                    [strings addObject:string];
+                }
+                rowCodes[row] = (uint32_t)code.unsignedIntegerValue;
+                bits[row >> 6] |= (uint64_t)1 << (row & 63);
+            }
+            else
+            {
+                _nullCount++;
+            }
+            row++;
+        }
+
+        NSArray *sortedStrings = [strings sortedArrayUsingSelector:@selector(localizedStandardCompare:)];
+        uint32_t *sortedCodes = malloc(MAX(strings.count, 1) * sizeof(uint32_t));
+        for (NSUInteger index = 0; index < sortedStrings.count; index++)
+            sortedCodes[[firstCodes[sortedStrings[index]] unsignedIntegerValue]] = (uint32_t)index;
+        for (row = 0; row < count; row++)
+        {
+            if (BDBColumnHasValue(bits, (uint32_t)row))
+                rowCodes[row] = sortedCodes[rowCodes[row]];
+        }
+        free(sortedCodes);
+
+        _codes = codes;
+        _strings = sortedStrings;
+        _validity = validity;
+    }
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBColumnarResultSet ()
+{
+    NSArray *_sourceObjects;
+    NSDictionary *_columns;
+    NSData *_rows;
+}
+
+- (id)initWithSourceObjects:(NSArray *)sourceObjects
+                    columns:(NSDictionary *)columns
+                numericKeys:(NSArray *)numericKeys
+                 stringKeys:(NSArray *)stringKeys
+                       rows:(NSData *)rows;
+
+- (instancetype)resultSetWithRows:(NSData *)rows;
+- (BDBColumnarColumn *)columnForKey:(NSString *)key;
+
+// Values of the rows that have one: the column itself when nothing is filtered out, otherwise a copy.
+- (NSData *)valuesForKey:(NSString *)key;
+
+@end
+
+
+#pragma mark -
+@implementation BDBColumnarResultSet
+
+#pragma mark Building
+- (id)initWithObjects:(NSArray *)objects numericKeys:(NSArray *)numericKeys stringKeys:(NSArray *)stringKeys
+{
+    NSParameterAssert(objects.count < UINT32_MAX);
+
+    NSMutableDictionary *columns = [NSMutableDictionary dictionary];
+    for (NSString *key in numericKeys)
+        columns[key] = [[BDBColumnarColumn alloc] initWithNumbersOfObjects:objects keyPath:key];
+    for (NSString *key in stringKeys)
+        columns[key] = [[BDBColumnarColumn alloc] initWithStringsOfObjects:objects keyPath:key];
+
+    return [self initWithSourceObjects:[objects copy]
+                               columns:columns
+                           numericKeys:[numericKeys copy] ?: @[]
+                            stringKeys:[stringKeys copy] ?: @[]
+                                  rows:nil];
+}
+
+- (id)initWithSourceObjects:(NSArray *)sourceObjects
+                    columns:(NSDictionary *)columns
+                numericKeys:(NSArray *)numericKeys
+                 stringKeys:(NSArray *)stringKeys
+                       rows:(NSData *)rows
+{
+    self = [super init];
+    if (self)
+    {
+        _sourceObjects = sourceObjects ?: @[];
+        _columns = columns;
+        _numericKeys = numericKeys;
+        _stringKeys = stringKeys;
+        _rows = rows;
+        _count = rows ? rows.length / sizeof(uint32_t) : _sourceObjects.count;
+    }
+    return self;
+}
+
++ (instancetype)resultSetWithBeers:(NSArray *)beers
+{
+    return [[self alloc] initWithObjects:beers
+                             numericKeys:@[@"abv", @"ibu", @"year", @"styleId", @"glasswareId", @"availableId", @"servingTemperature", @"organic"]
+                              stringKeys:@[@"name", @"status", @"style.name"]];
+}
+
++ (instancetype)resultSetWithBreweries:(NSArray *)breweries
+{
+    return [[self alloc] initWithObjects:breweries
+                             numericKeys:@[@"established", @"organic"]
+                              stringKeys:@[@"name", @"status"]];
+}
+
++ (instancetype)resultSetWithStyles:(NSArray *)styles
+{
+    return [[self alloc] initWithObjects:styles
+                             numericKeys:@[@"abvMin", @"abvMax", @"ibuMin", @"ibuMax", @"srmMin", @"srmMax",
+                                           @"ogMin", @"ogMax", @"fgMin", @"fgMax", @"categoryId"]
+                              stringKeys:@[@"name", @"status", @"category.name"]];
+}
+
++ (instancetype)resultSetWithHops:(NSArray *)hops
+{
+    return [[self alloc] initWithObjects:hops
+                             numericKeys:@[@"alphaAcidMin", @"alphaAcidMax", @"betaAcidMin", @"betaAcidMax",
+                                           @"humuleneMin", @"humuleneMax", @"caryophylleneMin", @"caryophylleneMax",
+                                           @"cohumuloneMin", @"cohumuloneMax", @"myrceneMin", @"myrceneMax",
+                                           @"farneseneMin", @"farneseneMax"]
+                              stringKeys:@[@"name", @"countryOfOrigin", @"category", @"status"]];
+}
+
+- (instancetype)resultSetWithRows:(NSData *)rows
+{
+    return [[[self class] alloc] initWithSourceObjects:_sourceObjects
+                                               columns:_columns
+                                           numericKeys:_numericKeys
+                                            stringKeys:_stringKeys
+                                                  rows:rows];
+}
+
+- (BDBColumnarColumn *)columnForKey:(NSString *)key
+{
+    BDBColumnarColumn *column = _columns[key];
+    NSAssert(column, @"%@ has no column for %@", NSStringFromClass([self class]), key);
+    return column;
+}
+
+#pragma mark Rows
+- (NSArray *)objects
+{
+    if (!_rows)
+        return _sourceObjects;
+
+    const uint32_t *rows = _rows.bytes;
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:_count];
+    for (NSUInteger index = 0; index < _count; index++)
+        [objects addObject:_sourceObjects[rows[index]]];
+    return objects;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < _count);
+    return _sourceObjects[BDBColumnarRow(_rows.bytes, index)];
+}
+
+- (double)doubleForKey:(NSString *)key atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < _count);
+    BDBColumnarColumn *column = [self columnForKey:key];
+    if (!column.numbers)
+        return NAN;
+
+    const double *numbers = column.numbers.bytes;
+    return numbers[BDBColumnarRow(_rows.bytes, index)];
+}
+
+- (NSString *)stringForKey:(NSString *)key atIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < _count);
+    BDBColumnarColumn *column = [self columnForKey:key];
+    uint32_t row = BDBColumnarRow(_rows.bytes, index);
+    if (!column.codes || !BDBColumnHasValue(column.validity.bytes, row))
+        return nil;
+
+    const uint32_t *codes = column.codes.bytes;
+    return column.strings[codes[row]];
+}
+
+#pragma mark Filtering
+- (instancetype)resultSetFilteredByKey:(NSString *)key minimum:(double)minimum maximum:(double)maximum
+{
+    BDBColumnarColumn *column = [self columnForKey:key];
+    NSMutableData *matches = [NSMutableData dataWithLength:_count * sizeof(uint32_t)];
+    uint32_t *matchingRows = matches.mutableBytes;
+    NSUInteger matchCount = 0;
+
+    if (column.numbers)
+    {
+        // Rows without a value hold NAN, which fails both comparisons. Writing every row and advancing only past
+        // matches keeps the loop free of branches.
+        const double *numbers = column.numbers.bytes;
+        const uint32_t *rows = _rows.bytes;
+        if (!rows)
+        {
+            for (uint32_t row = 0; row < _count; row++)
+            {
+                matchingRows[matchCount] = row;
+                matchCount += (numbers[row] >= minimum) & (numbers[row] <= maximum);
+            }
+        }
+        else
+        {
+            for (NSUInteger index = 0; index < _count; index++)
+            {
+                uint32_t row = rows[index];
+                matchingRows[matchCount] = row;
+                matchCount += (numbers[row] >= minimum) & (numbers[row] <= maximum);
+            }
+        }
+    }
+
+    matches.length = matchCount * sizeof(uint32_t);
+    return [self resultSetWithRows:matches];
+}
+
+- (instancetype)resultSetFilteredByKey:(NSString *)key values:(NSSet *)values
+{
+    BDBColumnarColumn *column = [self columnForKey:key];
+    NSMutableData *matches = [NSMutableData dataWithLength:_count * sizeof(uint32_t)];
+    uint32_t *matchingRows = matches.mutableBytes;
+    NSUInteger matchCount = 0;
+
+    if (column.codes)
+    {
+        // Look each distinct string up once, then compare codes.
+        NSArray *strings = column.strings;
+        uint8_t *matchingCodes = calloc(MAX(strings.count, 1), sizeof(uint8_t));
+        for (NSUInteger code = 0; code < strings.count; code++)
+            matchingCodes[code] = [values containsObject:strings[code]];
+
+        const uint32_t *codes = column.codes.bytes;
+        const uint64_t *validity = column.validity.bytes;
+        const uint32_t *rows = _rows.bytes;
+        for (NSUInteger index = 0; index < _count; index++)
+        {
+            uint32_t row = BDBColumnarRow(rows, index);
+            matchingRows[matchCount] = row;
+            matchCount += BDBColumnHasValue(validity, row) & matchingCodes[codes[row]];
+        }
+        free(matchingCodes);
+    }
+
+    matches.length = matchCount * sizeof(uint32_t);
+    return [self resultSetWithRows:matches];
+}
+
+#pragma mark Sorting
+- (instancetype)resultSetSortedByDescriptors:(NSArray *)sortDescriptors
+{
+    NSUInteger descriptorCount = sortDescriptors.count;
+    const double *numbers[MAX(descriptorCount, 1)];
+    const uint32_t *codes[MAX(descriptorCount, 1)];
+    const uint64_t *validity[MAX(descriptorCount, 1)];
+    BOOL ascending[MAX(descriptorCount, 1)];
+    NSUInteger keyCount = 0;
+    for (NSSortDescriptor *sortDescriptor in sortDescriptors)
+    {
+        BDBColumnarColumn *column = [self columnForKey:sortDescriptor.key];
+        if (!column)
+            continue;
+        numbers[keyCount] = column.numbers.bytes;
+        codes[keyCount] = column.codes.bytes;
+        validity[keyCount] = column.validity.bytes;
+        ascending[keyCount] = sortDescriptor.ascending;
+        keyCount++;
+    }
+    const uint32_t *currentRows = _rows.bytes;
+    BDBColumnarSortContext context = { currentRows, keyCount, numbers, codes, validity, ascending };
+
+    // Sort positions in this result set rather than rows, then map them back to rows.
+    NSMutableData *sortedRows = [NSMutableData dataWithLength:_count * sizeof(uint32_t)];
+    uint32_t *rows = sortedRows.mutableBytes;
+    for (uint32_t index = 0; index < _count; index++)
+        rows[index] = index;
+
+    qsort_r(rows, _count, sizeof(uint32_t), &context, BDBColumnarCompareRows);
+    for (NSUInteger index = 0; index < _count; index++)
+        rows[index] = BDBColumnarRow(currentRows, rows[index]);
+    return [self resultSetWithRows:sortedRows];
+}
+
+#pragma mark Grouping
+- (NSDictionary *)resultSetsGroupedByKey:(NSString *)key
+{
+    BDBColumnarColumn *column = [self columnForKey:key];
+    if (!column)
+        return @{};
+
+    const uint64_t *validity = column.validity.bytes;
+    const uint32_t *rows = _rows.bytes;
+    NSMutableDictionary *groups = [NSMutableDictionary dictionary];
+
+    NSMutableData *nullRows = [NSMutableData data];
+    if (column.codes)
+    {
+        // Counting sort on the codes: count each group, then place rows at their group's offset.
+        NSUInteger codeCount = column.strings.count;
+        const uint32_t *codes = column.codes.bytes;
+        NSUInteger *offsets = calloc(codeCount + 1, sizeof(NSUInteger));
+        for (NSUInteger index = 0; index < _count; index++)
+        {
+            uint32_t row = BDBColumnarRow(rows, index);
+            if (BDBColumnHasValue(validity, row))
+                offsets[codes[row] + 1]++;
+            else
+                [nullRows appendBytes:&row length:sizeof(uint32_t)];
+        }
+        for (NSUInteger code = 0; code < codeCount; code++)
+            offsets[code + 1] += offsets[code];
+
+        NSUInteger valueCount = offsets[codeCount];
+        uint32_t *groupedRows = malloc(MAX(valueCount, 1) * sizeof(uint32_t));
+        NSUInteger *next = malloc((codeCount + 1) * sizeof(NSUInteger));
+        memcpy(next, offsets, (codeCount + 1) * sizeof(NSUInteger));
+        for (NSUInteger index = 0; index < _count; index++)
+        {
+            uint32_t row = BDBColumnarRow(rows, index);
+            if (BDBColumnHasValue(validity, row))
+                groupedRows[next[codes[row]]++] = row;
+        }
+
+        for (NSUInteger code = 0; code < codeCount; code++)
+        {
+            if (offsets[code + 1] == offsets[code])
+                continue;
+            NSData *group = [NSData dataWithBytes:groupedRows + offsets[code] length:(offsets[code + 1] - offsets[code]) * sizeof(uint32_t)];
+            groups[column.strings[code]] = [self resultSetWithRows:group];
+        }
+        free(next);
+        free(groupedRows);
+        free(offsets);
+    }
+    else
+    {
+        // Sort (value, position) pairs so each group is a run, with rows in their original order.
+        const double *numbers = column.numbers.bytes;
+        BDBColumnarGroupEntry *entries = malloc(MAX(_count, 1) * sizeof(BDBColumnarGroupEntry));
+        NSUInteger entryCount = 0;
+        for (NSUInteger index = 0; index < _count; index++)
+        {
+            uint32_t row = BDBColumnarRow(rows, index);
+            if (BDBColumnHasValue(validity, row))
+                entries[entryCount++] = (BDBColumnarGroupEntry){ numbers[row], (uint32_t)index };
+            else
+                [nullRows appendBytes:&row length:sizeof(uint32_t)];
+        }
+        qsort(entries, entryCount, sizeof(BDBColumnarGroupEntry), BDBColumnarCompareGroupEntries);
+
+        NSUInteger start = 0;
+        while (start < entryCount)
+        {
+            NSUInteger end = start + 1;
+            while (end < entryCount && entries[end].value == entries[start].value)
+                end++;
+
+            NSMutableData *group = [NSMutableData dataWithLength:(end - start) * sizeof(uint32_t)];
+            uint32_t *groupRows = group.mutableBytes;
+            for (NSUInteger entry = start; entry < end; entry++)
+                groupRows[entry - start] = BDBColumnarRow(rows, entries[entry].index);
+            groups[@(entries[start].value)] = [self resultSetWithRows:group];
+            start = end;
+        }
+        free(entries);
+    }
+
+    if (nullRows.length > 0)
+        groups[[NSNull null]] = [self resultSetWithRows:nullRows];
+    return groups;
+}
+
+#pragma mark Aggregates
+- (NSData *)valuesForKey:(NSString *)key
+{
+    BDBColumnarColumn *column = [self columnForKey:key];
+    if (!column.numbers)
+        return [NSData data];
+    if (!_rows && column.nullCount == 0)
+        return column.numbers;
+
+    const double *numbers = column.numbers.bytes;
+    const uint32_t *rows = _rows.bytes;
+    NSMutableData *values = [NSMutableData dataWithLength:_count * sizeof(double)];
+    double *gathered = values.mutableBytes;
+    NSUInteger valueCount = 0;
+    for (NSUInteger index = 0; index < _count; index++)
+    {
+        double value = numbers[BDBColumnarRow(rows, index)];
+        gathered[valueCount] = value;
+        valueCount += !isnan(value);
+    }
+    values.length = valueCount * sizeof(double);
+    return values;
+}
+
+- (NSUInteger)countForKey:(NSString *)key
+{
+    return [self valuesForKey:key].length / sizeof(double);
+}
+
+- (double)minimumForKey:(NSString *)key
+{
+    NSData *values = [self valuesForKey:key];
+    vDSP_Length count = values.length / sizeof(double);
+    if (count == 0)
+        return NAN;
+
+    double minimum = 0.0;
+    vDSP_minvD(values.bytes, 1, &minimum, count);
+    return minimum;
+}
+
+- (double)maximumForKey:(NSString *)key
+{
+    NSData *values = [self valuesForKey:key];
+    vDSP_Length count = values.length / sizeof(double);
+    if (count == 0)
+        return NAN;
+
+    double maximum = 0.0;
+    vDSP_maxvD(values.bytes, 1, &maximum, count);
+    return maximum;
+}
+
+- (double)sumForKey:(NSString *)key
+{
+    NSData *values = [self valuesForKey:key];
+    vDSP_Length count = values.length / sizeof(double);
+    if (count == 0)
+        return 0.0;
+
+    double sum = 0.0;
+    vDSP_sveD(values.bytes, 1, &sum, count);
+    return sum;
+}
+
+- (double)meanForKey:(NSString *)key
+{
+    NSData *values = [self valuesForKey:key];
+    vDSP_Length count = values.length / sizeof(double);
+    if (count == 0)
+        return NAN;
+
+    double mean = 0.0;
+    vDSP_meanvD(values.bytes, 1, &mean, count);
+    return mean;
+}
+
+@end
@@ -23,11 +23,22 @@
 #ifndef __BDBERRORS__
 #define __BDBERRORS__
 
+#import <Foundation/Foundation.h>
+
+
+// Error Domain
+FOUNDATION_EXPORT NSString * const BreweryDBErrorDomain;
+
 
 // Error Codes
 #define BDB_ERRNO_MISSING_API_KEY                           1000
 #define BDB_ERRNO_API_ERROR                                 1001
 #define BDB_ERRNO_BAD_API_RESPONSE                          1002
+#define BDB_ERRNO_OBJECT_NOT_FOUND                          1003
+#define BDB_ERRNO_REQUEST_DROPPED                           1004
+#define BDB_ERRNO_BAD_SNAPSHOT                              1005
+#define BDB_ERRNO_MISSING_STORE                             1006
+#define BDB_ERRNO_BAD_IMAGE                                 1007
 #define BDB_ERRNO_BEER_OBJECT_CREATION_FAILED               1100
 #define BDB_ERRNO_BREWERY_OBJECT_CREATION_FAILED            1101
 #define BDB_ERRNO_GUILD_OBJECT_CREATION_FAILED              1102
@@ -36,6 +47,11 @@
 // Error Messages
 #define BDB_ERROR_MISSING_API_KEY                           NSLocalizedString(@"API key has not been set.", @"Missing API key")
 #define BDB_ERROR_BAD_API_RESPONSE                          NSLocalizedString(@"Cannot parse API response.", @"Bad API response")
+#define BDB_ERROR_OBJECT_NOT_FOUND                          NSLocalizedString(@"No object exists with the requested ID.", @"Object not found")
+#define BDB_ERROR_REQUEST_DROPPED                           NSLocalizedString(@"Request was dropped because the request budget ran low.", @"Request dropped")
+#define BDB_ERROR_BAD_SNAPSHOT                              NSLocalizedString(@"Snapshot is damaged, has an unsupported version, or mixes object classes.", @"Bad snapshot")
+#define BDB_ERROR_MISSING_STORE                             NSLocalizedString(@"No store has been set to sync into.", @"Missing store")
+#define BDB_ERROR_BAD_IMAGE                                 NSLocalizedString(@"Cannot decode image.", @"Bad image")
 #define BDB_ERROR_BEER_OBJECT_CREATION_FAILED               NSLocalizedString(@"Could not create BDBBeer object.", @"BDBBeer creation failed")
 #define BDB_ERROR_BREWERY_OBJECT_CREATION_FAILED            NSLocalizedString(@"Could not create BDBBrewery object.", @"BDBBrewery creation failed")
 #define BDB_ERROR_GUILD_OBJECT_CREATION_FAILED              NSLocalizedString(@"Could not create BDBGuild object.", @"BDBGuild creation failed")
@@ -49,5 +49,6 @@
 @property (nonatomic, copy, readonly) NSString *status;
 
 - (id)initWithDictionary:(NSDictionary *)dictionary;
+- (NSDictionary *)dictionaryRepresentation;
 
 @end
@@ -21,6 +21,7 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBFermentable.h"
+#import "BDBGeneratedDecoders.h"
 
 #pragma mark -
 @implementation BDBFermentable
@@ -34,39 +35,22 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _fermentableId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-
-        _countryOfOrigin = dictionary[NSStringFromSelector(@selector(countryOfOrigin))];
-        _srmId = dictionary[NSStringFromSelector(@selector(srmId))];
-        _srmPrecise = dictionary[NSStringFromSelector(@selector(srmPrecise))];
-        _srm = dictionary[NSStringFromSelector(@selector(srm))];
-        _moistureContent = dictionary[NSStringFromSelector(@selector(moistureContent))];
-        _coarseFineDifference = dictionary[NSStringFromSelector(@selector(coarseFineDifference))];
-        _diastaticPower = dictionary[NSStringFromSelector(@selector(diastaticPower))];
-        _dryYield = dictionary[NSStringFromSelector(@selector(dryYield))];
-        _potential = dictionary[NSStringFromSelector(@selector(potential))];
-        _protein = dictionary[NSStringFromSelector(@selector(protein))];
-        _solubleNitrogenRatio = dictionary[NSStringFromSelector(@selector(solubleNitrogenRatio))];
-        _maxInBatch = dictionary[NSStringFromSelector(@selector(maxInBatch))];
-        _mashing = [dictionary[NSStringFromSelector(@selector(requiresMashing))] boolValue];
-        _category = dictionary[NSStringFromSelector(@selector(category))];
-        _categoryDisplay = dictionary[NSStringFromSelector(@selector(categoryDisplay))];
-        _country = dictionary[NSStringFromSelector(@selector(country))];
-        _characteristics = dictionary[NSStringFromSelector(@selector(characteristics))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse beer: %@", exception);
+        NSLog(@"Could not parse fermentable: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_FERMENTABLE(dictionary);
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_FERMENTABLE(dictionary);
+    return dictionary;
+}
+
 @end
@@ -0,0 +1,559 @@
+//
+//  BDBGeneratedDecoders.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//  Generated by Scripts/generate_decoders.py from BreweryDB/Schema/Models.json.
+//  Do not edit by hand; change the schema and run the script instead.
+
+#ifndef __BDBGENERATEDDECODERS__
+#define __BDBGENERATEDDECODERS__
+
+#import "BDBModelCoercion.h"
+
+
+// Keys
+static NSString * const BDBModelKeyAbv                       = @"abv";
+static NSString * const BDBModelKeyAbvMax                    = @"abvMax";
+static NSString * const BDBModelKeyAbvMin                    = @"abvMin";
+static NSString * const BDBModelKeyAlcoholToleranceMax       = @"alcoholToleranceMax";
+static NSString * const BDBModelKeyAlcoholToleranceMin       = @"alcoholToleranceMin";
+static NSString * const BDBModelKeyAlphaAcidMax              = @"alphaAcidMax";
+static NSString * const BDBModelKeyAlphaAcidMin              = @"alphaAcidMin";
+static NSString * const BDBModelKeyAttenuationMax            = @"attenuationMax";
+static NSString * const BDBModelKeyAttenuationMin            = @"attenuationMin";
+static NSString * const BDBModelKeyAvailable                 = @"available";
+static NSString * const BDBModelKeyAvailableId               = @"availableId";
+static NSString * const BDBModelKeyBeerVariationId           = @"beerVariationId";
+static NSString * const BDBModelKeyBetaAcidMax               = @"betaAcidMax";
+static NSString * const BDBModelKeyBetaAcidMin               = @"betaAcidMin";
+static NSString * const BDBModelKeyBreweries                 = @"breweries";
+static NSString * const BDBModelKeyBrewery                   = @"brewery";
+static NSString * const BDBModelKeyCaryophylleneMax          = @"caryophylleneMax";
+static NSString * const BDBModelKeyCaryophylleneMin          = @"caryophylleneMin";
+static NSString * const BDBModelKeyCategory                  = @"category";
+static NSString * const BDBModelKeyCategoryDisplay           = @"categoryDisplay";
+static NSString * const BDBModelKeyCategoryId                = @"categoryId";
+static NSString * const BDBModelKeyCharacteristics           = @"characteristics";
+static NSString * const BDBModelKeyCoarseFineDifference      = @"coarseFineDifference";
+static NSString * const BDBModelKeyCohumuloneMax             = @"cohumuloneMax";
+static NSString * const BDBModelKeyCohumuloneMin             = @"cohumuloneMin";
+static NSString * const BDBModelKeyCountry                   = @"country";
+static NSString * const BDBModelKeyCountryIsoCode            = @"countryIsoCode";
+static NSString * const BDBModelKeyCountryOfOrigin           = @"countryOfOrigin";
+static NSString * const BDBModelKeyCreateDate                = @"createDate";
+static NSString * const BDBModelKeyDescription               = @"description";
+static NSString * const BDBModelKeyDiastaticPower            = @"diastaticPower";
+static NSString * const BDBModelKeyDryYield                  = @"dryYield";
+static NSString * const BDBModelKeyEstablished               = @"established";
+static NSString * const BDBModelKeyExtendedAddress           = @"extendedAddress";
+static NSString * const BDBModelKeyFarneseneMax              = @"farneseneMax";
+static NSString * const BDBModelKeyFarneseneMin              = @"farneseneMin";
+static NSString * const BDBModelKeyFermentTempMax            = @"fermentTempMax";
+static NSString * const BDBModelKeyFermentTempMin            = @"fermentTempMin";
+static NSString * const BDBModelKeyFermentables              = @"fermentables";
+static NSString * const BDBModelKeyFgMax                     = @"fgMax";
+static NSString * const BDBModelKeyFgMin                     = @"fgMin";
+static NSString * const BDBModelKeyFoodPairings              = @"foodPairings";
+static NSString * const BDBModelKeyGlass                     = @"glass";
+static NSString * const BDBModelKeyGlasswareId               = @"glasswareId";
+static NSString * const BDBModelKeyHops                      = @"hops";
+static NSString * const BDBModelKeyHoursOfOperation          = @"hoursOfOperation";
+static NSString * const BDBModelKeyHoursOfOperationExplicit  = @"hoursOfOperationExplicit";
+static NSString * const BDBModelKeyHoursOfOperationNotes     = @"hoursOfOperationNotes";
+static NSString * const BDBModelKeyHumuleneMax               = @"humuleneMax";
+static NSString * const BDBModelKeyHumuleneMin               = @"humuleneMin";
+static NSString * const BDBModelKeyIbu                       = @"ibu";
+static NSString * const BDBModelKeyIbuMax                    = @"ibuMax";
+static NSString * const BDBModelKeyIbuMin                    = @"ibuMin";
+static NSString * const BDBModelKeyId                        = @"id";
+static NSString * const BDBModelKeyImages                    = @"images";
+static NSString * const BDBModelKeyInPlanning                = @"inPlanning";
+static NSString * const BDBModelKeyIsClosed                  = @"isClosed";
+static NSString * const BDBModelKeyIsForAroma                = @"isForAroma";
+static NSString * const BDBModelKeyIsForBittering            = @"isForBittering";
+static NSString * const BDBModelKeyIsForFlavor               = @"isForFlavor";
+static NSString * const BDBModelKeyIsNobel                   = @"isNobel";
+static NSString * const BDBModelKeyIsOrganic                 = @"isOrganic";
+static NSString * const BDBModelKeyIsPrimary                 = @"isPrimary";
+static NSString * const BDBModelKeyLabels                    = @"labels";
+static NSString * const BDBModelKeyLatitude                  = @"latitude";
+static NSString * const BDBModelKeyLocality                  = @"locality";
+static NSString * const BDBModelKeyLocationType              = @"locationType";
+static NSString * const BDBModelKeyLocationTypeDisplay       = @"locationTypeDisplay";
+static NSString * const BDBModelKeyLocations                 = @"locations";
+static NSString * const BDBModelKeyLongitude                 = @"longitude";
+static NSString * const BDBModelKeyMailingListURL            = @"mailingListURL";
+static NSString * const BDBModelKeyMaxInBatch                = @"maxInBatch";
+static NSString * const BDBModelKeyMoistureContent           = @"moistureContent";
+static NSString * const BDBModelKeyMyrceneMax                = @"myrceneMax";
+static NSString * const BDBModelKeyMyrceneMin                = @"myrceneMin";
+static NSString * const BDBModelKeyName                      = @"name";
+static NSString * const BDBModelKeyOgMax                     = @"ogMax";
+static NSString * const BDBModelKeyOgMin                     = @"ogMin";
+static NSString * const BDBModelKeyOpenToPublic              = @"openToPublic";
+static NSString * const BDBModelKeyOriginalGravity           = @"originalGravity";
+static NSString * const BDBModelKeyPhone                     = @"phone";
+static NSString * const BDBModelKeyPostalCode                = @"postalCode";
+static NSString * const BDBModelKeyPotential                 = @"potential";
+static NSString * const BDBModelKeyProductId                 = @"productId";
+static NSString * const BDBModelKeyProtein                   = @"protein";
+static NSString * const BDBModelKeyRegion                    = @"region";
+static NSString * const BDBModelKeyRequiresMashing           = @"requiresMashing";
+static NSString * const BDBModelKeyServingTemperature        = @"servingTemperature";
+static NSString * const BDBModelKeyServingTemperatureDisplay = @"servingTemperatureDisplay";
+static NSString * const BDBModelKeySolubleNitrogenRatio      = @"solubleNitrogenRatio";
+static NSString * const BDBModelKeySrm                       = @"srm";
+static NSString * const BDBModelKeySrmId                     = @"srmId";
+static NSString * const BDBModelKeySrmMax                    = @"srmMax";
+static NSString * const BDBModelKeySrmMin                    = @"srmMin";
+static NSString * const BDBModelKeySrmPrecise                = @"srmPrecise";
+static NSString * const BDBModelKeyStatus                    = @"status";
+static NSString * const BDBModelKeyStreetAddress             = @"streetAddress";
+static NSString * const BDBModelKeyStyle                     = @"style";
+static NSString * const BDBModelKeyStyleId                   = @"styleId";
+static NSString * const BDBModelKeySupplier                  = @"supplier";
+static NSString * const BDBModelKeyTimezone                  = @"timezone";
+static NSString * const BDBModelKeyTourInfo                  = @"tourInfo";
+static NSString * const BDBModelKeyWebsite                   = @"website";
+static NSString * const BDBModelKeyYear                      = @"year";
+static NSString * const BDBModelKeyYearClosed                = @"yearClosed";
+static NSString * const BDBModelKeyYearOpened                = @"yearOpened";
+static NSString * const BDBModelKeyYeastFormat               = @"yeastFormat";
+static NSString * const BDBModelKeyYeastType                 = @"yeastType";
+static NSString * const BDBModelKeyYeasts                    = @"yeasts";
+
+
+// BDBBeer
+// Decoded by the model, on first access in lazy mode: descriptionString, breweries, hops, fermentables, yeasts, style
+#define BDB_DECODE_BEER(dictionary)                                                                              \
+    do                                                                                                           \
+    {                                                                                                            \
+        _beerId = BDBStringValue((dictionary)[BDBModelKeyId]);                                                   \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                                                   \
+        _foodPairings = BDBStringValue((dictionary)[BDBModelKeyFoodPairings]);                                   \
+        _originalGravity = BDBStringValue((dictionary)[BDBModelKeyOriginalGravity]);                             \
+        _abv = BDBNumberValue((dictionary)[BDBModelKeyAbv]);                                                     \
+        _ibu = BDBNumberValue((dictionary)[BDBModelKeyIbu]);                                                     \
+        _glasswareId = BDBNumberValue((dictionary)[BDBModelKeyGlasswareId]);                                     \
+        _glass = BDBDictionaryValue((dictionary)[BDBModelKeyGlass]);                                             \
+        _styleId = BDBNumberValue((dictionary)[BDBModelKeyStyleId]);                                             \
+        _organic = BDBBoolValue((dictionary)[BDBModelKeyIsOrganic]);                                             \
+        _labels = BDBDictionaryValue((dictionary)[BDBModelKeyLabels]);                                           \
+        _servingTemperature = BDBObjectValue((dictionary)[BDBModelKeyServingTemperature]);                       \
+        _servingTemperatureDisplay = BDBInternedStringValue((dictionary)[BDBModelKeyServingTemperatureDisplay]); \
+        _availableId = BDBNumberValue((dictionary)[BDBModelKeyAvailableId]);                                     \
+        _available = BDBDictionaryValue((dictionary)[BDBModelKeyAvailable]);                                     \
+        _beerVariationId = BDBStringValue((dictionary)[BDBModelKeyBeerVariationId]);                             \
+        _year = BDBNumberValue((dictionary)[BDBModelKeyYear]);                                                   \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                                       \
+    } while (0)
+
+#define BDB_ENCODE_BEER(dictionary)                                                                                 \
+    do                                                                                                              \
+    {                                                                                                               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.beerId);                                           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyBreweries, BDBArrayRepresentation(self.breweries));         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHops, BDBArrayRepresentation(self.hops));                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFermentables, BDBArrayRepresentation(self.fermentables));   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYeasts, BDBArrayRepresentation(self.yeasts));               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFoodPairings, self.foodPairings);                           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyOriginalGravity, self.originalGravity);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAbv, self.abv);                                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIbu, self.ibu);                                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyGlasswareId, self.glasswareId);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyGlass, self.glass);                                         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStyleId, self.styleId);                                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStyle, BDBObjectRepresentation(self.style));                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsOrganic, BDBBoolRepresentation(self.organic));            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLabels, self.labels);                                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyServingTemperature, self.servingTemperature);               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyServingTemperatureDisplay, self.servingTemperatureDisplay); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAvailableId, self.availableId);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAvailable, self.available);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyBeerVariationId, self.beerVariationId);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYear, self.year);                                           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                                       \
+    } while (0)
+
+#define BDB_LAZY_KEYS_BEER @[BDBModelKeyDescription, BDBModelKeyBreweries, BDBModelKeyHops, BDBModelKeyFermentables, BDBModelKeyYeasts, BDBModelKeyStyle]
+
+
+// BDBBrewery
+// Decoded by the model, on first access in lazy mode: descriptionString, locations
+#define BDB_DECODE_BREWERY(dictionary)                                             \
+    do                                                                             \
+    {                                                                              \
+        _breweryId = BDBStringValue((dictionary)[BDBModelKeyId]);                  \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                     \
+        _website = BDBStringValue((dictionary)[BDBModelKeyWebsite]);               \
+        _established = BDBNumberValue((dictionary)[BDBModelKeyEstablished]);       \
+        _mailingListURL = BDBStringValue((dictionary)[BDBModelKeyMailingListURL]); \
+        _organic = BDBBoolValue((dictionary)[BDBModelKeyIsOrganic]);               \
+        _images = BDBDictionaryValue((dictionary)[BDBModelKeyImages]);             \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);         \
+    } while (0)
+
+#define BDB_ENCODE_BREWERY(dictionary)                                                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.breweryId);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyWebsite, self.website);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyEstablished, self.established);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyMailingListURL, self.mailingListURL);               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsOrganic, BDBBoolRepresentation(self.organic));    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyImages, self.images);                               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLocations, BDBArrayRepresentation(self.locations)); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                               \
+    } while (0)
+
+#define BDB_LAZY_KEYS_BREWERY @[BDBModelKeyDescription, BDBModelKeyLocations]
+
+
+// BDBLocation
+// Decoded by the model, on first access in lazy mode: brewery
+#define BDB_DECODE_LOCATION(dictionary)                                                                \
+    do                                                                                                 \
+    {                                                                                                  \
+        _locationId = BDBStringValue((dictionary)[BDBModelKeyId]);                                     \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                                         \
+        _streetAddress = BDBStringValue((dictionary)[BDBModelKeyStreetAddress]);                       \
+        _extendedAddress = BDBStringValue((dictionary)[BDBModelKeyExtendedAddress]);                   \
+        _locality = BDBInternedStringValue((dictionary)[BDBModelKeyLocality]);                         \
+        _region = BDBInternedStringValue((dictionary)[BDBModelKeyRegion]);                             \
+        _postalCode = BDBStringValue((dictionary)[BDBModelKeyPostalCode]);                             \
+        _phone = BDBStringValue((dictionary)[BDBModelKeyPhone]);                                       \
+        _website = BDBStringValue((dictionary)[BDBModelKeyWebsite]);                                   \
+        _hoursOfOperation = BDBStringValue((dictionary)[BDBModelKeyHoursOfOperation]);                 \
+        _hoursOfOperationExplicit = BDBStringValue((dictionary)[BDBModelKeyHoursOfOperationExplicit]); \
+        _hoursOfOperationNotes = BDBStringValue((dictionary)[BDBModelKeyHoursOfOperationNotes]);       \
+        _tourInfo = BDBStringValue((dictionary)[BDBModelKeyTourInfo]);                                 \
+        _timezone = BDBInternedStringValue((dictionary)[BDBModelKeyTimezone]);                         \
+        _latitude = BDBNumberValue((dictionary)[BDBModelKeyLatitude]);                                 \
+        _longitude = BDBNumberValue((dictionary)[BDBModelKeyLongitude]);                               \
+        _primary = BDBBoolValue((dictionary)[BDBModelKeyIsPrimary]);                                   \
+        _planning = BDBBoolValue((dictionary)[BDBModelKeyInPlanning]);                                 \
+        _closed = BDBBoolValue((dictionary)[BDBModelKeyIsClosed]);                                     \
+        _openToPublic = BDBBoolValue((dictionary)[BDBModelKeyOpenToPublic]);                           \
+        _locationType = BDBInternedStringValue((dictionary)[BDBModelKeyLocationType]);                 \
+        _locationTypeDisplay = BDBInternedStringValue((dictionary)[BDBModelKeyLocationTypeDisplay]);   \
+        _countryIsoCode = BDBInternedStringValue((dictionary)[BDBModelKeyCountryIsoCode]);             \
+        _country = BDBDictionaryValue((dictionary)[BDBModelKeyCountry]);                               \
+        _yearOpened = BDBNumberValue((dictionary)[BDBModelKeyYearOpened]);                             \
+        _yearClosed = BDBNumberValue((dictionary)[BDBModelKeyYearClosed]);                             \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                             \
+    } while (0)
+
+#define BDB_ENCODE_LOCATION(dictionary)                                                                           \
+    do                                                                                                            \
+    {                                                                                                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.locationId);                                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStreetAddress, self.streetAddress);                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyExtendedAddress, self.extendedAddress);                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLocality, self.locality);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyRegion, self.region);                                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyPostalCode, self.postalCode);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyPhone, self.phone);                                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyWebsite, self.website);                                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHoursOfOperation, self.hoursOfOperation);                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHoursOfOperationExplicit, self.hoursOfOperationExplicit); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHoursOfOperationNotes, self.hoursOfOperationNotes);       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyTourInfo, self.tourInfo);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyTimezone, self.timezone);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLatitude, self.latitude);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLongitude, self.longitude);                               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyBrewery, BDBObjectRepresentation(self.brewery));          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsPrimary, BDBBoolRepresentation(self.primary));          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyInPlanning, BDBBoolRepresentation(self.planning));        \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsClosed, BDBBoolRepresentation(self.closed));            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyOpenToPublic, BDBBoolRepresentation(self.openToPublic));  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLocationType, self.locationType);                         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyLocationTypeDisplay, self.locationTypeDisplay);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountryIsoCode, self.countryIsoCode);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountry, self.country);                                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYearOpened, self.yearOpened);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYearClosed, self.yearClosed);                             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                                     \
+    } while (0)
+
+#define BDB_LAZY_KEYS_LOCATION @[BDBModelKeyBrewery]
+
+
+// BDBStyle
+// Decoded by the model, on first access in lazy mode: category, descriptionString
+#define BDB_DECODE_STYLE(dictionary)                                       \
+    do                                                                     \
+    {                                                                      \
+        _styleId = BDBStringValue((dictionary)[BDBModelKeyId]);            \
+        _srmMax = BDBNumberValue((dictionary)[BDBModelKeySrmMax]);         \
+        _ibuMax = BDBNumberValue((dictionary)[BDBModelKeyIbuMax]);         \
+        _srmMin = BDBNumberValue((dictionary)[BDBModelKeySrmMin]);         \
+        _fgMin = BDBNumberValue((dictionary)[BDBModelKeyFgMin]);           \
+        _ibuMin = BDBNumberValue((dictionary)[BDBModelKeyIbuMin]);         \
+        _createDate = BDBObjectValue((dictionary)[BDBModelKeyCreateDate]); \
+        _fgMax = BDBNumberValue((dictionary)[BDBModelKeyFgMax]);           \
+        _abvMax = BDBNumberValue((dictionary)[BDBModelKeyAbvMax]);         \
+        _ogMin = BDBNumberValue((dictionary)[BDBModelKeyOgMin]);           \
+        _ogMax = BDBNumberValue((dictionary)[BDBModelKeyOgMax]);           \
+        _abvMin = BDBNumberValue((dictionary)[BDBModelKeyAbvMin]);         \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);             \
+        _categoryId = BDBNumberValue((dictionary)[BDBModelKeyCategoryId]); \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]); \
+    } while (0)
+
+#define BDB_ENCODE_STYLE(dictionary)                                                                       \
+    do                                                                                                     \
+    {                                                                                                      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.styleId);                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategory, BDBObjectRepresentation(self.category)); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySrmMax, self.srmMax);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIbuMax, self.ibuMax);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySrmMin, self.srmMin);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFgMin, self.fgMin);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIbuMin, self.ibuMin);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCreateDate, self.createDate);                      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFgMax, self.fgMax);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAbvMax, self.abvMax);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyOgMin, self.ogMin);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyOgMax, self.ogMax);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAbvMin, self.abvMin);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategoryId, self.categoryId);                      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                              \
+    } while (0)
+
+#define BDB_LAZY_KEYS_STYLE @[BDBModelKeyCategory, BDBModelKeyDescription]
+
+
+// BDBCategory
+#define BDB_DECODE_CATEGORY(dictionary)                                    \
+    do                                                                     \
+    {                                                                      \
+        _categoryId = BDBStringValue((dictionary)[BDBModelKeyId]);         \
+        _createDate = BDBObjectValue((dictionary)[BDBModelKeyCreateDate]); \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);             \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]); \
+    } while (0)
+
+#define BDB_ENCODE_CATEGORY(dictionary)                                               \
+    do                                                                                \
+    {                                                                                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.categoryId);         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCreateDate, self.createDate); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);             \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);         \
+    } while (0)
+
+
+// BDBFermentable
+#define BDB_DECODE_FERMENTABLE(dictionary)                                                     \
+    do                                                                                         \
+    {                                                                                          \
+        _fermentableId = BDBStringValue((dictionary)[BDBModelKeyId]);                          \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                                 \
+        _descriptionString = BDBTrimmedStringValue((dictionary)[BDBModelKeyDescription]);      \
+        _countryOfOrigin = BDBInternedStringValue((dictionary)[BDBModelKeyCountryOfOrigin]);   \
+        _srmId = BDBNumberValue((dictionary)[BDBModelKeySrmId]);                               \
+        _srmPrecise = BDBNumberValue((dictionary)[BDBModelKeySrmPrecise]);                     \
+        _srm = BDBDictionaryValue((dictionary)[BDBModelKeySrm]);                               \
+        _moistureContent = BDBNumberValue((dictionary)[BDBModelKeyMoistureContent]);           \
+        _coarseFineDifference = BDBNumberValue((dictionary)[BDBModelKeyCoarseFineDifference]); \
+        _diastaticPower = BDBNumberValue((dictionary)[BDBModelKeyDiastaticPower]);             \
+        _dryYield = BDBNumberValue((dictionary)[BDBModelKeyDryYield]);                         \
+        _potential = BDBNumberValue((dictionary)[BDBModelKeyPotential]);                       \
+        _protein = BDBNumberValue((dictionary)[BDBModelKeyProtein]);                           \
+        _solubleNitrogenRatio = BDBNumberValue((dictionary)[BDBModelKeySolubleNitrogenRatio]); \
+        _maxInBatch = BDBNumberValue((dictionary)[BDBModelKeyMaxInBatch]);                     \
+        _mashing = BDBBoolValue((dictionary)[BDBModelKeyRequiresMashing]);                     \
+        _category = BDBInternedStringValue((dictionary)[BDBModelKeyCategory]);                 \
+        _categoryDisplay = BDBInternedStringValue((dictionary)[BDBModelKeyCategoryDisplay]);   \
+        _country = BDBDictionaryValue((dictionary)[BDBModelKeyCountry]);                       \
+        _characteristics = BDBObjectValue((dictionary)[BDBModelKeyCharacteristics]);           \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                     \
+    } while (0)
+
+#define BDB_ENCODE_FERMENTABLE(dictionary)                                                                     \
+    do                                                                                                         \
+    {                                                                                                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.fermentableId);                               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountryOfOrigin, self.countryOfOrigin);                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySrmId, self.srmId);                                    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySrmPrecise, self.srmPrecise);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySrm, self.srm);                                        \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyMoistureContent, self.moistureContent);                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCoarseFineDifference, self.coarseFineDifference);      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDiastaticPower, self.diastaticPower);                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDryYield, self.dryYield);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyPotential, self.potential);                            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyProtein, self.protein);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySolubleNitrogenRatio, self.solubleNitrogenRatio);      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyMaxInBatch, self.maxInBatch);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyRequiresMashing, BDBBoolRepresentation(self.mashing)); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategory, self.category);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategoryDisplay, self.categoryDisplay);                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountry, self.country);                                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCharacteristics, self.characteristics);                \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                                  \
+    } while (0)
+
+
+// BDBHop
+#define BDB_DECODE_HOP(dictionary)                                                           \
+    do                                                                                       \
+    {                                                                                        \
+        _hopId = BDBStringValue((dictionary)[BDBModelKeyId]);                                \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                               \
+        _descriptionString = BDBTrimmedStringValue((dictionary)[BDBModelKeyDescription]);    \
+        _countryOfOrigin = BDBInternedStringValue((dictionary)[BDBModelKeyCountryOfOrigin]); \
+        _alphaAcidMin = BDBNumberValue((dictionary)[BDBModelKeyAlphaAcidMin]);               \
+        _alphaAcidMax = BDBNumberValue((dictionary)[BDBModelKeyAlphaAcidMax]);               \
+        _betaAcidMin = BDBNumberValue((dictionary)[BDBModelKeyBetaAcidMin]);                 \
+        _betaAcidMax = BDBNumberValue((dictionary)[BDBModelKeyBetaAcidMax]);                 \
+        _humuleneMin = BDBNumberValue((dictionary)[BDBModelKeyHumuleneMin]);                 \
+        _humuleneMax = BDBNumberValue((dictionary)[BDBModelKeyHumuleneMax]);                 \
+        _caryophylleneMin = BDBNumberValue((dictionary)[BDBModelKeyCaryophylleneMin]);       \
+        _caryophylleneMax = BDBNumberValue((dictionary)[BDBModelKeyCaryophylleneMax]);       \
+        _cohumuloneMin = BDBNumberValue((dictionary)[BDBModelKeyCohumuloneMin]);             \
+        _cohumuloneMax = BDBNumberValue((dictionary)[BDBModelKeyCohumuloneMax]);             \
+        _myrceneMin = BDBNumberValue((dictionary)[BDBModelKeyMyrceneMin]);                   \
+        _myrceneMax = BDBNumberValue((dictionary)[BDBModelKeyMyrceneMax]);                   \
+        _farneseneMin = BDBNumberValue((dictionary)[BDBModelKeyFarneseneMin]);               \
+        _farneseneMax = BDBNumberValue((dictionary)[BDBModelKeyFarneseneMax]);               \
+        _nobel = BDBBoolValue((dictionary)[BDBModelKeyIsNobel]);                             \
+        _forBittering = BDBBoolValue((dictionary)[BDBModelKeyIsForBittering]);               \
+        _forFlavor = BDBBoolValue((dictionary)[BDBModelKeyIsForFlavor]);                     \
+        _forAroma = BDBBoolValue((dictionary)[BDBModelKeyIsForAroma]);                       \
+        _category = BDBInternedStringValue((dictionary)[BDBModelKeyCategory]);               \
+        _categoryDisplay = BDBInternedStringValue((dictionary)[BDBModelKeyCategoryDisplay]); \
+        _country = BDBDictionaryValue((dictionary)[BDBModelKeyCountry]);                     \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                   \
+    } while (0)
+
+#define BDB_ENCODE_HOP(dictionary)                                                                                 \
+    do                                                                                                             \
+    {                                                                                                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.hopId);                                           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);                      \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountryOfOrigin, self.countryOfOrigin);                    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAlphaAcidMin, self.alphaAcidMin);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAlphaAcidMax, self.alphaAcidMax);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyBetaAcidMin, self.betaAcidMin);                            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyBetaAcidMax, self.betaAcidMax);                            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHumuleneMin, self.humuleneMin);                            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyHumuleneMax, self.humuleneMax);                            \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCaryophylleneMin, self.caryophylleneMin);                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCaryophylleneMax, self.caryophylleneMax);                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCohumuloneMin, self.cohumuloneMin);                        \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCohumuloneMax, self.cohumuloneMax);                        \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyMyrceneMin, self.myrceneMin);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyMyrceneMax, self.myrceneMax);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFarneseneMin, self.farneseneMin);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFarneseneMax, self.farneseneMax);                          \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsNobel, BDBBoolRepresentation(self.nobel));               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsForBittering, BDBBoolRepresentation(self.forBittering)); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsForFlavor, BDBBoolRepresentation(self.forFlavor));       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyIsForAroma, BDBBoolRepresentation(self.forAroma));         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategory, self.category);                                  \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategoryDisplay, self.categoryDisplay);                    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCountry, self.country);                                    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                                      \
+    } while (0)
+
+
+// BDBYeast
+#define BDB_DECODE_YEAST(dictionary)                                                         \
+    do                                                                                       \
+    {                                                                                        \
+        _yeastId = BDBStringValue((dictionary)[BDBModelKeyId]);                              \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                               \
+        _descriptionString = BDBTrimmedStringValue((dictionary)[BDBModelKeyDescription]);    \
+        _yeastType = BDBInternedStringValue((dictionary)[BDBModelKeyYeastType]);             \
+        _attenuationMin = BDBNumberValue((dictionary)[BDBModelKeyAttenuationMin]);           \
+        _attenuationMax = BDBNumberValue((dictionary)[BDBModelKeyAttenuationMax]);           \
+        _fermentTempMin = BDBNumberValue((dictionary)[BDBModelKeyFermentTempMin]);           \
+        _fermentTempMax = BDBNumberValue((dictionary)[BDBModelKeyFermentTempMax]);           \
+        _alcoholToleranceMin = BDBNumberValue((dictionary)[BDBModelKeyAlcoholToleranceMin]); \
+        _alcoholToleranceMax = BDBNumberValue((dictionary)[BDBModelKeyAlcoholToleranceMax]); \
+        _productId = BDBStringValue((dictionary)[BDBModelKeyProductId]);                     \
+        _supplier = BDBInternedStringValue((dictionary)[BDBModelKeySupplier]);               \
+        _yeastFormat = BDBInternedStringValue((dictionary)[BDBModelKeyYeastFormat]);         \
+        _category = BDBInternedStringValue((dictionary)[BDBModelKeyCategory]);               \
+        _categoryDisplay = BDBInternedStringValue((dictionary)[BDBModelKeyCategoryDisplay]); \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                   \
+    } while (0)
+
+#define BDB_ENCODE_YEAST(dictionary)                                                                    \
+    do                                                                                                  \
+    {                                                                                                   \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.yeastId);                              \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYeastType, self.yeastType);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAttenuationMin, self.attenuationMin);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAttenuationMax, self.attenuationMax);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFermentTempMin, self.fermentTempMin);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyFermentTempMax, self.fermentTempMax);           \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAlcoholToleranceMin, self.alcoholToleranceMin); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyAlcoholToleranceMax, self.alcoholToleranceMax); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyProductId, self.productId);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeySupplier, self.supplier);                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyYeastFormat, self.yeastFormat);                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategory, self.category);                       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyCategoryDisplay, self.categoryDisplay);         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                           \
+    } while (0)
+
+
+// BDBGuild
+#define BDB_DECODE_GUILD(dictionary)                                                      \
+    do                                                                                    \
+    {                                                                                     \
+        _guildId = BDBStringValue((dictionary)[BDBModelKeyId]);                           \
+        _name = BDBStringValue((dictionary)[BDBModelKeyName]);                            \
+        _descriptionString = BDBTrimmedStringValue((dictionary)[BDBModelKeyDescription]); \
+        _website = BDBStringValue((dictionary)[BDBModelKeyWebsite]);                      \
+        _images = BDBDictionaryValue((dictionary)[BDBModelKeyImages]);                    \
+        _established = BDBNumberValue((dictionary)[BDBModelKeyEstablished]);              \
+        _status = BDBInternedStringValue((dictionary)[BDBModelKeyStatus]);                \
+    } while (0)
+
+#define BDB_ENCODE_GUILD(dictionary)                                                          \
+    do                                                                                        \
+    {                                                                                         \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyId, self.guildId);                    \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyName, self.name);                     \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyDescription, self.descriptionString); \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyWebsite, self.website);               \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyImages, self.images);                 \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyEstablished, self.established);       \
+        BDBSetRepresentedValue((dictionary), BDBModelKeyStatus, self.status);                 \
+    } while (0)
+
+
+#endif
@@ -36,5 +36,6 @@
 @property (nonatomic, copy, readonly) NSString *status;
 
 - (id)initWithDictionary:(NSDictionary *)dictionary;
+- (NSDictionary *)dictionaryRepresentation;
 
 @end
@@ -21,6 +21,7 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBGuild.h"
+#import "BDBGeneratedDecoders.h"
 
 
 #pragma mark -
@@ -35,24 +36,22 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _guildId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-        _website = dictionary[NSStringFromSelector(@selector(website))];
-        _images = dictionary[NSStringFromSelector(@selector(images))];
-        _established = dictionary[NSStringFromSelector(@selector(established))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse guild: %@", exception);
+        NSLog(@"Could not parse guild: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_GUILD(dictionary);
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_GUILD(dictionary);
+    return dictionary;
+}
+
 @end
@@ -21,6 +21,7 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBHop.h"
+#import "BDBGeneratedDecoders.h"
 
 #pragma mark -
 @implementation BDBHop
@@ -34,47 +35,22 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _hopId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-
-        _countryOfOrigin = dictionary[NSStringFromSelector(@selector(countryOfOrigin))];
-        
-        _alphaAcidMin = dictionary[NSStringFromSelector(@selector(alphaAcidMin))];
-        _alphaAcidMax = dictionary[NSStringFromSelector(@selector(alphaAcidMax))];
-        _betaAcidMin = dictionary[NSStringFromSelector(@selector(betaAcidMin))];
-        _betaAcidMax = dictionary[NSStringFromSelector(@selector(betaAcidMax))];
-        _humuleneMin = dictionary[NSStringFromSelector(@selector(humuleneMin))];
-        _humuleneMax = dictionary[NSStringFromSelector(@selector(humuleneMax))];
-        _caryophylleneMin = dictionary[NSStringFromSelector(@selector(caryophylleneMin))];
-        _caryophylleneMax = dictionary[NSStringFromSelector(@selector(caryophylleneMax))];
-        _cohumuloneMin = dictionary[NSStringFromSelector(@selector(cohumuloneMin))];
-        _cohumuloneMax = dictionary[NSStringFromSelector(@selector(cohumuloneMax))];
-        _myrceneMin = dictionary[NSStringFromSelector(@selector(myrceneMin))];
-        _myrceneMax = dictionary[NSStringFromSelector(@selector(myrceneMax))];
-        _farneseneMin = dictionary[NSStringFromSelector(@selector(farneseneMin))];
-        _farneseneMax = dictionary[NSStringFromSelector(@selector(farneseneMax))];
-
-        _nobel = [dictionary[NSStringFromSelector(@selector(isNobel))] boolValue];
-        _forBittering = [dictionary[NSStringFromSelector(@selector(isForBittering))] boolValue];
-        _forFlavor = [dictionary[NSStringFromSelector(@selector(isForFlavor))] boolValue];
-        _forAroma = [dictionary[NSStringFromSelector(@selector(isForAroma))] boolValue];
-
-        _category = dictionary[NSStringFromSelector(@selector(category))];
-        _categoryDisplay = dictionary[NSStringFromSelector(@selector(categoryDisplay))];
-        _country = dictionary[NSStringFromSelector(@selector(country))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse beer: %@", exception);
+        NSLog(@"Could not parse hop: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_HOP(dictionary);
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_HOP(dictionary);
+    return dictionary;
+}
+
 @end
@@ -0,0 +1,88 @@
+//
+//  BDBHydrator.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequest.h"
+
+@class BreweryDB;
+
+
+typedef NS_OPTIONS(NSUInteger, BDBHydrationOptions)
+{
+    BDBHydrationHops              = 1 << 0,
+    BDBHydrationFermentables      = 1 << 1,
+    BDBHydrationYeasts            = 1 << 2,
+    BDBHydrationBreweryLocations  = 1 << 3,
+    BDBHydrationIngredients       = BDBHydrationHops | BDBHydrationFermentables | BDBHydrationYeasts,
+    BDBHydrationAll               = BDBHydrationIngredients | BDBHydrationBreweryLocations,
+};
+
+
+#pragma mark -
+@interface BDBHydrator : NSObject
+
+/**
+ *  Create a hydrator for one batch of beers.
+ *
+ *  @param client                    The client requests are made with.
+ *  @param options                   What to fetch for each beer.
+ *  @param maximumConcurrentRequests Most requests the hydrator keeps in flight at once.
+ *
+ *  @return A new hydrator.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithClient:(BreweryDB *)client
+             options:(BDBHydrationOptions)options
+maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests;
+
+/**
+ *  Create a hydrator that makes its requests with +[BreweryDB defaultClient].
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithOptions:(BDBHydrationOptions)options maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests;
+
+/**
+ *  Fetch everything the options ask for, concurrently, and attach it to the
+ *  beers: their hops, fermentables and yeasts, and the locations of their
+ *  breweries. Beers and breweries that appear more than once are fetched once.
+ *
+ *  @param beers         BDBBeer objects, or beer IDs to load with brewery info first.
+ *  @param callbackQueue Queue success and failure are performed on.
+ *  @param success       Called once with the hydrated beers, in the order given, and
+ *                       the errors of any requests that failed, keyed by API path.
+ *                       Beers that could not be loaded are left out.
+ *  @param failure       Called only if the hydration is cancelled.
+ *
+ *  @return A handle that cancels every request of the hydration.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)hydrateBeers:(NSArray *)beers
+               callbackQueue:(dispatch_queue_t)callbackQueue
+                     success:(void (^)(NSArray *beers, NSDictionary *errors))success
+                     failure:(void (^)(NSError *error))failure;
+
+@end
@@ -0,0 +1,333 @@
+//
+//  BDBHydrator.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBHydrator.h"
+#import "BDBRequest_Private.h"
+#import "BreweryDB.h"
+
+
+#pragma mark -
+@interface BDBHydrator ()
+{
+    BreweryDB *_client;
+    BDBHydrationOptions _options;
+    NSUInteger _maximumConcurrentRequests;
+
+    // Everything below is only touched on _queue.
+    dispatch_queue_t _queue;
+    BDBRequest *_request;
+    NSMutableArray *_pendingRequests;
+    NSUInteger _activeRequestCount;
+    BOOL _finished;
+    void (^_completion)(void);
+
+    NSMutableArray *_beers;
+    NSMutableDictionary *_beersById;
+    NSMutableDictionary *_breweriesById;
+    NSMutableDictionary *_resultsByPath;
+    NSMutableDictionary *_errorsByPath;
+}
+
+- (void)enqueueRequest:(BDBRequest *(^)(void))request;
+- (void)startPendingRequests;
+- (void)requestFinished;
+
+- (void)loadBeerWithId:(NSString *)beerId atIndex:(NSUInteger)index;
+- (void)hydrateBeer:(BDBBeer *)beer;
+- (void)fetchListAtPath:(NSString *)path
+              withBlock:(BDBRequest *(^)(NSDictionary *parameters, void (^success)(NSArray *, NSUInteger, NSUInteger), void (^failure)(NSError *)))block;
+- (void)finishWithCallbackQueue:(dispatch_queue_t)callbackQueue success:(void (^)(NSArray *, NSDictionary *))success;
+
+@end
+
+
+#pragma mark -
+@implementation BDBHydrator
+
+- (id)init
+{
+    return [self initWithOptions:BDBHydrationAll maximumConcurrentRequests:4];
+}
+
+- (id)initWithOptions:(BDBHydrationOptions)options maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+{
+    return [self initWithClient:[BreweryDB defaultClient] options:options maximumConcurrentRequests:maximumConcurrentRequests];
+}
+
+- (id)initWithClient:(BreweryDB *)client
+             options:(BDBHydrationOptions)options
+maximumConcurrentRequests:(NSUInteger)maximumConcurrentRequests
+{
+    NSParameterAssert(client);
+
+    self = [super init];
+    if (self)
+    {
+        _client = client;
+        _options = options;
+        _maximumConcurrentRequests = MAX(maximumConcurrentRequests, 1);
+        _queue = dispatch_queue_create("com.brewerydb.hydrator", DISPATCH_QUEUE_SERIAL);
+        _pendingRequests = [NSMutableArray array];
+        _beers = [NSMutableArray array];
+        _beersById = [NSMutableDictionary dictionary];
+        _breweriesById = [NSMutableDictionary dictionary];
+        _resultsByPath = [NSMutableDictionary dictionary];
+        _errorsByPath = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (BDBRequest *)hydrateBeers:(NSArray *)beers
+               callbackQueue:(dispatch_queue_t)callbackQueue
+                     success:(void (^)(NSArray *, NSDictionary *))success
+                     failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(callbackQueue);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+    NSAssert(!_request, @"A hydrator hydrates one batch of beers");
+
+    _request = [[BDBRequest alloc] init];
+    [_request addCancellationHandler:^{
+        dispatch_async(callbackQueue, ^{
+            failure([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+        });
+    }];
+
+    dispatch_async(_queue, ^{
+        for (id beer in beers)
+        {
+            [_beers addObject:[NSNull null]];
+            if ([beer isKindOfClass:[NSString class]])
+            {
+                [self loadBeerWithId:beer atIndex:_beers.count - 1];
+            }
+            else if ([beer isKindOfClass:[BDBBeer class]])
+            {
+                _beers[_beers.count - 1] = beer;
+
+                // A beer fetched without brewery info needs its breweries before their locations.
+                if ((_options & BDBHydrationBreweryLocations) && [beer breweries].count == 0 && [beer beerId])
+                    [self loadBeerWithId:[beer beerId] atIndex:_beers.count - 1];
+                else
+                    [self hydrateBeer:beer];
+            }
+        }
+
+        // Runs once the last request has finished; the completion block keeps self alive until then.
+        _completion = ^{
+            [self finishWithCallbackQueue:callbackQueue success:success];
+        };
+        [self startPendingRequests];
+    });
+
+    return _request;
+}
+
+#pragma mark Requests
+- (void)enqueueRequest:(BDBRequest *(^)(void))request
+{
+    [_pendingRequests addObject:[request copy]];
+}
+
+- (void)startPendingRequests
+{
+    if (_request.isCancelled)
+        [_pendingRequests removeAllObjects];
+
+    while (_activeRequestCount < _maximumConcurrentRequests && _pendingRequests.count > 0)
+    {
+        BDBRequest *(^request)(void) = _pendingRequests.firstObject;
+        [_pendingRequests removeObjectAtIndex:0];
+        _activeRequestCount++;
+        [_request addChildRequest:request()];
+    }
+
+    if (_activeRequestCount == 0 && _pendingRequests.count == 0 && !_finished && _completion)
+    {
+        _finished = YES;
+        _completion();
+        _completion = nil;
+    }
+}
+
+- (void)requestFinished
+{
+    _activeRequestCount--;
+    [self startPendingRequests];
+}
+
+#pragma mark Hydration
+- (void)loadBeerWithId:(NSString *)beerId atIndex:(NSUInteger)index
+{
+    [self enqueueRequest:^BDBRequest *{
+        NSString *path = [@"beer" stringByAppendingFormat:@"/%@", beerId];
+        // Lookups go through the client's batch loader, which calls back on the client's queue.
+        return [_client loadBeerWithId:beerId
+                       withBreweryInfo:YES
+                               success:^(BDBBeer *loadedBeer) {
+                                   dispatch_async(_queue, ^{
+                                       BDBBeer *beer = _beers[index];
+                                       if ([beer isKindOfClass:[BDBBeer class]])
+                                           beer.breweries = loadedBeer.breweries;
+                                       else
+                                           _beers[index] = beer = loadedBeer;
+
+                                       [self hydrateBeer:beer];
+                                       [self requestFinished];
+                                   });
+                               }
+                               failure:^(NSError *error) {
+                                   dispatch_async(_queue, ^{
+                                       _errorsByPath[path] = error;
+                                       // A given beer is still hydrated as far as it can be.
+                                       if ([_beers[index] isKindOfClass:[BDBBeer class]])
+                                           [self hydrateBeer:_beers[index]];
+                                       [self requestFinished];
+                                   });
+                               }];
+    }];
+}
+
+- (void)hydrateBeer:(BDBBeer *)beer
+{
+    NSString *beerId = beer.beerId;
+    if (!beerId)
+        return;
+
+    NSMutableArray *sameBeers = _beersById[beerId];
+    if (!sameBeers)
+    {
+        _beersById[beerId] = [NSMutableArray arrayWithObject:beer];
+
+        if (_options & BDBHydrationHops)
+        {
+            [self fetchListAtPath:[@"beer" stringByAppendingFormat:@"/%@/hops", beerId]
+                        withBlock:^BDBRequest *(NSDictionary *parameters, void (^success)(NSArray *, NSUInteger, NSUInteger), void (^failure)(NSError *)) {
+                            return [_client fetchHopsForBeerId:beerId withParameters:parameters success:success failure:failure];
+                        }];
+        }
+        if (_options & BDBHydrationFermentables)
+        {
+            [self fetchListAtPath:[@"beer" stringByAppendingFormat:@"/%@/fermentables", beerId]
+                        withBlock:^BDBRequest *(NSDictionary *parameters, void (^success)(NSArray *, NSUInteger, NSUInteger), void (^failure)(NSError *)) {
+                            return [_client fetchFermentablesForBeerId:beerId withParameters:parameters success:success failure:failure];
+                        }];
+        }
+        if (_options & BDBHydrationYeasts)
+        {
+            [self fetchListAtPath:[@"beer" stringByAppendingFormat:@"/%@/yeasts", beerId]
+                        withBlock:^BDBRequest *(NSDictionary *parameters, void (^success)(NSArray *, NSUInteger, NSUInteger), void (^failure)(NSError *)) {
+                            return [_client fetchYeastsForBeerId:beerId withParameters:parameters success:success failure:failure];
+                        }];
+        }
+    }
+    else if (![sameBeers containsObject:beer])
+    {
+        [sameBeers addObject:beer];
+    }
+
+    if (!(_options & BDBHydrationBreweryLocations))
+        return;
+
+    for (BDBBrewery *brewery in beer.breweries)
+    {
+        NSString *breweryId = brewery.breweryId;
+        if (!breweryId)
+            continue;
+
+        NSMutableArray *sameBreweries = _breweriesById[breweryId];
+        if (sameBreweries)
+        {
+            if (![sameBreweries containsObject:brewery])
+                [sameBreweries addObject:brewery];
+            continue;
+        }
+
+        _breweriesById[breweryId] = [NSMutableArray arrayWithObject:brewery];
+        [self fetchListAtPath:[@"brewery" stringByAppendingFormat:@"/%@/locations", breweryId]
+                    withBlock:^BDBRequest *(NSDictionary *parameters, void (^success)(NSArray *, NSUInteger, NSUInteger), void (^failure)(NSError *)) {
+                        return [_client fetchLocationsForBreweryId:breweryId withParameters:parameters success:success failure:failure];
+                    }];
+    }
+}
+
+- (void)fetchListAtPath:(NSString *)path
+              withBlock:(BDBRequest *(^)(NSDictionary *, void (^)(NSArray *, NSUInteger, NSUInteger), void (^)(NSError *)))block
+{
+    [self enqueueRequest:^BDBRequest *{
+        return block(@{BreweryDBRequestOptionCallbackQueueKey: _queue},
+                     ^(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages) {
+                         _resultsByPath[path] = objects;
+                         [self requestFinished];
+                     },
+                     ^(NSError *error) {
+                         _errorsByPath[path] = error;
+                         [self requestFinished];
+                     });
+    }];
+}
+
+- (void)finishWithCallbackQueue:(dispatch_queue_t)callbackQueue success:(void (^)(NSArray *, NSDictionary *))success
+{
+    if (![_request markFinished])
+        return;
+
+    // Join the results into every copy of each beer and brewery.
+    [_beersById enumerateKeysAndObjectsUsingBlock:^(NSString *beerId, NSArray *beers, BOOL *stop) {
+        NSArray *hops = _resultsByPath[[@"beer" stringByAppendingFormat:@"/%@/hops", beerId]];
+        NSArray *fermentables = _resultsByPath[[@"beer" stringByAppendingFormat:@"/%@/fermentables", beerId]];
+        NSArray *yeasts = _resultsByPath[[@"beer" stringByAppendingFormat:@"/%@/yeasts", beerId]];
+        for (BDBBeer *beer in beers)
+        {
+            if (hops)
+                beer.hops = hops;
+            if (fermentables)
+                beer.fermentables = fermentables;
+            if (yeasts)
+                beer.yeasts = yeasts;
+        }
+    }];
+    [_breweriesById enumerateKeysAndObjectsUsingBlock:^(NSString *breweryId, NSArray *breweries, BOOL *stop) {
+        NSArray *locations = _resultsByPath[[@"brewery" stringByAppendingFormat:@"/%@/locations", breweryId]];
+        for (BDBBrewery *brewery in breweries)
+        {
+            if (locations)
+                brewery.locations = locations;
+        }
+    }];
+
+    NSMutableArray *beers = [NSMutableArray arrayWithCapacity:_beers.count];
+    for (id beer in _beers)
+    {
+        if (beer != [NSNull null])
+            [beers addObject:beer];
+    }
+
+    NSDictionary *errors = [_errorsByPath copy];
+    dispatch_async(callbackQueue, ^{
+        success(beers, errors);
+    });
+}
+
+@end
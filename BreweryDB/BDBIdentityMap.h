@@ -0,0 +1,98 @@
+//
+//  BDBIdentityMap.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBIdentityMap : NSObject
+
+#pragma mark Instantiation
+/**
+ *  The identity map consulted while decoding models. Disabled by default.
+ *
+ *  @return BDBIdentityMap singleton
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)sharedMap;
+
+#pragma mark Configuration
+/**
+ *  When enabled, nested breweries, locations, styles and categories with the
+ *  same id decode to a single shared instance, and low-cardinality string
+ *  fields such as status, locality and countryIsoCode are interned. Entities
+ *  are held weakly, so an instance lives only as long as some result holds it;
+ *  while it does, later responses reuse it instead of decoding the entity again,
+ *  unless their dictionary has a later updateDate or fields the instance was
+ *  decoded without. Such a dictionary decodes a new instance that replaces the
+ *  old one in the map.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign, getter = isEnabled) BOOL enabled;
+
+/**
+ *  Maximum number of distinct strings interned. Beyond it, strings are
+ *  returned as is. Defaults to 4096.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSUInteger internCapacity;
+
+#pragma mark Lookup
+/**
+ *  Return the live instance of modelClass for the dictionary's id, decoding
+ *  and registering a new one with -initWithDictionary: if there is none or the
+ *  dictionary is newer or more complete than the one it was decoded from. When
+ *  the map is disabled or the dictionary has no id, a new instance is returned.
+ *
+ *  @param modelClass A model class responding to -initWithDictionary:.
+ *  @param dictionary The entity's API dictionary.
+ *
+ *  @return The shared instance, or nil if the dictionary cannot be decoded.
+ *
+ *  @since 1.1.0
+ */
+- (id)objectOfClass:(Class)modelClass withDictionary:(NSDictionary *)dictionary;
+
+/**
+ *  Return a canonical instance equal to string, or string itself when the
+ *  map is disabled or full.
+ *
+ *  @since 1.1.0
+ */
+- (NSString *)internedString:(NSString *)string;
+
+/**
+ *  Forget every registered entity and interned string.
+ *
+ *  @since 1.1.0
+ */
+- (void)removeAllObjects;
+
+#pragma mark Statistics
+@property (nonatomic, readonly) NSUInteger reusedObjectCount;
+@property (nonatomic, readonly) NSUInteger internedStringCount;
+
+@end
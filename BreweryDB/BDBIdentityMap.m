@@ -0,0 +1,189 @@
+//
+//  BDBIdentityMap.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <objc/runtime.h>
+
+#import "BDBIdentityMap.h"
+#import "BDBModelCoercion.h"
+
+
+static NSUInteger const BDBIdentityMapDefaultInternCapacity = 4096;
+
+static char BDBIdentityMapRevisionKey;
+
+// A registered instance records the updateDate and keys of the dictionary it was decoded from.
+static void BDBIdentityMapSetRevision(id object, NSDictionary *dictionary)
+{
+    NSArray *revision = @[BDBStringValue(dictionary[@"updateDate"]) ?: @"", [NSSet setWithArray:dictionary.allKeys]];
+    objc_setAssociatedObject(object, &BDBIdentityMapRevisionKey, revision, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+// An instance can stand in for a dictionary that is no newer and has no field the instance lacks.
+static BOOL BDBIdentityMapObjectCoversDictionary(id object, NSDictionary *dictionary)
+{
+    NSArray *revision = objc_getAssociatedObject(object, &BDBIdentityMapRevisionKey);
+    if (!revision)
+        return NO;
+
+    NSString *updateDate = BDBStringValue(dictionary[@"updateDate"]);
+    if (updateDate && [updateDate compare:revision[0]] == NSOrderedDescending)
+        return NO;
+    return [[NSSet setWithArray:dictionary.allKeys] isSubsetOfSet:revision[1]];
+}
+
+
+#pragma mark -
+@interface BDBIdentityMap ()
+{
+    NSMutableDictionary *_objectsByClass;
+    NSMutableSet *_internedStrings;
+}
+
+@property (nonatomic, readwrite) NSUInteger reusedObjectCount;
+
+@end
+
+
+#pragma mark -
+@implementation BDBIdentityMap
+
+#pragma mark Instantiation
++ (instancetype)sharedMap
+{
+    static BDBIdentityMap *_sharedMap = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _sharedMap = [[[self class] alloc] init];
+    });
+    return _sharedMap;
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self)
+    {
+        _objectsByClass = [NSMutableDictionary dictionary];
+        _internedStrings = [NSMutableSet set];
+        _internCapacity = BDBIdentityMapDefaultInternCapacity;
+    }
+    return self;
+}
+
+#pragma mark Lookup
+- (id)objectOfClass:(Class)modelClass withDictionary:(NSDictionary *)dictionary
+{
+    NSString *identifier = nil;
+    if (self.enabled)
+        identifier = BDBStringValue(BDBDictionaryValue(dictionary)[@"id"]);
+
+    if (!identifier)
+        return [[modelClass alloc] initWithDictionary:dictionary];
+
+    NSString *className = NSStringFromClass(modelClass);
+    @synchronized(self)
+    {
+        NSMapTable *objects = _objectsByClass[className];
+        id object = [objects objectForKey:identifier];
+        if (object && BDBIdentityMapObjectCoversDictionary(object, dictionary))
+        {
+            self.reusedObjectCount++;
+            return object;
+        }
+    }
+
+    // Decode outside the lock; nested entities look themselves up in the map too.
+    id object = [[modelClass alloc] initWithDictionary:dictionary];
+    if (!object)
+        return nil;
+    BDBIdentityMapSetRevision(object, dictionary);
+
+    @synchronized(self)
+    {
+        NSMapTable *objects = _objectsByClass[className];
+        if (!objects)
+        {
+            objects = [NSMapTable strongToWeakObjectsMapTable];
+            _objectsByClass[className] = objects;
+        }
+
+        // Another thread may have registered the same entity meanwhile; keep it unless this one is newer.
+        // A newer or more complete dictionary replaces the entry, and instances already handed out keep their data.
+        id existingObject = [objects objectForKey:identifier];
+        if (existingObject && BDBIdentityMapObjectCoversDictionary(existingObject, dictionary))
+        {
+            self.reusedObjectCount++;
+            return existingObject;
+        }
+        [objects setObject:object forKey:identifier];
+    }
+    return object;
+}
+
+- (NSString *)internedString:(NSString *)string
+{
+    if (!string || !self.enabled)
+        return string;
+
+    @synchronized(self)
+    {
+        NSString *internedString = [_internedStrings member:string];
+        if (internedString)
+            return internedString;
+
+        if (_internedStrings.count >= self.internCapacity)
+            return string;
+
+        internedString = [string copy];
+        [_internedStrings addObject:internedString];
+        return internedString;
+    }
+}
+
+- (void)removeAllObjects
+{
+    @synchronized(self)
+    {
+        [_objectsByClass removeAllObjects];
+        [_internedStrings removeAllObjects];
+    }
+}
+
+#pragma mark Statistics
+- (NSUInteger)reusedObjectCount
+{
+    @synchronized(self)
+    {
+        return _reusedObjectCount;
+    }
+}
+
+- (NSUInteger)internedStringCount
+{
+    @synchronized(self)
+    {
+        return _internedStrings.count;
+    }
+}
+
+@end
@@ -0,0 +1,167 @@
+//
+//  BDBImagePipeline.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+#if TARGET_OS_IPHONE
+#import <UIKit/UIKit.h>
+#else
+#import <AppKit/AppKit.h>
+#endif
+
+#import "BDBRequest.h"
+
+
+#if TARGET_OS_IPHONE
+typedef UIImage BDBImage;
+#else
+typedef NSImage BDBImage;
+#endif
+
+typedef NS_OPTIONS(NSUInteger, BDBImageOptions)
+{
+    BDBImageOptionNone     = 0,
+    BDBImageOptionCircular = 1 << 0,  // Crop to a circle while decoding, so views need no corner mask.
+};
+
+
+#pragma mark -
+@interface BDBImagePipeline : NSObject
+
+#pragma mark Instantiation
+/**
+ *  The pipeline for label and brewery images, with its disk cache in the
+ *  caches directory.
+ *
+ *  @return BDBImagePipeline singleton
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)sharedPipeline;
+
+/**
+ *  Create an image pipeline. Downloaded images are kept encoded on disk and
+ *  decoded, downsampled images are kept in memory.
+ *
+ *  @param directoryURL   Directory for downloaded images. Pass nil for a memory-only pipeline.
+ *  @param memoryCapacity Maximum number of bytes of decoded images kept in memory.
+ *  @param diskCapacity   Maximum number of bytes of downloaded images kept on disk.
+ *
+ *  @return A new image pipeline.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithDirectoryURL:(NSURL *)directoryURL
+            memoryCapacity:(NSUInteger)memoryCapacity
+              diskCapacity:(NSUInteger)diskCapacity;
+
+#pragma mark Configuration
+@property (nonatomic, readonly) NSURL *directoryURL;
+@property (nonatomic, assign) NSUInteger memoryCapacity;
+@property (nonatomic, assign) NSUInteger diskCapacity;
+
+/**
+ *  Maximum images downloaded or decoded at the same time. Loads start before
+ *  prefetches. Defaults to 4.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
+#pragma mark Variants
+/**
+ *  Pick the smallest image variant at least as large as the target, or the
+ *  largest one if none is.
+ *
+ *  @param variants  A BDBBeer's labels or a BDBBrewery's images.
+ *  @param pixelSize Size the image will be displayed at, in pixels.
+ *
+ *  @return The URL of the chosen variant, or nil if there is none.
+ *
+ *  @since 1.1.0
+ */
++ (NSURL *)URLForVariants:(NSDictionary *)variants pixelSize:(CGSize)pixelSize;
+
+#pragma mark Loading
+/**
+ *  Look up an image in memory only. Cheap enough to call while configuring a
+ *  cell; fall back to -loadImageForVariants:... on a miss.
+ *
+ *  @since 1.1.0
+ */
+- (BDBImage *)cachedImageForVariants:(NSDictionary *)variants
+                                size:(CGSize)size
+                               scale:(CGFloat)scale
+                             options:(BDBImageOptions)options;
+
+/**
+ *  Load the best variant for a target size, decoded and downsampled to that
+ *  size off the calling thread. Loads of the same image share one download.
+ *
+ *  @param variants      A BDBBeer's labels or a BDBBrewery's images.
+ *  @param size          Size the image will be displayed at, in points.
+ *  @param scale         Screen scale; the image is decoded at size * scale pixels.
+ *  @param options       How to process the image.
+ *  @param callbackQueue Queue completion is performed on.
+ *  @param completion    Called once with the image, or with an error. Both are nil when
+ *                       there are no variants, and the error is NSURLErrorCancelled after -cancel.
+ *
+ *  @return A handle that cancels the load.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)loadImageForVariants:(NSDictionary *)variants
+                                size:(CGSize)size
+                               scale:(CGFloat)scale
+                             options:(BDBImageOptions)options
+                       callbackQueue:(dispatch_queue_t)callbackQueue
+                          completion:(void (^)(BDBImage *image, NSError *error))completion;
+
+#pragma mark Prefetching
+/**
+ *  Download and decode images for results that are about to be shown, e.g.
+ *  the next page of beers. Prefetches wait behind loads and become loads when
+ *  one asks for the same image.
+ *
+ *  @param variantsArray Dictionaries of labels or images; NSNull entries are skipped.
+ *
+ *  @since 1.1.0
+ */
+- (void)prefetchImagesForVariants:(NSArray *)variantsArray
+                             size:(CGSize)size
+                            scale:(CGFloat)scale
+                          options:(BDBImageOptions)options;
+
+/**
+ *  Stop every prefetch that no load is waiting on.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancelPrefetching;
+
+#pragma mark Storage
+- (void)removeAllImages;
+
+@property (nonatomic, readonly) NSUInteger currentMemoryUsage;
+@property (nonatomic, readonly) NSUInteger currentDiskUsage;
+
+@end
@@ -0,0 +1,757 @@
+//
+//  BDBImagePipeline.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <CommonCrypto/CommonDigest.h>
+#import <ImageIO/ImageIO.h>
+
+#import "BDBImagePipeline.h"
+#import "BDBErrors.h"
+#import "BDBRequest_Private.h"
+
+
+static NSString * const BDBImagePipelineDirectoryName = @"com.brewerydb.images";
+
+static NSUInteger const BDBImagePipelineDefaultMemoryCapacity = 16 * 1024 * 1024;
+static NSUInteger const BDBImagePipelineDefaultDiskCapacity = 50 * 1024 * 1024;
+static NSUInteger const BDBImagePipelineDefaultMaxConcurrentRequests = 4;
+
+typedef struct
+{
+    const char *name;
+    CGFloat pixelSize;
+} BDBImageVariant;
+
+// Label and brewery image variants from smallest to largest, with the length of
+// their longer side as the API serves them.
+static const BDBImageVariant BDBImageVariants[] =
+{
+    {"icon",          64.0},
+    {"medium",       256.0},
+    {"squareMedium", 400.0},
+    {"squareLarge",  600.0},
+    {"large",       1024.0},
+};
+
+static NSError *BDBImagePipelineError(void)
+{
+    return [NSError errorWithDomain:BreweryDBErrorDomain
+                               code:BDB_ERRNO_BAD_IMAGE
+                           userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_BAD_IMAGE}];
+}
+
+// ImageIO decodes straight to the target size, so the full-size bitmap never exists,
+// and decodes immediately, so the first draw on the main thread does not have to.
+static CGImageRef BDBImageCreateDownsampled(NSData *data, CGFloat maxPixelSize) CF_RETURNS_RETAINED
+{
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)@{(id)kCGImageSourceShouldCache: @NO});
+    if (!source)
+        return NULL;
+
+    NSDictionary *options = @{(id)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                              (id)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                              (id)kCGImageSourceShouldCacheImmediately: @YES,
+                              (id)kCGImageSourceThumbnailMaxPixelSize: @(MAX(maxPixelSize, 1.0))};
+    CGImageRef image = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+    return image;
+}
+
+static CGImageRef BDBImageCreateCircular(CGImageRef image) CF_RETURNS_RETAINED
+{
+    size_t width = CGImageGetWidth(image);
+    size_t height = CGImageGetHeight(image);
+    size_t diameter = MIN(width, height);
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, diameter, diameter, 8, 0, colorSpace,
+                                                 kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    if (!context)
+        return CGImageRetain(image);
+
+    // Fill the circle, centring the image on it.
+    CGContextAddEllipseInRect(context, CGRectMake(0.0, 0.0, diameter, diameter));
+    CGContextClip(context);
+    CGContextDrawImage(context, CGRectMake(((CGFloat)diameter - width) / 2.0, ((CGFloat)diameter - height) / 2.0, width, height), image);
+
+    CGImageRef circularImage = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    return circularImage;
+}
+
+static BDBImage *BDBImageCreatePlatformImage(CGImageRef image, CGFloat scale)
+{
+#if TARGET_OS_IPHONE
+    return [UIImage imageWithCGImage:image scale:scale orientation:UIImageOrientationUp];
+#else
+    return [[NSImage alloc] initWithCGImage:image size:NSMakeSize(CGImageGetWidth(image) / scale, CGImageGetHeight(image) / scale)];
+#endif
+}
+
+
+#pragma mark -
+@interface BDBImageJob : NSObject
+
+@property (nonatomic, copy) NSString *key;
+@property (nonatomic) NSURL *URL;
+@property (nonatomic, assign) CGFloat maxPixelSize;
+@property (nonatomic, assign) CGFloat scale;
+@property (nonatomic, assign) BDBImageOptions options;
+
+@property (nonatomic) NSMutableArray *loads;
+@property (nonatomic, assign, getter = isPrefetch) BOOL prefetch;
+@property (nonatomic, assign, getter = isStarted) BOOL started;
+@property (nonatomic, assign, getter = isCancelled) BOOL cancelled;
+@property (nonatomic) NSURLSessionDataTask *task;
+
+@end
+
+
+#pragma mark -
+@implementation BDBImageJob
+
+@end
+
+
+#pragma mark -
+@interface BDBImageLoad : NSObject
+
+@property (nonatomic) BDBRequest *request;
+@property (nonatomic) dispatch_queue_t callbackQueue;
+@property (nonatomic, copy) void (^completion)(BDBImage *image, NSError *error);
+@property (nonatomic, weak) BDBImageJob *job;
+
+@end
+
+
+#pragma mark -
+@implementation BDBImageLoad
+
+@end
+
+
+#pragma mark -
+@interface BDBImagePipeline ()
+{
+    dispatch_queue_t _queue;
+    dispatch_queue_t _ioQueue;
+    dispatch_queue_t _decodeQueue;
+    NSURLSession *_session;
+
+    // Disk writes, eviction and _currentDiskUsage belong to _ioQueue, so they never hold up
+    // memory cache lookups. Everything below is only touched on _queue.
+    NSMutableDictionary *_jobs;
+    NSMutableArray *_pendingJobs;
+    NSUInteger _activeJobCount;
+
+    NSMutableDictionary *_memoryImages;
+    NSMutableDictionary *_memoryCosts;
+    NSMutableOrderedSet *_memoryKeys;
+}
+
+@property (nonatomic, readwrite) NSURL *directoryURL;
+@property (nonatomic, readwrite) NSUInteger currentMemoryUsage;
+@property (nonatomic, readwrite) NSUInteger currentDiskUsage;
+
++ (NSString *)keyForURL:(NSURL *)URL maxPixelSize:(CGFloat)maxPixelSize options:(BDBImageOptions)options;
+- (NSURL *)fileURLForURL:(NSURL *)URL;
+- (BDBImage *)memoryImageForKey:(NSString *)key;
+
+- (BDBImageJob *)jobForVariants:(NSDictionary *)variants size:(CGSize)size scale:(CGFloat)scale options:(BDBImageOptions)options;
+- (void)startPendingJobs;
+- (void)startJob:(BDBImageJob *)job;
+- (void)downloadJob:(BDBImageJob *)job;
+- (void)decodeData:(NSData *)data forJob:(BDBImageJob *)job;
+- (void)finishJob:(BDBImageJob *)job image:(BDBImage *)image cost:(NSUInteger)cost error:(NSError *)error;
+- (void)cancelJobIfUnused:(BDBImageJob *)job;
+
+- (void)writeData:(NSData *)data forURL:(NSURL *)URL;
+- (void)addMemoryImage:(BDBImage *)image cost:(NSUInteger)cost forKey:(NSString *)key;
+- (void)removeMemoryImageForKey:(NSString *)key;
+- (void)removeAllMemoryImages;
+- (void)trimMemory;
+- (void)trimDisk;
+
+@end
+
+
+#pragma mark -
+@implementation BDBImagePipeline
+
+#pragma mark Instantiation
++ (instancetype)sharedPipeline
+{
+    static BDBImagePipeline *_sharedPipeline = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURL *cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+        _sharedPipeline = [[[self class] alloc] initWithDirectoryURL:[cachesURL URLByAppendingPathComponent:BDBImagePipelineDirectoryName isDirectory:YES]
+                                                      memoryCapacity:BDBImagePipelineDefaultMemoryCapacity
+                                                        diskCapacity:BDBImagePipelineDefaultDiskCapacity];
+    });
+    return _sharedPipeline;
+}
+
+- (id)init
+{
+    return [self initWithDirectoryURL:nil memoryCapacity:BDBImagePipelineDefaultMemoryCapacity diskCapacity:0];
+}
+
+- (id)initWithDirectoryURL:(NSURL *)directoryURL
+            memoryCapacity:(NSUInteger)memoryCapacity
+              diskCapacity:(NSUInteger)diskCapacity
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _queue = dispatch_queue_create("com.brewerydb.images", DISPATCH_QUEUE_SERIAL);
+    _ioQueue = dispatch_queue_create("com.brewerydb.images.io", DISPATCH_QUEUE_SERIAL);
+    _decodeQueue = dispatch_queue_create("com.brewerydb.images.decode", DISPATCH_QUEUE_CONCURRENT);
+
+    // Downloaded images are cached here, so the URL cache would only hold second copies.
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    configuration.URLCache = nil;
+    configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    _session = [NSURLSession sessionWithConfiguration:configuration];
+
+    _jobs = [NSMutableDictionary dictionary];
+    _pendingJobs = [NSMutableArray array];
+    _memoryImages = [NSMutableDictionary dictionary];
+    _memoryCosts = [NSMutableDictionary dictionary];
+    _memoryKeys = [NSMutableOrderedSet orderedSet];
+
+    _directoryURL = directoryURL;
+    _memoryCapacity = memoryCapacity;
+    _diskCapacity = diskCapacity;
+    _maxConcurrentRequests = BDBImagePipelineDefaultMaxConcurrentRequests;
+
+    if (_directoryURL)
+    {
+        dispatch_async(_ioQueue, ^{
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+
+            NSUInteger diskUsage = 0;
+            for (NSURL *fileURL in [fileManager contentsOfDirectoryAtURL:_directoryURL
+                                              includingPropertiesForKeys:@[NSURLFileSizeKey]
+                                                                 options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                   error:NULL])
+            {
+                NSNumber *fileSize = nil;
+                [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+                diskUsage += fileSize.unsignedIntegerValue;
+            }
+            _currentDiskUsage = diskUsage;
+            [self trimDisk];
+        });
+    }
+
+#if TARGET_OS_IPHONE
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(removeAllMemoryImages)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+#endif
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [_session invalidateAndCancel];
+}
+
+#pragma mark Configuration
+- (void)setMemoryCapacity:(NSUInteger)memoryCapacity
+{
+    dispatch_async(_queue, ^{
+        _memoryCapacity = memoryCapacity;
+        [self trimMemory];
+    });
+}
+
+- (void)setDiskCapacity:(NSUInteger)diskCapacity
+{
+    dispatch_async(_ioQueue, ^{
+        _diskCapacity = diskCapacity;
+        [self trimDisk];
+    });
+}
+
+- (void)setMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+{
+    dispatch_async(_queue, ^{
+        _maxConcurrentRequests = MAX(maxConcurrentRequests, 1);
+        [self startPendingJobs];
+    });
+}
+
+#pragma mark Variants
++ (NSURL *)URLForVariants:(NSDictionary *)variants pixelSize:(CGSize)pixelSize
+{
+    if (![variants isKindOfClass:[NSDictionary class]])
+        return nil;
+
+    CGFloat targetPixelSize = MAX(pixelSize.width, pixelSize.height);
+    NSString *chosenURLString = nil;
+    for (size_t i = 0; i < sizeof(BDBImageVariants) / sizeof(BDBImageVariants[0]); i++)
+    {
+        NSString *URLString = variants[@(BDBImageVariants[i].name)];
+        if (![URLString isKindOfClass:[NSString class]] || URLString.length == 0)
+            continue;
+
+        chosenURLString = URLString;
+        if (BDBImageVariants[i].pixelSize >= targetPixelSize)
+            break;
+    }
+    return chosenURLString ? [NSURL URLWithString:chosenURLString] : nil;
+}
+
++ (NSString *)keyForURL:(NSURL *)URL maxPixelSize:(CGFloat)maxPixelSize options:(BDBImageOptions)options
+{
+    return [NSString stringWithFormat:@"%@ %.0f %lu", URL.absoluteString, maxPixelSize, (unsigned long)options];
+}
+
+- (NSURL *)fileURLForURL:(NSURL *)URL
+{
+    NSData *URLData = [URL.absoluteString dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(URLData.bytes, (CC_LONG)URLData.length, digest);
+
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++)
+        [fileName appendFormat:@"%02x", digest[i]];
+
+    return [self.directoryURL URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
+- (BDBImage *)memoryImageForKey:(NSString *)key
+{
+    BDBImage *image = _memoryImages[key];
+    if (image)
+    {
+        [_memoryKeys removeObject:key];
+        [_memoryKeys addObject:key];
+    }
+    return image;
+}
+
+#pragma mark Loading
+- (BDBImage *)cachedImageForVariants:(NSDictionary *)variants
+                                size:(CGSize)size
+                               scale:(CGFloat)scale
+                             options:(BDBImageOptions)options
+{
+    CGSize pixelSize = CGSizeMake(size.width * scale, size.height * scale);
+    NSURL *URL = [[self class] URLForVariants:variants pixelSize:pixelSize];
+    if (!URL)
+        return nil;
+
+    NSString *key = [[self class] keyForURL:URL maxPixelSize:MAX(pixelSize.width, pixelSize.height) options:options];
+    __block BDBImage *image = nil;
+    dispatch_sync(_queue, ^{
+        image = [self memoryImageForKey:key];
+    });
+    return image;
+}
+
+- (BDBRequest *)loadImageForVariants:(NSDictionary *)variants
+                                size:(CGSize)size
+                               scale:(CGFloat)scale
+                             options:(BDBImageOptions)options
+                       callbackQueue:(dispatch_queue_t)callbackQueue
+                          completion:(void (^)(BDBImage *, NSError *))completion
+{
+    NSParameterAssert(callbackQueue);
+    NSParameterAssert(completion);
+
+    BDBImageLoad *load = [[BDBImageLoad alloc] init];
+    load.request = [[BDBRequest alloc] init];
+    load.callbackQueue = callbackQueue;
+    load.completion = completion;
+
+    __weak BDBImageLoad *weakLoad = load;
+    [load.request addCancellationHandler:^{
+        dispatch_async(callbackQueue, ^{
+            completion(nil, [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+        });
+        dispatch_async(_queue, ^{
+            BDBImageLoad *cancelledLoad = weakLoad;
+            BDBImageJob *job = cancelledLoad.job;
+            if (!job)
+                return;
+
+            [job.loads removeObject:cancelledLoad];
+            [self cancelJobIfUnused:job];
+        });
+    }];
+
+    dispatch_async(_queue, ^{
+        if (load.request.isCancelled)
+            return;
+
+        BDBImageJob *job = [self jobForVariants:variants size:size scale:scale options:options];
+        if (!job)
+        {
+            // Either there is nothing to load or the image is already in memory.
+            CGSize pixelSize = CGSizeMake(size.width * scale, size.height * scale);
+            NSURL *URL = [[self class] URLForVariants:variants pixelSize:pixelSize];
+            BDBImage *image = URL ? [self memoryImageForKey:[[self class] keyForURL:URL maxPixelSize:MAX(pixelSize.width, pixelSize.height) options:options]] : nil;
+            if ([load.request markFinished])
+            {
+                dispatch_async(callbackQueue, ^{
+                    completion(image, nil);
+                });
+            }
+            return;
+        }
+
+        load.job = job;
+        [job.loads addObject:load];
+
+        // A load takes over a waiting prefetch, so it moves ahead of the other prefetches.
+        if (!job.isStarted && job.loads.count == 1)
+        {
+            [_pendingJobs removeObject:job];
+            NSUInteger index = [_pendingJobs indexOfObjectPassingTest:^BOOL(BDBImageJob *pendingJob, NSUInteger idx, BOOL *stop) {
+                return (pendingJob.loads.count == 0);
+            }];
+            [_pendingJobs insertObject:job atIndex:(index == NSNotFound ? _pendingJobs.count : index)];
+        }
+
+        [self startPendingJobs];
+    });
+
+    return load.request;
+}
+
+// Returns the job for an image that is not in memory, creating it if needed, or nil.
+- (BDBImageJob *)jobForVariants:(NSDictionary *)variants size:(CGSize)size scale:(CGFloat)scale options:(BDBImageOptions)options
+{
+    CGSize pixelSize = CGSizeMake(size.width * scale, size.height * scale);
+    NSURL *URL = [[self class] URLForVariants:variants pixelSize:pixelSize];
+    if (!URL)
+        return nil;
+
+    CGFloat maxPixelSize = MAX(pixelSize.width, pixelSize.height);
+    NSString *key = [[self class] keyForURL:URL maxPixelSize:maxPixelSize options:options];
+    if (_memoryImages[key])
+        return nil;
+
+    BDBImageJob *job = _jobs[key];
+    if (job)
+        return job;
+
+    job = [[BDBImageJob alloc] init];
+    job.key = key;
+    job.URL = URL;
+    job.maxPixelSize = maxPixelSize;
+    job.scale = MAX(scale, 1.0);
+    job.options = options;
+    job.loads = [NSMutableArray array];
+    _jobs[key] = job;
+    [_pendingJobs addObject:job];
+    return job;
+}
+
+#pragma mark Prefetching
+- (void)prefetchImagesForVariants:(NSArray *)variantsArray
+                             size:(CGSize)size
+                            scale:(CGFloat)scale
+                          options:(BDBImageOptions)options
+{
+    dispatch_async(_queue, ^{
+        for (NSDictionary *variants in variantsArray)
+        {
+            BDBImageJob *job = [self jobForVariants:variants size:size scale:scale options:options];
+            job.prefetch = YES;
+        }
+        [self startPendingJobs];
+    });
+}
+
+- (void)cancelPrefetching
+{
+    dispatch_async(_queue, ^{
+        for (BDBImageJob *job in _jobs.allValues)
+        {
+            job.prefetch = NO;
+            [self cancelJobIfUnused:job];
+        }
+    });
+}
+
+#pragma mark Jobs
+- (void)startPendingJobs
+{
+    while (_activeJobCount < _maxConcurrentRequests && _pendingJobs.count > 0)
+    {
+        BDBImageJob *job = _pendingJobs.firstObject;
+        [_pendingJobs removeObjectAtIndex:0];
+        [self startJob:job];
+    }
+}
+
+- (void)startJob:(BDBImageJob *)job
+{
+    job.started = YES;
+    _activeJobCount++;
+
+    NSURL *fileURL = self.directoryURL ? [self fileURLForURL:job.URL] : nil;
+    dispatch_async(_decodeQueue, ^{
+        NSData *data = fileURL ? [NSData dataWithContentsOfURL:fileURL] : nil;
+        if (!data)
+        {
+            dispatch_async(_queue, ^{
+                [self downloadJob:job];
+            });
+            return;
+        }
+
+        [fileURL setResourceValue:[NSDate date] forKey:NSURLContentModificationDateKey error:NULL];
+        [self decodeData:data forJob:job];
+    });
+}
+
+- (void)downloadJob:(BDBImageJob *)job
+{
+    if (job.isCancelled)
+    {
+        [self finishJob:job image:nil cost:0 error:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+        return;
+    }
+
+    job.task = [_session dataTaskWithURL:job.URL completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse *)response statusCode] : 200;
+        if (!error && (statusCode < 200 || statusCode >= 300))
+            error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:nil];
+        if (error || data.length == 0)
+        {
+            dispatch_async(_queue, ^{
+                [self finishJob:job image:nil cost:0 error:(error ?: BDBImagePipelineError())];
+            });
+            return;
+        }
+
+        dispatch_async(_ioQueue, ^{
+            [self writeData:data forURL:job.URL];
+        });
+        dispatch_async(_decodeQueue, ^{
+            [self decodeData:data forJob:job];
+        });
+    }];
+    [job.task resume];
+}
+
+- (void)decodeData:(NSData *)data forJob:(BDBImageJob *)job
+{
+    BDBImage *image = nil;
+    NSUInteger cost = 0;
+
+    CGImageRef decodedImage = BDBImageCreateDownsampled(data, job.maxPixelSize);
+    if (decodedImage && (job.options & BDBImageOptionCircular))
+    {
+        CGImageRef circularImage = BDBImageCreateCircular(decodedImage);
+        CGImageRelease(decodedImage);
+        decodedImage = circularImage;
+    }
+    if (decodedImage)
+    {
+        image = BDBImageCreatePlatformImage(decodedImage, job.scale);
+        cost = CGImageGetBytesPerRow(decodedImage) * CGImageGetHeight(decodedImage);
+        CGImageRelease(decodedImage);
+    }
+
+    dispatch_async(_queue, ^{
+        [self finishJob:job image:image cost:cost error:(image ? nil : BDBImagePipelineError())];
+    });
+}
+
+- (void)finishJob:(BDBImageJob *)job image:(BDBImage *)image cost:(NSUInteger)cost error:(NSError *)error
+{
+    if (_jobs[job.key] == job)
+        [_jobs removeObjectForKey:job.key];
+    _activeJobCount--;
+
+    if (image)
+        [self addMemoryImage:image cost:cost forKey:job.key];
+
+    for (BDBImageLoad *load in job.loads)
+    {
+        if (![load.request markFinished])
+            continue;
+
+        void (^completion)(BDBImage *, NSError *) = load.completion;
+        dispatch_async(load.callbackQueue, ^{
+            completion(image, error);
+        });
+    }
+    [job.loads removeAllObjects];
+
+    [self startPendingJobs];
+}
+
+- (void)cancelJobIfUnused:(BDBImageJob *)job
+{
+    if (job.loads.count > 0 || job.isPrefetch || job.isCancelled || _jobs[job.key] != job)
+        return;
+
+    if (!job.isStarted)
+    {
+        [_pendingJobs removeObject:job];
+        [_jobs removeObjectForKey:job.key];
+        return;
+    }
+
+    // A started job finishes through its task's completion handler.
+    job.cancelled = YES;
+    [_jobs removeObjectForKey:job.key];
+    [job.task cancel];
+}
+
+#pragma mark Storage
+- (void)writeData:(NSData *)data forURL:(NSURL *)URL
+{
+    if (!self.directoryURL || data.length > self.diskCapacity)
+        return;
+
+    NSURL *fileURL = [self fileURLForURL:URL];
+    NSNumber *previousSize = nil;
+    [fileURL getResourceValue:&previousSize forKey:NSURLFileSizeKey error:NULL];
+
+    if ([data writeToURL:fileURL atomically:YES])
+    {
+        _currentDiskUsage -= MIN(_currentDiskUsage, previousSize.unsignedIntegerValue);
+        _currentDiskUsage += data.length;
+        [self trimDisk];
+    }
+}
+
+- (void)addMemoryImage:(BDBImage *)image cost:(NSUInteger)cost forKey:(NSString *)key
+{
+    [self removeMemoryImageForKey:key];
+
+    if (cost > self.memoryCapacity)
+        return;
+
+    _memoryImages[key] = image;
+    _memoryCosts[key] = @(cost);
+    [_memoryKeys addObject:key];
+    _currentMemoryUsage += cost;
+    [self trimMemory];
+}
+
+- (void)removeMemoryImageForKey:(NSString *)key
+{
+    if (!_memoryImages[key])
+        return;
+
+    _currentMemoryUsage -= MIN(_currentMemoryUsage, [_memoryCosts[key] unsignedIntegerValue]);
+    [_memoryImages removeObjectForKey:key];
+    [_memoryCosts removeObjectForKey:key];
+    [_memoryKeys removeObject:key];
+}
+
+- (void)removeAllMemoryImages
+{
+    dispatch_async(_queue, ^{
+        [_memoryImages removeAllObjects];
+        [_memoryCosts removeAllObjects];
+        [_memoryKeys removeAllObjects];
+        _currentMemoryUsage = 0;
+    });
+}
+
+- (void)removeAllImages
+{
+    [self removeAllMemoryImages];
+
+    dispatch_async(_ioQueue, ^{
+        if (!self.directoryURL)
+            return;
+
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        for (NSURL *fileURL in [fileManager contentsOfDirectoryAtURL:self.directoryURL includingPropertiesForKeys:nil options:0 error:NULL])
+            [fileManager removeItemAtURL:fileURL error:NULL];
+        _currentDiskUsage = 0;
+    });
+}
+
+#pragma mark Eviction
+- (void)trimMemory
+{
+    while (_currentMemoryUsage > _memoryCapacity && _memoryKeys.count > 0)
+        [self removeMemoryImageForKey:_memoryKeys.firstObject];
+}
+
+- (void)trimDisk
+{
+    if (!self.directoryURL || _currentDiskUsage <= _diskCapacity)
+        return;
+
+    NSArray *propertyKeys = @[NSURLContentModificationDateKey, NSURLFileSizeKey];
+    NSArray *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                      includingPropertiesForKeys:propertyKeys
+                                                                         options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                           error:NULL];
+    fileURLs = [fileURLs sortedArrayUsingComparator:^NSComparisonResult(NSURL *URL1, NSURL *URL2) {
+        NSDate *date1 = nil, *date2 = nil;
+        [URL1 getResourceValue:&date1 forKey:NSURLContentModificationDateKey error:NULL];
+        [URL2 getResourceValue:&date2 forKey:NSURLContentModificationDateKey error:NULL];
+        return [date1 compare:date2];
+    }];
+
+    for (NSURL *fileURL in fileURLs)
+    {
+        if (_currentDiskUsage <= _diskCapacity)
+            break;
+
+        NSNumber *fileSize = nil;
+        [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+        if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL])
+            _currentDiskUsage -= MIN(_currentDiskUsage, fileSize.unsignedIntegerValue);
+    }
+}
+
+#pragma mark Statistics
+- (NSUInteger)currentMemoryUsage
+{
+    __block NSUInteger currentMemoryUsage = 0;
+    dispatch_sync(_queue, ^{
+        currentMemoryUsage = _currentMemoryUsage;
+    });
+    return currentMemoryUsage;
+}
+
+- (NSUInteger)currentDiskUsage
+{
+    __block NSUInteger currentDiskUsage = 0;
+    dispatch_sync(_ioQueue, ^{
+        currentDiskUsage = _currentDiskUsage;
+    });
+    return currentDiskUsage;
+}
+
+@end
@@ -0,0 +1,82 @@
+//
+//  BDBKeyPool.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBKeyPool : NSObject
+
+/**
+ *  Create a pool that spreads requests over several API keys, each with its
+ *  own daily quota.
+ *
+ *  @param keys The API keys to use. Duplicates are ignored.
+ *
+ *  @return A new key pool.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithKeys:(NSArray *)keys;
+
+@property (nonatomic, readonly) NSArray *keys;
+
+/**
+ *  The key with the most quota left. Keys not yet seen in a response count
+ *  as full, and ties rotate. Every key handed out counts against its quota
+ *  until the response reports the real figure, so concurrent requests
+ *  spread out instead of all taking the same key.
+ *
+ *  @return An API key, or nil if the pool is empty.
+ *
+ *  @since 1.1.0
+ */
+- (NSString *)nextKey;
+
+/**
+ *  Record the quota a response reported for key.
+ *
+ *  @since 1.1.0
+ */
+- (void)updateKey:(NSString *)key rateLimit:(NSUInteger)rateLimit remaining:(NSUInteger)remaining;
+
+/**
+ *  The quota left for key.
+ *
+ *  @return The number of requests left, or NSNotFound if no response has reported it yet.
+ *
+ *  @since 1.1.0
+ */
+- (NSUInteger)remainingForKey:(NSString *)key;
+
+/**
+ *  The quota of the whole pool, summed over its keys.
+ *
+ *  @return NO until every key has been seen in a response.
+ *
+ *  @since 1.1.0
+ */
+- (BOOL)getRateLimit:(NSUInteger *)rateLimit remaining:(NSUInteger *)remaining;
+
+@end
@@ -0,0 +1,154 @@
+//
+//  BDBKeyPool.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import "BDBKeyPool.h"
+
+
+#pragma mark -
+@interface BDBKeyPool ()
+{
+    NSDictionary *_indexesByKey;
+
+    // Indexed like keys; only touched while synchronized on self.
+    NSMutableData *_rateLimits;
+    NSMutableData *_remaining;
+    NSUInteger _nextIndex;
+}
+
+@end
+
+
+#pragma mark -
+@implementation BDBKeyPool
+
+- (id)init
+{
+    return [self initWithKeys:@[]];
+}
+
+- (id)initWithKeys:(NSArray *)keys
+{
+    self = [super init];
+    if (self)
+    {
+        NSMutableArray *uniqueKeys = [NSMutableArray arrayWithCapacity:keys.count];
+        NSMutableDictionary *indexesByKey = [NSMutableDictionary dictionaryWithCapacity:keys.count];
+        for (NSString *key in keys)
+        {
+            if (indexesByKey[key])
+                continue;
+            indexesByKey[key] = @(uniqueKeys.count);
+            [uniqueKeys addObject:[key copy]];
+        }
+
+        _keys = [uniqueKeys copy];
+        _indexesByKey = [indexesByKey copy];
+        _rateLimits = [NSMutableData dataWithLength:_keys.count * sizeof(NSUInteger)];
+        _remaining = [NSMutableData dataWithLength:_keys.count * sizeof(NSUInteger)];
+
+        NSUInteger *remaining = _remaining.mutableBytes;
+        for (NSUInteger index = 0; index < _keys.count; index++)
+            remaining[index] = NSNotFound;
+    }
+    return self;
+}
+
+#pragma mark Keys
+- (NSString *)nextKey
+{
+    NSUInteger count = _keys.count;
+    if (count == 0)
+        return nil;
+
+    @synchronized(self)
+    {
+        // NSNotFound is the largest NSUInteger, so unseen keys win until they report a quota.
+        NSUInteger *remaining = _remaining.mutableBytes;
+        NSUInteger bestIndex = _nextIndex;
+        for (NSUInteger offset = 1; offset < count; offset++)
+        {
+            NSUInteger index = (_nextIndex + offset) % count;
+            if (remaining[index] > remaining[bestIndex])
+                bestIndex = index;
+        }
+
+        if (remaining[bestIndex] != NSNotFound && remaining[bestIndex] > 0)
+            remaining[bestIndex]--;
+        _nextIndex = (bestIndex + 1) % count;
+        return _keys[bestIndex];
+    }
+}
+
+#pragma mark Quota
+- (void)updateKey:(NSString *)key rateLimit:(NSUInteger)rateLimit remaining:(NSUInteger)remaining
+{
+    NSNumber *index = _indexesByKey[key];
+    if (!index)
+        return;
+
+    @synchronized(self)
+    {
+        ((NSUInteger *)_rateLimits.mutableBytes)[index.unsignedIntegerValue] = rateLimit;
+        ((NSUInteger *)_remaining.mutableBytes)[index.unsignedIntegerValue] = MIN(remaining, rateLimit);
+    }
+}
+
+- (NSUInteger)remainingForKey:(NSString *)key
+{
+    NSNumber *index = _indexesByKey[key];
+    if (!index)
+        return NSNotFound;
+
+    @synchronized(self)
+    {
+        return ((const NSUInteger *)_remaining.bytes)[index.unsignedIntegerValue];
+    }
+}
+
+- (BOOL)getRateLimit:(NSUInteger *)rateLimit remaining:(NSUInteger *)remaining
+{
+    NSUInteger totalRateLimit = 0;
+    NSUInteger totalRemaining = 0;
+
+    @synchronized(self)
+    {
+        const NSUInteger *rateLimits = _rateLimits.bytes;
+        const NSUInteger *remainingByKey = _remaining.bytes;
+        for (NSUInteger index = 0; index < _keys.count; index++)
+        {
+            if (remainingByKey[index] == NSNotFound)
+                return NO;
+            totalRateLimit += rateLimits[index];
+            totalRemaining += remainingByKey[index];
+        }
+    }
+
+    if (rateLimit)
+        *rateLimit = totalRateLimit;
+    if (remaining)
+        *remaining = totalRemaining;
+    return (_keys.count > 0);
+}
+
+@end
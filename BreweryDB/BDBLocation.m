@@ -21,11 +21,28 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBLocation.h"
+#import "BDBGeneratedDecoders.h"
 #import "BDBBrewery.h"
 
+
+#pragma mark -
+@interface BDBLocation ()
+{
+    // In lazy mode, the brewery is decoded on first access from the part of the dictionary kept here,
+    // which is then released. Otherwise it is decoded up front and _lazy is cleared, so the accessors
+    // take no lock.
+    BOOL _lazy;
+    NSMutableDictionary *_lazyValues;
+}
+
+@end
+
+
 #pragma mark -
 @implementation BDBLocation
 
+@synthesize brewery = _brewery;
+
 - (id)initWithDictionary:(NSDictionary *)dictionary
 {
     self = [super init];
@@ -35,52 +52,60 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _locationId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-
-        _streetAddress = dictionary[NSStringFromSelector(@selector(streetAddress))];
-        _extendedAddress = dictionary[NSStringFromSelector(@selector(extendedAddress))];
-        _locality = dictionary[NSStringFromSelector(@selector(locality))];
-        _region = dictionary[NSStringFromSelector(@selector(region))];
-        _postalCode = dictionary[NSStringFromSelector(@selector(postalCode))];
-        _phone = dictionary[NSStringFromSelector(@selector(phone))];
-        _website = dictionary[NSStringFromSelector(@selector(website))];
-        _hoursOfOperation = dictionary[NSStringFromSelector(@selector(hoursOfOperation))];
-        _hoursOfOperationExplicit = dictionary[NSStringFromSelector(@selector(hoursOfOperationExplicit))];
-        _hoursOfOperationNotes = dictionary[NSStringFromSelector(@selector(hoursOfOperationNotes))];
-        _tourInfo = dictionary[NSStringFromSelector(@selector(tourInfo))];
-        _timezone = dictionary[NSStringFromSelector(@selector(timezone))];
-
-        _latitude = dictionary[NSStringFromSelector(@selector(latitude))];
-        _longitude = dictionary[NSStringFromSelector(@selector(longitude))];
-
-        NSDictionary* breweryDictionary = dictionary[NSStringFromSelector(@selector(brewery))];
-        _brewery = [[BDBBrewery alloc] initWithDictionary:breweryDictionary];
-
-        _primary = [dictionary[NSStringFromSelector(@selector(isPrimary))] boolValue];
-        _planning = [dictionary[NSStringFromSelector(@selector(inPlanning))] boolValue];
-        _closed = [dictionary[NSStringFromSelector(@selector(isClosed))] boolValue];
-        _openToPublic = [dictionary[NSStringFromSelector(@selector(openToPublic))] boolValue];
-        
-        _locationType = dictionary[NSStringFromSelector(@selector(locationType))];
-        _locationTypeDisplay = dictionary[NSStringFromSelector(@selector(locationTypeDisplay))];
-        _countryIsoCode = dictionary[NSStringFromSelector(@selector(countryIsoCode))];
-        
-        _country = dictionary[NSStringFromSelector(@selector(country))];
-        _yearOpened = dictionary[NSStringFromSelector(@selector(yearOpened))];
-        _yearClosed = dictionary[NSStringFromSelector(@selector(yearClosed))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
+        NSLog(@"Could not parse location: %@", dictionary);
+        return nil;
     }
-    @catch (NSException *exception)
+
+    BDB_DECODE_LOCATION(dictionary);
+
+    _lazy = YES;
+    _lazyValues = [[dictionary dictionaryWithValuesForKeys:BDB_LAZY_KEYS_LOCATION] mutableCopy];
+    if (!BDBLazyDecodingEnabled)
     {
-        NSLog(@"Could not parse beer: %@", exception);
-        return nil;
+        [self brewery];
+        _lazy = NO;
     }
 
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_LOCATION(dictionary);
+    return dictionary;
+}
+
+#pragma mark Lazy Decoding
+- (BDBBrewery *)brewery
+{
+    if (!_lazy)
+        return _brewery;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyBrewery);
+        if (value)
+            _brewery = [[BDBIdentityMap sharedMap] objectOfClass:[BDBBrewery class] withDictionary:BDBDictionaryValue(value)];
+        return _brewery;
+    }
+}
+
+- (void)setBrewery:(BDBBrewery *)brewery
+{
+    if (!_lazy)
+    {
+        _brewery = brewery;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyBrewery);
+        _brewery = brewery;
+    }
+}
+
 @end
@@ -0,0 +1,85 @@
+//
+//  BDBLocationIndex.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+#import <CoreLocation/CoreLocation.h>
+
+
+#pragma mark -
+@interface BDBLocationIndex : NSObject
+
+#pragma mark Instantiation
+/**
+ *  Build an immutable spatial index over locations. Locations without
+ *  coordinates are left out. Queries are safe from any thread.
+ *
+ *  @param locations BDBLocation objects, e.g. [[BDBStore sharedStore] locationsWithBreweries].
+ *
+ *  @return A new index.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithLocations:(NSArray *)locations;
+
+@property (nonatomic, readonly) NSUInteger count;
+
+#pragma mark Querying
+/**
+ *  Locations within a great-circle distance of a coordinate.
+ *
+ *  @param distance   Radius in meters.
+ *  @param coordinate Center of the search.
+ *
+ *  @return BDBLocation objects, nearest first.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)locationsWithinDistance:(CLLocationDistance)distance ofCoordinate:(CLLocationCoordinate2D)coordinate;
+
+/**
+ *  Locations inside a latitude/longitude box, such as a map view's visible
+ *  region. A box whose south-west longitude is east of its north-east
+ *  longitude crosses the antimeridian.
+ *
+ *  @param southWest South-west corner of the box.
+ *  @param northEast North-east corner of the box.
+ *
+ *  @return BDBLocation objects, nearest to the center of the box first.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)locationsInRegionWithSouthWest:(CLLocationCoordinate2D)southWest northEast:(CLLocationCoordinate2D)northEast;
+
+/**
+ *  The locations closest to a coordinate.
+ *
+ *  @param count      Maximum number of locations to return.
+ *  @param coordinate Coordinate to measure from.
+ *
+ *  @return Up to count BDBLocation objects, nearest first.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)nearestLocations:(NSUInteger)count toCoordinate:(CLLocationCoordinate2D)coordinate;
+
+@end
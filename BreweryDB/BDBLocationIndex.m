@@ -0,0 +1,314 @@
+//
+//  BDBLocationIndex.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBLocationIndex.h"
+#import "BDBLocation.h"
+
+
+static double const BDBLocationIndexCellSize = 0.1;                 // degrees, about 11 km of latitude
+static CLLocationDistance const BDBLocationIndexEarthRadius = 6371008.8;
+
+// Entries are sorted by grid cell, so every cell of one grid row is a contiguous run.
+typedef struct
+{
+    int32_t row;
+    int32_t column;
+    double latitude;
+    double longitude;
+    NSUInteger index;
+} BDBLocationIndexEntry;
+
+typedef struct
+{
+    CLLocationDistance distance;
+    NSUInteger index;
+} BDBLocationIndexMatch;
+
+static int32_t BDBLocationIndexRow(double latitude)
+{
+    return (int32_t)floor((latitude + 90.0) / BDBLocationIndexCellSize);
+}
+
+static int32_t BDBLocationIndexColumn(double longitude)
+{
+    return (int32_t)floor((longitude + 180.0) / BDBLocationIndexCellSize);
+}
+
+static int BDBLocationIndexCompareEntries(const void *a, const void *b)
+{
+    const BDBLocationIndexEntry *entryA = a;
+    const BDBLocationIndexEntry *entryB = b;
+    if (entryA->row != entryB->row)
+        return entryA->row < entryB->row ? -1 : 1;
+    if (entryA->column != entryB->column)
+        return entryA->column < entryB->column ? -1 : 1;
+    return 0;
+}
+
+static int BDBLocationIndexCompareMatches(const void *a, const void *b)
+{
+    const BDBLocationIndexMatch *matchA = a;
+    const BDBLocationIndexMatch *matchB = b;
+    if (matchA->distance != matchB->distance)
+        return matchA->distance < matchB->distance ? -1 : 1;
+    return matchA->index < matchB->index ? -1 : (matchA->index > matchB->index);
+}
+
+static CLLocationDistance BDBLocationIndexDistance(double latitudeA, double longitudeA, double latitudeB, double longitudeB)
+{
+    double phiA = latitudeA * M_PI / 180.0;
+    double phiB = latitudeB * M_PI / 180.0;
+    double sinHalfDeltaPhi = sin((phiB - phiA) / 2.0);
+    double sinHalfDeltaLambda = sin((longitudeB - longitudeA) * M_PI / 360.0);
+    double h = sinHalfDeltaPhi * sinHalfDeltaPhi + cos(phiA) * cos(phiB) * sinHalfDeltaLambda * sinHalfDeltaLambda;
+    return 2.0 * BDBLocationIndexEarthRadius * asin(MIN(1.0, sqrt(h)));
+}
+
+
+#pragma mark -
+@interface BDBLocationIndex ()
+{
+    NSArray *_locations;
+    BDBLocationIndexEntry *_entries;
+    NSUInteger _entryCount;
+}
+
+- (NSUInteger)firstEntryAtRow:(int32_t)row column:(int32_t)column;
+- (void)addMatches:(NSMutableData *)matches
+   betweenLatitude:(double)minimumLatitude
+       andLatitude:(double)maximumLatitude
+     fromLongitude:(double)minimumLongitude
+       toLongitude:(double)maximumLongitude
+            origin:(CLLocationCoordinate2D)origin
+   maximumDistance:(CLLocationDistance)maximumDistance;
+- (NSArray *)locationsForMatches:(NSMutableData *)matches;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLocationIndex
+
+#pragma mark Instantiation
+- (id)init
+{
+    return [self initWithLocations:@[]];
+}
+
+- (id)initWithLocations:(NSArray *)locations
+{
+    self = [super init];
+    if (self)
+    {
+        NSMutableArray *indexedLocations = [NSMutableArray arrayWithCapacity:locations.count];
+        _entries = calloc(MAX(locations.count, 1), sizeof(BDBLocationIndexEntry));
+        for (BDBLocation *location in locations)
+        {
+            if (!location.latitude || !location.longitude)
+                continue;
+
+            double latitude = location.latitude.doubleValue;
+            double longitude = location.longitude.doubleValue;
+            if (!CLLocationCoordinate2DIsValid(CLLocationCoordinate2DMake(latitude, longitude)))
+                continue;
+
+            _entries[_entryCount] = (BDBLocationIndexEntry){
+                .row = BDBLocationIndexRow(latitude),
+                .column = BDBLocationIndexColumn(longitude),
+                .latitude = latitude,
+                .longitude = longitude,
+                .index = indexedLocations.count
+            };
+            _entryCount++;
+            [indexedLocations addObject:location];
+        }
+
+        qsort(_entries, _entryCount, sizeof(BDBLocationIndexEntry), BDBLocationIndexCompareEntries);
+        _locations = indexedLocations;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_entries);
+}
+
+- (NSUInteger)count
+{
+    return _entryCount;
+}
+
+#pragma mark Querying
+- (NSArray *)locationsWithinDistance:(CLLocationDistance)distance ofCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    if (distance < 0.0 || !CLLocationCoordinate2DIsValid(coordinate))
+        return @[];
+
+    // The circle's bounding box; its longitude span widens towards the poles.
+    double angularDistance = distance / BDBLocationIndexEarthRadius;
+    double deltaLatitude = angularDistance * 180.0 / M_PI;
+    double minimumLatitude = coordinate.latitude - deltaLatitude;
+    double maximumLatitude = coordinate.latitude + deltaLatitude;
+    double deltaLongitude = 180.0;
+    if (minimumLatitude > -90.0 && maximumLatitude < 90.0)
+    {
+        double sinDeltaLongitude = sin(angularDistance) / cos(coordinate.latitude * M_PI / 180.0);
+        if (angularDistance < M_PI_2 && sinDeltaLongitude < 1.0)
+            deltaLongitude = asin(sinDeltaLongitude) * 180.0 / M_PI;
+    }
+
+    minimumLatitude = MAX(minimumLatitude, -90.0);
+    maximumLatitude = MIN(maximumLatitude, 90.0);
+    double minimumLongitude = coordinate.longitude - deltaLongitude;
+    double maximumLongitude = coordinate.longitude + deltaLongitude;
+    NSMutableData *matches = [NSMutableData data];
+    if (deltaLongitude >= 180.0)
+    {
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:-180.0 toLongitude:180.0 origin:coordinate maximumDistance:distance];
+    }
+    else if (minimumLongitude < -180.0)
+    {
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:minimumLongitude + 360.0 toLongitude:180.0 origin:coordinate maximumDistance:distance];
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:-180.0 toLongitude:maximumLongitude origin:coordinate maximumDistance:distance];
+    }
+    else if (maximumLongitude > 180.0)
+    {
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:minimumLongitude toLongitude:180.0 origin:coordinate maximumDistance:distance];
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:-180.0 toLongitude:maximumLongitude - 360.0 origin:coordinate maximumDistance:distance];
+    }
+    else
+    {
+        [self addMatches:matches betweenLatitude:minimumLatitude andLatitude:maximumLatitude fromLongitude:minimumLongitude toLongitude:maximumLongitude origin:coordinate maximumDistance:distance];
+    }
+
+    return [self locationsForMatches:matches];
+}
+
+- (NSArray *)locationsInRegionWithSouthWest:(CLLocationCoordinate2D)southWest northEast:(CLLocationCoordinate2D)northEast
+{
+    if (!CLLocationCoordinate2DIsValid(southWest) || !CLLocationCoordinate2DIsValid(northEast) || southWest.latitude > northEast.latitude)
+        return @[];
+
+    BOOL crossesAntimeridian = southWest.longitude > northEast.longitude;
+    double centerLongitude = (southWest.longitude + northEast.longitude + (crossesAntimeridian ? 360.0 : 0.0)) / 2.0;
+    if (centerLongitude > 180.0)
+        centerLongitude -= 360.0;
+    CLLocationCoordinate2D center = CLLocationCoordinate2DMake((southWest.latitude + northEast.latitude) / 2.0, centerLongitude);
+
+    NSMutableData *matches = [NSMutableData data];
+    if (crossesAntimeridian)
+    {
+        [self addMatches:matches betweenLatitude:southWest.latitude andLatitude:northEast.latitude fromLongitude:southWest.longitude toLongitude:180.0 origin:center maximumDistance:INFINITY];
+        [self addMatches:matches betweenLatitude:southWest.latitude andLatitude:northEast.latitude fromLongitude:-180.0 toLongitude:northEast.longitude origin:center maximumDistance:INFINITY];
+    }
+    else
+    {
+        [self addMatches:matches betweenLatitude:southWest.latitude andLatitude:northEast.latitude fromLongitude:southWest.longitude toLongitude:northEast.longitude origin:center maximumDistance:INFINITY];
+    }
+
+    return [self locationsForMatches:matches];
+}
+
+- (NSArray *)nearestLocations:(NSUInteger)count toCoordinate:(CLLocationCoordinate2D)coordinate
+{
+    if (count == 0 || !CLLocationCoordinate2DIsValid(coordinate))
+        return @[];
+
+    // Widen the search until it holds enough locations; every location within the
+    // radius is found, so the nearest ones inside it are the nearest overall.
+    CLLocationDistance distance = BDBLocationIndexCellSize * M_PI / 180.0 * BDBLocationIndexEarthRadius;
+    CLLocationDistance halfCircumference = M_PI * BDBLocationIndexEarthRadius;
+    NSArray *locations = nil;
+    do
+    {
+        locations = [self locationsWithinDistance:distance ofCoordinate:coordinate];
+        distance *= 4.0;
+    } while (locations.count < count && distance / 4.0 < halfCircumference);
+
+    return locations.count > count ? [locations subarrayWithRange:NSMakeRange(0, count)] : locations;
+}
+
+#pragma mark Grid
+- (NSUInteger)firstEntryAtRow:(int32_t)row column:(int32_t)column
+{
+    NSUInteger low = 0;
+    NSUInteger high = _entryCount;
+    while (low < high)
+    {
+        NSUInteger middle = low + (high - low) / 2;
+        const BDBLocationIndexEntry *entry = &_entries[middle];
+        if (entry->row < row || (entry->row == row && entry->column < column))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+- (void)addMatches:(NSMutableData *)matches
+   betweenLatitude:(double)minimumLatitude
+       andLatitude:(double)maximumLatitude
+     fromLongitude:(double)minimumLongitude
+       toLongitude:(double)maximumLongitude
+            origin:(CLLocationCoordinate2D)origin
+   maximumDistance:(CLLocationDistance)maximumDistance
+{
+    int32_t minimumColumn = BDBLocationIndexColumn(minimumLongitude);
+    int32_t maximumColumn = BDBLocationIndexColumn(maximumLongitude);
+    int32_t maximumRow = BDBLocationIndexRow(maximumLatitude);
+
+    // Two binary searches per grid row bound the run of cells inside the box.
+    for (int32_t row = BDBLocationIndexRow(minimumLatitude); row <= maximumRow; row++)
+    {
+        NSUInteger end = [self firstEntryAtRow:row column:maximumColumn + 1];
+        for (NSUInteger i = [self firstEntryAtRow:row column:minimumColumn]; i < end; i++)
+        {
+            const BDBLocationIndexEntry *entry = &_entries[i];
+            if (entry->latitude < minimumLatitude || entry->latitude > maximumLatitude ||
+                entry->longitude < minimumLongitude || entry->longitude > maximumLongitude)
+                continue;
+
+            CLLocationDistance distance = BDBLocationIndexDistance(origin.latitude, origin.longitude, entry->latitude, entry->longitude);
+            if (distance > maximumDistance)
+                continue;
+
+            BDBLocationIndexMatch match = { distance, entry->index };
+            [matches appendBytes:&match length:sizeof(match)];
+        }
+    }
+}
+
+- (NSArray *)locationsForMatches:(NSMutableData *)matches
+{
+    NSUInteger matchCount = matches.length / sizeof(BDBLocationIndexMatch);
+    BDBLocationIndexMatch *sortedMatches = matches.mutableBytes;
+    qsort(sortedMatches, matchCount, sizeof(BDBLocationIndexMatch), BDBLocationIndexCompareMatches);
+
+    NSMutableArray *locations = [NSMutableArray arrayWithCapacity:matchCount];
+    for (NSUInteger i = 0; i < matchCount; i++)
+        [locations addObject:_locations[sortedMatches[i].index]];
+    return locations;
+}
+
+@end
@@ -0,0 +1,136 @@
+//
+//  BDBMetricsCollector.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import <Foundation/Foundation.h>
+
+@class BDBRequestMetrics;
+
+
+#pragma mark -
+@interface BDBMetricsHistogram : NSObject
+
+/**
+ *  Upper bounds, in seconds, of the buckets counted by bucketCounts: 1 ms
+ *  doubling up to about 16 seconds. The last bucket also counts every
+ *  longer value.
+ *
+ *  @since 1.1.0
+ */
++ (NSArray *)bucketUpperBounds;
+
+@property (nonatomic, readonly) NSUInteger count;
+@property (nonatomic, readonly) NSTimeInterval minimum;
+@property (nonatomic, readonly) NSTimeInterval maximum;
+@property (nonatomic, readonly) NSTimeInterval mean;
+@property (nonatomic, readonly) NSArray *bucketCounts;
+
+/**
+ *  The nearest-rank percentile of the values.
+ *
+ *  @param percentile Between 0 and 100, e.g. 99 for p99.
+ *
+ *  @return The value, or 0 if there are none.
+ *
+ *  @since 1.1.0
+ */
+- (NSTimeInterval)valueAtPercentile:(double)percentile;
+
+@end
+
+
+#pragma mark -
+@interface BDBEndpointMetrics : NSObject
+
+@property (nonatomic, readonly) NSString *endpoint;
+
+/**
+ *  Requests in the window and how they were answered. The histograms below
+ *  cover only the requests each phase applies to: network phases need
+ *  NSURLSessionTaskMetrics, and coalesced or local results are not decoded.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSUInteger requestCount;
+@property (nonatomic, readonly) NSUInteger errorCount;
+@property (nonatomic, readonly) NSUInteger cacheCount;
+@property (nonatomic, readonly) NSUInteger coalescedCount;
+@property (nonatomic, readonly) int64_t responseBytes;
+@property (nonatomic, readonly) NSUInteger itemCount;
+
+@property (nonatomic, readonly) BDBMetricsHistogram *totalDuration;
+@property (nonatomic, readonly) BDBMetricsHistogram *queueDuration;
+@property (nonatomic, readonly) BDBMetricsHistogram *connectDuration;
+@property (nonatomic, readonly) BDBMetricsHistogram *timeToFirstByte;
+@property (nonatomic, readonly) BDBMetricsHistogram *transferDuration;
+@property (nonatomic, readonly) BDBMetricsHistogram *deserializationDuration;
+@property (nonatomic, readonly) BDBMetricsHistogram *decodeDuration;
+
+@end
+
+
+#pragma mark -
+@interface BDBMetricsCollector : NSObject
+
+/**
+ *  Create a collector that keeps the most recent requests to each endpoint.
+ *  Install it with +[BreweryDB setMetricsObserver:], e.g.
+ *
+ *      [BreweryDB setMetricsObserver:^(BDBRequestMetrics *metrics) {
+ *          [collector recordMetrics:metrics];
+ *      }];
+ *
+ *  @param windowSize Number of requests kept per endpoint. -init keeps 500.
+ *
+ *  @return A new collector.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithWindowSize:(NSUInteger)windowSize;
+
+/**
+ *  Add a request to its endpoint's window, evicting the oldest one if full.
+ *
+ *  @since 1.1.0
+ */
+- (void)recordMetrics:(BDBRequestMetrics *)metrics;
+
+/**
+ *  Summaries of each endpoint's window, computed when called.
+ *
+ *  @return BDBEndpointMetrics keyed by endpoint.
+ *
+ *  @since 1.1.0
+ */
+- (NSDictionary *)endpointMetrics;
+
+/**
+ *  @return The summary for one endpoint, or nil if it has no requests.
+ *
+ *  @since 1.1.0
+ */
+- (BDBEndpointMetrics *)metricsForEndpoint:(NSString *)endpoint;
+
+- (void)reset;
+
+@end
@@ -0,0 +1,325 @@
+//
+//  BDBMetricsCollector.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import "BDBMetricsCollector.h"
+#import "BDBRequestMetrics.h"
+
+
+static NSUInteger const BDBMetricsCollectorDefaultWindowSize = 500;
+static NSUInteger const BDBMetricsHistogramBucketCount = 15;
+
+static int BDBMetricsCompareValues(const void *a, const void *b)
+{
+    NSTimeInterval lhs = *(const NSTimeInterval *)a;
+    NSTimeInterval rhs = *(const NSTimeInterval *)b;
+    return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+
+#pragma mark -
+@interface BDBMetricsHistogram ()
+{
+    NSData *_sortedValues;
+}
+
+- (id)initWithValues:(NSTimeInterval *)values count:(NSUInteger)count;
+
+@end
+
+
+#pragma mark -
+@implementation BDBMetricsHistogram
+
++ (NSArray *)bucketUpperBounds
+{
+    static NSArray *bucketUpperBounds = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray *bounds = [NSMutableArray arrayWithCapacity:BDBMetricsHistogramBucketCount];
+        for (NSUInteger bucket = 0; bucket < BDBMetricsHistogramBucketCount; bucket++)
+            [bounds addObject:@(ldexp(0.001, (int)bucket))];
+        bucketUpperBounds = [bounds copy];
+    });
+    return bucketUpperBounds;
+}
+
+- (id)initWithValues:(NSTimeInterval *)values count:(NSUInteger)count
+{
+    self = [super init];
+    if (self)
+    {
+        qsort(values, count, sizeof(NSTimeInterval), BDBMetricsCompareValues);
+        _sortedValues = [NSData dataWithBytes:values length:count * sizeof(NSTimeInterval)];
+        _count = count;
+
+        NSUInteger buckets[BDBMetricsHistogramBucketCount] = {0};
+        NSTimeInterval sum = 0.0;
+        for (NSUInteger index = 0; index < count; index++)
+        {
+            sum += values[index];
+
+            // Bucket b holds values up to 2^b ms, so it is the ceiling of log2 of the value in ms.
+            NSTimeInterval milliseconds = values[index] * 1000.0;
+            NSUInteger bucket = (milliseconds <= 1.0) ? 0 : (NSUInteger)ceil(log2(milliseconds));
+            buckets[MIN(bucket, BDBMetricsHistogramBucketCount - 1)]++;
+        }
+
+        NSMutableArray *bucketCounts = [NSMutableArray arrayWithCapacity:BDBMetricsHistogramBucketCount];
+        for (NSUInteger bucket = 0; bucket < BDBMetricsHistogramBucketCount; bucket++)
+            [bucketCounts addObject:@(buckets[bucket])];
+        _bucketCounts = [bucketCounts copy];
+
+        if (count > 0)
+        {
+            _minimum = values[0];
+            _maximum = values[count - 1];
+            _mean = sum / count;
+        }
+    }
+    return self;
+}
+
+- (NSTimeInterval)valueAtPercentile:(double)percentile
+{
+    if (_count == 0)
+        return 0.0;
+
+    const NSTimeInterval *values = _sortedValues.bytes;
+    NSUInteger rank = (NSUInteger)ceil(MIN(MAX(percentile, 0.0), 100.0) / 100.0 * _count);
+    return values[MIN(MAX(rank, 1), _count) - 1];
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> n=%lu mean %.1f ms, p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms",
+            NSStringFromClass([self class]), self, (unsigned long)self.count, self.mean * 1000.0,
+            [self valueAtPercentile:50] * 1000.0, [self valueAtPercentile:95] * 1000.0,
+            [self valueAtPercentile:99] * 1000.0, self.maximum * 1000.0];
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBEndpointMetrics ()
+
+- (id)initWithEndpoint:(NSString *)endpoint samples:(NSArray *)samples;
+
+@end
+
+
+#pragma mark -
+@implementation BDBEndpointMetrics
+
+- (id)initWithEndpoint:(NSString *)endpoint samples:(NSArray *)samples
+{
+    self = [super init];
+    if (self)
+    {
+        _endpoint = [endpoint copy];
+        _requestCount = samples.count;
+
+        // One scratch column per histogram; each only takes the requests its phase applies to.
+        NSUInteger capacity = MAX(samples.count, 1);
+        NSMutableData *storage = [NSMutableData dataWithLength:7 * capacity * sizeof(NSTimeInterval)];
+        NSTimeInterval *total = storage.mutableBytes;
+        NSTimeInterval *queue = total + capacity;
+        NSTimeInterval *connect = queue + capacity;
+        NSTimeInterval *firstByte = connect + capacity;
+        NSTimeInterval *transfer = firstByte + capacity;
+        NSTimeInterval *deserialization = transfer + capacity;
+        NSTimeInterval *decode = deserialization + capacity;
+        NSUInteger totalCount = 0;
+        NSUInteger networkCount = 0;
+        NSUInteger phaseCount = 0;
+        NSUInteger decodedCount = 0;
+
+        for (BDBRequestMetrics *metrics in samples)
+        {
+            total[totalCount++] = metrics.totalDuration;
+            _itemCount += metrics.itemCount;
+            if (metrics.error)
+                _errorCount++;
+
+            switch (metrics.source)
+            {
+                case BDBRequestMetricsSourceCoalesced:
+                    _coalescedCount++;
+                    continue;
+                case BDBRequestMetricsSourceStore:
+                    continue;
+                case BDBRequestMetricsSourceCache:
+                case BDBRequestMetricsSourceStaleCache:
+                    _cacheCount++;
+                    break;
+                case BDBRequestMetricsSourceNotModified:
+                    _cacheCount++;
+                    // Fall through: revalidation still went to the network.
+                case BDBRequestMetricsSourceNetwork:
+                    queue[networkCount] = metrics.queueDuration;
+                    deserialization[networkCount] = metrics.deserializationDuration;
+                    networkCount++;
+                    _responseBytes += metrics.responseBytes;
+                    if (metrics.hasNetworkPhases)
+                    {
+                        connect[phaseCount] = metrics.domainLookupDuration + metrics.connectDuration;
+                        firstByte[phaseCount] = metrics.timeToFirstByte;
+                        transfer[phaseCount] = metrics.transferDuration;
+                        phaseCount++;
+                    }
+                    break;
+            }
+
+            if (!metrics.error)
+                decode[decodedCount++] = metrics.decodeDuration;
+        }
+
+        _totalDuration = [[BDBMetricsHistogram alloc] initWithValues:total count:totalCount];
+        _queueDuration = [[BDBMetricsHistogram alloc] initWithValues:queue count:networkCount];
+        _connectDuration = [[BDBMetricsHistogram alloc] initWithValues:connect count:phaseCount];
+        _timeToFirstByte = [[BDBMetricsHistogram alloc] initWithValues:firstByte count:phaseCount];
+        _transferDuration = [[BDBMetricsHistogram alloc] initWithValues:transfer count:phaseCount];
+        _deserializationDuration = [[BDBMetricsHistogram alloc] initWithValues:deserialization count:networkCount];
+        _decodeDuration = [[BDBMetricsHistogram alloc] initWithValues:decode count:decodedCount];
+    }
+    return self;
+}
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p> %@: %lu requests, %lu errors, %lu cached, %lu coalesced, total %@",
+            NSStringFromClass([self class]), self, self.endpoint, (unsigned long)self.requestCount,
+            (unsigned long)self.errorCount, (unsigned long)self.cacheCount, (unsigned long)self.coalescedCount,
+            self.totalDuration];
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBMetricsCollector ()
+{
+    NSUInteger _windowSize;
+    NSMutableDictionary *_windows;
+    NSMutableDictionary *_nextIndexes;
+}
+
+@end
+
+
+#pragma mark -
+@implementation BDBMetricsCollector
+
+- (id)init
+{
+    return [self initWithWindowSize:BDBMetricsCollectorDefaultWindowSize];
+}
+
+- (id)initWithWindowSize:(NSUInteger)windowSize
+{
+    NSParameterAssert(windowSize > 0);
+
+    self = [super init];
+    if (self)
+    {
+        _windowSize = windowSize;
+        _windows = [NSMutableDictionary dictionary];
+        _nextIndexes = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Recording
+- (void)recordMetrics:(BDBRequestMetrics *)metrics
+{
+    NSString *endpoint = metrics.endpoint;
+    if (!endpoint)
+        return;
+
+    @synchronized(self)
+    {
+        NSMutableArray *window = _windows[endpoint];
+        if (!window)
+        {
+            window = [NSMutableArray arrayWithCapacity:_windowSize];
+            _windows[endpoint] = window;
+        }
+
+        // Once full, the window is a ring: the next slot holds the oldest request.
+        if (window.count < _windowSize)
+        {
+            [window addObject:metrics];
+            return;
+        }
+
+        NSUInteger nextIndex = [_nextIndexes[endpoint] unsignedIntegerValue];
+        window[nextIndex] = metrics;
+        _nextIndexes[endpoint] = @((nextIndex + 1) % _windowSize);
+    }
+}
+
+- (void)reset
+{
+    @synchronized(self)
+    {
+        [_windows removeAllObjects];
+        [_nextIndexes removeAllObjects];
+    }
+}
+
+#pragma mark Summaries
+- (NSDictionary *)endpointMetrics
+{
+    NSDictionary *windows = nil;
+    @synchronized(self)
+    {
+        NSMutableDictionary *copies = [NSMutableDictionary dictionaryWithCapacity:_windows.count];
+        [_windows enumerateKeysAndObjectsUsingBlock:^(NSString *endpoint, NSArray *window, BOOL *stop) {
+            copies[endpoint] = [window copy];
+        }];
+        windows = copies;
+    }
+
+    // Histograms are built outside the lock so polling never holds up recording.
+    NSMutableDictionary *endpointMetrics = [NSMutableDictionary dictionaryWithCapacity:windows.count];
+    [windows enumerateKeysAndObjectsUsingBlock:^(NSString *endpoint, NSArray *window, BOOL *stop) {
+        endpointMetrics[endpoint] = [[BDBEndpointMetrics alloc] initWithEndpoint:endpoint samples:window];
+    }];
+    return endpointMetrics;
+}
+
+- (BDBEndpointMetrics *)metricsForEndpoint:(NSString *)endpoint
+{
+    NSArray *window = nil;
+    @synchronized(self)
+    {
+        window = [_windows[endpoint] copy];
+    }
+
+    if (window.count == 0)
+        return nil;
+    return [[BDBEndpointMetrics alloc] initWithEndpoint:endpoint samples:window];
+}
+
+@end
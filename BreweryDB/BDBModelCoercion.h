@@ -0,0 +1,178 @@
+//
+//  BDBModelCoercion.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#ifndef __BDBMODELCOERCION__
+#define __BDBMODELCOERCION__
+
+#import <Foundation/Foundation.h>
+
+#import "BDBIdentityMap.h"
+
+#include <stdlib.h>
+#include <ctype.h>
+#include <math.h>
+
+
+// Whether models decoded from now on defer nested objects and descriptions until first access. Set
+// through +[BreweryDB setLazyDecodingEnabled:]; a plain BOOL, since decoders only need to see a change
+// eventually.
+FOUNDATION_EXPORT BOOL BDBLazyDecodingEnabled;
+
+
+// Coercions used by the generated model decoders. Each returns nil (or NO) for
+// NSNull and for values of an unexpected type instead of raising.
+
+static inline id BDBObjectValue(id value)
+{
+    return (value == [NSNull null]) ? nil : value;
+}
+
+static inline NSString *BDBStringValue(id value)
+{
+    if ([value isKindOfClass:[NSString class]])
+        return value;
+    if ([value isKindOfClass:[NSNumber class]])
+        return [value stringValue];
+    return nil;
+}
+
+static inline NSString *BDBInternedStringValue(id value)
+{
+    // Low-cardinality values (status, locality, countryIsoCode...) share one instance when the identity map is enabled.
+    return [[BDBIdentityMap sharedMap] internedString:BDBStringValue(value)];
+}
+
+static inline NSString *BDBTrimmedStringValue(id value)
+{
+    NSString *string = BDBStringValue(value);
+    return [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+}
+
+static inline NSNumber *BDBNumberValue(id value)
+{
+    if ([value isKindOfClass:[NSNumber class]])
+        return value;
+    if (![value isKindOfClass:[NSString class]])
+        return nil;
+
+    // The API sends many numeric fields (abv, ibu, established...) as strings.
+    const char *characters = [value UTF8String];
+    char *end = NULL;
+    double number = strtod(characters, &end);
+    if (end == characters)
+        return nil;
+    while (isspace((unsigned char)*end))
+        end++;
+    if (*end != '\0')
+        return nil;
+
+    if (number == floor(number) && fabs(number) < 1e15)
+        return @((long long)number);
+    return @(number);
+}
+
+static inline BOOL BDBBoolValue(id value)
+{
+    // "Y"/"N" strings and numbers both respond to -boolValue.
+    if ([value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSString class]])
+        return [value boolValue];
+    return NO;
+}
+
+static inline NSDictionary *BDBDictionaryValue(id value)
+{
+    return [value isKindOfClass:[NSDictionary class]] ? value : nil;
+}
+
+static inline NSArray *BDBArrayValue(id value)
+{
+    return [value isKindOfClass:[NSArray class]] ? value : nil;
+}
+
+// Remove and return the source value of a lazily decoded field, or nil if the field has already been
+// decoded or set. The dictionary itself is released with its last value.
+static inline id BDBTakeLazyValue(NSMutableDictionary *__strong *lazyValues, NSString *key)
+{
+    id value = (*lazyValues)[key];
+    if (!value)
+        return nil;
+
+    [*lazyValues removeObjectForKey:key];
+    if ((*lazyValues).count == 0)
+        *lazyValues = nil;
+    return value;
+}
+
+static inline NSArray *BDBModelArrayValue(id value, Class modelClass)
+{
+    // Nested entities go through the identity map, so shared ones decode once when it is enabled.
+    NSMutableArray *models = [NSMutableArray array];
+    for (id dictionary in BDBArrayValue(value))
+    {
+        id model = [[BDBIdentityMap sharedMap] objectOfClass:modelClass withDictionary:dictionary];
+        if (model)
+            [models addObject:model];
+        else
+            NSLog(@"Could not parse %@: %@", NSStringFromClass(modelClass), dictionary);
+    }
+    return models;
+}
+
+
+// Representations used by the generated model encoders to rebuild API dictionaries.
+
+@protocol BDBDictionaryRepresentable <NSObject>
+- (NSDictionary *)dictionaryRepresentation;
+@end
+
+static inline void BDBSetRepresentedValue(NSMutableDictionary *dictionary, NSString *key, id value)
+{
+    if (value)
+        dictionary[key] = value;
+}
+
+static inline NSString *BDBBoolRepresentation(BOOL value)
+{
+    return value ? @"Y" : @"N";
+}
+
+static inline id BDBObjectRepresentation(id object)
+{
+    if ([object respondsToSelector:@selector(dictionaryRepresentation)])
+        return [(id<BDBDictionaryRepresentable>)object dictionaryRepresentation];
+    return object;
+}
+
+static inline NSArray *BDBArrayRepresentation(NSArray *array)
+{
+    if (!array)
+        return nil;
+
+    NSMutableArray *representation = [NSMutableArray arrayWithCapacity:array.count];
+    for (id object in array)
+        [representation addObject:BDBObjectRepresentation(object)];
+    return representation;
+}
+
+
+#endif
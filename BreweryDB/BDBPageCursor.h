@@ -0,0 +1,94 @@
+//
+//  BDBPageCursor.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+#import "BDBPageFetcher.h"
+
+
+#pragma mark -
+@interface BDBPageCursor : NSObject
+
+/**
+ *  Create a cursor that hands out pages one at a time.
+ *
+ *  @param pageRequest Block that requests a single 1-based page, e.g. from
+ *                     +[BreweryDB pageRequestForBeersWithParameters:withBreweryInfo:].
+ *
+ *  @return A new page cursor. No request is made until the first page is pulled.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest;
+
+/**
+ *  Number of pages fetched ahead of the page being handed out. Prefetching
+ *  only advances when the consumer pulls, so an idle consumer stops it.
+ *  Defaults to 1.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger prefetchDepth;
+
+/**
+ *  Queue the callbacks of -nextPageWithSuccess:failure: run on. Defaults to the main queue.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic) dispatch_queue_t callbackQueue;
+
+/**
+ *  Total number of pages, or 0 until the first page has arrived.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSUInteger numberOfPages;
+
+/**
+ *  Priority of every page request, including prefetches already in flight.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) BDBRequestPriority priority;
+
+@property (nonatomic, readonly) BOOL hasMorePages;
+@property (nonatomic, readonly, getter = isCancelled) BOOL cancelled;
+
+/**
+ *  Pull the next page. Only one pull may be outstanding at a time.
+ *
+ *  @param success Callback performed with the page's results, or with nil results once every page has been handed out.
+ *  @param failure Callback performed when the page fails to load. Pulling again retries the same page.
+ *
+ *  @since 1.1.0
+ */
+- (void)nextPageWithSuccess:(void (^)(NSArray *results, NSUInteger page, NSUInteger numberOfPages))success
+                    failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Stop prefetching and fail any outstanding pull with NSURLErrorCancelled.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancel;
+
+@end
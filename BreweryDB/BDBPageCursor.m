@@ -0,0 +1,266 @@
+//
+//  BDBPageCursor.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "BDBPageCursor.h"
+#import "BDBRequest_Private.h"
+
+
+static NSUInteger const BDBPageCursorDefaultPrefetchDepth = 1;
+
+
+#pragma mark -
+@interface BDBPageCursor ()
+{
+    BDBPageRequestBlock _pageRequest;
+    BDBRequest *_request;
+
+    NSMutableDictionary *_loadedPages;
+    NSMutableDictionary *_failedPages;
+    NSMutableIndexSet *_loadingPages;
+    NSUInteger _nextPage;
+
+    void (^_pendingSuccess)(NSArray *results, NSUInteger page, NSUInteger numberOfPages);
+    void (^_pendingFailure)(NSError *error);
+}
+
+@property (nonatomic, readwrite) NSUInteger numberOfPages;
+@property (nonatomic, readwrite, getter = isCancelled) BOOL cancelled;
+
+- (void)requestPage:(NSUInteger)page;
+- (void)prefetch;
+- (void)deliverIfReady;
+
+@end
+
+
+#pragma mark -
+@implementation BDBPageCursor
+
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest
+{
+    NSParameterAssert(pageRequest);
+
+    self = [super init];
+    if (self)
+    {
+        _pageRequest = [pageRequest copy];
+        _request = [[BDBRequest alloc] init];
+        _loadedPages = [NSMutableDictionary dictionary];
+        _failedPages = [NSMutableDictionary dictionary];
+        _loadingPages = [NSMutableIndexSet indexSet];
+        _nextPage = 1;
+        _prefetchDepth = BDBPageCursorDefaultPrefetchDepth;
+        _callbackQueue = dispatch_get_main_queue();
+    }
+    return self;
+}
+
+#pragma mark Priority
+- (BDBRequestPriority)priority
+{
+    return _request.priority;
+}
+
+- (void)setPriority:(BDBRequestPriority)priority
+{
+    _request.priority = priority;
+}
+
+#pragma mark State
+- (BOOL)hasMorePages
+{
+    @synchronized(self)
+    {
+        return (!self.cancelled && (_numberOfPages == 0 || _nextPage <= _numberOfPages));
+    }
+}
+
+#pragma mark Pulling
+- (void)nextPageWithSuccess:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                    failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    BOOL exhausted = NO;
+    NSUInteger numberOfPages = 0;
+    @synchronized(self)
+    {
+        NSAssert(!_pendingSuccess, @"Only one page may be pulled from a cursor at a time.");
+
+        if (self.cancelled)
+        {
+            dispatch_async(self.callbackQueue, ^{
+                failure([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+            });
+            return;
+        }
+
+        exhausted = (_numberOfPages > 0 && _nextPage > _numberOfPages);
+        numberOfPages = _numberOfPages;
+        if (!exhausted)
+        {
+            _pendingSuccess = [success copy];
+            _pendingFailure = [failure copy];
+        }
+    }
+
+    if (exhausted)
+    {
+        dispatch_async(self.callbackQueue, ^{
+            success(nil, 0, numberOfPages);
+        });
+        return;
+    }
+
+    [self deliverIfReady];
+    [self prefetch];
+}
+
+- (void)cancel
+{
+    void (^failure)(NSError *) = nil;
+    @synchronized(self)
+    {
+        self.cancelled = YES;
+        failure = _pendingFailure;
+        _pendingSuccess = nil;
+        _pendingFailure = nil;
+        [_loadedPages removeAllObjects];
+        [_failedPages removeAllObjects];
+    }
+
+    [_request cancel];
+    if (failure)
+    {
+        dispatch_async(self.callbackQueue, ^{
+            failure([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+        });
+    }
+}
+
+#pragma mark Loading
+- (void)prefetch
+{
+    NSMutableIndexSet *pages = [NSMutableIndexSet indexSet];
+    @synchronized(self)
+    {
+        if (self.cancelled)
+            return;
+
+        // Until page 1 arrives the page count is unknown, so only the next page is requested.
+        NSUInteger lastPage = _nextPage;
+        if (_numberOfPages > 0)
+            lastPage = MIN(_nextPage + self.prefetchDepth, _numberOfPages);
+
+        for (NSUInteger page = _nextPage; page <= lastPage; page++)
+        {
+            if (_loadedPages[@(page)] || _failedPages[@(page)] || [_loadingPages containsIndex:page])
+                continue;
+            [pages addIndex:page];
+        }
+        [_loadingPages addIndexes:pages];
+    }
+
+    [pages enumerateIndexesUsingBlock:^(NSUInteger page, BOOL *stop) {
+        [self requestPage:page];
+    }];
+}
+
+- (void)requestPage:(NSUInteger)page
+{
+    BDBRequest *pageRequest = _pageRequest(page,
+                                           ^(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                               @synchronized(self)
+                                               {
+                                                   [_loadingPages removeIndex:page];
+                                                   if (self.cancelled)
+                                                       return;
+
+                                                   _loadedPages[@(page)] = results ?: @[];
+                                                   _numberOfPages = MAX(numberOfPages, (NSUInteger)1);
+                                               }
+                                               [self deliverIfReady];
+                                               [self prefetch];
+                                           },
+                                           ^(NSError *error) {
+                                               @synchronized(self)
+                                               {
+                                                   [_loadingPages removeIndex:page];
+                                                   if (self.cancelled)
+                                                       return;
+
+                                                   _failedPages[@(page)] = error;
+                                               }
+                                               [self deliverIfReady];
+                                           });
+    pageRequest.priority = _request.priority;
+    [_request addChildRequest:pageRequest];
+}
+
+- (void)deliverIfReady
+{
+    void (^success)(NSArray *, NSUInteger, NSUInteger) = nil;
+    void (^failure)(NSError *) = nil;
+    NSArray *results = nil;
+    NSError *error = nil;
+    NSUInteger page = 0;
+    NSUInteger numberOfPages = 0;
+
+    @synchronized(self)
+    {
+        if (!_pendingSuccess)
+            return;
+
+        page = _nextPage;
+        results = _loadedPages[@(page)];
+        error = _failedPages[@(page)];
+        numberOfPages = _numberOfPages;
+
+        if (results)
+        {
+            [_loadedPages removeObjectForKey:@(page)];
+            _nextPage++;
+            success = _pendingSuccess;
+        }
+        else if (error)
+        {
+            // Forget the error so the next pull retries this page.
+            [_failedPages removeObjectForKey:@(page)];
+            failure = _pendingFailure;
+        }
+        else
+            return;
+
+        _pendingSuccess = nil;
+        _pendingFailure = nil;
+    }
+
+    dispatch_async(self.callbackQueue, ^{
+        if (success)
+            success(results, page, numberOfPages);
+        else
+            failure(error);
+    });
+}
+
+@end
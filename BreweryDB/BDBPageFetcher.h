@@ -0,0 +1,89 @@
+//
+//  BDBPageFetcher.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequest.h"
+
+
+typedef void (^BDBPageSuccessBlock)(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages);
+typedef BDBRequest *(^BDBPageRequestBlock)(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *error));
+
+
+#pragma mark -
+@interface BDBPageFetcher : NSObject
+
+/**
+ *  Create a fetcher that loads every page of a list endpoint.
+ *
+ *  @param pageRequest Block that requests a single 1-based page.
+ *
+ *  @return A new page fetcher.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest;
+
+/**
+ *  Maximum number of pages requested at the same time once the page count is
+ *  known. Defaults to 4.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
+/**
+ *  Called each time a page arrives.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, copy) void (^progress)(NSUInteger completedPages, NSUInteger numberOfPages);
+
+/**
+ *  Priority of every page request, including those already in flight.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) BDBRequestPriority priority;
+
+@property (nonatomic, readonly, getter = isCancelled) BOOL cancelled;
+
+/**
+ *  Request page 1, then the remaining pages concurrently.
+ *
+ *  @param success Called once with the results of every page, in page order.
+ *  @param failure Called once with the first error, or with NSURLErrorCancelled after -cancel.
+ *
+ *  @since 1.1.0
+ */
+- (void)startWithSuccess:(void (^)(NSArray *results))success
+                 failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Cancel the page requests in flight, stop requesting further pages and
+ *  report cancellation to the failure block.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,217 @@
+//
+//  BDBPageFetcher.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "BDBPageFetcher.h"
+#import "BDBRequest_Private.h"
+
+
+static NSUInteger const BDBPageFetcherDefaultMaxConcurrentRequests = 4;
+
+
+#pragma mark -
+@interface BDBPageFetcher ()
+{
+    BDBPageRequestBlock _pageRequest;
+    BDBRequest *_request;
+
+    void (^_success)(NSArray *results);
+    void (^_failure)(NSError *error);
+
+    NSMutableDictionary *_pages;
+    NSUInteger _numberOfPages;
+    NSUInteger _nextPage;
+    NSUInteger _runningRequests;
+    BOOL _started;
+    BOOL _finished;
+}
+
+@property (nonatomic, readwrite, getter = isCancelled) BOOL cancelled;
+
+- (void)requestPage:(NSUInteger)page;
+- (void)requestMorePages;
+- (void)didLoadPage:(NSUInteger)page results:(NSArray *)results numberOfPages:(NSUInteger)numberOfPages;
+- (void)finishWithError:(NSError *)error;
+
+@end
+
+
+#pragma mark -
+@implementation BDBPageFetcher
+
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest
+{
+    NSParameterAssert(pageRequest);
+
+    self = [super init];
+    if (self)
+    {
+        _pageRequest = [pageRequest copy];
+        _request = [[BDBRequest alloc] init];
+        _pages = [NSMutableDictionary dictionary];
+        _maxConcurrentRequests = BDBPageFetcherDefaultMaxConcurrentRequests;
+    }
+    return self;
+}
+
+#pragma mark Priority
+- (BDBRequestPriority)priority
+{
+    return _request.priority;
+}
+
+- (void)setPriority:(BDBRequestPriority)priority
+{
+    _request.priority = priority;
+}
+
+#pragma mark Fetching
+- (void)startWithSuccess:(void (^)(NSArray *))success failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    @synchronized(self)
+    {
+        NSAssert(!_started, @"A page fetcher can only be started once.");
+        _started = YES;
+        _success = [success copy];
+        _failure = [failure copy];
+        _nextPage = 2;
+        _runningRequests = 1;
+    }
+
+    [self requestPage:1];
+}
+
+- (void)cancel
+{
+    @synchronized(self)
+    {
+        if (_finished)
+            return;
+        self.cancelled = YES;
+    }
+
+    [_request cancel];
+    [self finishWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]];
+}
+
+- (void)requestPage:(NSUInteger)page
+{
+    BDBRequest *pageRequest = _pageRequest(page,
+                                           ^(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                               [self didLoadPage:page results:results numberOfPages:numberOfPages];
+                                           },
+                                           ^(NSError *error) {
+                                               [self finishWithError:error];
+                                           });
+    pageRequest.priority = _request.priority;
+    [_request addChildRequest:pageRequest];
+}
+
+- (void)requestMorePages
+{
+    NSMutableArray *pages = [NSMutableArray array];
+    @synchronized(self)
+    {
+        if (_finished)
+            return;
+
+        NSUInteger maxConcurrentRequests = MAX(self.maxConcurrentRequests, (NSUInteger)1);
+        while (_runningRequests < maxConcurrentRequests && _nextPage <= _numberOfPages)
+        {
+            [pages addObject:@(_nextPage)];
+            _nextPage++;
+            _runningRequests++;
+        }
+    }
+
+    for (NSNumber *page in pages)
+        [self requestPage:page.unsignedIntegerValue];
+}
+
+- (void)didLoadPage:(NSUInteger)page results:(NSArray *)results numberOfPages:(NSUInteger)numberOfPages
+{
+    NSUInteger completedPages = 0;
+    NSUInteger totalPages = 0;
+    NSArray *mergedResults = nil;
+    void (^success)(NSArray *) = nil;
+
+    @synchronized(self)
+    {
+        if (_finished)
+            return;
+
+        // Page 1 tells us how many pages there are; an empty result set still has one page.
+        if (page == 1)
+            _numberOfPages = MAX(numberOfPages, (NSUInteger)1);
+
+        _pages[@(page)] = results ?: @[];
+        _runningRequests--;
+
+        completedPages = _pages.count;
+        totalPages = _numberOfPages;
+
+        if (completedPages == totalPages)
+        {
+            NSMutableArray *mutableResults = [NSMutableArray array];
+            for (NSUInteger i = 1; i <= totalPages; i++)
+                [mutableResults addObjectsFromArray:_pages[@(i)]];
+            mergedResults = mutableResults;
+
+            success = _success;
+            _finished = YES;
+            _success = nil;
+            _failure = nil;
+            [_pages removeAllObjects];
+        }
+    }
+
+    if (self.progress)
+        self.progress(completedPages, totalPages);
+
+    if (success)
+        success(mergedResults);
+    else
+        [self requestMorePages];
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    void (^failure)(NSError *) = nil;
+    @synchronized(self)
+    {
+        if (_finished)
+            return;
+
+        failure = _failure;
+        _finished = YES;
+        _success = nil;
+        _failure = nil;
+        [_pages removeAllObjects];
+    }
+
+    if (failure)
+        failure(error);
+}
+
+@end
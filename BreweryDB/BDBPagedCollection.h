@@ -0,0 +1,137 @@
+//
+//  BDBPagedCollection.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBPageFetcher.h"
+
+
+#pragma mark -
+@interface BDBPagedCollection : NSObject
+
+/**
+ *  Create a collection that presents every result of a list endpoint by
+ *  index while keeping only a window of pages in memory.
+ *
+ *  @param pageRequest Block that requests a single 1-based page, e.g. from
+ *                     -[BreweryDB pageRequestForBeersWithParameters:withBreweryInfo:].
+ *
+ *  @return A new paged collection. No request is made until -start or the first access.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest;
+
+/**
+ *  Most pages kept in memory. Pages farthest from the last access are evicted
+ *  first, and requests for pages that fall outside the window are cancelled.
+ *  Evicted pages are requested again when accessed, which the client's
+ *  response cache usually answers without the network. Defaults to 5.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger windowSize;
+
+/**
+ *  Pages loaded ahead of the last access, in the direction the accesses are
+ *  moving. Defaults to 1.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSUInteger prefetchDepth;
+
+/**
+ *  Queue the handlers run on. Defaults to the main queue.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic) dispatch_queue_t callbackQueue;
+
+/**
+ *  Performed when a page arrives, with the range of indexes it filled and the
+ *  collection's count, which may have changed.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, copy) void (^updateHandler)(NSRange range, NSUInteger count);
+
+/**
+ *  Performed when a page fails to load. Accessing one of its indexes again retries it.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, copy) void (^failureHandler)(NSError *error, NSUInteger page);
+
+/**
+ *  Priority of every page request, including those already in flight.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) BDBRequestPriority priority;
+
+/**
+ *  Number of results, or 0 until the first page has arrived. Until the last
+ *  page has been seen every page is assumed to be full.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+@property (nonatomic, readonly) NSUInteger numberOfPages;
+@property (nonatomic, readonly) NSUInteger numberOfLoadedPages;
+
+/**
+ *  Request the first page.
+ *
+ *  @since 1.1.0
+ */
+- (void)start;
+
+/**
+ *  Look up a result and move the window to it. Returns immediately; when the
+ *  result's page is not in memory it is requested and nil is returned, and the
+ *  update handler reports when it arrives.
+ *
+ *  @param index Index of the result.
+ *
+ *  @return The result, or nil if its page is not loaded.
+ *
+ *  @since 1.1.0
+ */
+- (id)objectAtIndex:(NSUInteger)index;
+
+/**
+ *  Look up a result without moving the window or requesting anything.
+ *
+ *  @since 1.1.0
+ */
+- (id)loadedObjectAtIndex:(NSUInteger)index;
+
+/**
+ *  Cancel every page request and drop the loaded pages.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,322 @@
+//
+//  BDBPagedCollection.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBPagedCollection.h"
+#import "BDBRequest_Private.h"
+
+
+static NSUInteger const BDBPagedCollectionDefaultWindowSize = 5;
+static NSUInteger const BDBPagedCollectionDefaultPrefetchDepth = 1;
+
+static NSUInteger BDBPageDistance(NSUInteger page, NSUInteger otherPage)
+{
+    return (page > otherPage) ? page - otherPage : otherPage - page;
+}
+
+
+#pragma mark -
+@interface BDBPagedCollection ()
+{
+    BDBPageRequestBlock _pageRequest;
+    BDBRequest *_request;
+
+    NSMutableDictionary *_loadedPages;
+    NSMutableDictionary *_loadingPages;
+    NSMutableDictionary *_pageRequests;
+    NSMutableIndexSet *_failedPages;
+    NSUInteger _requestCount;
+
+    NSUInteger _pageSize;
+    NSUInteger _lastPageCount;
+    NSUInteger _currentPage;
+    NSInteger _direction;
+}
+
+@property (nonatomic, readwrite) NSUInteger numberOfPages;
+
+- (NSUInteger)pageForIndex:(NSUInteger)index;
+- (void)moveToPage:(NSUInteger)page;
+- (void)requestPage:(NSUInteger)page;
+- (void)page:(NSUInteger)page didLoadResults:(NSArray *)results numberOfPages:(NSUInteger)numberOfPages;
+- (void)page:(NSUInteger)page didFailWithError:(NSError *)error;
+- (void)evictPages;
+
+@end
+
+
+#pragma mark -
+@implementation BDBPagedCollection
+
+- (id)initWithPageRequest:(BDBPageRequestBlock)pageRequest
+{
+    NSParameterAssert(pageRequest);
+
+    self = [super init];
+    if (self)
+    {
+        _pageRequest = [pageRequest copy];
+        _request = [[BDBRequest alloc] init];
+        _loadedPages = [NSMutableDictionary dictionary];
+        _loadingPages = [NSMutableDictionary dictionary];
+        _pageRequests = [NSMutableDictionary dictionary];
+        _failedPages = [NSMutableIndexSet indexSet];
+        _lastPageCount = NSNotFound;
+        _currentPage = 1;
+        _direction = 1;
+        _windowSize = BDBPagedCollectionDefaultWindowSize;
+        _prefetchDepth = BDBPagedCollectionDefaultPrefetchDepth;
+        _callbackQueue = dispatch_get_main_queue();
+    }
+    return self;
+}
+
+#pragma mark Priority
+- (BDBRequestPriority)priority
+{
+    return _request.priority;
+}
+
+- (void)setPriority:(BDBRequestPriority)priority
+{
+    _request.priority = priority;
+}
+
+#pragma mark State
+- (NSUInteger)count
+{
+    @synchronized(self)
+    {
+        if (_numberOfPages == 0)
+            return 0;
+        if (_lastPageCount != NSNotFound)
+            return (_numberOfPages - 1) * _pageSize + _lastPageCount;
+        return _numberOfPages * _pageSize;
+    }
+}
+
+- (NSUInteger)numberOfLoadedPages
+{
+    @synchronized(self)
+    {
+        return _loadedPages.count;
+    }
+}
+
+- (NSUInteger)pageForIndex:(NSUInteger)index
+{
+    // Until page 1 arrives the page size is unknown, so every index maps to it.
+    return (_pageSize > 0) ? index / _pageSize + 1 : 1;
+}
+
+#pragma mark Access
+- (void)start
+{
+    @synchronized(self)
+    {
+        [self moveToPage:1];
+    }
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    @synchronized(self)
+    {
+        NSUInteger page = [self pageForIndex:index];
+        [self moveToPage:page];
+
+        NSArray *results = _loadedPages[@(page)];
+        NSUInteger pageIndex = index - (page - 1) * _pageSize;
+        return (pageIndex < results.count) ? results[pageIndex] : nil;
+    }
+}
+
+- (id)loadedObjectAtIndex:(NSUInteger)index
+{
+    @synchronized(self)
+    {
+        NSUInteger page = [self pageForIndex:index];
+        NSArray *results = _loadedPages[@(page)];
+        NSUInteger pageIndex = index - (page - 1) * _pageSize;
+        return (pageIndex < results.count) ? results[pageIndex] : nil;
+    }
+}
+
+- (void)cancel
+{
+    @synchronized(self)
+    {
+        [_loadedPages removeAllObjects];
+        [_loadingPages removeAllObjects];
+        [_pageRequests removeAllObjects];
+        [_failedPages removeAllIndexes];
+    }
+    [_request cancel];
+}
+
+#pragma mark Loading
+// Called with the lock held. The lock is recursive, so a page request that fails before
+// returning, e.g. for a missing API key, can report back straight away.
+- (void)moveToPage:(NSUInteger)page
+{
+    if (_request.isCancelled)
+        return;
+
+    if (page != _currentPage)
+        _direction = (page > _currentPage) ? 1 : -1;
+    _currentPage = page;
+
+    // Accessing a page that failed is how its retry is asked for.
+    [_failedPages removeIndex:page];
+
+    NSMutableIndexSet *pages = [NSMutableIndexSet indexSetWithIndex:page];
+    if (_numberOfPages > 0)
+    {
+        for (NSUInteger i = 1; i <= self.prefetchDepth; i++)
+        {
+            NSInteger prefetchPage = (NSInteger)page + _direction * (NSInteger)i;
+            if (prefetchPage >= 1 && prefetchPage <= (NSInteger)_numberOfPages)
+                [pages addIndex:(NSUInteger)prefetchPage];
+        }
+    }
+
+    [pages enumerateIndexesUsingBlock:^(NSUInteger wantedPage, BOOL *stop) {
+        if (!_loadedPages[@(wantedPage)] && !_loadingPages[@(wantedPage)] && ![_failedPages containsIndex:wantedPage])
+            [self requestPage:wantedPage];
+    }];
+
+    // Fast scrolling leaves requests behind that would only be evicted on arrival.
+    NSUInteger windowSize = MAX(self.windowSize, self.prefetchDepth + 1);
+    for (NSNumber *loadingPage in _loadingPages.allKeys)
+    {
+        if (BDBPageDistance(loadingPage.unsignedIntegerValue, page) < windowSize)
+            continue;
+
+        [_pageRequests[loadingPage] cancel];
+        [_pageRequests removeObjectForKey:loadingPage];
+        [_loadingPages removeObjectForKey:loadingPage];
+    }
+
+    [self evictPages];
+}
+
+// Each request is tagged, so callbacks from requests that were cancelled or replaced are
+// ignored, including callbacks performed before the page request block returns.
+- (void)requestPage:(NSUInteger)page
+{
+    NSNumber *tag = @(++_requestCount);
+    _loadingPages[@(page)] = tag;
+
+    BDBRequest *pageRequest = _pageRequest(page,
+                                           ^(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                               @synchronized(self)
+                                               {
+                                                   if (![_loadingPages[@(page)] isEqual:tag])
+                                                       return;
+
+                                                   [_loadingPages removeObjectForKey:@(page)];
+                                                   [_pageRequests removeObjectForKey:@(page)];
+                                                   [self page:page didLoadResults:(results ?: @[]) numberOfPages:numberOfPages];
+                                               }
+                                           },
+                                           ^(NSError *error) {
+                                               @synchronized(self)
+                                               {
+                                                   if (![_loadingPages[@(page)] isEqual:tag])
+                                                       return;
+
+                                                   [_loadingPages removeObjectForKey:@(page)];
+                                                   [_pageRequests removeObjectForKey:@(page)];
+                                                   [self page:page didFailWithError:error];
+                                               }
+                                           });
+    if (!pageRequest || ![_loadingPages[@(page)] isEqual:tag])
+        return;
+
+    pageRequest.priority = _request.priority;
+    _pageRequests[@(page)] = pageRequest;
+    [_request addChildRequest:pageRequest];
+}
+
+- (void)page:(NSUInteger)page didLoadResults:(NSArray *)results numberOfPages:(NSUInteger)numberOfPages
+{
+    BOOL firstPage = (_numberOfPages == 0);
+    _numberOfPages = MAX(numberOfPages, page);
+    if (_pageSize == 0 && page == 1)
+        _pageSize = MAX(results.count, (NSUInteger)1);
+    if (page == _numberOfPages)
+        _lastPageCount = MIN(results.count, _pageSize);
+
+    _loadedPages[@(page)] = results;
+    [self evictPages];
+
+    NSRange range = NSMakeRange((page - 1) * _pageSize, MIN(results.count, _pageSize));
+    NSUInteger count = self.count;
+    void (^updateHandler)(NSRange, NSUInteger) = self.updateHandler;
+    if (updateHandler)
+    {
+        dispatch_async(self.callbackQueue, ^{
+            updateHandler(range, count);
+        });
+    }
+
+    // Page 1 is the first time the page count is known, so prefetching can begin.
+    if (firstPage)
+        [self moveToPage:_currentPage];
+}
+
+- (void)page:(NSUInteger)page didFailWithError:(NSError *)error
+{
+    [_failedPages addIndex:page];
+
+    void (^failureHandler)(NSError *, NSUInteger) = self.failureHandler;
+    if (failureHandler)
+    {
+        dispatch_async(self.callbackQueue, ^{
+            failureHandler(error, page);
+        });
+    }
+}
+
+// Keep the pages nearest the current one, preferring those ahead of it.
+- (void)evictPages
+{
+    NSUInteger windowSize = MAX(self.windowSize, self.prefetchDepth + 1);
+    while (_loadedPages.count > windowSize)
+    {
+        NSNumber *farthestPage = nil;
+        NSUInteger farthestDistance = 0;
+        for (NSNumber *loadedPage in _loadedPages)
+        {
+            NSUInteger distance = BDBPageDistance(loadedPage.unsignedIntegerValue, _currentPage);
+            BOOL behind = (_direction > 0) ? (loadedPage.unsignedIntegerValue < _currentPage) : (loadedPage.unsignedIntegerValue > _currentPage);
+            if (!farthestPage || distance > farthestDistance || (distance == farthestDistance && behind))
+            {
+                farthestPage = loadedPage;
+                farthestDistance = distance;
+            }
+        }
+        [_loadedPages removeObjectForKey:farthestPage];
+    }
+}
+
+@end
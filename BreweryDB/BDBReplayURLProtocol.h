@@ -0,0 +1,120 @@
+//
+//  BDBReplayURLProtocol.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+typedef NS_ENUM(NSInteger, BDBReplayMode)
+{
+    BDBReplayModeReplay,    // answer from recordings and synthetic lists only
+    BDBReplayModeRecord,    // pass requests to the network and save every response
+};
+
+
+/**
+ *  A stand-in for the BreweryDB API that records real responses and replays
+ *  them offline with controllable latency, bandwidth and failures. Install it
+ *  with +[BreweryDB setSessionConfiguration:] and +sessionConfiguration.
+ *  Settings are global and apply to requests started after they change.
+ */
+#pragma mark -
+@interface BDBReplayURLProtocol : NSURLProtocol
+
+#pragma mark Installation
+/**
+ *  A default session configuration with this protocol ahead of the system ones.
+ *
+ *  @since 1.1.0
+ */
++ (NSURLSessionConfiguration *)sessionConfiguration;
+
+#pragma mark Recording
+/**
+ *  Set whether requests are recorded from the network or replayed. Defaults to BDBReplayModeReplay.
+ *
+ *  @since 1.1.0
+ */
++ (void)setMode:(BDBReplayMode)mode;
+
+/**
+ *  Set the directory recordings are written to and read from. Recordings are
+ *  keyed on request path and query, ignoring the API key, so they can be
+ *  shared between developers.
+ *
+ *  @param directoryURL File URL of the directory, created if needed.
+ *
+ *  @since 1.1.0
+ */
++ (void)setRecordingsDirectoryURL:(NSURL *)directoryURL;
+
+#pragma mark Network Conditions
+/**
+ *  Delay replayed responses by latency plus or minus a uniformly random jitter.
+ *
+ *  @since 1.1.0
+ */
++ (void)setLatency:(NSTimeInterval)latency jitter:(NSTimeInterval)jitter;
+
+/**
+ *  Deliver replayed bodies at most this many bytes per second. Pass 0, the default, for no limit.
+ *
+ *  @since 1.1.0
+ */
++ (void)setBandwidth:(double)bytesPerSecond;
+
+/**
+ *  Fail a fraction of replayed requests, chosen at random.
+ *
+ *  @param errorRate Probability from 0 to 1 that a request fails.
+ *  @param error     Error to fail with. Pass nil for NSURLErrorTimedOut.
+ *
+ *  @since 1.1.0
+ */
++ (void)setErrorRate:(double)errorRate error:(NSError *)error;
+
+#pragma mark Synthetic Payloads
+/**
+ *  Answer a list endpoint with generated pages instead of recordings, e.g. to
+ *  load-test with far more results than the live API returns.
+ *
+ *  @param path           API path such as @"beers".
+ *  @param numberOfPages  Pages the list claims to have.
+ *  @param resultsPerPage Results in each page.
+ *  @param generator      Block returning the API dictionary for the result at a zero-based index.
+ *
+ *  @since 1.1.0
+ */
++ (void)registerSyntheticListAtPath:(NSString *)path
+                      numberOfPages:(NSUInteger)numberOfPages
+                     resultsPerPage:(NSUInteger)resultsPerPage
+                          generator:(NSDictionary *(^)(NSUInteger index))generator;
+
+/**
+ *  Forget synthetic lists and restore default network conditions and mode.
+ *  Recordings on disk are kept.
+ *
+ *  @since 1.1.0
+ */
++ (void)reset;
+
+@end
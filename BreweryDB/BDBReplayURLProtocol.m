@@ -0,0 +1,415 @@
+//
+//  BDBReplayURLProtocol.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import "BDBReplayURLProtocol.h"
+
+
+static NSString * const BDBReplayHandledKey = @"BDBReplayHandled";
+static NSString * const BDBReplayRecordingKeyKey = @"key";
+static NSString * const BDBReplayRecordingStatusCodeKey = @"statusCode";
+static NSString * const BDBReplayRecordingHeaderFieldsKey = @"headerFields";
+static NSString * const BDBReplayRecordingBodyKey = @"body";
+
+// Settings are shared by every instance and guarded by the class object.
+static BDBReplayMode BDBReplayCurrentMode = BDBReplayModeReplay;
+static NSURL *BDBReplayDirectoryURL = nil;
+static NSTimeInterval BDBReplayLatency = 0.0;
+static NSTimeInterval BDBReplayJitter = 0.0;
+static double BDBReplayBandwidth = 0.0;
+static double BDBReplayErrorRate = 0.0;
+static NSError *BDBReplayInjectedError = nil;
+static NSMutableDictionary *BDBReplaySyntheticLists = nil;
+
+static double BDBReplayRandom(void)
+{
+    return (double)arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+}
+
+// Query items other than the API key, sorted so parameter order does not matter.
+static NSArray *BDBReplayQueryItems(NSURL *URL)
+{
+    NSMutableArray *queryItems = [NSMutableArray array];
+    for (NSString *queryItem in [URL.query componentsSeparatedByString:@"&"])
+    {
+        if (queryItem.length > 0 && ![queryItem hasPrefix:@"key="])
+            [queryItems addObject:queryItem];
+    }
+    [queryItems sortUsingSelector:@selector(compare:)];
+    return queryItems;
+}
+
+static NSString *BDBReplayKeyForRequest(NSURLRequest *request)
+{
+    return [NSString stringWithFormat:@"%@ %@?%@", (request.HTTPMethod ?: @"GET"), request.URL.path, [BDBReplayQueryItems(request.URL) componentsJoinedByString:@"&"]];
+}
+
+static NSURL *BDBReplayFileURLForKey(NSURL *directoryURL, NSString *key)
+{
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(keyData.bytes, (CC_LONG)keyData.length, digest);
+
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2 + 6];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++)
+        [fileName appendFormat:@"%02x", digest[i]];
+    [fileName appendString:@".plist"];
+
+    return [directoryURL URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
+
+#pragma mark -
+@interface BDBReplayURLProtocol ()
+{
+    // The loading system calls startLoading and stopLoading on one thread, and
+    // expects client callbacks there too.
+    NSThread *_clientThread;
+    NSArray *_runLoopModes;
+    NSURLSessionDataTask *_recordingTask;
+    BOOL _stopped;
+}
+
++ (NSURLSession *)recordingSession;
+
+- (void)startRecordingToDirectoryURL:(NSURL *)directoryURL;
+- (BOOL)syntheticResponse:(NSHTTPURLResponse *__autoreleasing *)response body:(NSData *__autoreleasing *)body;
+- (BOOL)recordedResponse:(NSHTTPURLResponse *__autoreleasing *)response body:(NSData *__autoreleasing *)body directoryURL:(NSURL *)directoryURL;
+- (void)deliverBody:(NSData *)body fromOffset:(NSUInteger)offset bandwidth:(double)bandwidth;
+- (void)performAfterDelay:(NSTimeInterval)delay block:(dispatch_block_t)block;
+- (void)performBlock:(dispatch_block_t)block;
+
+@end
+
+
+#pragma mark -
+@implementation BDBReplayURLProtocol
+
+#pragma mark Installation
++ (NSURLSessionConfiguration *)sessionConfiguration
+{
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+    configuration.protocolClasses = [@[[self class]] arrayByAddingObjectsFromArray:(configuration.protocolClasses ?: @[])];
+    return configuration;
+}
+
++ (NSURLSession *)recordingSession
+{
+    static NSURLSession *_recordingSession = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        _recordingSession = [NSURLSession sessionWithConfiguration:[NSURLSessionConfiguration defaultSessionConfiguration]];
+    });
+    return _recordingSession;
+}
+
+#pragma mark Settings
++ (void)setMode:(BDBReplayMode)mode
+{
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayCurrentMode = mode;
+    }
+}
+
++ (void)setRecordingsDirectoryURL:(NSURL *)directoryURL
+{
+    if (directoryURL)
+        [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayDirectoryURL = [directoryURL copy];
+    }
+}
+
++ (void)setLatency:(NSTimeInterval)latency jitter:(NSTimeInterval)jitter
+{
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayLatency = MAX(latency, 0.0);
+        BDBReplayJitter = MAX(jitter, 0.0);
+    }
+}
+
++ (void)setBandwidth:(double)bytesPerSecond
+{
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayBandwidth = MAX(bytesPerSecond, 0.0);
+    }
+}
+
++ (void)setErrorRate:(double)errorRate error:(NSError *)error
+{
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayErrorRate = MIN(MAX(errorRate, 0.0), 1.0);
+        BDBReplayInjectedError = error;
+    }
+}
+
++ (void)registerSyntheticListAtPath:(NSString *)path
+                      numberOfPages:(NSUInteger)numberOfPages
+                     resultsPerPage:(NSUInteger)resultsPerPage
+                          generator:(NSDictionary *(^)(NSUInteger))generator
+{
+    NSParameterAssert(path);
+    NSParameterAssert(generator);
+
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        if (!BDBReplaySyntheticLists)
+            BDBReplaySyntheticLists = [NSMutableDictionary dictionary];
+        BDBReplaySyntheticLists[path] = @[@(numberOfPages), @(resultsPerPage), [generator copy]];
+    }
+}
+
++ (void)reset
+{
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        BDBReplayCurrentMode = BDBReplayModeReplay;
+        BDBReplayLatency = 0.0;
+        BDBReplayJitter = 0.0;
+        BDBReplayBandwidth = 0.0;
+        BDBReplayErrorRate = 0.0;
+        BDBReplayInjectedError = nil;
+        [BDBReplaySyntheticLists removeAllObjects];
+    }
+}
+
+#pragma mark NSURLProtocol
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    NSString *scheme = request.URL.scheme.lowercaseString;
+    return (([scheme isEqualToString:@"http"] || [scheme isEqualToString:@"https"]) &&
+            ![NSURLProtocol propertyForKey:BDBReplayHandledKey inRequest:request]);
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+- (void)startLoading
+{
+    _clientThread = [NSThread currentThread];
+    NSString *currentMode = [[NSRunLoop currentRunLoop] currentMode];
+    _runLoopModes = (currentMode && ![currentMode isEqualToString:NSDefaultRunLoopMode]) ? @[NSDefaultRunLoopMode, currentMode] : @[NSDefaultRunLoopMode];
+
+    BDBReplayMode mode;
+    NSURL *directoryURL;
+    NSTimeInterval delay;
+    double bandwidth;
+    NSError *injectedError = nil;
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        mode = BDBReplayCurrentMode;
+        directoryURL = BDBReplayDirectoryURL;
+        delay = MAX(BDBReplayLatency + BDBReplayJitter * (2.0 * BDBReplayRandom() - 1.0), 0.0);
+        bandwidth = BDBReplayBandwidth;
+        if (BDBReplayErrorRate > 0.0 && BDBReplayRandom() < BDBReplayErrorRate)
+            injectedError = BDBReplayInjectedError ?: [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil];
+    }
+
+    if (mode == BDBReplayModeRecord)
+    {
+        [self startRecordingToDirectoryURL:directoryURL];
+        return;
+    }
+
+    NSHTTPURLResponse *response = nil;
+    NSData *body = nil;
+    if (!injectedError &&
+        ![self syntheticResponse:&response body:&body] &&
+        ![self recordedResponse:&response body:&body directoryURL:directoryURL])
+    {
+        NSString *description = [NSString stringWithFormat:@"No recording for %@", BDBReplayKeyForRequest(self.request)];
+        injectedError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorResourceUnavailable userInfo:@{NSLocalizedDescriptionKey:description}];
+    }
+
+    [self performAfterDelay:delay block:^{
+        if (injectedError)
+        {
+            [self.client URLProtocol:self didFailWithError:injectedError];
+            return;
+        }
+
+        [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+        [self deliverBody:body fromOffset:0 bandwidth:bandwidth];
+    }];
+}
+
+- (void)stopLoading
+{
+    _stopped = YES;
+    [_recordingTask cancel];
+    _recordingTask = nil;
+}
+
+#pragma mark Recording
+- (void)startRecordingToDirectoryURL:(NSURL *)directoryURL
+{
+    NSMutableURLRequest *request = [self.request mutableCopy];
+    [NSURLProtocol setProperty:@YES forKey:BDBReplayHandledKey inRequest:request];
+    NSString *key = BDBReplayKeyForRequest(self.request);
+
+    _recordingTask = [[[self class] recordingSession] dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        NSHTTPURLResponse *HTTPResponse = [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+        if (HTTPResponse && directoryURL)
+        {
+            // The body is stored decoded, so its original encoding and length no longer apply.
+            NSMutableDictionary *headerFields = [HTTPResponse.allHeaderFields mutableCopy];
+            [headerFields removeObjectForKey:@"Content-Encoding"];
+            [headerFields removeObjectForKey:@"Content-Length"];
+
+            NSDictionary *recording = @{BDBReplayRecordingKeyKey: key,
+                                        BDBReplayRecordingStatusCodeKey: @(HTTPResponse.statusCode),
+                                        BDBReplayRecordingHeaderFieldsKey: headerFields,
+                                        BDBReplayRecordingBodyKey: (data ?: [NSData data])};
+            NSData *recordingData = [NSPropertyListSerialization dataWithPropertyList:recording format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+            [recordingData writeToURL:BDBReplayFileURLForKey(directoryURL, key) atomically:YES];
+        }
+
+        [self performAfterDelay:0.0 block:^{
+            if (error)
+            {
+                [self.client URLProtocol:self didFailWithError:error];
+                return;
+            }
+
+            [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+            if (data.length > 0)
+                [self.client URLProtocol:self didLoadData:data];
+            [self.client URLProtocolDidFinishLoading:self];
+        }];
+    }];
+    [_recordingTask resume];
+}
+
+#pragma mark Replay
+- (BOOL)syntheticResponse:(NSHTTPURLResponse *__autoreleasing *)response body:(NSData *__autoreleasing *)body
+{
+    NSArray *syntheticList = nil;
+    @synchronized([BDBReplayURLProtocol class])
+    {
+        for (NSString *path in BDBReplaySyntheticLists)
+        {
+            if ([self.request.URL.path hasSuffix:[@"/" stringByAppendingString:path]])
+            {
+                syntheticList = BDBReplaySyntheticLists[path];
+                break;
+            }
+        }
+    }
+    if (!syntheticList)
+        return NO;
+
+    NSUInteger numberOfPages = [syntheticList[0] unsignedIntegerValue];
+    NSUInteger resultsPerPage = [syntheticList[1] unsignedIntegerValue];
+    NSDictionary *(^generator)(NSUInteger) = syntheticList[2];
+
+    NSUInteger page = 1;
+    for (NSString *queryItem in BDBReplayQueryItems(self.request.URL))
+    {
+        if ([queryItem hasPrefix:@"p="])
+            page = MAX([[queryItem substringFromIndex:2] integerValue], 1);
+    }
+
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:resultsPerPage];
+    for (NSUInteger index = (page - 1) * resultsPerPage; page <= numberOfPages && index < page * resultsPerPage; index++)
+    {
+        NSDictionary *result = generator(index);
+        if (result)
+            [results addObject:result];
+    }
+
+    NSDictionary *payload = @{@"status": @"success",
+                              @"currentPage": @(page),
+                              @"numberOfPages": @(numberOfPages),
+                              @"totalResults": @(numberOfPages * resultsPerPage),
+                              @"data": results};
+    *body = [NSJSONSerialization dataWithJSONObject:payload options:0 error:NULL];
+    *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                            statusCode:200
+                                           HTTPVersion:@"HTTP/1.1"
+                                          headerFields:@{@"Content-Type": @"application/json"}];
+    return (*body != nil);
+}
+
+- (BOOL)recordedResponse:(NSHTTPURLResponse *__autoreleasing *)response body:(NSData *__autoreleasing *)body directoryURL:(NSURL *)directoryURL
+{
+    if (!directoryURL)
+        return NO;
+
+    NSData *recordingData = [NSData dataWithContentsOfURL:BDBReplayFileURLForKey(directoryURL, BDBReplayKeyForRequest(self.request))];
+    NSDictionary *recording = recordingData ? [NSPropertyListSerialization propertyListWithData:recordingData options:NSPropertyListImmutable format:NULL error:NULL] : nil;
+    if (![recording isKindOfClass:[NSDictionary class]])
+        return NO;
+
+    *body = recording[BDBReplayRecordingBodyKey];
+    *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                            statusCode:[recording[BDBReplayRecordingStatusCodeKey] integerValue]
+                                           HTTPVersion:@"HTTP/1.1"
+                                          headerFields:recording[BDBReplayRecordingHeaderFieldsKey]];
+    return YES;
+}
+
+// Throttled bodies arrive in chunks of a twentieth of a second each, so progress
+// reporting and streaming decoding see realistic data arrival.
+- (void)deliverBody:(NSData *)body fromOffset:(NSUInteger)offset bandwidth:(double)bandwidth
+{
+    NSUInteger length = body.length - offset;
+    if (bandwidth > 0.0)
+        length = MIN(length, MAX((NSUInteger)(bandwidth / 20.0), 1));
+
+    if (length > 0)
+        [self.client URLProtocol:self didLoadData:[body subdataWithRange:NSMakeRange(offset, length)]];
+
+    if (offset + length >= body.length)
+    {
+        [self.client URLProtocolDidFinishLoading:self];
+        return;
+    }
+
+    [self performAfterDelay:length / bandwidth block:^{
+        [self deliverBody:body fromOffset:offset + length bandwidth:bandwidth];
+    }];
+}
+
+- (void)performAfterDelay:(NSTimeInterval)delay block:(dispatch_block_t)block
+{
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self performSelector:@selector(performBlock:) onThread:_clientThread withObject:[block copy] waitUntilDone:NO modes:_runLoopModes];
+    });
+}
+
+- (void)performBlock:(dispatch_block_t)block
+{
+    if (!_stopped)
+        block();
+}
+
+@end
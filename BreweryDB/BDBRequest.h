@@ -0,0 +1,69 @@
+//
+//  BDBRequest.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequestScheduler.h"
+
+
+#pragma mark -
+@interface BDBRequest : NSObject
+
+/**
+ *  Priority the request is scheduled with. Changing it moves a queued request
+ *  to its new class and adjusts the priority of a running task.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) BDBRequestPriority priority;
+
+/**
+ *  Called with the bytes received so far and the expected total (-1 if the
+ *  server did not send a length), on a private queue.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, copy) void (^progressHandler)(int64_t bytesReceived, int64_t bytesExpected);
+
+/**
+ *  Fraction of the response received, between 0 and 1.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) double fractionCompleted;
+
+@property (nonatomic, readonly, getter = isCancelled) BOOL cancelled;
+@property (nonatomic, readonly, getter = isFinished) BOOL finished;
+
+/**
+ *  Stop the request: a queued request never starts, a running task is
+ *  cancelled and its response is not decoded. The failure block is called
+ *  with NSURLErrorCancelled and the success block is never called. Child
+ *  requests, such as the pages of a fan-out, are cancelled too. Has no
+ *  effect once the request has finished.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,208 @@
+//
+//  BDBRequest.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBRequest_Private.h"
+
+
+#pragma mark -
+@interface BDBRequest ()
+{
+    NSMutableArray *_cancellationHandlers;
+    NSMutableArray *_priorityHandlers;
+    NSMutableArray *_progressHandlers;
+    NSHashTable *_childRequests;
+    double _fractionCompleted;
+}
+
+@property (nonatomic, readwrite, getter = isCancelled) BOOL cancelled;
+@property (nonatomic, readwrite, getter = isFinished) BOOL finished;
+
+@end
+
+
+#pragma mark -
+@implementation BDBRequest
+
+@synthesize priority = _priority;
+
+- (id)init
+{
+    return [self initWithPriority:BDBRequestPriorityInteractive];
+}
+
+- (id)initWithPriority:(BDBRequestPriority)priority
+{
+    self = [super init];
+    if (self)
+    {
+        _priority = priority;
+        _cancellationHandlers = [NSMutableArray array];
+        _priorityHandlers = [NSMutableArray array];
+        _progressHandlers = [NSMutableArray array];
+        _childRequests = [NSHashTable weakObjectsHashTable];
+    }
+    return self;
+}
+
+#pragma mark Priority
+- (BDBRequestPriority)priority
+{
+    @synchronized(self)
+    {
+        return _priority;
+    }
+}
+
+- (void)setPriority:(BDBRequestPriority)priority
+{
+    NSArray *priorityHandlers = nil;
+    NSArray *childRequests = nil;
+    @synchronized(self)
+    {
+        if (_priority == priority)
+            return;
+        _priority = priority;
+        priorityHandlers = [_priorityHandlers copy];
+        childRequests = [_childRequests allObjects];
+    }
+
+    for (void (^priorityHandler)(BDBRequestPriority) in priorityHandlers)
+        priorityHandler(priority);
+    for (BDBRequest *childRequest in childRequests)
+        childRequest.priority = priority;
+}
+
+- (void)addPriorityHandler:(void (^)(BDBRequestPriority))priorityHandler
+{
+    NSParameterAssert(priorityHandler);
+    @synchronized(self)
+    {
+        [_priorityHandlers addObject:[priorityHandler copy]];
+    }
+}
+
+#pragma mark Progress
+- (double)fractionCompleted
+{
+    @synchronized(self)
+    {
+        return _fractionCompleted;
+    }
+}
+
+- (void)addProgressHandler:(void (^)(int64_t, int64_t))progressHandler
+{
+    NSParameterAssert(progressHandler);
+    @synchronized(self)
+    {
+        [_progressHandlers addObject:[progressHandler copy]];
+    }
+}
+
+- (void)updateProgressWithBytesReceived:(int64_t)bytesReceived bytesExpected:(int64_t)bytesExpected
+{
+    NSArray *progressHandlers = nil;
+    @synchronized(self)
+    {
+        if (bytesExpected > 0)
+            _fractionCompleted = MIN((double)bytesReceived / (double)bytesExpected, 1.0);
+        progressHandlers = [_progressHandlers copy];
+    }
+
+    void (^progressHandler)(int64_t, int64_t) = self.progressHandler;
+    if (progressHandler)
+        progressHandler(bytesReceived, bytesExpected);
+    for (void (^handler)(int64_t, int64_t) in progressHandlers)
+        handler(bytesReceived, bytesExpected);
+}
+
+#pragma mark Completion
+- (BOOL)markFinished
+{
+    @synchronized(self)
+    {
+        if (_cancelled || _finished)
+            return NO;
+        _finished = YES;
+        _fractionCompleted = 1.0;
+        [_cancellationHandlers removeAllObjects];
+        [_priorityHandlers removeAllObjects];
+        [_progressHandlers removeAllObjects];
+        return YES;
+    }
+}
+
+- (void)cancel
+{
+    NSArray *cancellationHandlers = nil;
+    NSArray *childRequests = nil;
+    @synchronized(self)
+    {
+        if (_cancelled || _finished)
+            return;
+        _cancelled = YES;
+        cancellationHandlers = [_cancellationHandlers copy];
+        childRequests = [_childRequests allObjects];
+        [_cancellationHandlers removeAllObjects];
+        [_priorityHandlers removeAllObjects];
+        [_progressHandlers removeAllObjects];
+    }
+
+    for (BDBRequest *childRequest in childRequests)
+        [childRequest cancel];
+    for (void (^cancellationHandler)(void) in cancellationHandlers)
+        cancellationHandler();
+}
+
+- (void)addCancellationHandler:(void (^)(void))cancellationHandler
+{
+    NSParameterAssert(cancellationHandler);
+    @synchronized(self)
+    {
+        if (!_cancelled)
+        {
+            if (!_finished)
+                [_cancellationHandlers addObject:[cancellationHandler copy]];
+            return;
+        }
+    }
+    cancellationHandler();
+}
+
+- (void)addChildRequest:(BDBRequest *)childRequest
+{
+    if (!childRequest)
+        return;
+
+    @synchronized(self)
+    {
+        if (!_cancelled)
+        {
+            [_childRequests addObject:childRequest];
+            return;
+        }
+    }
+    [childRequest cancel];
+}
+
+@end
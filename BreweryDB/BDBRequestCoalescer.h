@@ -0,0 +1,104 @@
+//
+//  BDBRequestCoalescer.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class BDBRequest;
+
+
+typedef void (^BDBResultsBlock)(id results, NSUInteger currentPage, NSUInteger numberOfPages);
+
+
+#pragma mark -
+@interface BDBRequestCoalescer : NSObject
+
+/**
+ *  Register interest in the request identified by key. A caller joining a
+ *  request in flight raises it to the caller's priority if that is higher.
+ *
+ *  @param request        The caller's handle, used to remove it again on cancel.
+ *  @param key            Identifies the request, typically path plus normalized parameters.
+ *  @param networkRequest Handle for the shared network request, kept only if the caller starts it.
+ *  @param success        Called with the shared results once the request finishes.
+ *  @param failure        Called with the shared error if the request fails.
+ *
+ *  @return YES if the caller must start the request, NO if it joined one already in flight.
+ *
+ *  @since 1.1.0
+ */
+- (BOOL)addRequest:(BDBRequest *)request
+            forKey:(NSString *)key
+    networkRequest:(BDBRequest *)networkRequest
+           success:(BDBResultsBlock)success
+           failure:(void (^)(NSError *error))failure;
+
+/**
+ *  The shared network request in flight for key, if any.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)networkRequestForKey:(NSString *)key;
+
+/**
+ *  Run the shared network request for key at the highest priority among the
+ *  callers still waiting on it. Call after a caller's priority changes.
+ *
+ *  @since 1.1.0
+ */
+- (void)updatePriorityForKey:(NSString *)key;
+
+/**
+ *  Stop waiting on key for one caller. Its blocks are not called. The shared
+ *  request drops back to the highest priority of the callers that remain.
+ *
+ *  @return The shared network request if no callers remain, so it can be
+ *          cancelled, otherwise nil.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)removeRequest:(BDBRequest *)request forKey:(NSString *)key;
+
+/**
+ *  Deliver results to every caller waiting on key.
+ *
+ *  @since 1.1.0
+ */
+- (void)finishRequestForKey:(NSString *)key
+                    results:(id)results
+                currentPage:(NSUInteger)currentPage
+              numberOfPages:(NSUInteger)numberOfPages;
+
+/**
+ *  Deliver an error to every caller waiting on key.
+ *
+ *  @since 1.1.0
+ */
+- (void)failRequestForKey:(NSString *)key error:(NSError *)error;
+
+#pragma mark Statistics
+@property (nonatomic, readonly) NSUInteger startedRequestCount;
+@property (nonatomic, readonly) NSUInteger coalescedRequestCount;
+@property (nonatomic, readonly) NSUInteger pendingRequestCount;
+
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,238 @@
+//
+//  BDBRequestCoalescer.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "BDBRequestCoalescer.h"
+#import "BDBRequest.h"
+
+
+#pragma mark -
+@interface BDBRequestCoalescer ()
+{
+    NSMutableDictionary *_pendingSuccessBlocks;
+    NSMutableDictionary *_pendingFailureBlocks;
+    NSMutableDictionary *_pendingRequests;
+    NSMutableDictionary *_networkRequests;
+
+    NSUInteger _startedRequestCount;
+    NSUInteger _coalescedRequestCount;
+}
+
+- (void)removeRequestForKey:(NSString *)key
+              successBlocks:(NSArray **)successBlocks
+              failureBlocks:(NSArray **)failureBlocks;
+- (BDBRequest *)networkRequestForKey:(NSString *)key priority:(BDBRequestPriority *)priority;
+
+@end
+
+
+#pragma mark -
+@implementation BDBRequestCoalescer
+
+- (id)init
+{
+    self = [super init];
+    if (self)
+    {
+        _pendingSuccessBlocks = [NSMutableDictionary dictionary];
+        _pendingFailureBlocks = [NSMutableDictionary dictionary];
+        _pendingRequests = [NSMutableDictionary dictionary];
+        _networkRequests = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Requests
+- (BOOL)addRequest:(BDBRequest *)request
+            forKey:(NSString *)key
+    networkRequest:(BDBRequest *)networkRequest
+           success:(BDBResultsBlock)success
+           failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(request);
+    NSParameterAssert(key);
+    NSParameterAssert(networkRequest);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    @synchronized(self)
+    {
+        NSMutableArray *successBlocks = _pendingSuccessBlocks[key];
+        NSMutableArray *failureBlocks = _pendingFailureBlocks[key];
+        NSMutableArray *requests = _pendingRequests[key];
+        BOOL startsRequest = (successBlocks == nil);
+
+        if (startsRequest)
+        {
+            successBlocks = [NSMutableArray array];
+            failureBlocks = [NSMutableArray array];
+            requests = [NSMutableArray array];
+            _pendingSuccessBlocks[key] = successBlocks;
+            _pendingFailureBlocks[key] = failureBlocks;
+            _pendingRequests[key] = requests;
+            _networkRequests[key] = networkRequest;
+            _startedRequestCount++;
+        }
+        else
+            _coalescedRequestCount++;
+
+        [successBlocks addObject:[success copy]];
+        [failureBlocks addObject:[failure copy]];
+        [requests addObject:request];
+
+        if (startsRequest)
+            return YES;
+    }
+
+    [self updatePriorityForKey:key];
+    return NO;
+}
+
+- (BDBRequest *)networkRequestForKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        return _networkRequests[key];
+    }
+}
+
+- (void)updatePriorityForKey:(NSString *)key
+{
+    // Set outside the lock, since a priority change reaches into the scheduler and the running task.
+    BDBRequestPriority priority = BDBRequestPriorityInteractive;
+    BDBRequest *networkRequest = [self networkRequestForKey:key priority:&priority];
+    networkRequest.priority = priority;
+}
+
+- (BDBRequest *)removeRequest:(BDBRequest *)request forKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        NSMutableArray *requests = _pendingRequests[key];
+        NSUInteger index = [requests indexOfObjectIdenticalTo:request];
+        if (index == NSNotFound)
+            return nil;
+
+        [requests removeObjectAtIndex:index];
+        [_pendingSuccessBlocks[key] removeObjectAtIndex:index];
+        [_pendingFailureBlocks[key] removeObjectAtIndex:index];
+        if (requests.count == 0)
+        {
+            BDBRequest *networkRequest = _networkRequests[key];
+            [self removeRequestForKey:key successBlocks:NULL failureBlocks:NULL];
+            return networkRequest;
+        }
+    }
+
+    [self updatePriorityForKey:key];
+    return nil;
+}
+
+- (void)finishRequestForKey:(NSString *)key
+                    results:(id)results
+                currentPage:(NSUInteger)currentPage
+              numberOfPages:(NSUInteger)numberOfPages
+{
+    NSArray *successBlocks = nil;
+    [self removeRequestForKey:key successBlocks:&successBlocks failureBlocks:NULL];
+
+    for (BDBResultsBlock success in successBlocks)
+        success(results, currentPage, numberOfPages);
+}
+
+- (void)failRequestForKey:(NSString *)key error:(NSError *)error
+{
+    NSArray *failureBlocks = nil;
+    [self removeRequestForKey:key successBlocks:NULL failureBlocks:&failureBlocks];
+
+    for (void (^failure)(NSError *) in failureBlocks)
+        failure(error);
+}
+
+- (void)removeRequestForKey:(NSString *)key
+              successBlocks:(NSArray **)successBlocks
+              failureBlocks:(NSArray **)failureBlocks
+{
+    @synchronized(self)
+    {
+        if (successBlocks)
+            *successBlocks = _pendingSuccessBlocks[key];
+        if (failureBlocks)
+            *failureBlocks = _pendingFailureBlocks[key];
+
+        [_pendingSuccessBlocks removeObjectForKey:key];
+        [_pendingFailureBlocks removeObjectForKey:key];
+        [_pendingRequests removeObjectForKey:key];
+        [_networkRequests removeObjectForKey:key];
+    }
+}
+
+- (BDBRequest *)networkRequestForKey:(NSString *)key priority:(BDBRequestPriority *)priority
+{
+    @synchronized(self)
+    {
+        BDBRequest *networkRequest = _networkRequests[key];
+        if (!networkRequest)
+            return nil;
+
+        BDBRequestPriority highestPriority = BDBRequestPriorityBulk;
+        for (BDBRequest *request in _pendingRequests[key])
+            highestPriority = MIN(highestPriority, request.priority);
+        *priority = highestPriority;
+        return networkRequest;
+    }
+}
+
+#pragma mark Statistics
+- (NSUInteger)startedRequestCount
+{
+    @synchronized(self)
+    {
+        return _startedRequestCount;
+    }
+}
+
+- (NSUInteger)coalescedRequestCount
+{
+    @synchronized(self)
+    {
+        return _coalescedRequestCount;
+    }
+}
+
+- (NSUInteger)pendingRequestCount
+{
+    @synchronized(self)
+    {
+        return _pendingSuccessBlocks.count;
+    }
+}
+
+- (void)resetStatistics
+{
+    @synchronized(self)
+    {
+        _startedRequestCount = 0;
+        _coalescedRequestCount = 0;
+    }
+}
+
+@end
@@ -0,0 +1,135 @@
+//
+//  BDBRequestMetrics.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import <Foundation/Foundation.h>
+
+
+/**
+ *  Whether the SDK being built against has NSURLSessionTaskMetrics. Without it
+ *  the network phase durations are always zero.
+ */
+#define BDB_CAN_USE_TASK_METRICS ((__IPHONE_OS_VERSION_MAX_ALLOWED >= 100000) || (__MAC_OS_X_VERSION_MAX_ALLOWED >= 101200))
+
+typedef NS_ENUM(NSInteger, BDBRequestMetricsSource)
+{
+    BDBRequestMetricsSourceNetwork = 0,
+    BDBRequestMetricsSourceCache,
+    BDBRequestMetricsSourceStaleCache,
+    BDBRequestMetricsSourceNotModified,
+    BDBRequestMetricsSourceCoalesced,
+    BDBRequestMetricsSourceStore,
+};
+
+
+#pragma mark -
+@interface BDBRequestMetrics : NSObject
+
+/**
+ *  The endpoint path requested, e.g. "beer/oeGSxs", and the endpoint it
+ *  belongs to, e.g. "beer", which is what BDBMetricsCollector groups by.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSString *path;
+@property (nonatomic, readonly) NSString *endpoint;
+
+/**
+ *  Where the results came from. Only BDBRequestMetricsSourceNetwork and
+ *  BDBRequestMetricsSourceNotModified requests have network phases; a
+ *  coalesced request shared another caller's response, which is reported
+ *  with that caller's metrics.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) BDBRequestMetricsSource source;
+
+/**
+ *  HTTP status of the response, or 0 if none was received.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSInteger statusCode;
+@property (nonatomic, readonly) NSError *error;
+
+/**
+ *  Time from the call to the results being handed to the callback queue.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+/**
+ *  Time spent waiting in the request scheduler before the task started.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSTimeInterval queueDuration;
+
+/**
+ *  Phases of the final HTTP transaction, from NSURLSessionTaskMetrics.
+ *  Lookup, connect and TLS are zero when a connection was reused.
+ *  hasNetworkPhases is NO when task metrics were unavailable.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) BOOL hasNetworkPhases;
+@property (nonatomic, readonly) NSTimeInterval domainLookupDuration;
+@property (nonatomic, readonly) NSTimeInterval connectDuration;
+@property (nonatomic, readonly) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, readonly) NSTimeInterval timeToFirstByte;
+@property (nonatomic, readonly) NSTimeInterval transferDuration;
+
+/**
+ *  Size of the response body.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) int64_t responseBytes;
+
+/**
+ *  Retries made and whether a hedged duplicate was sent, when the client has
+ *  a retry policy.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSUInteger retryCount;
+@property (nonatomic, readonly, getter = isHedged) BOOL hedged;
+
+/**
+ *  Time spent turning the body into JSON objects, and the JSON objects into
+ *  models. Streamed responses do both while the body arrives.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSTimeInterval deserializationDuration;
+@property (nonatomic, readonly) NSTimeInterval decodeDuration;
+
+/**
+ *  Number of objects delivered: the length of a list, otherwise 1.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSUInteger itemCount;
+
+@end
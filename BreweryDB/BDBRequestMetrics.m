@@ -0,0 +1,94 @@
+//
+//  BDBRequestMetrics.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import "BDBRequestMetrics_Private.h"
+
+
+static NSTimeInterval BDBRequestMetricsInterval(NSDate *start, NSDate *end)
+{
+    return (start && end) ? MAX([end timeIntervalSinceDate:start], 0.0) : 0.0;
+}
+
+
+#pragma mark -
+@interface BDBRequestMetrics ()
+
+@property (nonatomic, readwrite) BOOL hasNetworkPhases;
+@property (nonatomic, readwrite) NSTimeInterval domainLookupDuration;
+@property (nonatomic, readwrite) NSTimeInterval connectDuration;
+@property (nonatomic, readwrite) NSTimeInterval secureConnectionDuration;
+@property (nonatomic, readwrite) NSTimeInterval timeToFirstByte;
+@property (nonatomic, readwrite) NSTimeInterval transferDuration;
+
+@end
+
+
+#pragma mark -
+@implementation BDBRequestMetrics
+
+- (id)initWithPath:(NSString *)path endpoint:(NSString *)endpoint
+{
+    self = [super init];
+    if (self)
+    {
+        _path = [path copy];
+        _endpoint = [endpoint copy];
+        _startTime = CFAbsoluteTimeGetCurrent();
+        _source = BDBRequestMetricsSourceNetwork;
+    }
+    return self;
+}
+
+#if BDB_CAN_USE_TASK_METRICS
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics
+{
+    // Earlier transactions are redirects or failed attempts; the last one produced the response.
+    NSURLSessionTaskTransactionMetrics *transaction = taskMetrics.transactionMetrics.lastObject;
+    if (!transaction)
+        return;
+
+    self.hasNetworkPhases = YES;
+    self.domainLookupDuration = BDBRequestMetricsInterval(transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+    self.connectDuration = BDBRequestMetricsInterval(transaction.connectStartDate, transaction.connectEndDate);
+    self.secureConnectionDuration = BDBRequestMetricsInterval(transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+    self.timeToFirstByte = BDBRequestMetricsInterval(transaction.requestStartDate, transaction.responseStartDate);
+    self.transferDuration = BDBRequestMetricsInterval(transaction.responseStartDate, transaction.responseEndDate);
+}
+#endif
+
+- (NSString *)description
+{
+    static NSArray *sourceNames = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sourceNames = @[@"network", @"cache", @"stale cache", @"not modified", @"coalesced", @"store"];
+    });
+
+    return [NSString stringWithFormat:@"<%@: %p> %@ (%@, %ld) total %.1f ms, queued %.1f ms, first byte %.1f ms, transfer %.1f ms, %lld bytes, JSON %.1f ms, decode %.1f ms, %lu items",
+            NSStringFromClass([self class]), self, self.path, sourceNames[self.source], (long)self.statusCode,
+            self.totalDuration * 1000.0, self.queueDuration * 1000.0, self.timeToFirstByte * 1000.0, self.transferDuration * 1000.0,
+            self.responseBytes, self.deserializationDuration * 1000.0, self.decodeDuration * 1000.0, (unsigned long)self.itemCount];
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  BDBRequestMetrics_Private.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#import "BDBRequestMetrics.h"
+
+
+#pragma mark -
+@interface BDBRequestMetrics ()
+
+- (id)initWithPath:(NSString *)path endpoint:(NSString *)endpoint;
+
+@property (nonatomic, readonly) CFAbsoluteTime startTime;
+
+@property (nonatomic, readwrite) BDBRequestMetricsSource source;
+@property (nonatomic, readwrite) NSInteger statusCode;
+@property (nonatomic, readwrite) NSError *error;
+@property (nonatomic, readwrite) NSTimeInterval totalDuration;
+@property (nonatomic, readwrite) NSTimeInterval queueDuration;
+@property (nonatomic, readwrite) int64_t responseBytes;
+@property (nonatomic, readwrite) NSUInteger retryCount;
+@property (nonatomic, readwrite) BOOL hedged;
+@property (nonatomic, readwrite) NSTimeInterval deserializationDuration;
+@property (nonatomic, readwrite) NSTimeInterval decodeDuration;
+@property (nonatomic, readwrite) NSUInteger itemCount;
+
+#if BDB_CAN_USE_TASK_METRICS
+/**
+ *  Fill in the network phases from the task's final transaction.
+ */
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)taskMetrics NS_AVAILABLE(10_12, 10_0);
+#endif
+
+@end
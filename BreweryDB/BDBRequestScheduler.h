@@ -0,0 +1,155 @@
+//
+//  BDBRequestScheduler.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+typedef NS_ENUM(NSInteger, BDBRequestPriority)
+{
+    BDBRequestPriorityInteractive,
+    BDBRequestPriorityPrefetch,
+    BDBRequestPriorityBulk,
+};
+
+typedef void (^BDBScheduledRequestBlock)(void (^finish)(void));
+
+
+#pragma mark -
+@interface BDBRequestScheduler : NSObject
+
+/**
+ *  Create a scheduler that starts requests as a token bucket allows.
+ *
+ *  @param requestsPerSecond Rate the bucket refills at.
+ *  @param burstSize         Capacity of the bucket.
+ *
+ *  @return A new request scheduler.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithRequestsPerSecond:(double)requestsPerSecond burstSize:(NSUInteger)burstSize;
+
+#pragma mark Configuration
+@property (atomic, assign) double requestsPerSecond;
+@property (atomic, assign) NSUInteger burstSize;
+
+/**
+ *  Limit the number of started but unfinished requests of one priority.
+ *  Defaults to 6 interactive, 2 prefetch and 2 bulk requests.
+ *
+ *  @since 1.1.0
+ */
+- (void)setMaxOutstandingRequests:(NSUInteger)maxOutstandingRequests forPriority:(BDBRequestPriority)priority;
+- (NSUInteger)maxOutstandingRequestsForPriority:(BDBRequestPriority)priority;
+
+/**
+ *  Fraction of the bucket (and of the remaining API quota) a priority must
+ *  leave untouched, so low-priority work waits while the budget is low and
+ *  interactive requests can still go out immediately. Defaults to 0 for
+ *  interactive, 0.25 for prefetch and 0.5 for bulk requests.
+ *
+ *  @since 1.1.0
+ */
+- (void)setReservedFraction:(double)reservedFraction forPriority:(BDBRequestPriority)priority;
+- (double)reservedFractionForPriority:(BDBRequestPriority)priority;
+
+/**
+ *  Longest a request of the priority may wait before it is dropped with
+ *  BDB_ERRNO_REQUEST_DROPPED. 0 waits forever, the default for interactive
+ *  and bulk requests; prefetch requests are dropped after 10 seconds.
+ *
+ *  @since 1.1.0
+ */
+- (void)setMaxQueueDelay:(NSTimeInterval)maxQueueDelay forPriority:(BDBRequestPriority)priority;
+- (NSTimeInterval)maxQueueDelayForPriority:(BDBRequestPriority)priority;
+
+/**
+ *  Time over which a spent API quota is restored. Between responses reporting
+ *  the remaining quota, the scheduler assumes it comes back evenly over this
+ *  window, so requests held back to protect the reserve start again even when
+ *  nothing else is in flight. 0 waits for a response to report it. Defaults to
+ *  one day, the window BreweryDB's rate limits cover.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSTimeInterval quotaWindow;
+
+/**
+ *  Called with the time each request spent queued, just before it starts.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, copy) void (^queueWaitObserver)(BDBRequestPriority priority, NSTimeInterval queueWait);
+
+#pragma mark Scheduling
+/**
+ *  Queue a request.
+ *
+ *  @param priority Priority class of the request.
+ *  @param start    Called when the request may start. It must call finish exactly once when the request completes.
+ *  @param drop     Called instead of start if the request is dropped or cancelled.
+ *
+ *  @return A token identifying the queued request.
+ *
+ *  @since 1.1.0
+ */
+- (id)scheduleRequestWithPriority:(BDBRequestPriority)priority
+                            start:(BDBScheduledRequestBlock)start
+                             drop:(void (^)(NSError *error))drop;
+
+/**
+ *  Remove a request from its queue and call its drop block with
+ *  NSURLErrorCancelled. Has no effect once the request has started.
+ *
+ *  @param scheduledRequest Token returned when the request was scheduled.
+ *
+ *  @since 1.1.0
+ */
+- (void)cancelScheduledRequest:(id)scheduledRequest;
+
+/**
+ *  Move a queued request to another priority class, keeping its place by
+ *  enqueue time. Has no effect once the request has started.
+ *
+ *  @param priority         New priority class.
+ *  @param scheduledRequest Token returned when the request was scheduled.
+ *
+ *  @since 1.1.0
+ */
+- (void)setPriority:(BDBRequestPriority)priority forScheduledRequest:(id)scheduledRequest;
+
+/**
+ *  Update the remaining API quota, e.g. from the X-Ratelimit-Limit and
+ *  X-Ratelimit-Remaining response headers.
+ *
+ *  @since 1.1.0
+ */
+- (void)updateRateLimit:(NSUInteger)rateLimit remaining:(NSUInteger)remaining;
+
+#pragma mark Statistics
+- (NSUInteger)queuedRequestCountForPriority:(BDBRequestPriority)priority;
+- (NSUInteger)outstandingRequestCountForPriority:(BDBRequestPriority)priority;
+- (NSTimeInterval)averageQueueWaitForPriority:(BDBRequestPriority)priority;
+@property (nonatomic, readonly) NSUInteger droppedRequestCount;
+
+@end
@@ -0,0 +1,420 @@
+//
+//  BDBRequestScheduler.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBRequestScheduler.h"
+#import "BDBErrors.h"
+
+
+#define BDBRequestPriorityCount 3
+
+static double const BDBRequestSchedulerDefaultRequestsPerSecond = 10.0;
+static NSUInteger const BDBRequestSchedulerDefaultBurstSize = 10;
+static NSTimeInterval const BDBRequestSchedulerDefaultQuotaWindow = 24.0 * 60.0 * 60.0;
+
+
+#pragma mark -
+@interface BDBScheduledRequest : NSObject
+
+@property (nonatomic, copy) BDBScheduledRequestBlock start;
+@property (nonatomic, copy) void (^drop)(NSError *error);
+@property (nonatomic, assign) BDBRequestPriority priority;
+@property (nonatomic, assign) CFAbsoluteTime enqueueTime;
+@property (nonatomic, assign) BOOL finished;
+
+@end
+
+
+#pragma mark -
+@implementation BDBScheduledRequest
+@end
+
+
+#pragma mark -
+@interface BDBRequestScheduler ()
+{
+    NSMutableArray *_queues[BDBRequestPriorityCount];
+    NSUInteger _outstandingRequests[BDBRequestPriorityCount];
+    NSUInteger _maxOutstandingRequests[BDBRequestPriorityCount];
+    double _reservedFractions[BDBRequestPriorityCount];
+    NSTimeInterval _maxQueueDelays[BDBRequestPriorityCount];
+
+    NSUInteger _startedRequests[BDBRequestPriorityCount];
+    NSTimeInterval _totalQueueWaits[BDBRequestPriorityCount];
+
+    double _tokens;
+    CFAbsoluteTime _lastRefillTime;
+    CFAbsoluteTime _lastQuotaRefillTime;
+    CFAbsoluteTime _nextPumpTime;
+
+    NSUInteger _rateLimit;
+    double _remainingQuota;
+}
+
+@property (nonatomic, readwrite) NSUInteger droppedRequestCount;
+
+- (void)pump;
+- (void)schedulePumpAfter:(NSTimeInterval)delay;
+- (void)finishRequest:(BDBScheduledRequest *)request;
+
+@end
+
+
+#pragma mark -
+@implementation BDBRequestScheduler
+
+- (id)init
+{
+    return [self initWithRequestsPerSecond:BDBRequestSchedulerDefaultRequestsPerSecond burstSize:BDBRequestSchedulerDefaultBurstSize];
+}
+
+- (id)initWithRequestsPerSecond:(double)requestsPerSecond burstSize:(NSUInteger)burstSize
+{
+    self = [super init];
+    if (self)
+    {
+        _requestsPerSecond = requestsPerSecond;
+        _burstSize = MAX(burstSize, (NSUInteger)1);
+        _tokens = _burstSize;
+        _lastRefillTime = CFAbsoluteTimeGetCurrent();
+        _lastQuotaRefillTime = _lastRefillTime;
+        _quotaWindow = BDBRequestSchedulerDefaultQuotaWindow;
+
+        for (NSUInteger priority = 0; priority < BDBRequestPriorityCount; priority++)
+            _queues[priority] = [NSMutableArray array];
+
+        _maxOutstandingRequests[BDBRequestPriorityInteractive] = 6;
+        _maxOutstandingRequests[BDBRequestPriorityPrefetch] = 2;
+        _maxOutstandingRequests[BDBRequestPriorityBulk] = 2;
+
+        _reservedFractions[BDBRequestPriorityInteractive] = 0.0;
+        _reservedFractions[BDBRequestPriorityPrefetch] = 0.25;
+        _reservedFractions[BDBRequestPriorityBulk] = 0.5;
+
+        _maxQueueDelays[BDBRequestPriorityPrefetch] = 10.0;
+    }
+    return self;
+}
+
+#pragma mark Configuration
+- (void)setMaxOutstandingRequests:(NSUInteger)maxOutstandingRequests forPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        _maxOutstandingRequests[priority] = MAX(maxOutstandingRequests, (NSUInteger)1);
+    }
+    [self pump];
+}
+
+- (NSUInteger)maxOutstandingRequestsForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return _maxOutstandingRequests[priority];
+    }
+}
+
+- (void)setReservedFraction:(double)reservedFraction forPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        _reservedFractions[priority] = MIN(MAX(reservedFraction, 0.0), 1.0);
+    }
+    [self pump];
+}
+
+- (double)reservedFractionForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return _reservedFractions[priority];
+    }
+}
+
+- (void)setMaxQueueDelay:(NSTimeInterval)maxQueueDelay forPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        _maxQueueDelays[priority] = MAX(maxQueueDelay, 0.0);
+    }
+    [self pump];
+}
+
+- (NSTimeInterval)maxQueueDelayForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return _maxQueueDelays[priority];
+    }
+}
+
+#pragma mark Scheduling
+- (id)scheduleRequestWithPriority:(BDBRequestPriority)priority
+                            start:(BDBScheduledRequestBlock)start
+                             drop:(void (^)(NSError *))drop
+{
+    NSParameterAssert(start);
+    NSParameterAssert(drop);
+
+    BDBScheduledRequest *request = [[BDBScheduledRequest alloc] init];
+    request.start = start;
+    request.drop = drop;
+    request.priority = MIN(MAX(priority, BDBRequestPriorityInteractive), BDBRequestPriorityBulk);
+    request.enqueueTime = CFAbsoluteTimeGetCurrent();
+
+    @synchronized(self)
+    {
+        [_queues[request.priority] addObject:request];
+    }
+    [self pump];
+
+    return request;
+}
+
+- (void)cancelScheduledRequest:(id)scheduledRequest
+{
+    if (![scheduledRequest isKindOfClass:[BDBScheduledRequest class]])
+        return;
+
+    BDBScheduledRequest *request = scheduledRequest;
+    @synchronized(self)
+    {
+        NSMutableArray *queue = _queues[request.priority];
+        NSUInteger index = [queue indexOfObjectIdenticalTo:request];
+        if (index == NSNotFound)
+            return;
+        [queue removeObjectAtIndex:index];
+    }
+
+    request.drop([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+    [self pump];
+}
+
+- (void)setPriority:(BDBRequestPriority)priority forScheduledRequest:(id)scheduledRequest
+{
+    if (![scheduledRequest isKindOfClass:[BDBScheduledRequest class]])
+        return;
+
+    BDBScheduledRequest *request = scheduledRequest;
+    priority = MIN(MAX(priority, BDBRequestPriorityInteractive), BDBRequestPriorityBulk);
+    @synchronized(self)
+    {
+        NSMutableArray *queue = _queues[request.priority];
+        NSUInteger index = [queue indexOfObjectIdenticalTo:request];
+        if (index == NSNotFound || request.priority == priority)
+            return;
+        [queue removeObjectAtIndex:index];
+
+        // Keep the target queue ordered by enqueue time so max queue delays still expire from the head.
+        NSMutableArray *targetQueue = _queues[priority];
+        NSUInteger targetIndex = [targetQueue indexOfObject:request
+                                              inSortedRange:NSMakeRange(0, targetQueue.count)
+                                                    options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                            usingComparator:^NSComparisonResult(BDBScheduledRequest *first, BDBScheduledRequest *second) {
+                                                if (first.enqueueTime < second.enqueueTime)
+                                                    return NSOrderedAscending;
+                                                return (first.enqueueTime > second.enqueueTime) ? NSOrderedDescending : NSOrderedSame;
+                                            }];
+        request.priority = priority;
+        [targetQueue insertObject:request atIndex:targetIndex];
+    }
+    [self pump];
+}
+
+- (void)updateRateLimit:(NSUInteger)rateLimit remaining:(NSUInteger)remaining
+{
+    @synchronized(self)
+    {
+        _rateLimit = rateLimit;
+        _remainingQuota = MIN(remaining, rateLimit);
+        _lastQuotaRefillTime = CFAbsoluteTimeGetCurrent();
+    }
+    [self pump];
+}
+
+- (void)pump
+{
+    NSMutableArray *startedRequests = [NSMutableArray array];
+    NSMutableArray *droppedRequests = [NSMutableArray array];
+    NSMutableArray *queueWaits = [NSMutableArray array];
+    NSTimeInterval retryDelay = 0.0;
+
+    @synchronized(self)
+    {
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+        double burstSize = MAX(self.burstSize, (NSUInteger)1);
+        _tokens = MIN(burstSize, _tokens + (now - _lastRefillTime) * self.requestsPerSecond);
+        _lastRefillTime = now;
+
+        // Without responses to report it, the quota comes back evenly over its window instead of never.
+        NSTimeInterval quotaWindow = self.quotaWindow;
+        double quotaRefillRate = (_rateLimit > 0 && quotaWindow > 0.0) ? _rateLimit / quotaWindow : 0.0;
+        _remainingQuota = MIN((double)_rateLimit, _remainingQuota + (now - _lastQuotaRefillTime) * quotaRefillRate);
+        _lastQuotaRefillTime = now;
+
+        for (NSUInteger priority = 0; priority < BDBRequestPriorityCount; priority++)
+        {
+            NSMutableArray *queue = _queues[priority];
+
+            NSTimeInterval maxQueueDelay = _maxQueueDelays[priority];
+            while (maxQueueDelay > 0.0 && queue.count > 0 && now - [queue[0] enqueueTime] >= maxQueueDelay)
+            {
+                [droppedRequests addObject:queue[0]];
+                [queue removeObjectAtIndex:0];
+            }
+
+            // Lower priorities leave part of the bucket and of the API quota for interactive work.
+            double reservedFraction = _reservedFractions[priority];
+            double requiredTokens = MIN(burstSize, 1.0 + reservedFraction * burstSize);
+            double requiredQuota = reservedFraction * _rateLimit + 1.0;
+            BOOL quotaAvailable = (_rateLimit == 0 || reservedFraction == 0.0 || _remainingQuota >= requiredQuota);
+
+            while (queue.count > 0 && quotaAvailable && _outstandingRequests[priority] < _maxOutstandingRequests[priority])
+            {
+                if (_tokens < requiredTokens)
+                {
+                    NSTimeInterval delay = (self.requestsPerSecond > 0.0) ? (requiredTokens - _tokens) / self.requestsPerSecond : 1.0;
+                    retryDelay = (retryDelay > 0.0) ? MIN(retryDelay, delay) : delay;
+                    break;
+                }
+
+                BDBScheduledRequest *request = queue[0];
+                [queue removeObjectAtIndex:0];
+                _tokens -= 1.0;
+                _outstandingRequests[priority]++;
+                _remainingQuota = MAX(_remainingQuota - 1.0, 0.0);
+
+                NSTimeInterval queueWait = now - request.enqueueTime;
+                _startedRequests[priority]++;
+                _totalQueueWaits[priority] += queueWait;
+
+                [startedRequests addObject:request];
+                [queueWaits addObject:@(queueWait)];
+            }
+
+            // Wake up once enough quota has come back for the head of the queue.
+            if (!quotaAvailable && queue.count > 0 && quotaRefillRate > 0.0)
+            {
+                NSTimeInterval delay = (requiredQuota - _remainingQuota) / quotaRefillRate;
+                retryDelay = (retryDelay > 0.0) ? MIN(retryDelay, delay) : delay;
+            }
+
+            // Wake up in time to drop whatever would otherwise wait past its limit.
+            if (maxQueueDelay > 0.0 && queue.count > 0)
+            {
+                NSTimeInterval expiry = maxQueueDelay - (now - [queue[0] enqueueTime]);
+                retryDelay = (retryDelay > 0.0) ? MIN(retryDelay, expiry) : expiry;
+            }
+        }
+
+        self.droppedRequestCount += droppedRequests.count;
+    }
+
+    if (retryDelay > 0.0)
+        [self schedulePumpAfter:retryDelay];
+
+    NSError *dropError = nil;
+    if (droppedRequests.count > 0)
+        dropError = [NSError errorWithDomain:BreweryDBErrorDomain
+                                        code:BDB_ERRNO_REQUEST_DROPPED
+                                    userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_REQUEST_DROPPED}];
+    for (BDBScheduledRequest *request in droppedRequests)
+        request.drop(dropError);
+
+    void (^queueWaitObserver)(BDBRequestPriority, NSTimeInterval) = self.queueWaitObserver;
+    [startedRequests enumerateObjectsUsingBlock:^(BDBScheduledRequest *request, NSUInteger index, BOOL *stop) {
+        if (queueWaitObserver)
+            queueWaitObserver(request.priority, [queueWaits[index] doubleValue]);
+
+        request.start(^{
+            [self finishRequest:request];
+        });
+    }];
+}
+
+- (void)schedulePumpAfter:(NSTimeInterval)delay
+{
+    CFAbsoluteTime pumpTime = CFAbsoluteTimeGetCurrent() + delay;
+    @synchronized(self)
+    {
+        if (_nextPumpTime > CFAbsoluteTimeGetCurrent() && _nextPumpTime <= pumpTime)
+            return;
+        _nextPumpTime = pumpTime;
+    }
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @synchronized(self)
+        {
+            if (_nextPumpTime == pumpTime)
+                _nextPumpTime = 0.0;
+        }
+        [self pump];
+    });
+}
+
+- (void)finishRequest:(BDBScheduledRequest *)request
+{
+    @synchronized(self)
+    {
+        if (request.finished)
+            return;
+        request.finished = YES;
+        _outstandingRequests[request.priority]--;
+    }
+    [self pump];
+}
+
+#pragma mark Statistics
+- (NSUInteger)queuedRequestCountForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return _queues[priority].count;
+    }
+}
+
+- (NSUInteger)outstandingRequestCountForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return _outstandingRequests[priority];
+    }
+}
+
+- (NSTimeInterval)averageQueueWaitForPriority:(BDBRequestPriority)priority
+{
+    NSParameterAssert(priority >= 0 && priority < BDBRequestPriorityCount);
+    @synchronized(self)
+    {
+        return (_startedRequests[priority] > 0) ? _totalQueueWaits[priority] / _startedRequests[priority] : 0.0;
+    }
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  BDBRequest_Private.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBRequest.h"
+
+@class BDBRequestMetrics;
+
+
+#pragma mark -
+@interface BDBRequest ()
+
+- (id)initWithPriority:(BDBRequestPriority)priority;
+
+/**
+ *  Metrics filled in as the request moves through scheduling, the network
+ *  and decoding, if a metrics observer is set.
+ */
+@property (atomic) BDBRequestMetrics *metrics;
+
+/**
+ *  When the request left the scheduler and went to the network, or 0 if it
+ *  has not.
+ */
+@property (atomic) CFAbsoluteTime startTime;
+
+/**
+ *  Mark the request finished so its completion runs once. Returns NO if it
+ *  was cancelled or has already finished.
+ */
+- (BOOL)markFinished;
+
+/**
+ *  Blocks run once when the request is cancelled, or immediately if it
+ *  already was.
+ */
+- (void)addCancellationHandler:(void (^)(void))cancellationHandler;
+
+/**
+ *  Blocks run whenever the priority changes.
+ */
+- (void)addPriorityHandler:(void (^)(BDBRequestPriority priority))priorityHandler;
+
+/**
+ *  Blocks run whenever progress is reported, after progressHandler.
+ */
+- (void)addProgressHandler:(void (^)(int64_t bytesReceived, int64_t bytesExpected))progressHandler;
+
+/**
+ *  Cancel child along with the receiver. Children are held weakly.
+ */
+- (void)addChildRequest:(BDBRequest *)childRequest;
+
+- (void)updateProgressWithBytesReceived:(int64_t)bytesReceived bytesExpected:(int64_t)bytesExpected;
+
+@end
@@ -0,0 +1,140 @@
+//
+//  BDBResponseCache.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBCachedResponse : NSObject
+
+@property (nonatomic, readonly) id responseObject;
+@property (nonatomic, copy, readonly) NSString *ETag;
+@property (nonatomic, readonly) NSDate *expirationDate;
+@property (nonatomic, readonly) NSUInteger cost;
+
+@property (nonatomic, readonly, getter = isExpired) BOOL expired;
+
+@end
+
+
+#pragma mark -
+@interface BDBResponseCache : NSObject
+
+#pragma mark Instantiation
+/**
+ *  The cache used by BreweryDB unless another one is set.
+ *
+ *  @return BDBResponseCache singleton
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)sharedCache;
+
+/**
+ *  Create a response cache backed by memory and a directory on disk.
+ *
+ *  @param directoryURL   Directory for persisted responses. Pass nil for a memory-only cache.
+ *  @param memoryCapacity Maximum number of bytes kept in memory.
+ *  @param diskCapacity   Maximum number of bytes kept on disk.
+ *
+ *  @return A new response cache.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithDirectoryURL:(NSURL *)directoryURL
+            memoryCapacity:(NSUInteger)memoryCapacity
+              diskCapacity:(NSUInteger)diskCapacity;
+
+#pragma mark Configuration
+@property (nonatomic, readonly) NSURL *directoryURL;
+@property (nonatomic, assign) NSUInteger memoryCapacity;
+@property (nonatomic, assign) NSUInteger diskCapacity;
+
+/**
+ *  Time to live for endpoints without an explicit value.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign) NSTimeInterval defaultTimeToLive;
+
+/**
+ *  When enabled, expired responses younger than maximumStaleness are returned
+ *  immediately while a revalidation request refreshes the cache in the background.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, assign, getter = isStaleWhileRevalidateEnabled) BOOL staleWhileRevalidateEnabled;
+@property (nonatomic, assign) NSTimeInterval maximumStaleness;
+
+/**
+ *  Set how long responses for an endpoint stay fresh.
+ *
+ *  @param timeToLive Freshness lifetime in seconds. Zero disables caching for the endpoint.
+ *  @param endpoint   First path component of the request, e.g. "styles" or "search".
+ *
+ *  @since 1.1.0
+ */
+- (void)setTimeToLive:(NSTimeInterval)timeToLive forEndpoint:(NSString *)endpoint;
+- (NSTimeInterval)timeToLiveForEndpoint:(NSString *)endpoint;
+
+#pragma mark Keys
+/**
+ *  Build a cache key from a request path and its parameters. The API key is
+ *  left out so responses survive key changes.
+ *
+ *  @since 1.1.0
+ */
++ (NSString *)keyForPath:(NSString *)path parameters:(NSDictionary *)parameters;
++ (NSString *)endpointForPath:(NSString *)path;
+
+#pragma mark Lookup
+/**
+ *  Look up a response, checking memory first and then disk.
+ *
+ *  @param key        Key created by +keyForPath:parameters:.
+ *  @param completion Called on a private queue with the cached response, or nil on a miss.
+ *
+ *  @since 1.1.0
+ */
+- (void)fetchCachedResponseForKey:(NSString *)key completion:(void (^)(BDBCachedResponse *cachedResponse))completion;
+
+- (BOOL)canServeStaleResponse:(BDBCachedResponse *)cachedResponse;
+
+#pragma mark Storage
+- (void)storeResponseObject:(id)responseObject ETag:(NSString *)ETag forKey:(NSString *)key endpoint:(NSString *)endpoint;
+- (void)refreshCachedResponse:(BDBCachedResponse *)cachedResponse forKey:(NSString *)key endpoint:(NSString *)endpoint;
+- (void)removeResponseForKey:(NSString *)key;
+- (void)removeAllResponses;
+
+#pragma mark Statistics
+@property (nonatomic, readonly) NSUInteger hitCount;
+@property (nonatomic, readonly) NSUInteger staleHitCount;
+@property (nonatomic, readonly) NSUInteger missCount;
+@property (nonatomic, readonly) NSUInteger notModifiedCount;
+
+@property (nonatomic, readonly) NSUInteger currentMemoryUsage;
+@property (nonatomic, readonly) NSUInteger currentDiskUsage;
+
+- (void)recordNotModified;
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,589 @@
+//
+//  BDBResponseCache.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import "BDBResponseCache.h"
+
+
+static NSString * const BDBResponseCacheDirectoryName       = @"com.brewerydb.responses";
+
+static NSString * const BDBResponseCacheFileDataKey         = @"data";
+static NSString * const BDBResponseCacheFileETagKey         = @"etag";
+static NSString * const BDBResponseCacheFileExpirationKey   = @"expiration";
+
+static NSUInteger const BDBResponseCacheDefaultMemoryCapacity   = 4 * 1024 * 1024;
+static NSUInteger const BDBResponseCacheDefaultDiskCapacity     = 20 * 1024 * 1024;
+
+static NSTimeInterval const BDBResponseCacheReferenceTimeToLive = 24.0 * 60.0 * 60.0;
+static NSTimeInterval const BDBResponseCacheSearchTimeToLive    = 60.0;
+static NSTimeInterval const BDBResponseCacheDefaultTimeToLive   = 5.0 * 60.0;
+
+
+#pragma mark -
+@interface BDBCachedResponse ()
+
+@property (nonatomic, readwrite) id responseObject;
+@property (nonatomic, copy, readwrite) NSString *ETag;
+@property (nonatomic, readwrite) NSDate *expirationDate;
+@property (nonatomic) NSData *data;
+
+@end
+
+
+#pragma mark -
+@implementation BDBCachedResponse
+
+- (BOOL)isExpired
+{
+    return ([self.expirationDate timeIntervalSinceNow] <= 0.0);
+}
+
+- (NSUInteger)cost
+{
+    return self.data.length;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBResponseCache ()
+{
+    dispatch_queue_t _queue;
+    dispatch_queue_t _ioQueue;
+
+    // Disk reads and writes, eviction and _currentDiskUsage belong to _ioQueue, so they never hold
+    // up memory lookups and statistics. The memory cache and counters are only touched on _queue.
+    NSMutableDictionary *_memoryResponses;
+    NSMutableOrderedSet *_memoryKeys;
+    NSMutableDictionary *_timeToLives;
+}
+
+@property (nonatomic, readwrite) NSURL *directoryURL;
+
+@property (nonatomic, readwrite) NSUInteger hitCount;
+@property (nonatomic, readwrite) NSUInteger staleHitCount;
+@property (nonatomic, readwrite) NSUInteger missCount;
+@property (nonatomic, readwrite) NSUInteger notModifiedCount;
+
+@property (nonatomic, readwrite) NSUInteger currentMemoryUsage;
+@property (nonatomic, readwrite) NSUInteger currentDiskUsage;
+
+- (NSURL *)fileURLForKey:(NSString *)key;
+- (BDBCachedResponse *)diskResponseForKey:(NSString *)key;
+- (void)recordLookupOfResponse:(BDBCachedResponse *)cachedResponse;
+- (void)writeResponse:(BDBCachedResponse *)cachedResponse toDiskForKey:(NSString *)key;
+- (void)addMemoryResponse:(BDBCachedResponse *)cachedResponse forKey:(NSString *)key;
+- (void)removeMemoryResponseForKey:(NSString *)key;
+- (void)removeDiskResponseForKey:(NSString *)key;
+- (void)trimMemory;
+- (void)trimDisk;
+
+@end
+
+
+#pragma mark -
+@implementation BDBResponseCache
+
+#pragma mark Instantiation
++ (instancetype)sharedCache
+{
+    static BDBResponseCache *_sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURL *cachesURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+        _sharedCache = [[[self class] alloc] initWithDirectoryURL:[cachesURL URLByAppendingPathComponent:BDBResponseCacheDirectoryName isDirectory:YES]
+                                                   memoryCapacity:BDBResponseCacheDefaultMemoryCapacity
+                                                     diskCapacity:BDBResponseCacheDefaultDiskCapacity];
+    });
+    return _sharedCache;
+}
+
+- (id)init
+{
+    return [self initWithDirectoryURL:nil memoryCapacity:BDBResponseCacheDefaultMemoryCapacity diskCapacity:0];
+}
+
+- (id)initWithDirectoryURL:(NSURL *)directoryURL
+            memoryCapacity:(NSUInteger)memoryCapacity
+              diskCapacity:(NSUInteger)diskCapacity
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    _queue = dispatch_queue_create("com.brewerydb.responsecache", DISPATCH_QUEUE_SERIAL);
+    _ioQueue = dispatch_queue_create("com.brewerydb.responsecache.io", DISPATCH_QUEUE_SERIAL);
+
+    _memoryResponses = [NSMutableDictionary dictionary];
+    _memoryKeys = [NSMutableOrderedSet orderedSet];
+
+    _directoryURL = directoryURL;
+    _memoryCapacity = memoryCapacity;
+    _diskCapacity = diskCapacity;
+
+    _defaultTimeToLive = BDBResponseCacheDefaultTimeToLive;
+    _staleWhileRevalidateEnabled = NO;
+    _maximumStaleness = BDBResponseCacheReferenceTimeToLive;
+
+    _timeToLives = [NSMutableDictionary dictionary];
+    for (NSString *endpoint in @[@"styles", @"style", @"categories", @"category",
+                                 @"fermentables", @"fermentable", @"hops", @"hop", @"yeasts", @"yeast"])
+        _timeToLives[endpoint] = @(BDBResponseCacheReferenceTimeToLive);
+    _timeToLives[@"search"] = @(BDBResponseCacheSearchTimeToLive);
+
+    if (_directoryURL)
+    {
+        dispatch_async(_ioQueue, ^{
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager createDirectoryAtURL:_directoryURL withIntermediateDirectories:YES attributes:nil error:NULL];
+
+            NSUInteger diskUsage = 0;
+            for (NSURL *fileURL in [fileManager contentsOfDirectoryAtURL:_directoryURL
+                                              includingPropertiesForKeys:@[NSURLFileSizeKey]
+                                                                 options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                   error:NULL])
+            {
+                NSNumber *fileSize = nil;
+                [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+                diskUsage += fileSize.unsignedIntegerValue;
+            }
+            _currentDiskUsage = diskUsage;
+            [self trimDisk];
+        });
+    }
+
+    return self;
+}
+
+#pragma mark Configuration
+- (void)setMemoryCapacity:(NSUInteger)memoryCapacity
+{
+    dispatch_async(_queue, ^{
+        _memoryCapacity = memoryCapacity;
+        [self trimMemory];
+    });
+}
+
+- (void)setDiskCapacity:(NSUInteger)diskCapacity
+{
+    dispatch_async(_ioQueue, ^{
+        _diskCapacity = diskCapacity;
+        [self trimDisk];
+    });
+}
+
+- (void)setTimeToLive:(NSTimeInterval)timeToLive forEndpoint:(NSString *)endpoint
+{
+    NSParameterAssert(endpoint);
+
+    @synchronized(_timeToLives)
+    {
+        _timeToLives[endpoint] = @(timeToLive);
+    }
+}
+
+- (NSTimeInterval)timeToLiveForEndpoint:(NSString *)endpoint
+{
+    // Looked up on the caller's thread for every request, so it takes a lock rather than waiting on a queue.
+    NSNumber *timeToLive = nil;
+    @synchronized(_timeToLives)
+    {
+        timeToLive = endpoint ? _timeToLives[endpoint] : nil;
+    }
+    return (timeToLive ? timeToLive.doubleValue : self.defaultTimeToLive);
+}
+
+#pragma mark Keys
++ (NSString *)keyForPath:(NSString *)path parameters:(NSDictionary *)parameters
+{
+    NSMutableString *key = [NSMutableString stringWithString:path];
+    NSString *separator = @"?";
+    for (NSString *name in [parameters.allKeys sortedArrayUsingSelector:@selector(compare:)])
+    {
+        if ([name isEqualToString:@"key"])
+            continue;
+
+        [key appendFormat:@"%@%@=%@", separator, name, parameters[name]];
+        separator = @"&";
+    }
+    return key;
+}
+
++ (NSString *)endpointForPath:(NSString *)path
+{
+    return [[path componentsSeparatedByString:@"/"] firstObject];
+}
+
+- (NSURL *)fileURLForKey:(NSString *)key
+{
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(keyData.bytes, (CC_LONG)keyData.length, digest);
+
+    NSMutableString *fileName = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++)
+        [fileName appendFormat:@"%02x", digest[i]];
+
+    return [self.directoryURL URLByAppendingPathComponent:fileName isDirectory:NO];
+}
+
+#pragma mark Lookup
+- (void)fetchCachedResponseForKey:(NSString *)key completion:(void (^)(BDBCachedResponse *))completion
+{
+    NSParameterAssert(key);
+    NSParameterAssert(completion);
+
+    dispatch_async(_queue, ^{
+        BDBCachedResponse *cachedResponse = _memoryResponses[key];
+        if (cachedResponse || !self.directoryURL)
+        {
+            if (cachedResponse)
+            {
+                [_memoryKeys removeObject:key];
+                [_memoryKeys addObject:key];
+            }
+            [self recordLookupOfResponse:cachedResponse];
+            completion(cachedResponse);
+            return;
+        }
+
+        dispatch_async(_ioQueue, ^{
+            BDBCachedResponse *diskResponse = [self diskResponseForKey:key];
+            dispatch_async(_queue, ^{
+                // A response stored while the file was read is newer than the file.
+                BDBCachedResponse *cachedResponse = _memoryResponses[key];
+                if (!cachedResponse && diskResponse)
+                {
+                    cachedResponse = diskResponse;
+                    [self addMemoryResponse:cachedResponse forKey:key];
+                }
+                [self recordLookupOfResponse:cachedResponse];
+                completion(cachedResponse);
+            });
+        });
+    });
+}
+
+- (void)recordLookupOfResponse:(BDBCachedResponse *)cachedResponse
+{
+    if (cachedResponse && !cachedResponse.isExpired)
+        _hitCount++;
+    else if (cachedResponse && [self canServeStaleResponse:cachedResponse])
+        _staleHitCount++;
+    else
+        _missCount++;
+}
+
+- (BOOL)canServeStaleResponse:(BDBCachedResponse *)cachedResponse
+{
+    if (!self.isStaleWhileRevalidateEnabled)
+        return NO;
+
+    return (-[cachedResponse.expirationDate timeIntervalSinceNow] < self.maximumStaleness);
+}
+
+- (BDBCachedResponse *)diskResponseForKey:(NSString *)key
+{
+    if (!self.directoryURL)
+        return nil;
+
+    NSURL *fileURL = [self fileURLForKey:key];
+    NSData *fileData = [NSData dataWithContentsOfURL:fileURL];
+    if (!fileData)
+        return nil;
+
+    NSDictionary *file = [NSPropertyListSerialization propertyListWithData:fileData options:NSPropertyListImmutable format:NULL error:NULL];
+    if (![file isKindOfClass:[NSDictionary class]])
+        return nil;
+
+    NSData *data = file[BDBResponseCacheFileDataKey];
+    id responseObject = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL] : nil;
+    if (!responseObject)
+    {
+        [self removeDiskResponseForKey:key];
+        return nil;
+    }
+
+    [fileURL setResourceValue:[NSDate date] forKey:NSURLContentModificationDateKey error:NULL];
+
+    BDBCachedResponse *cachedResponse = [[BDBCachedResponse alloc] init];
+    cachedResponse.responseObject = responseObject;
+    cachedResponse.data = data;
+    cachedResponse.ETag = file[BDBResponseCacheFileETagKey];
+    cachedResponse.expirationDate = file[BDBResponseCacheFileExpirationKey];
+    return cachedResponse;
+}
+
+#pragma mark Storage
+- (void)storeResponseObject:(id)responseObject ETag:(NSString *)ETag forKey:(NSString *)key endpoint:(NSString *)endpoint
+{
+    NSParameterAssert(key);
+
+    if (![NSJSONSerialization isValidJSONObject:responseObject])
+        return;
+
+    NSTimeInterval timeToLive = [self timeToLiveForEndpoint:endpoint];
+    if (timeToLive <= 0.0)
+        return;
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:responseObject options:0 error:NULL];
+    if (!data)
+        return;
+
+    BDBCachedResponse *cachedResponse = [[BDBCachedResponse alloc] init];
+    cachedResponse.responseObject = responseObject;
+    cachedResponse.data = data;
+    cachedResponse.ETag = ETag;
+    cachedResponse.expirationDate = [NSDate dateWithTimeIntervalSinceNow:timeToLive];
+
+    dispatch_async(_queue, ^{
+        [self addMemoryResponse:cachedResponse forKey:key];
+    });
+    dispatch_async(_ioQueue, ^{
+        [self writeResponse:cachedResponse toDiskForKey:key];
+    });
+}
+
+- (void)refreshCachedResponse:(BDBCachedResponse *)cachedResponse forKey:(NSString *)key endpoint:(NSString *)endpoint
+{
+    NSParameterAssert(cachedResponse);
+    NSParameterAssert(key);
+
+    BDBCachedResponse *refreshedResponse = [[BDBCachedResponse alloc] init];
+    refreshedResponse.responseObject = cachedResponse.responseObject;
+    refreshedResponse.data = cachedResponse.data;
+    refreshedResponse.ETag = cachedResponse.ETag;
+    refreshedResponse.expirationDate = [NSDate dateWithTimeIntervalSinceNow:[self timeToLiveForEndpoint:endpoint]];
+
+    dispatch_async(_queue, ^{
+        [self addMemoryResponse:refreshedResponse forKey:key];
+    });
+    dispatch_async(_ioQueue, ^{
+        [self writeResponse:refreshedResponse toDiskForKey:key];
+    });
+}
+
+- (void)removeResponseForKey:(NSString *)key
+{
+    NSParameterAssert(key);
+
+    dispatch_async(_queue, ^{
+        [self removeMemoryResponseForKey:key];
+    });
+    dispatch_async(_ioQueue, ^{
+        [self removeDiskResponseForKey:key];
+    });
+}
+
+- (void)removeDiskResponseForKey:(NSString *)key
+{
+    if (!self.directoryURL)
+        return;
+
+    NSURL *fileURL = [self fileURLForKey:key];
+    NSNumber *fileSize = nil;
+    [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+    if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL])
+        _currentDiskUsage -= MIN(_currentDiskUsage, fileSize.unsignedIntegerValue);
+}
+
+- (void)removeAllResponses
+{
+    dispatch_async(_queue, ^{
+        [_memoryResponses removeAllObjects];
+        [_memoryKeys removeAllObjects];
+        _currentMemoryUsage = 0;
+    });
+
+    dispatch_async(_ioQueue, ^{
+        if (!self.directoryURL)
+            return;
+
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        for (NSURL *fileURL in [fileManager contentsOfDirectoryAtURL:self.directoryURL includingPropertiesForKeys:nil options:0 error:NULL])
+            [fileManager removeItemAtURL:fileURL error:NULL];
+        _currentDiskUsage = 0;
+    });
+}
+
+- (void)writeResponse:(BDBCachedResponse *)cachedResponse toDiskForKey:(NSString *)key
+{
+    if (!self.directoryURL || cachedResponse.cost > self.diskCapacity)
+        return;
+
+    NSMutableDictionary *file = [NSMutableDictionary dictionary];
+    file[BDBResponseCacheFileDataKey] = cachedResponse.data;
+    file[BDBResponseCacheFileExpirationKey] = cachedResponse.expirationDate;
+    if (cachedResponse.ETag)
+        file[BDBResponseCacheFileETagKey] = cachedResponse.ETag;
+
+    NSData *fileData = [NSPropertyListSerialization dataWithPropertyList:file format:NSPropertyListBinaryFormat_v1_0 options:0 error:NULL];
+    if (!fileData)
+        return;
+
+    NSURL *fileURL = [self fileURLForKey:key];
+    NSNumber *previousSize = nil;
+    [fileURL getResourceValue:&previousSize forKey:NSURLFileSizeKey error:NULL];
+
+    if ([fileData writeToURL:fileURL atomically:YES])
+    {
+        _currentDiskUsage -= MIN(_currentDiskUsage, previousSize.unsignedIntegerValue);
+        _currentDiskUsage += fileData.length;
+        [self trimDisk];
+    }
+}
+
+- (void)addMemoryResponse:(BDBCachedResponse *)cachedResponse forKey:(NSString *)key
+{
+    [self removeMemoryResponseForKey:key];
+
+    if (cachedResponse.cost > self.memoryCapacity)
+        return;
+
+    _memoryResponses[key] = cachedResponse;
+    [_memoryKeys addObject:key];
+    _currentMemoryUsage += cachedResponse.cost;
+    [self trimMemory];
+}
+
+- (void)removeMemoryResponseForKey:(NSString *)key
+{
+    BDBCachedResponse *cachedResponse = _memoryResponses[key];
+    if (!cachedResponse)
+        return;
+
+    _currentMemoryUsage -= MIN(_currentMemoryUsage, cachedResponse.cost);
+    [_memoryResponses removeObjectForKey:key];
+    [_memoryKeys removeObject:key];
+}
+
+#pragma mark Eviction
+- (void)trimMemory
+{
+    while (_currentMemoryUsage > _memoryCapacity && _memoryKeys.count > 0)
+        [self removeMemoryResponseForKey:_memoryKeys.firstObject];
+}
+
+- (void)trimDisk
+{
+    if (!self.directoryURL || _currentDiskUsage <= _diskCapacity)
+        return;
+
+    NSArray *propertyKeys = @[NSURLContentModificationDateKey, NSURLFileSizeKey];
+    NSArray *fileURLs = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:self.directoryURL
+                                                      includingPropertiesForKeys:propertyKeys
+                                                                         options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                           error:NULL];
+    fileURLs = [fileURLs sortedArrayUsingComparator:^NSComparisonResult(NSURL *URL1, NSURL *URL2) {
+        NSDate *date1 = nil, *date2 = nil;
+        [URL1 getResourceValue:&date1 forKey:NSURLContentModificationDateKey error:NULL];
+        [URL2 getResourceValue:&date2 forKey:NSURLContentModificationDateKey error:NULL];
+        return [date1 compare:date2];
+    }];
+
+    for (NSURL *fileURL in fileURLs)
+    {
+        if (_currentDiskUsage <= _diskCapacity)
+            break;
+
+        NSNumber *fileSize = nil;
+        [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:NULL];
+        if ([[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL])
+            _currentDiskUsage -= MIN(_currentDiskUsage, fileSize.unsignedIntegerValue);
+    }
+}
+
+#pragma mark Statistics
+- (NSUInteger)hitCount
+{
+    __block NSUInteger hitCount = 0;
+    dispatch_sync(_queue, ^{
+        hitCount = _hitCount;
+    });
+    return hitCount;
+}
+
+- (NSUInteger)staleHitCount
+{
+    __block NSUInteger staleHitCount = 0;
+    dispatch_sync(_queue, ^{
+        staleHitCount = _staleHitCount;
+    });
+    return staleHitCount;
+}
+
+- (NSUInteger)missCount
+{
+    __block NSUInteger missCount = 0;
+    dispatch_sync(_queue, ^{
+        missCount = _missCount;
+    });
+    return missCount;
+}
+
+- (NSUInteger)notModifiedCount
+{
+    __block NSUInteger notModifiedCount = 0;
+    dispatch_sync(_queue, ^{
+        notModifiedCount = _notModifiedCount;
+    });
+    return notModifiedCount;
+}
+
+- (NSUInteger)currentMemoryUsage
+{
+    __block NSUInteger currentMemoryUsage = 0;
+    dispatch_sync(_queue, ^{
+        currentMemoryUsage = _currentMemoryUsage;
+    });
+    return currentMemoryUsage;
+}
+
+- (NSUInteger)currentDiskUsage
+{
+    __block NSUInteger currentDiskUsage = 0;
+    dispatch_sync(_ioQueue, ^{
+        currentDiskUsage = _currentDiskUsage;
+    });
+    return currentDiskUsage;
+}
+
+- (void)recordNotModified
+{
+    dispatch_async(_queue, ^{
+        _notModifiedCount++;
+    });
+}
+
+- (void)resetStatistics
+{
+    dispatch_async(_queue, ^{
+        _hitCount = 0;
+        _staleHitCount = 0;
+        _missCount = 0;
+        _notModifiedCount = 0;
+    });
+}
+
+@end
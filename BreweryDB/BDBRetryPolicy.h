@@ -0,0 +1,131 @@
+//
+//  BDBRetryPolicy.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBRetryPolicy : NSObject
+
+#pragma mark Retries
+/**
+ *  Retries after the first attempt. Only transient network errors and 429,
+ *  500, 502, 503 and 504 responses are retried. Defaults to 2.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSUInteger maximumRetries;
+
+/**
+ *  Retries wait a random time up to baseRetryDelay * 2^retry, capped at
+ *  maximumRetryDelay. Defaults to 0.25 and 8 seconds.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSTimeInterval baseRetryDelay;
+@property (atomic, assign) NSTimeInterval maximumRetryDelay;
+
+/**
+ *  Longest Retry-After the policy waits out. A response asking for a longer
+ *  wait fails instead of being retried. Defaults to 30 seconds.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSTimeInterval maximumRetryAfter;
+
+/**
+ *  How long to wait before the next attempt.
+ *
+ *  @param retry    Number of retries made so far.
+ *  @param response The failed attempt's response, if any.
+ *  @param error    The failed attempt's error.
+ *
+ *  @return The delay, or a negative value if the attempt should not be retried.
+ *
+ *  @since 1.1.0
+ */
+- (NSTimeInterval)delayBeforeRetry:(NSUInteger)retry response:(NSHTTPURLResponse *)response error:(NSError *)error;
+
+#pragma mark Hedging
+/**
+ *  Send a duplicate of a request that is still running after its endpoint's
+ *  hedge delay; the first response wins and the other request is cancelled.
+ *  Defaults to YES.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign, getter = isHedgingEnabled) BOOL hedgingEnabled;
+
+/**
+ *  Percentile of an endpoint's recent latencies used as its hedge delay.
+ *  Defaults to 95.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) double hedgePercentile;
+
+/**
+ *  Hedge delay for endpoints with fewer than minimumSampleCount recent
+ *  latencies. Defaults to 1 second and 20 samples.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) NSTimeInterval defaultHedgeDelay;
+@property (atomic, assign) NSUInteger minimumSampleCount;
+
+/**
+ *  Most hedges sent, as a fraction of requests, so a slow API is not sent
+ *  twice the traffic. Defaults to 0.1.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, assign) double maximumHedgeFraction;
+
+/**
+ *  The delay after which a request to the endpoint is hedged, or a negative
+ *  value if hedging is disabled or over budget.
+ *
+ *  @param endpoint First path component of the request, e.g. "beers".
+ *
+ *  @since 1.1.0
+ */
+- (NSTimeInterval)hedgeDelayForEndpoint:(NSString *)endpoint;
+
+/**
+ *  Claim a hedge from the budget.
+ *
+ *  @return NO if the budget is spent.
+ *
+ *  @since 1.1.0
+ */
+- (BOOL)beginHedge;
+
+/**
+ *  Record the latency of an attempt that succeeded, from its start to its
+ *  response. The latest 100 per endpoint are kept.
+ *
+ *  @since 1.1.0
+ */
+- (void)recordLatency:(NSTimeInterval)latency forEndpoint:(NSString *)endpoint;
+
+@end
@@ -0,0 +1,218 @@
+//
+//  BDBRetryPolicy.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBRetryPolicy.h"
+
+
+static NSUInteger const BDBRetryPolicyLatencyWindowSize = 100;
+static NSUInteger const BDBRetryPolicyHedgeBudgetWindow = 1000;
+
+static int BDBRetryPolicyCompareValues(const void *a, const void *b)
+{
+    NSTimeInterval lhs = *(const NSTimeInterval *)a;
+    NSTimeInterval rhs = *(const NSTimeInterval *)b;
+    return (lhs < rhs) ? -1 : (lhs > rhs) ? 1 : 0;
+}
+
+static double BDBRetryPolicyRandom(void)
+{
+    return (double)arc4random_uniform(UINT32_MAX) / (double)UINT32_MAX;
+}
+
+static BOOL BDBRetryPolicyIsTransientError(NSError *error)
+{
+    if (![error.domain isEqualToString:NSURLErrorDomain])
+        return NO;
+
+    switch (error.code)
+    {
+        case NSURLErrorTimedOut:
+        case NSURLErrorCannotFindHost:
+        case NSURLErrorCannotConnectToHost:
+        case NSURLErrorNetworkConnectionLost:
+        case NSURLErrorDNSLookupFailed:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+static BOOL BDBRetryPolicyIsTransientStatus(NSInteger statusCode)
+{
+    return statusCode == 429 || statusCode == 500 || statusCode == 502 || statusCode == 503 || statusCode == 504;
+}
+
+// Retry-After is either a number of seconds or an HTTP date; returns a negative value if absent or unreadable.
+static NSTimeInterval BDBRetryPolicyRetryAfter(NSHTTPURLResponse *response)
+{
+    NSString *value = [response.allHeaderFields[@"Retry-After"] description];
+    value = [value stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    if (value.length == 0)
+        return -1.0;
+
+    NSScanner *scanner = [NSScanner scannerWithString:value];
+    NSInteger seconds = 0;
+    if ([scanner scanInteger:&seconds] && scanner.isAtEnd)
+        return MAX(seconds, 0);
+
+    static NSDateFormatter *formatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneWithAbbreviation:@"GMT"];
+        formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+    });
+
+    NSDate *date = nil;
+    @synchronized(formatter)
+    {
+        date = [formatter dateFromString:value];
+    }
+    return date ? MAX(date.timeIntervalSinceNow, 0.0) : -1.0;
+}
+
+
+#pragma mark -
+@interface BDBRetryPolicy ()
+{
+    NSMutableDictionary *_latencies;
+    NSUInteger _requestCount;
+    NSUInteger _hedgeCount;
+}
+
+@end
+
+
+#pragma mark -
+@implementation BDBRetryPolicy
+
+- (id)init
+{
+    self = [super init];
+    if (self)
+    {
+        _maximumRetries = 2;
+        _baseRetryDelay = 0.25;
+        _maximumRetryDelay = 8.0;
+        _maximumRetryAfter = 30.0;
+        _hedgingEnabled = YES;
+        _hedgePercentile = 95.0;
+        _defaultHedgeDelay = 1.0;
+        _minimumSampleCount = 20;
+        _maximumHedgeFraction = 0.1;
+        _latencies = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Retries
+
+- (NSTimeInterval)delayBeforeRetry:(NSUInteger)retry response:(NSHTTPURLResponse *)response error:(NSError *)error
+{
+    if (retry >= self.maximumRetries)
+        return -1.0;
+
+    BOOL transient = (response && [response isKindOfClass:[NSHTTPURLResponse class]])
+        ? BDBRetryPolicyIsTransientStatus(response.statusCode)
+        : BDBRetryPolicyIsTransientError(error);
+    if (!transient)
+        return -1.0;
+
+    // Full jitter: a random delay up to the exponential ceiling spreads out clients that failed together.
+    NSTimeInterval ceiling = MIN(self.maximumRetryDelay, ldexp(self.baseRetryDelay, (int)MIN(retry, 30)));
+    NSTimeInterval delay = BDBRetryPolicyRandom() * ceiling;
+
+    NSTimeInterval retryAfter = BDBRetryPolicyRetryAfter(response);
+    if (retryAfter > self.maximumRetryAfter)
+        return -1.0;
+    return MAX(delay, retryAfter);
+}
+
+#pragma mark Hedging
+
+- (NSTimeInterval)hedgeDelayForEndpoint:(NSString *)endpoint
+{
+    if (!self.hedgingEnabled)
+        return -1.0;
+
+    double percentile = self.hedgePercentile;
+    NSUInteger minimumSampleCount = MAX(self.minimumSampleCount, 1);
+    NSTimeInterval delay = self.defaultHedgeDelay;
+
+    @synchronized(self)
+    {
+        // Every request asks once, so this also counts requests for the hedge budget.
+        if (++_requestCount > BDBRetryPolicyHedgeBudgetWindow)
+        {
+            _requestCount /= 2;
+            _hedgeCount /= 2;
+        }
+
+        NSMutableArray *latencies = _latencies[endpoint ?: @""];
+        NSUInteger count = latencies.count;
+        if (count >= minimumSampleCount)
+        {
+            NSTimeInterval *values = malloc(count * sizeof(NSTimeInterval));
+            for (NSUInteger index = 0; index < count; index++)
+                values[index] = [latencies[index] doubleValue];
+            qsort(values, count, sizeof(NSTimeInterval), BDBRetryPolicyCompareValues);
+
+            NSUInteger rank = (NSUInteger)ceil(MIN(MAX(percentile, 0.0), 100.0) / 100.0 * count);
+            delay = values[MIN(MAX(rank, 1), count) - 1];
+            free(values);
+        }
+    }
+    return delay;
+}
+
+- (BOOL)beginHedge
+{
+    double fraction = self.maximumHedgeFraction;
+    @synchronized(self)
+    {
+        if (_hedgeCount + 1 > fraction * _requestCount)
+            return NO;
+        _hedgeCount++;
+    }
+    return YES;
+}
+
+- (void)recordLatency:(NSTimeInterval)latency forEndpoint:(NSString *)endpoint
+{
+    if (latency < 0.0)
+        return;
+
+    @synchronized(self)
+    {
+        NSString *key = endpoint ?: @"";
+        NSMutableArray *latencies = _latencies[key];
+        if (!latencies)
+            _latencies[key] = latencies = [NSMutableArray arrayWithCapacity:BDBRetryPolicyLatencyWindowSize];
+        if (latencies.count >= BDBRetryPolicyLatencyWindowSize)
+            [latencies removeObjectAtIndex:0];
+        [latencies addObject:@(latency)];
+    }
+}
+
+@end
@@ -0,0 +1,71 @@
+//
+//  BDBSearchIndex.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBSearchIndex : NSObject
+
+#pragma mark Indexing
+/**
+ *  Add a document, replacing any earlier document with the same type and identifier.
+ *  Terms in the name weigh more than terms in the text.
+ *
+ *  @param identifier Document identifier, e.g. a beer ID.
+ *  @param type       Document type, matching the search API's type parameter ("beer", "brewery", "guild").
+ *  @param name       Name to index.
+ *  @param text       Longer text to index, e.g. a description. May be nil.
+ *
+ *  @since 1.1.0
+ */
+- (void)addDocumentWithIdentifier:(NSString *)identifier type:(NSString *)type name:(NSString *)name text:(NSString *)text;
+
+- (void)removeDocumentWithIdentifier:(NSString *)identifier type:(NSString *)type;
+- (void)removeAllDocuments;
+
+@property (nonatomic, readonly) NSUInteger documentCount;
+
+#pragma mark Searching
+/**
+ *  Rank documents matching every term of a query. Query terms match indexed
+ *  terms exactly, as a prefix, or within one edit for terms of four or more
+ *  characters, in decreasing order of relevance.
+ *
+ *  @param query Free text query.
+ *  @param type  Document type to restrict results to, or nil for every type.
+ *
+ *  @return Two-element arrays of document type and identifier, best match first.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)documentsMatchingQuery:(NSString *)query type:(NSString *)type;
+
+/**
+ *  Split text into the lowercase, diacritic-folded terms the index stores.
+ *
+ *  @since 1.1.0
+ */
++ (NSArray *)termsInString:(NSString *)string;
+
+@end
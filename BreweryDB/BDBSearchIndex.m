@@ -0,0 +1,324 @@
+//
+//  BDBSearchIndex.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBSearchIndex.h"
+
+
+static double const BDBSearchNameWeight = 3.0;
+static double const BDBSearchTextWeight = 1.0;
+static double const BDBSearchPrefixFactor = 0.6;
+static double const BDBSearchTypoFactor = 0.4;
+static NSUInteger const BDBSearchTypoMinimumLength = 4;
+
+static NSString *BDBSearchDocumentKey(NSString *type, NSString *identifier)
+{
+    return [NSString stringWithFormat:@"%@\x1F%@", type, identifier];
+}
+
+// Damerau-Levenshtein distance of at most one: one insertion, deletion, substitution or adjacent swap.
+static BOOL BDBSearchTermsWithinOneEdit(NSString *a, NSString *b)
+{
+    if (a.length > b.length)
+    {
+        NSString *swap = a;
+        a = b;
+        b = swap;
+    }
+    if (b.length - a.length > 1)
+        return NO;
+
+    NSUInteger i = 0;
+    while (i < a.length && [a characterAtIndex:i] == [b characterAtIndex:i])
+        i++;
+    if (i == a.length)
+        return YES;
+
+    if (a.length < b.length)
+        return [[a substringFromIndex:i] isEqualToString:[b substringFromIndex:i + 1]];
+    if ([[a substringFromIndex:i + 1] isEqualToString:[b substringFromIndex:i + 1]])
+        return YES;
+    return (i + 1 < a.length &&
+            [a characterAtIndex:i] == [b characterAtIndex:i + 1] &&
+            [a characterAtIndex:i + 1] == [b characterAtIndex:i] &&
+            [[a substringFromIndex:i + 2] isEqualToString:[b substringFromIndex:i + 2]]);
+}
+
+
+#pragma mark -
+@interface BDBSearchDocument : NSObject
+
+@property (nonatomic, copy) NSString *type;
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSArray *terms;
+
+@end
+
+
+#pragma mark -
+@implementation BDBSearchDocument
+@end
+
+
+#pragma mark -
+@interface BDBSearchIndex ()
+{
+    NSMutableDictionary *_postings;     // term -> document key -> weight
+    NSMutableDictionary *_documents;    // document key -> BDBSearchDocument
+    NSArray *_sortedTerms;              // rebuilt lazily after the vocabulary changes
+}
+
+- (void)removeDocumentForKey:(NSString *)key;
+- (NSArray *)sortedTerms;
+- (NSDictionary *)matchingTermsForQueryTerm:(NSString *)queryTerm;
+
+@end
+
+
+#pragma mark -
+@implementation BDBSearchIndex
+
+- (id)init
+{
+    self = [super init];
+    if (self)
+    {
+        _postings = [NSMutableDictionary dictionary];
+        _documents = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
++ (NSArray *)termsInString:(NSString *)string
+{
+    if (![string isKindOfClass:[NSString class]])
+        return @[];
+
+    NSString *folded = [string stringByFoldingWithOptions:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch locale:nil];
+    NSMutableArray *terms = [NSMutableArray array];
+    for (NSString *component in [folded componentsSeparatedByCharactersInSet:[[NSCharacterSet alphanumericCharacterSet] invertedSet]])
+    {
+        if (component.length > 0)
+            [terms addObject:component];
+    }
+    return terms;
+}
+
+#pragma mark Indexing
+- (void)addDocumentWithIdentifier:(NSString *)identifier type:(NSString *)type name:(NSString *)name text:(NSString *)text
+{
+    NSParameterAssert(identifier);
+    NSParameterAssert(type);
+
+    NSMutableDictionary *weights = [NSMutableDictionary dictionary];
+    for (NSString *term in [[self class] termsInString:name])
+        weights[term] = @([weights[term] doubleValue] + BDBSearchNameWeight);
+    for (NSString *term in [[self class] termsInString:text])
+        weights[term] = @([weights[term] doubleValue] + BDBSearchTextWeight);
+
+    BDBSearchDocument *document = [[BDBSearchDocument alloc] init];
+    document.type = type;
+    document.identifier = identifier;
+    document.name = [name isKindOfClass:[NSString class]] ? name : @"";
+    document.terms = weights.allKeys;
+
+    NSString *key = BDBSearchDocumentKey(type, identifier);
+    @synchronized(self)
+    {
+        [self removeDocumentForKey:key];
+        _documents[key] = document;
+
+        [weights enumerateKeysAndObjectsUsingBlock:^(NSString *term, NSNumber *weight, BOOL *stop) {
+            NSMutableDictionary *postings = _postings[term];
+            if (!postings)
+            {
+                postings = [NSMutableDictionary dictionary];
+                _postings[term] = postings;
+                _sortedTerms = nil;
+            }
+            postings[key] = weight;
+        }];
+    }
+}
+
+- (void)removeDocumentWithIdentifier:(NSString *)identifier type:(NSString *)type
+{
+    @synchronized(self)
+    {
+        [self removeDocumentForKey:BDBSearchDocumentKey(type, identifier)];
+    }
+}
+
+- (void)removeDocumentForKey:(NSString *)key
+{
+    BDBSearchDocument *document = _documents[key];
+    if (!document)
+        return;
+
+    for (NSString *term in document.terms)
+    {
+        NSMutableDictionary *postings = _postings[term];
+        [postings removeObjectForKey:key];
+        if (postings.count == 0)
+        {
+            [_postings removeObjectForKey:term];
+            _sortedTerms = nil;
+        }
+    }
+    [_documents removeObjectForKey:key];
+}
+
+- (void)removeAllDocuments
+{
+    @synchronized(self)
+    {
+        [_postings removeAllObjects];
+        [_documents removeAllObjects];
+        _sortedTerms = nil;
+    }
+}
+
+- (NSUInteger)documentCount
+{
+    @synchronized(self)
+    {
+        return _documents.count;
+    }
+}
+
+#pragma mark Searching
+- (NSArray *)sortedTerms
+{
+    if (!_sortedTerms)
+    {
+        _sortedTerms = [_postings.allKeys sortedArrayUsingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+            return [a compare:b options:NSLiteralSearch];
+        }];
+    }
+    return _sortedTerms;
+}
+
+- (NSDictionary *)matchingTermsForQueryTerm:(NSString *)queryTerm
+{
+    NSMutableDictionary *matches = [NSMutableDictionary dictionary];
+    if (_postings[queryTerm])
+        matches[queryTerm] = @1.0;
+
+    // Terms sharing a prefix sort next to each other, so prefix matches are one contiguous run.
+    NSArray *sortedTerms = [self sortedTerms];
+    NSUInteger index = [sortedTerms indexOfObject:queryTerm
+                                    inSortedRange:NSMakeRange(0, sortedTerms.count)
+                                          options:NSBinarySearchingInsertionIndex | NSBinarySearchingFirstEqual
+                                  usingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+                                      return [a compare:b options:NSLiteralSearch];
+                                  }];
+    for (; index < sortedTerms.count && [sortedTerms[index] hasPrefix:queryTerm]; index++)
+    {
+        if (!matches[sortedTerms[index]])
+            matches[sortedTerms[index]] = @(BDBSearchPrefixFactor);
+    }
+
+    // Short terms would match too much with a typo allowed, and exact hits need no correction.
+    if (matches.count == 0 && queryTerm.length >= BDBSearchTypoMinimumLength)
+    {
+        for (NSString *term in sortedTerms)
+        {
+            if (BDBSearchTermsWithinOneEdit(queryTerm, term))
+                matches[term] = @(BDBSearchTypoFactor);
+        }
+    }
+
+    return matches;
+}
+
+- (NSArray *)documentsMatchingQuery:(NSString *)query type:(NSString *)type
+{
+    NSArray *queryTerms = [[self class] termsInString:query];
+    if (queryTerms.count == 0)
+        return @[];
+
+    NSMutableDictionary *scores = nil;
+    NSMutableArray *rankedDocuments = [NSMutableArray array];
+    @synchronized(self)
+    {
+        double documentCount = _documents.count;
+        for (NSString *queryTerm in queryTerms)
+        {
+            // Each query term scores a document by its best matching indexed term.
+            NSMutableDictionary *termScores = [NSMutableDictionary dictionary];
+            [[self matchingTermsForQueryTerm:queryTerm] enumerateKeysAndObjectsUsingBlock:^(NSString *term, NSNumber *factor, BOOL *stop) {
+                NSDictionary *postings = _postings[term];
+                double inverseDocumentFrequency = log(1.0 + documentCount / postings.count);
+                [postings enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSNumber *weight, BOOL *stop) {
+                    double score = factor.doubleValue * log1p(weight.doubleValue) * inverseDocumentFrequency;
+                    if (score > [termScores[key] doubleValue])
+                        termScores[key] = @(score);
+                }];
+            }];
+
+            // Documents must match every query term.
+            if (!scores)
+            {
+                scores = termScores;
+            }
+            else
+            {
+                for (NSString *key in scores.allKeys)
+                {
+                    NSNumber *termScore = termScores[key];
+                    if (termScore)
+                        scores[key] = @([scores[key] doubleValue] + termScore.doubleValue);
+                    else
+                        [scores removeObjectForKey:key];
+                }
+            }
+
+            if (scores.count == 0)
+                return @[];
+        }
+
+        for (NSString *key in scores)
+        {
+            BDBSearchDocument *document = _documents[key];
+            if (!type || [document.type isEqualToString:type])
+                [rankedDocuments addObject:@[scores[key], document]];
+        }
+    }
+
+    [rankedDocuments sortUsingComparator:^NSComparisonResult(NSArray *a, NSArray *b) {
+        NSComparisonResult order = [b[0] compare:a[0]];
+        if (order != NSOrderedSame)
+            return order;
+        return [((BDBSearchDocument *)a[1]).name localizedCaseInsensitiveCompare:((BDBSearchDocument *)b[1]).name];
+    }];
+
+    NSMutableArray *results = [NSMutableArray arrayWithCapacity:rankedDocuments.count];
+    for (NSArray *rankedDocument in rankedDocuments)
+    {
+        BDBSearchDocument *document = rankedDocument[1];
+        [results addObject:@[document.type, document.identifier]];
+    }
+    return results;
+}
+
+@end
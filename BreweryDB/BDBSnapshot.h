@@ -0,0 +1,103 @@
+//
+//  BDBSnapshot.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBSnapshot : NSObject
+
+#pragma mark Writing
+/**
+ *  Encode model objects, e.g. the results of +[BreweryDB fetchAllStylesWithParameters:...],
+ *  into a compact binary snapshot. Every object must be of the same model class.
+ *
+ *  @param objects Objects responding to -dictionaryRepresentation.
+ *  @param error   Set to BDB_ERRNO_BAD_SNAPSHOT if the objects cannot be encoded.
+ *
+ *  @return The snapshot bytes, or nil on error.
+ *
+ *  @since 1.1.0
+ */
++ (NSData *)dataWithObjects:(NSArray *)objects error:(NSError *__autoreleasing *)error;
+
+/**
+ *  Encode model objects and write the snapshot atomically to URL.
+ *
+ *  @since 1.1.0
+ */
++ (BOOL)writeObjects:(NSArray *)objects toURL:(NSURL *)URL error:(NSError *__autoreleasing *)error;
+
+#pragma mark Reading
+/**
+ *  Memory-map a snapshot file. Objects are built from the mapped bytes only
+ *  when they are first accessed.
+ *
+ *  @param URL   File URL of the snapshot.
+ *  @param error Set if the file cannot be mapped or is not a valid snapshot.
+ *
+ *  @return The snapshot, or nil on error.
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)snapshotWithContentsOfURL:(NSURL *)URL error:(NSError *__autoreleasing *)error;
+
+/**
+ *  Open a snapshot shipped as a bundle resource with the "bdbsnapshot" extension.
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)snapshotNamed:(NSString *)name inBundle:(NSBundle *)bundle error:(NSError *__autoreleasing *)error;
+
+/**
+ *  Open a snapshot held in memory. The data is read in place, not copied.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithData:(NSData *)data error:(NSError *__autoreleasing *)error;
+
+@property (nonatomic, readonly) Class modelClass;
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  The object at index, built on first access and kept for later calls.
+ *
+ *  @since 1.1.0
+ */
+- (id)objectAtIndex:(NSUInteger)index;
+
+/**
+ *  The API dictionary for the object at index, rebuilt from the columns.
+ *
+ *  @since 1.1.0
+ */
+- (NSDictionary *)dictionaryAtIndex:(NSUInteger)index;
+
+/**
+ *  Every object, as an array that builds each element when it is first read.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSArray *objects;
+
+@end
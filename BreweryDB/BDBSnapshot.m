@@ -0,0 +1,497 @@
+//
+//  BDBSnapshot.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <libkern/OSByteOrder.h>
+
+#import "BDBSnapshot.h"
+#import "BDBErrors.h"
+#import "BDBModelCoercion.h"
+
+
+//  Layout (all integers little-endian):
+//
+//  header             BDBSnapshotHeader
+//  columns            BDBSnapshotColumn[columnCount]
+//  column data        rowCount values per column, each column 8-byte aligned
+//                       string: uint32 string index, UINT32_MAX when absent
+//                       number: float64, NaN when absent
+//                       json:   uint32 index of a one-element JSON array
+//  string offsets     uint32[stringCount + 1], relative to the string data
+//  string data        deduplicated UTF-8 bytes
+
+static char const BDBSnapshotMagic[4] = {'B', 'D', 'B', 'S'};
+static uint32_t const BDBSnapshotVersion = 1;
+static uint32_t const BDBSnapshotAbsent = UINT32_MAX;
+static NSString * const BDBSnapshotResourceExtension = @"bdbsnapshot";
+
+typedef NS_ENUM(uint32_t, BDBSnapshotColumnKind)
+{
+    BDBSnapshotColumnKindString = 1,
+    BDBSnapshotColumnKindNumber = 2,
+    BDBSnapshotColumnKindJSON   = 3
+};
+
+typedef struct
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t rowCount;
+    uint32_t columnCount;
+    uint32_t stringCount;
+    uint32_t classNameIndex;
+    uint32_t stringOffsetsOffset;
+    uint32_t stringDataOffset;
+} BDBSnapshotHeader;
+
+typedef struct
+{
+    uint32_t keyIndex;
+    uint32_t kind;
+    uint32_t dataOffset;
+    uint32_t reserved;
+} BDBSnapshotColumn;
+
+
+static NSError *BDBSnapshotError(void)
+{
+    return [NSError errorWithDomain:BreweryDBErrorDomain
+                               code:BDB_ERRNO_BAD_SNAPSHOT
+                           userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_BAD_SNAPSHOT}];
+}
+
+static BOOL BDBSnapshotIsBoolean(id value)
+{
+    return [value isKindOfClass:[NSNumber class]] && CFGetTypeID((__bridge CFTypeRef)value) == CFBooleanGetTypeID();
+}
+
+static void BDBAppendUInt32(NSMutableData *data, uint32_t value)
+{
+    value = OSSwapHostToLittleInt32(value);
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void BDBAppendDouble(NSMutableData *data, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    bits = OSSwapHostToLittleInt64(bits);
+    [data appendBytes:&bits length:sizeof(bits)];
+}
+
+static void BDBAlign(NSMutableData *data)
+{
+    NSUInteger padding = (8 - data.length % 8) % 8;
+    [data increaseLengthBy:padding];
+}
+
+
+#pragma mark -
+@interface BDBSnapshotArray : NSArray
+
+- (id)initWithSnapshot:(BDBSnapshot *)snapshot;
+
+@end
+
+
+#pragma mark -
+@implementation BDBSnapshot
+{
+    NSData *_data;
+    const uint8_t *_bytes;
+    BDBSnapshotHeader _header;
+    const BDBSnapshotColumn *_columns;
+    NSArray *_keys;
+    NSPointerArray *_strings;
+    NSPointerArray *_objects;
+}
+
+#pragma mark Writing
++ (NSData *)dataWithObjects:(NSArray *)objects error:(NSError *__autoreleasing *)error
+{
+    Class modelClass = [objects.firstObject class];
+    NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:objects.count];
+    NSMutableSet *keySet = [NSMutableSet set];
+    for (id object in objects)
+    {
+        if ([object class] != modelClass || ![object respondsToSelector:@selector(dictionaryRepresentation)])
+        {
+            if (error)
+                *error = BDBSnapshotError();
+            return nil;
+        }
+
+        NSDictionary *dictionary = [(id<BDBDictionaryRepresentable>)object dictionaryRepresentation];
+        [dictionaries addObject:dictionary];
+        [keySet addObjectsFromArray:dictionary.allKeys];
+    }
+
+    NSArray *keys = [keySet.allObjects sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray *strings = [NSMutableArray array];
+    NSMutableDictionary *stringIndexes = [NSMutableDictionary dictionary];
+    uint32_t (^intern)(NSString *) = ^uint32_t (NSString *string) {
+        NSNumber *index = stringIndexes[string];
+        if (!index)
+        {
+            index = @(strings.count);
+            stringIndexes[string] = index;
+            [strings addObject:string];
+        }
+        return index.unsignedIntValue;
+    };
+
+    uint32_t classNameIndex = modelClass ? intern(NSStringFromClass(modelClass)) : BDBSnapshotAbsent;
+
+    NSMutableData *columnData = [NSMutableData data];
+    NSMutableData *columns = [NSMutableData data];
+    NSUInteger columnsStart = sizeof(BDBSnapshotHeader) + keys.count * sizeof(BDBSnapshotColumn);
+    for (NSString *key in keys)
+    {
+        BOOL allStrings = YES;
+        BOOL allNumbers = YES;
+        for (NSDictionary *dictionary in dictionaries)
+        {
+            id value = dictionary[key];
+            if (!value)
+                continue;
+            allStrings = allStrings && [value isKindOfClass:[NSString class]];
+            allNumbers = allNumbers && [value isKindOfClass:[NSNumber class]] && !BDBSnapshotIsBoolean(value);
+        }
+
+        BDBSnapshotColumnKind kind = allStrings ? BDBSnapshotColumnKindString : (allNumbers ? BDBSnapshotColumnKindNumber : BDBSnapshotColumnKindJSON);
+        BDBAlign(columnData);
+        BDBAppendUInt32(columns, intern(key));
+        BDBAppendUInt32(columns, kind);
+        BDBAppendUInt32(columns, (uint32_t)(columnsStart + columnData.length));
+        BDBAppendUInt32(columns, 0);
+
+        for (NSDictionary *dictionary in dictionaries)
+        {
+            id value = dictionary[key];
+            if (kind == BDBSnapshotColumnKindNumber)
+            {
+                BDBAppendDouble(columnData, value ? [value doubleValue] : NAN);
+            }
+            else if (!value)
+            {
+                BDBAppendUInt32(columnData, BDBSnapshotAbsent);
+            }
+            else if (kind == BDBSnapshotColumnKindString)
+            {
+                BDBAppendUInt32(columnData, intern(value));
+            }
+            else
+            {
+                NSData *JSON = [NSJSONSerialization dataWithJSONObject:@[value] options:0 error:error];
+                if (!JSON)
+                    return nil;
+                BDBAppendUInt32(columnData, intern([[NSString alloc] initWithData:JSON encoding:NSUTF8StringEncoding]));
+            }
+        }
+    }
+    BDBAlign(columnData);
+
+    NSMutableData *stringOffsets = [NSMutableData dataWithCapacity:(strings.count + 1) * sizeof(uint32_t)];
+    NSMutableData *stringData = [NSMutableData data];
+    for (NSString *string in strings)
+    {
+        BDBAppendUInt32(stringOffsets, (uint32_t)stringData.length);
+        [stringData appendData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+    }
+    BDBAppendUInt32(stringOffsets, (uint32_t)stringData.length);
+
+    uint32_t stringOffsetsOffset = (uint32_t)(columnsStart + columnData.length);
+    if ((uint64_t)stringOffsetsOffset + stringOffsets.length + stringData.length > UINT32_MAX)
+    {
+        if (error)
+            *error = BDBSnapshotError();
+        return nil;
+    }
+
+    BDBSnapshotHeader header;
+    memcpy(header.magic, BDBSnapshotMagic, sizeof(header.magic));
+    header.version = OSSwapHostToLittleInt32(BDBSnapshotVersion);
+    header.rowCount = OSSwapHostToLittleInt32((uint32_t)dictionaries.count);
+    header.columnCount = OSSwapHostToLittleInt32((uint32_t)keys.count);
+    header.stringCount = OSSwapHostToLittleInt32((uint32_t)strings.count);
+    header.classNameIndex = OSSwapHostToLittleInt32(classNameIndex);
+    header.stringOffsetsOffset = OSSwapHostToLittleInt32(stringOffsetsOffset);
+    header.stringDataOffset = OSSwapHostToLittleInt32((uint32_t)(stringOffsetsOffset + stringOffsets.length));
+
+    NSMutableData *data = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+    [data appendData:columns];
+    [data appendData:columnData];
+    [data appendData:stringOffsets];
+    [data appendData:stringData];
+    return data;
+}
+
++ (BOOL)writeObjects:(NSArray *)objects toURL:(NSURL *)URL error:(NSError *__autoreleasing *)error
+{
+    NSData *data = [self dataWithObjects:objects error:error];
+    return data && [data writeToURL:URL options:NSDataWritingAtomic error:error];
+}
+
+#pragma mark Reading
++ (instancetype)snapshotWithContentsOfURL:(NSURL *)URL error:(NSError *__autoreleasing *)error
+{
+    NSData *data = [NSData dataWithContentsOfURL:URL options:NSDataReadingMappedAlways error:error];
+    return data ? [[self alloc] initWithData:data error:error] : nil;
+}
+
++ (instancetype)snapshotNamed:(NSString *)name inBundle:(NSBundle *)bundle error:(NSError *__autoreleasing *)error
+{
+    NSURL *URL = [bundle ?: [NSBundle mainBundle] URLForResource:name withExtension:BDBSnapshotResourceExtension];
+    if (!URL)
+    {
+        if (error)
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileNoSuchFileError userInfo:nil];
+        return nil;
+    }
+    return [self snapshotWithContentsOfURL:URL error:error];
+}
+
+- (id)initWithData:(NSData *)data error:(NSError *__autoreleasing *)error
+{
+    self = [super init];
+    if (self)
+    {
+        _data = data;
+        _bytes = data.bytes;
+        if (![self validate])
+        {
+            if (error)
+                *error = BDBSnapshotError();
+            return nil;
+        }
+
+        _strings = [NSPointerArray strongObjectsPointerArray];
+        _strings.count = _header.stringCount;
+        _objects = [NSPointerArray strongObjectsPointerArray];
+        _objects.count = _header.rowCount;
+
+        NSMutableArray *keys = [NSMutableArray arrayWithCapacity:_header.columnCount];
+        for (uint32_t column = 0; column < _header.columnCount; column++)
+        {
+            NSString *key = [self stringAtIndex:OSSwapLittleToHostInt32(_columns[column].keyIndex)];
+            if (!key)
+            {
+                if (error)
+                    *error = BDBSnapshotError();
+                return nil;
+            }
+            [keys addObject:key];
+        }
+        _keys = keys;
+
+        if (_header.classNameIndex != BDBSnapshotAbsent)
+        {
+            NSString *className = [self stringAtIndex:_header.classNameIndex];
+            _modelClass = className ? NSClassFromString(className) : Nil;
+            if (![_modelClass instancesRespondToSelector:@selector(initWithDictionary:)])
+            {
+                if (error)
+                    *error = BDBSnapshotError();
+                return nil;
+            }
+        }
+    }
+
+    return self;
+}
+
+- (BOOL)validate
+{
+    NSUInteger length = _data.length;
+    if (length < sizeof(BDBSnapshotHeader))
+        return NO;
+
+    memcpy(&_header, _bytes, sizeof(_header));
+    if (memcmp(_header.magic, BDBSnapshotMagic, sizeof(_header.magic)) != 0)
+        return NO;
+
+    _header.version = OSSwapLittleToHostInt32(_header.version);
+    _header.rowCount = OSSwapLittleToHostInt32(_header.rowCount);
+    _header.columnCount = OSSwapLittleToHostInt32(_header.columnCount);
+    _header.stringCount = OSSwapLittleToHostInt32(_header.stringCount);
+    _header.classNameIndex = OSSwapLittleToHostInt32(_header.classNameIndex);
+    _header.stringOffsetsOffset = OSSwapLittleToHostInt32(_header.stringOffsetsOffset);
+    _header.stringDataOffset = OSSwapLittleToHostInt32(_header.stringDataOffset);
+    if (_header.version != BDBSnapshotVersion)
+        return NO;
+
+    uint64_t columnsEnd = sizeof(BDBSnapshotHeader) + (uint64_t)_header.columnCount * sizeof(BDBSnapshotColumn);
+    if (columnsEnd > length)
+        return NO;
+    _columns = (const BDBSnapshotColumn *)(_bytes + sizeof(BDBSnapshotHeader));
+
+    for (uint32_t column = 0; column < _header.columnCount; column++)
+    {
+        uint32_t kind = OSSwapLittleToHostInt32(_columns[column].kind);
+        uint32_t offset = OSSwapLittleToHostInt32(_columns[column].dataOffset);
+        uint64_t width = kind == BDBSnapshotColumnKindNumber ? sizeof(double) : sizeof(uint32_t);
+        if (kind < BDBSnapshotColumnKindString || kind > BDBSnapshotColumnKindJSON)
+            return NO;
+        if (offset % 8 != 0 || offset < columnsEnd || offset + width * _header.rowCount > _header.stringOffsetsOffset)
+            return NO;
+    }
+
+    uint64_t stringOffsetsEnd = _header.stringOffsetsOffset + ((uint64_t)_header.stringCount + 1) * sizeof(uint32_t);
+    if (_header.stringOffsetsOffset % 4 != 0 || stringOffsetsEnd != _header.stringDataOffset || _header.stringDataOffset > length)
+        return NO;
+
+    return YES;
+}
+
+- (NSUInteger)count
+{
+    return _header.rowCount;
+}
+
+- (NSArray *)objects
+{
+    return [[BDBSnapshotArray alloc] initWithSnapshot:self];
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _header.rowCount)
+        [NSException raise:NSRangeException format:@"Index %lu beyond snapshot of %u objects", (unsigned long)index, _header.rowCount];
+
+    @synchronized(self)
+    {
+        id object = (__bridge id)[_objects pointerAtIndex:index];
+        if (!object)
+        {
+            NSDictionary *dictionary = [self dictionaryAtIndex:index];
+            object = dictionary ? [[_modelClass alloc] initWithDictionary:dictionary] : nil;
+            object = object ?: [NSNull null];
+            [_objects replacePointerAtIndex:index withPointer:(__bridge void *)object];
+        }
+        return object == [NSNull null] ? nil : object;
+    }
+}
+
+- (NSDictionary *)dictionaryAtIndex:(NSUInteger)index
+{
+    if (index >= _header.rowCount)
+        return nil;
+
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:_header.columnCount];
+    for (uint32_t column = 0; column < _header.columnCount; column++)
+    {
+        const uint8_t *values = _bytes + OSSwapLittleToHostInt32(_columns[column].dataOffset);
+        id value = nil;
+        switch (OSSwapLittleToHostInt32(_columns[column].kind))
+        {
+            case BDBSnapshotColumnKindNumber:
+            {
+                uint64_t bits = OSSwapLittleToHostInt64(((const uint64_t *)values)[index]);
+                double number;
+                memcpy(&number, &bits, sizeof(number));
+                if (!isnan(number))
+                    value = number == floor(number) && fabs(number) < 9007199254740992.0 ? @((long long)number) : @(number);
+                break;
+            }
+
+            case BDBSnapshotColumnKindString:
+            {
+                uint32_t stringIndex = OSSwapLittleToHostInt32(((const uint32_t *)values)[index]);
+                if (stringIndex != BDBSnapshotAbsent)
+                    value = [self stringAtIndex:stringIndex];
+                break;
+            }
+
+            case BDBSnapshotColumnKindJSON:
+            {
+                uint32_t stringIndex = OSSwapLittleToHostInt32(((const uint32_t *)values)[index]);
+                NSString *JSON = stringIndex != BDBSnapshotAbsent ? [self stringAtIndex:stringIndex] : nil;
+                NSArray *wrapper = JSON ? [NSJSONSerialization JSONObjectWithData:[JSON dataUsingEncoding:NSUTF8StringEncoding] options:0 error:nil] : nil;
+                value = [wrapper isKindOfClass:[NSArray class]] ? [wrapper firstObject] : nil;
+                break;
+            }
+        }
+
+        if (value)
+            dictionary[_keys[column]] = value;
+    }
+
+    return dictionary;
+}
+
+#pragma mark Strings
+//  Strings are copied out of the mapping so objects built from them can outlive the snapshot.
+- (NSString *)stringAtIndex:(uint32_t)index
+{
+    if (index >= _header.stringCount)
+        return nil;
+
+    @synchronized(_strings)
+    {
+        NSString *string = (__bridge NSString *)[_strings pointerAtIndex:index];
+        if (string)
+            return string;
+
+        const uint32_t *offsets = (const uint32_t *)(_bytes + _header.stringOffsetsOffset);
+        uint64_t start = _header.stringDataOffset + (uint64_t)OSSwapLittleToHostInt32(offsets[index]);
+        uint64_t end = _header.stringDataOffset + (uint64_t)OSSwapLittleToHostInt32(offsets[index + 1]);
+        if (start > end || end > _data.length)
+            return nil;
+
+        string = [[NSString alloc] initWithBytes:_bytes + start length:(NSUInteger)(end - start) encoding:NSUTF8StringEncoding];
+        if (string)
+            [_strings replacePointerAtIndex:index withPointer:(__bridge void *)string];
+        return string;
+    }
+}
+
+@end
+
+
+#pragma mark -
+@implementation BDBSnapshotArray
+{
+    BDBSnapshot *_snapshot;
+}
+
+- (id)initWithSnapshot:(BDBSnapshot *)snapshot
+{
+    self = [super init];
+    if (self)
+    {
+        _snapshot = snapshot;
+    }
+
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _snapshot.count;
+}
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    return [_snapshot objectAtIndex:index] ?: [NSNull null];
+}
+
+@end
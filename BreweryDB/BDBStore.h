@@ -0,0 +1,162 @@
+//
+//  BDBStore.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBStore : NSObject
+
+#pragma mark Instantiation
+/**
+ *  The store BreweryDB writes fetched objects into unless another one is set.
+ *  It lives in the caches directory. Only the top-level results of a response
+ *  are written: breweries nested in beers and locations nested in breweries
+ *  are often partial, so they are not stored on their own.
+ *
+ *  @return BDBStore singleton
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)sharedStore;
+
+/**
+ *  Open or create a SQLite store.
+ *
+ *  @param path Path of the database file. Pass nil for an in-memory store.
+ *
+ *  @return A new store, or nil if the database could not be opened.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithPath:(NSString *)path;
+
+@property (nonatomic, copy, readonly) NSString *path;
+
+#pragma mark Writing
+/**
+ *  Insert or replace objects, given as API dictionaries. Writes are queued and
+ *  committed together in one transaction on the store's private queue.
+ *
+ *  @param dictionaries API dictionaries, e.g. the elements of a response's data array.
+ *  @param modelClass   Model class the dictionaries decode to, e.g. [BDBBeer class].
+ *
+ *  @since 1.1.0
+ */
+- (void)storeObjectDictionaries:(NSArray *)dictionaries ofClass:(Class)modelClass;
+
+/**
+ *  Delete objects by ID. Deletes are queued with the other writes and applied
+ *  in order, so an object stored and then removed ends up removed.
+ *
+ *  @param modelClass  Model class of the objects, e.g. [BDBBeer class].
+ *  @param identifiers IDs of the objects to delete.
+ *
+ *  @since 1.1.0
+ */
+- (void)removeObjectsOfClass:(Class)modelClass withIds:(NSArray *)identifiers;
+
+/**
+ *  Set or clear a metadata value. The value is committed in the same
+ *  transaction as, or after, every write queued before it, so it can record
+ *  how far a series of writes has got.
+ *
+ *  @param value Value to store, or nil to remove the key.
+ *  @param key   Metadata key.
+ *
+ *  @since 1.1.0
+ */
+- (void)setMetadataValue:(NSString *)value forKey:(NSString *)key;
+
+/**
+ *  Commit queued writes before returning.
+ *
+ *  @since 1.1.0
+ */
+- (void)flush;
+
+/**
+ *  Delete every stored object and all metadata.
+ *
+ *  @since 1.1.0
+ */
+- (void)removeAllObjects;
+
+#pragma mark Querying
+/**
+ *  Look up a metadata value, seeing every write queued before the call.
+ *
+ *  @param key Metadata key.
+ *
+ *  @return The value, or nil if none is set.
+ *
+ *  @since 1.1.0
+ */
+- (NSString *)metadataValueForKey:(NSString *)key;
+
+/**
+ *  Queries block until the indexed lookup finishes, and see every write queued
+ *  before them. Results are decoded into the same model classes the network
+ *  methods return.
+ *
+ *  @since 1.1.0
+ */
+- (id)objectOfClass:(Class)modelClass withId:(NSString *)identifier;
+- (NSArray *)objectsOfClass:(Class)modelClass withIds:(NSArray *)identifiers;
+- (NSArray *)objectsOfClass:(Class)modelClass withNamePrefix:(NSString *)namePrefix limit:(NSUInteger)limit;
+- (NSUInteger)countOfObjectsOfClass:(Class)modelClass;
+
+- (NSArray *)beersWithStyleId:(NSNumber *)styleId;
+- (NSArray *)beersForBreweryId:(NSString *)breweryId;
+- (NSArray *)locationsForBreweryId:(NSString *)breweryId;
+- (NSArray *)stylesWithCategoryId:(NSNumber *)categoryId;
+
+/**
+ *  Every stored location. Locations fetched without their brewery are linked
+ *  to it from the stored breweries, e.g. to build a BDBLocationIndex.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)locationsWithBreweries;
+
+#pragma mark Searching
+/**
+ *  Full-text search over the names and descriptions of stored beers, breweries
+ *  and guilds. The index is built from the store on first use and then kept up
+ *  to date as objects are written.
+ *
+ *  @param query      Free text query. Terms match as words, prefixes or with one typo.
+ *  @param type       "beer", "brewery" or "guild", or nil for all three.
+ *  @param range      Range of the ranked matches to return.
+ *  @param totalCount Set to the number of matches before range is applied. May be NULL.
+ *
+ *  @return BDBBeer, BDBBrewery and BDBGuild objects, best match first.
+ *
+ *  @since 1.1.0
+ */
+- (NSArray *)objectsMatchingSearch:(NSString *)query
+                              type:(NSString *)type
+                             range:(NSRange)range
+                        totalCount:(NSUInteger *)totalCount;
+
+@end
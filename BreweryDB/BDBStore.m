@@ -0,0 +1,812 @@
+//
+//  BDBStore.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <objc/runtime.h>
+#import <sqlite3.h>
+
+#import "BDBStore.h"
+#import "BDBSearchIndex.h"
+#import "BDBBeer.h"
+#import "BDBBrewery.h"
+#import "BDBLocation.h"
+#import "BDBStyle.h"
+#import "BDBCategory.h"
+#import "BDBHop.h"
+#import "BDBYeast.h"
+#import "BDBFermentable.h"
+#import "BDBGuild.h"
+
+
+static NSString * const BDBStoreFileName = @"BreweryDB.sqlite";
+static int const BDBStoreSchemaVersion = 2;
+static NSUInteger const BDBStoreMaximumQueryArguments = 512;
+
+typedef struct
+{
+    const char *className;
+    const char *tableName;
+    const char *foreignKeyColumn;
+    const char *foreignKey;
+    const char *searchType;
+} BDBStoreTable;
+
+// Every table has id, name, json and updated_at columns; some also index one foreign key.
+// Tables with a search type feed the full-text index under the search API's type name.
+static const BDBStoreTable BDBStoreTables[] =
+{
+    {"BDBBeer",        "beers",        "style_id",    "styleId",    "beer"},
+    {"BDBBrewery",     "breweries",    NULL,          NULL,         "brewery"},
+    {"BDBLocation",    "locations",    "brewery_id",  "breweryId",  NULL},
+    {"BDBStyle",       "styles",       "category_id", "categoryId", NULL},
+    {"BDBCategory",    "categories",   NULL,          NULL,         NULL},
+    {"BDBHop",         "hops",         NULL,          NULL,         NULL},
+    {"BDBYeast",       "yeasts",       NULL,          NULL,         NULL},
+    {"BDBFermentable", "fermentables", NULL,          NULL,         NULL},
+    {"BDBGuild",       "guilds",       NULL,          NULL,         "guild"},
+};
+
+static const BDBStoreTable *BDBStoreTableForClass(Class modelClass)
+{
+    const char *className = class_getName(modelClass);
+    for (size_t i = 0; i < sizeof(BDBStoreTables) / sizeof(BDBStoreTables[0]); i++)
+    {
+        if (strcmp(BDBStoreTables[i].className, className) == 0)
+            return &BDBStoreTables[i];
+    }
+    return NULL;
+}
+
+static const BDBStoreTable *BDBStoreTableForSearchType(NSString *searchType)
+{
+    for (size_t i = 0; i < sizeof(BDBStoreTables) / sizeof(BDBStoreTables[0]); i++)
+    {
+        if (BDBStoreTables[i].searchType && [searchType isEqualToString:@(BDBStoreTables[i].searchType)])
+            return &BDBStoreTables[i];
+    }
+    return NULL;
+}
+
+static NSString *BDBStoreIdentifier(id value)
+{
+    if ([value isKindOfClass:[NSString class]])
+        return value;
+    if ([value isKindOfClass:[NSNumber class]])
+        return [value stringValue];
+    return nil;
+}
+
+
+#pragma mark -
+@interface BDBStore ()
+{
+    sqlite3 *_database;
+    dispatch_queue_t _queue;
+    NSMutableDictionary *_statements;
+
+    NSMutableArray *_pendingWrites;
+    BOOL _flushScheduled;
+
+    BDBSearchIndex *_searchIndex;
+    BOOL _searchIndexLoaded;
+}
+
+@property (nonatomic, copy, readwrite) NSString *path;
+
+- (BOOL)openDatabase;
+- (BOOL)executeSQL:(NSString *)SQL;
+- (sqlite3_stmt *)statementForSQL:(NSString *)SQL;
+- (void)bindValue:(id)value toStatement:(sqlite3_stmt *)statement atIndex:(int)index;
+
+- (void)enqueueWrites:(NSArray *)writes;
+- (void)writePendingObjects;
+- (void)writeObjectDictionary:(NSDictionary *)dictionary table:(const BDBStoreTable *)table;
+- (void)deleteObjectWithId:(NSString *)identifier table:(const BDBStoreTable *)table;
+- (void)writeMetadataValue:(id)value forKey:(NSString *)key;
+- (void)indexObjectDictionary:(NSDictionary *)dictionary table:(const BDBStoreTable *)table;
+- (void)loadSearchIndex;
+
+- (NSArray *)dictionariesForQuery:(NSString *)SQL arguments:(NSArray *)arguments;
+- (NSArray *)objectsOfClass:(Class)modelClass query:(NSString *)SQL arguments:(NSArray *)arguments;
+- (NSArray *)objectsOfClass:(Class)modelClass fromDictionaries:(NSArray *)dictionaries;
+- (NSDictionary *)dictionariesByIdInTable:(const BDBStoreTable *)table withIds:(NSArray *)identifiers;
+
+@end
+
+
+#pragma mark -
+@implementation BDBStore
+
+#pragma mark Instantiation
++ (instancetype)sharedStore
+{
+    static BDBStore *_sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *cachesPath = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        _sharedStore = [[[self class] alloc] initWithPath:[cachesPath stringByAppendingPathComponent:BDBStoreFileName]];
+    });
+    return _sharedStore;
+}
+
+- (id)init
+{
+    return [self initWithPath:nil];
+}
+
+- (id)initWithPath:(NSString *)path
+{
+    self = [super init];
+    if (self)
+    {
+        _path = [path copy];
+        _queue = dispatch_queue_create("com.brewerydb.store", DISPATCH_QUEUE_SERIAL);
+        _statements = [NSMutableDictionary dictionary];
+        _pendingWrites = [NSMutableArray array];
+        _searchIndex = [[BDBSearchIndex alloc] init];
+
+        __block BOOL opened = NO;
+        dispatch_sync(_queue, ^{
+            opened = [self openDatabase];
+        });
+        if (!opened)
+            return nil;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (NSValue *statement in _statements.allValues)
+        sqlite3_finalize(statement.pointerValue);
+    if (_database)
+        sqlite3_close(_database);
+}
+
+#pragma mark Database
+- (BOOL)openDatabase
+{
+    NSString *path = self.path ?: @":memory:";
+    if (self.path)
+        [[NSFileManager defaultManager] createDirectoryAtPath:[self.path stringByDeletingLastPathComponent]
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:NULL];
+
+    // Every statement runs on the store's serial queue, so SQLite's own mutexes are unnecessary.
+    if (sqlite3_open_v2(path.fileSystemRepresentation, &_database, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, NULL) != SQLITE_OK)
+    {
+        NSLog(@"Could not open store at %@: %s", path, sqlite3_errmsg(_database));
+        sqlite3_close(_database);
+        _database = NULL;
+        return NO;
+    }
+
+    [self executeSQL:@"PRAGMA journal_mode = WAL"];
+    [self executeSQL:@"PRAGMA synchronous = NORMAL"];
+
+    sqlite3_stmt *statement = [self statementForSQL:@"PRAGMA user_version"];
+    int version = (sqlite3_step(statement) == SQLITE_ROW) ? sqlite3_column_int(statement, 0) : 0;
+    sqlite3_reset(statement);
+    if (version == BDBStoreSchemaVersion)
+        return YES;
+
+    BOOL succeeded = [self executeSQL:@"BEGIN"];
+    for (size_t i = 0; i < sizeof(BDBStoreTables) / sizeof(BDBStoreTables[0]) && succeeded; i++)
+    {
+        const BDBStoreTable *table = &BDBStoreTables[i];
+        NSString *foreignKeyColumn = table->foreignKeyColumn ? [NSString stringWithFormat:@"%s TEXT, ", table->foreignKeyColumn] : @"";
+        succeeded = [self executeSQL:[NSString stringWithFormat:@"CREATE TABLE IF NOT EXISTS %s (id TEXT PRIMARY KEY NOT NULL, name TEXT COLLATE NOCASE, %@json BLOB NOT NULL, updated_at REAL NOT NULL)", table->tableName, foreignKeyColumn]];
+        succeeded = succeeded && [self executeSQL:[NSString stringWithFormat:@"CREATE INDEX IF NOT EXISTS %s_name ON %s (name)", table->tableName, table->tableName]];
+        if (table->foreignKeyColumn)
+            succeeded = succeeded && [self executeSQL:[NSString stringWithFormat:@"CREATE INDEX IF NOT EXISTS %s_%s ON %s (%s)", table->tableName, table->foreignKeyColumn, table->tableName, table->foreignKeyColumn]];
+    }
+
+    // Beers list their breweries, so the beer-brewery relation gets its own table.
+    succeeded = succeeded && [self executeSQL:@"CREATE TABLE IF NOT EXISTS beer_breweries (beer_id TEXT NOT NULL, brewery_id TEXT NOT NULL, PRIMARY KEY (beer_id, brewery_id)) WITHOUT ROWID"];
+    succeeded = succeeded && [self executeSQL:@"CREATE INDEX IF NOT EXISTS beer_breweries_brewery_id ON beer_breweries (brewery_id)"];
+    succeeded = succeeded && [self executeSQL:@"CREATE TABLE IF NOT EXISTS metadata (key TEXT PRIMARY KEY NOT NULL, value TEXT NOT NULL)"];
+    succeeded = succeeded && [self executeSQL:[NSString stringWithFormat:@"PRAGMA user_version = %d", BDBStoreSchemaVersion]];
+
+    [self executeSQL:(succeeded ? @"COMMIT" : @"ROLLBACK")];
+    return succeeded;
+}
+
+- (BOOL)executeSQL:(NSString *)SQL
+{
+    char *errorMessage = NULL;
+    if (sqlite3_exec(_database, SQL.UTF8String, NULL, NULL, &errorMessage) == SQLITE_OK)
+        return YES;
+
+    NSLog(@"Could not execute store statement %@: %s", SQL, errorMessage);
+    sqlite3_free(errorMessage);
+    return NO;
+}
+
+- (sqlite3_stmt *)statementForSQL:(NSString *)SQL
+{
+    sqlite3_stmt *statement = [_statements[SQL] pointerValue];
+    if (statement)
+        return statement;
+
+    if (sqlite3_prepare_v2(_database, SQL.UTF8String, -1, &statement, NULL) != SQLITE_OK)
+    {
+        NSLog(@"Could not prepare store statement %@: %s", SQL, sqlite3_errmsg(_database));
+        return NULL;
+    }
+
+    _statements[SQL] = [NSValue valueWithPointer:statement];
+    return statement;
+}
+
+- (void)bindValue:(id)value toStatement:(sqlite3_stmt *)statement atIndex:(int)index
+{
+    if ([value isKindOfClass:[NSString class]])
+        sqlite3_bind_text(statement, index, [value UTF8String], -1, SQLITE_TRANSIENT);
+    else if ([value isKindOfClass:[NSNumber class]] && CFNumberIsFloatType((__bridge CFNumberRef)value))
+        sqlite3_bind_double(statement, index, [value doubleValue]);
+    else if ([value isKindOfClass:[NSNumber class]])
+        sqlite3_bind_int64(statement, index, [value longLongValue]);
+    else if ([value isKindOfClass:[NSData class]])
+        sqlite3_bind_blob(statement, index, [value bytes], (int)[value length], SQLITE_TRANSIENT);
+    else
+        sqlite3_bind_null(statement, index);
+}
+
+#pragma mark Writing
+- (void)storeObjectDictionaries:(NSArray *)dictionaries ofClass:(Class)modelClass
+{
+    const BDBStoreTable *table = BDBStoreTableForClass(modelClass);
+    if (!table)
+        return;
+
+    NSMutableArray *writes = [NSMutableArray arrayWithCapacity:dictionaries.count];
+    for (NSDictionary *dictionary in dictionaries)
+    {
+        if ([dictionary isKindOfClass:[NSDictionary class]] && BDBStoreIdentifier(dictionary[@"id"]))
+            [writes addObject:@[[NSValue valueWithPointer:table], dictionary]];
+    }
+    [self enqueueWrites:writes];
+}
+
+- (void)removeObjectsOfClass:(Class)modelClass withIds:(NSArray *)identifiers
+{
+    const BDBStoreTable *table = BDBStoreTableForClass(modelClass);
+    if (!table)
+        return;
+
+    NSMutableArray *writes = [NSMutableArray arrayWithCapacity:identifiers.count];
+    for (id identifier in identifiers)
+    {
+        if (BDBStoreIdentifier(identifier))
+            [writes addObject:@[[NSValue valueWithPointer:table], BDBStoreIdentifier(identifier)]];
+    }
+    [self enqueueWrites:writes];
+}
+
+- (void)setMetadataValue:(NSString *)value forKey:(NSString *)key
+{
+    NSParameterAssert(key);
+    [self enqueueWrites:@[@[key, value ?: [NSNull null]]]];
+}
+
+// Pending writes are [table, dictionary] to store an object, [table, id] to delete one,
+// or [key, value] to set metadata. They are applied in the order they were queued.
+- (void)enqueueWrites:(NSArray *)writes
+{
+    BOOL scheduleWrite = NO;
+    @synchronized(_pendingWrites)
+    {
+        [_pendingWrites addObjectsFromArray:writes];
+
+        // Writes arriving while a transaction is queued join it instead of starting their own.
+        scheduleWrite = (!_flushScheduled && _pendingWrites.count > 0);
+        if (scheduleWrite)
+            _flushScheduled = YES;
+    }
+
+    if (scheduleWrite)
+    {
+        dispatch_async(_queue, ^{
+            [self writePendingObjects];
+        });
+    }
+}
+
+- (void)flush
+{
+    dispatch_sync(_queue, ^{
+        [self writePendingObjects];
+    });
+}
+
+- (void)writePendingObjects
+{
+    NSArray *pendingWrites = nil;
+    @synchronized(_pendingWrites)
+    {
+        pendingWrites = [_pendingWrites copy];
+        [_pendingWrites removeAllObjects];
+        _flushScheduled = NO;
+    }
+
+    if (pendingWrites.count == 0 || ![self executeSQL:@"BEGIN"])
+        return;
+
+    for (NSArray *pendingWrite in pendingWrites)
+    {
+        @autoreleasepool
+        {
+            if ([pendingWrite[0] isKindOfClass:[NSString class]])
+                [self writeMetadataValue:pendingWrite[1] forKey:pendingWrite[0]];
+            else if ([pendingWrite[1] isKindOfClass:[NSDictionary class]])
+                [self writeObjectDictionary:pendingWrite[1] table:[pendingWrite[0] pointerValue]];
+            else
+                [self deleteObjectWithId:pendingWrite[1] table:[pendingWrite[0] pointerValue]];
+        }
+    }
+
+    [self executeSQL:@"COMMIT"];
+}
+
+- (void)writeObjectDictionary:(NSDictionary *)dictionary table:(const BDBStoreTable *)table
+{
+    NSData *JSONData = [NSJSONSerialization dataWithJSONObject:dictionary options:0 error:NULL];
+    if (!JSONData)
+        return;
+
+    NSString *identifier = BDBStoreIdentifier(dictionary[@"id"]);
+    NSString *name = [dictionary[@"name"] isKindOfClass:[NSString class]] ? dictionary[@"name"] : nil;
+
+    NSString *SQL = nil;
+    id foreignKeyValue = nil;
+    if (table->foreignKeyColumn)
+    {
+        SQL = [NSString stringWithFormat:@"INSERT OR REPLACE INTO %s (id, name, json, updated_at, %s) VALUES (?, ?, ?, ?, ?)", table->tableName, table->foreignKeyColumn];
+        foreignKeyValue = BDBStoreIdentifier(dictionary[@(table->foreignKey)]);
+
+        // Locations embed their brewery when the response does not carry breweryId.
+        if (!foreignKeyValue && [dictionary[@"brewery"] isKindOfClass:[NSDictionary class]])
+            foreignKeyValue = BDBStoreIdentifier(dictionary[@"brewery"][@"id"]);
+    }
+    else
+        SQL = [NSString stringWithFormat:@"INSERT OR REPLACE INTO %s (id, name, json, updated_at) VALUES (?, ?, ?, ?)", table->tableName];
+
+    sqlite3_stmt *statement = [self statementForSQL:SQL];
+    if (!statement)
+        return;
+
+    [self bindValue:identifier toStatement:statement atIndex:1];
+    [self bindValue:name toStatement:statement atIndex:2];
+    [self bindValue:JSONData toStatement:statement atIndex:3];
+    sqlite3_bind_double(statement, 4, CFAbsoluteTimeGetCurrent());
+    if (table->foreignKeyColumn)
+        [self bindValue:foreignKeyValue toStatement:statement atIndex:5];
+
+    if (sqlite3_step(statement) != SQLITE_DONE)
+        NSLog(@"Could not store %s %@: %s", table->tableName, identifier, sqlite3_errmsg(_database));
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    if (_searchIndexLoaded)
+        [self indexObjectDictionary:dictionary table:table];
+
+    // A beer fetched without brewery info says nothing about its breweries, so its links are kept.
+    NSArray *breweries = dictionary[@"breweries"];
+    if (strcmp(table->tableName, "beers") != 0 || ![breweries isKindOfClass:[NSArray class]])
+        return;
+
+    statement = [self statementForSQL:@"DELETE FROM beer_breweries WHERE beer_id = ?"];
+    [self bindValue:identifier toStatement:statement atIndex:1];
+    sqlite3_step(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    statement = [self statementForSQL:@"INSERT OR IGNORE INTO beer_breweries (beer_id, brewery_id) VALUES (?, ?)"];
+    for (NSDictionary *brewery in breweries)
+    {
+        NSString *breweryId = [brewery isKindOfClass:[NSDictionary class]] ? BDBStoreIdentifier(brewery[@"id"]) : nil;
+        if (!breweryId)
+            continue;
+
+        [self bindValue:identifier toStatement:statement atIndex:1];
+        [self bindValue:breweryId toStatement:statement atIndex:2];
+        sqlite3_step(statement);
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    }
+}
+
+- (void)deleteObjectWithId:(NSString *)identifier table:(const BDBStoreTable *)table
+{
+    sqlite3_stmt *statement = [self statementForSQL:[NSString stringWithFormat:@"DELETE FROM %s WHERE id = ?", table->tableName]];
+    if (!statement)
+        return;
+
+    [self bindValue:identifier toStatement:statement atIndex:1];
+    if (sqlite3_step(statement) != SQLITE_DONE)
+        NSLog(@"Could not delete %s %@: %s", table->tableName, identifier, sqlite3_errmsg(_database));
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+
+    if (_searchIndexLoaded && table->searchType)
+        [_searchIndex removeDocumentWithIdentifier:identifier type:@(table->searchType)];
+
+    if (strcmp(table->tableName, "beers") != 0)
+        return;
+
+    statement = [self statementForSQL:@"DELETE FROM beer_breweries WHERE beer_id = ?"];
+    [self bindValue:identifier toStatement:statement atIndex:1];
+    sqlite3_step(statement);
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+}
+
+- (void)writeMetadataValue:(id)value forKey:(NSString *)key
+{
+    NSString *SQL = (value == [NSNull null]) ? @"DELETE FROM metadata WHERE key = ?" : @"INSERT OR REPLACE INTO metadata (key, value) VALUES (?, ?)";
+    sqlite3_stmt *statement = [self statementForSQL:SQL];
+    if (!statement)
+        return;
+
+    [self bindValue:key toStatement:statement atIndex:1];
+    if (value != [NSNull null])
+        [self bindValue:value toStatement:statement atIndex:2];
+    if (sqlite3_step(statement) != SQLITE_DONE)
+        NSLog(@"Could not store metadata %@: %s", key, sqlite3_errmsg(_database));
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+}
+
+- (void)removeAllObjects
+{
+    dispatch_sync(_queue, ^{
+        @synchronized(_pendingWrites)
+        {
+            [_pendingWrites removeAllObjects];
+        }
+
+        [self executeSQL:@"BEGIN"];
+        for (size_t i = 0; i < sizeof(BDBStoreTables) / sizeof(BDBStoreTables[0]); i++)
+            [self executeSQL:[NSString stringWithFormat:@"DELETE FROM %s", BDBStoreTables[i].tableName]];
+        [self executeSQL:@"DELETE FROM beer_breweries"];
+        // Metadata such as sync marks describes the stored objects, so it goes with them.
+        [self executeSQL:@"DELETE FROM metadata"];
+        [self executeSQL:@"COMMIT"];
+
+        [_searchIndex removeAllDocuments];
+    });
+}
+
+#pragma mark Search Index
+- (void)indexObjectDictionary:(NSDictionary *)dictionary table:(const BDBStoreTable *)table
+{
+    if (!table->searchType)
+        return;
+
+    NSString *description = [dictionary[@"description"] isKindOfClass:[NSString class]] ? dictionary[@"description"] : nil;
+    [_searchIndex addDocumentWithIdentifier:BDBStoreIdentifier(dictionary[@"id"])
+                                       type:@(table->searchType)
+                                       name:dictionary[@"name"]
+                                       text:description];
+}
+
+// The index lives in memory and is built from the stored rows the first time it is searched;
+// after that every write updates it in place.
+- (void)loadSearchIndex
+{
+    if (_searchIndexLoaded)
+        return;
+    _searchIndexLoaded = YES;
+
+    for (size_t i = 0; i < sizeof(BDBStoreTables) / sizeof(BDBStoreTables[0]); i++)
+    {
+        const BDBStoreTable *table = &BDBStoreTables[i];
+        if (!table->searchType)
+            continue;
+
+        sqlite3_stmt *statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT json FROM %s", table->tableName]];
+        while (statement && sqlite3_step(statement) == SQLITE_ROW)
+        {
+            @autoreleasepool
+            {
+                const void *bytes = sqlite3_column_blob(statement, 0);
+                int length = sqlite3_column_bytes(statement, 0);
+                NSData *row = (bytes && length > 0) ? [NSData dataWithBytesNoCopy:(void *)bytes length:(NSUInteger)length freeWhenDone:NO] : nil;
+                NSDictionary *dictionary = row ? [NSJSONSerialization JSONObjectWithData:row options:0 error:NULL] : nil;
+                if ([dictionary isKindOfClass:[NSDictionary class]] && BDBStoreIdentifier(dictionary[@"id"]))
+                    [self indexObjectDictionary:dictionary table:table];
+            }
+        }
+        sqlite3_reset(statement);
+    }
+}
+
+#pragma mark Querying
+- (NSString *)metadataValueForKey:(NSString *)key
+{
+    NSParameterAssert(key);
+
+    __block NSString *value = nil;
+    dispatch_sync(_queue, ^{
+        [self writePendingObjects];
+
+        sqlite3_stmt *statement = [self statementForSQL:@"SELECT value FROM metadata WHERE key = ?"];
+        if (!statement)
+            return;
+
+        [self bindValue:key toStatement:statement atIndex:1];
+        if (sqlite3_step(statement) == SQLITE_ROW && sqlite3_column_text(statement, 0))
+            value = @((const char *)sqlite3_column_text(statement, 0));
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    });
+    return value;
+}
+
+- (NSArray *)dictionariesForQuery:(NSString *)SQL arguments:(NSArray *)arguments
+{
+    NSMutableArray *rows = [NSMutableArray array];
+    dispatch_sync(_queue, ^{
+        [self writePendingObjects];
+
+        sqlite3_stmt *statement = [self statementForSQL:SQL];
+        if (!statement)
+            return;
+
+        [arguments enumerateObjectsUsingBlock:^(id argument, NSUInteger index, BOOL *stop) {
+            [self bindValue:argument toStatement:statement atIndex:(int)index + 1];
+        }];
+        while (sqlite3_step(statement) == SQLITE_ROW)
+        {
+            const void *bytes = sqlite3_column_blob(statement, 0);
+            int length = sqlite3_column_bytes(statement, 0);
+            if (bytes && length > 0)
+                [rows addObject:[NSData dataWithBytes:bytes length:(NSUInteger)length]];
+        }
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+    });
+
+    // Rows are parsed off the store's queue so queries do not hold up writes.
+    NSMutableArray *dictionaries = [NSMutableArray arrayWithCapacity:rows.count];
+    for (NSData *row in rows)
+    {
+        NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:row options:0 error:NULL];
+        if ([dictionary isKindOfClass:[NSDictionary class]])
+            [dictionaries addObject:dictionary];
+    }
+    return dictionaries;
+}
+
+- (NSArray *)objectsOfClass:(Class)modelClass query:(NSString *)SQL arguments:(NSArray *)arguments
+{
+    return [self objectsOfClass:modelClass fromDictionaries:[self dictionariesForQuery:SQL arguments:arguments]];
+}
+
+- (NSArray *)objectsOfClass:(Class)modelClass fromDictionaries:(NSArray *)dictionaries
+{
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:dictionaries.count];
+    for (NSDictionary *dictionary in dictionaries)
+    {
+        id object = [[modelClass alloc] initWithDictionary:dictionary];
+        if (object)
+            [objects addObject:object];
+    }
+    return objects;
+}
+
+- (id)objectOfClass:(Class)modelClass withId:(NSString *)identifier
+{
+    if (!identifier)
+        return nil;
+    return [[self objectsOfClass:modelClass withIds:@[identifier]] firstObject];
+}
+
+- (NSArray *)objectsOfClass:(Class)modelClass withIds:(NSArray *)identifiers
+{
+    const BDBStoreTable *table = BDBStoreTableForClass(modelClass);
+    if (!table || identifiers.count == 0)
+        return @[];
+
+    // Hand objects back in the order they were asked for.
+    NSDictionary *dictionariesById = [self dictionariesByIdInTable:table withIds:identifiers];
+    NSMutableArray *orderedDictionaries = [NSMutableArray arrayWithCapacity:dictionariesById.count];
+    for (id identifier in identifiers)
+    {
+        NSDictionary *dictionary = dictionariesById[BDBStoreIdentifier(identifier) ?: @""];
+        if (dictionary)
+            [orderedDictionaries addObject:dictionary];
+    }
+    return [self objectsOfClass:modelClass fromDictionaries:orderedDictionaries];
+}
+
+- (NSDictionary *)dictionariesByIdInTable:(const BDBStoreTable *)table withIds:(NSArray *)identifiers
+{
+    NSMutableDictionary *dictionariesById = [NSMutableDictionary dictionaryWithCapacity:identifiers.count];
+
+    // Stay well under SQLite's limit on bound arguments per statement, and round each chunk up to
+    // a power of two padded with NULLs (which match no id), so a table only ever prepares a
+    // handful of statements instead of one per distinct count.
+    for (NSUInteger start = 0; start < identifiers.count; start += BDBStoreMaximumQueryArguments)
+    {
+        NSUInteger count = MIN(BDBStoreMaximumQueryArguments, identifiers.count - start);
+        NSUInteger placeholderCount = 1;
+        while (placeholderCount < count)
+            placeholderCount *= 2;
+
+        NSMutableArray *arguments = [[identifiers subarrayWithRange:NSMakeRange(start, count)] mutableCopy];
+        NSMutableArray *placeholders = [NSMutableArray arrayWithCapacity:placeholderCount];
+        for (NSUInteger i = 0; i < placeholderCount; i++)
+        {
+            [placeholders addObject:@"?"];
+            if (i >= count)
+                [arguments addObject:[NSNull null]];
+        }
+
+        NSString *SQL = [NSString stringWithFormat:@"SELECT json FROM %s WHERE id IN (%@)", table->tableName, [placeholders componentsJoinedByString:@", "]];
+        for (NSDictionary *dictionary in [self dictionariesForQuery:SQL arguments:arguments])
+            dictionariesById[BDBStoreIdentifier(dictionary[@"id"])] = dictionary;
+    }
+    return dictionariesById;
+}
+
+- (NSArray *)objectsOfClass:(Class)modelClass withNamePrefix:(NSString *)namePrefix limit:(NSUInteger)limit
+{
+    const BDBStoreTable *table = BDBStoreTableForClass(modelClass);
+    if (!table || !namePrefix)
+        return @[];
+
+    // Names are NOCASE, so LIKE with a literal prefix is answered from the name index.
+    NSString *escapedPrefix = [[[namePrefix stringByReplacingOccurrencesOfString:@"\\" withString:@"\\\\"]
+                                stringByReplacingOccurrencesOfString:@"%" withString:@"\\%"]
+                               stringByReplacingOccurrencesOfString:@"_" withString:@"\\_"];
+    NSString *SQL = [NSString stringWithFormat:@"SELECT json FROM %s WHERE name LIKE ? ESCAPE '\\' ORDER BY name LIMIT ?", table->tableName];
+    return [self objectsOfClass:modelClass
+                          query:SQL
+                      arguments:@[[escapedPrefix stringByAppendingString:@"%"], @(limit > 0 ? limit : INT_MAX)]];
+}
+
+- (NSUInteger)countOfObjectsOfClass:(Class)modelClass
+{
+    const BDBStoreTable *table = BDBStoreTableForClass(modelClass);
+    if (!table)
+        return 0;
+
+    __block NSUInteger count = 0;
+    dispatch_sync(_queue, ^{
+        [self writePendingObjects];
+
+        sqlite3_stmt *statement = [self statementForSQL:[NSString stringWithFormat:@"SELECT COUNT(*) FROM %s", table->tableName]];
+        if (statement && sqlite3_step(statement) == SQLITE_ROW)
+            count = (NSUInteger)sqlite3_column_int64(statement, 0);
+        sqlite3_reset(statement);
+    });
+    return count;
+}
+
+- (NSArray *)objectsMatchingSearch:(NSString *)query
+                              type:(NSString *)type
+                             range:(NSRange)range
+                        totalCount:(NSUInteger *)totalCount
+{
+    dispatch_sync(_queue, ^{
+        [self writePendingObjects];
+        [self loadSearchIndex];
+    });
+
+    // The index does its own locking, so ranking does not hold up the store's queue.
+    NSArray *documents = [_searchIndex documentsMatchingQuery:query type:type];
+    if (totalCount)
+        *totalCount = documents.count;
+    if (range.location >= documents.count)
+        return @[];
+    documents = [documents subarrayWithRange:NSMakeRange(range.location, MIN(range.length, documents.count - range.location))];
+
+    NSMutableDictionary *identifiersByType = [NSMutableDictionary dictionary];
+    for (NSArray *document in documents)
+    {
+        NSMutableArray *identifiers = identifiersByType[document[0]];
+        if (!identifiers)
+        {
+            identifiers = [NSMutableArray array];
+            identifiersByType[document[0]] = identifiers;
+        }
+        [identifiers addObject:document[1]];
+    }
+
+    NSMutableDictionary *dictionariesByType = [NSMutableDictionary dictionaryWithCapacity:identifiersByType.count];
+    [identifiersByType enumerateKeysAndObjectsUsingBlock:^(NSString *documentType, NSArray *identifiers, BOOL *stop) {
+        dictionariesByType[documentType] = [self dictionariesByIdInTable:BDBStoreTableForSearchType(documentType) withIds:identifiers];
+    }];
+
+    NSMutableArray *objects = [NSMutableArray arrayWithCapacity:documents.count];
+    for (NSArray *document in documents)
+    {
+        NSDictionary *dictionary = dictionariesByType[document[0]][document[1]];
+        id object = dictionary ? [[objc_getClass(BDBStoreTableForSearchType(document[0])->className) alloc] initWithDictionary:dictionary] : nil;
+        if (object)
+            [objects addObject:object];
+    }
+    return objects;
+}
+
+- (NSArray *)beersWithStyleId:(NSNumber *)styleId
+{
+    if (!styleId)
+        return @[];
+    return [self objectsOfClass:[BDBBeer class] query:@"SELECT json FROM beers WHERE style_id = ? ORDER BY name" arguments:@[styleId]];
+}
+
+- (NSArray *)beersForBreweryId:(NSString *)breweryId
+{
+    if (!breweryId)
+        return @[];
+    return [self objectsOfClass:[BDBBeer class]
+                          query:@"SELECT beers.json FROM beer_breweries JOIN beers ON beers.id = beer_breweries.beer_id WHERE beer_breweries.brewery_id = ? ORDER BY beers.name"
+                      arguments:@[breweryId]];
+}
+
+- (NSArray *)locationsForBreweryId:(NSString *)breweryId
+{
+    if (!breweryId)
+        return @[];
+    return [self objectsOfClass:[BDBLocation class] query:@"SELECT json FROM locations WHERE brewery_id = ? ORDER BY name" arguments:@[breweryId]];
+}
+
+- (NSArray *)locationsWithBreweries
+{
+    NSArray *locations = [self dictionariesForQuery:@"SELECT json FROM locations" arguments:nil];
+
+    NSMutableSet *breweryIds = [NSMutableSet set];
+    for (NSDictionary *location in locations)
+    {
+        NSString *breweryId = BDBStoreIdentifier(location[@"breweryId"]);
+        if (breweryId && ![location[@"brewery"] isKindOfClass:[NSDictionary class]])
+            [breweryIds addObject:breweryId];
+    }
+
+    NSDictionary *breweriesById = [self dictionariesByIdInTable:BDBStoreTableForClass([BDBBrewery class]) withIds:breweryIds.allObjects];
+
+    NSMutableArray *linkedLocations = [NSMutableArray arrayWithCapacity:locations.count];
+    for (NSDictionary *location in locations)
+    {
+        NSDictionary *brewery = breweriesById[BDBStoreIdentifier(location[@"breweryId"]) ?: @""];
+        if (brewery && ![location[@"brewery"] isKindOfClass:[NSDictionary class]])
+        {
+            NSMutableDictionary *linkedLocation = [location mutableCopy];
+            linkedLocation[@"brewery"] = brewery;
+            location = linkedLocation;
+        }
+        [linkedLocations addObject:location];
+    }
+    return [self objectsOfClass:[BDBLocation class] fromDictionaries:linkedLocations];
+}
+
+- (NSArray *)stylesWithCategoryId:(NSNumber *)categoryId
+{
+    if (!categoryId)
+        return @[];
+    return [self objectsOfClass:[BDBStyle class] query:@"SELECT json FROM styles WHERE category_id = ? ORDER BY name" arguments:@[categoryId]];
+}
+
+@end
@@ -0,0 +1,69 @@
+//
+//  BDBStreamingResponseParser.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+
+#pragma mark -
+@interface BDBStreamingResponseParser : NSObject
+
+/**
+ *  Create a parser for a BreweryDB response envelope. Elements of the
+ *  top-level "data" array are handed out one at a time as soon as their
+ *  closing bracket arrives; only the element being parsed is buffered.
+ *
+ *  @param elementHandler Called with each deserialized element. Return NO to stop parsing.
+ *
+ *  @return A new parser.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithElementHandler:(BOOL (^)(id element))elementHandler;
+
+/**
+ *  Feed the next chunk of the response body.
+ *
+ *  @return NO if the bytes are not a valid response envelope or the element handler stopped parsing.
+ *
+ *  @since 1.1.0
+ */
+- (BOOL)appendData:(NSData *)data error:(NSError *__autoreleasing *)error;
+
+/**
+ *  Top-level members of the envelope other than a streamed "data" array,
+ *  e.g. status, errorMessage, currentPage and numberOfPages.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSDictionary *envelope;
+
+@property (nonatomic, readonly) NSUInteger elementCount;
+
+/**
+ *  Time spent in -appendData:error: so far, including the element handler.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, readonly) NSTimeInterval parseDuration;
+@property (nonatomic, readonly, getter = isComplete) BOOL complete;
+
+@end
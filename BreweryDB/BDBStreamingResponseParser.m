@@ -0,0 +1,364 @@
+//
+//  BDBStreamingResponseParser.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#import "BDBStreamingResponseParser.h"
+#import "BDBErrors.h"
+
+
+typedef NS_ENUM(NSInteger, BDBStreamingParserState)
+{
+    BDBStreamingParserStateBegin,
+    BDBStreamingParserStateExpectKey,
+    BDBStreamingParserStateExpectColon,
+    BDBStreamingParserStateExpectValue,
+    BDBStreamingParserStateAfterValue,
+    BDBStreamingParserStateExpectElement,
+    BDBStreamingParserStateAfterElement,
+    BDBStreamingParserStateCapture,
+    BDBStreamingParserStateEnd,
+    BDBStreamingParserStateError,
+};
+
+typedef NS_ENUM(NSInteger, BDBStreamingParserCapture)
+{
+    BDBStreamingParserCaptureKey,
+    BDBStreamingParserCaptureValue,
+    BDBStreamingParserCaptureElement,
+};
+
+static NSString * const BDBStreamingParserDataKey = @"data";
+
+static inline BOOL BDBStreamingParserIsWhitespace(uint8_t c)
+{
+    return (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+}
+
+
+#pragma mark -
+@interface BDBStreamingResponseParser ()
+{
+    BOOL (^_elementHandler)(id element);
+
+    BDBStreamingParserState _state;
+    BDBStreamingParserCapture _capture;
+
+    NSMutableData *_buffer;
+    NSUInteger _captureDepth;
+    BOOL _captureStarted;
+    BOOL _inString;
+    BOOL _escaped;
+    BOOL _scalar;
+
+    NSString *_currentKey;
+    NSMutableDictionary *_envelope;
+}
+
+@property (nonatomic, readwrite) NSUInteger elementCount;
+@property (nonatomic, readwrite) NSTimeInterval parseDuration;
+
+- (BOOL)parseData:(NSData *)data error:(NSError *__autoreleasing *)error;
+- (void)beginCapture:(BDBStreamingParserCapture)capture;
+- (BOOL)finishCapture;
+
+@end
+
+
+#pragma mark -
+@implementation BDBStreamingResponseParser
+
+- (id)initWithElementHandler:(BOOL (^)(id))elementHandler
+{
+    NSParameterAssert(elementHandler);
+
+    self = [super init];
+    if (self)
+    {
+        _elementHandler = [elementHandler copy];
+        _state = BDBStreamingParserStateBegin;
+        _buffer = [NSMutableData data];
+        _envelope = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark State
+- (NSDictionary *)envelope
+{
+    return [_envelope copy];
+}
+
+- (BOOL)isComplete
+{
+    return (_state == BDBStreamingParserStateEnd);
+}
+
+#pragma mark Parsing
+- (BOOL)appendData:(NSData *)data error:(NSError *__autoreleasing *)error
+{
+    CFAbsoluteTime parseStart = CFAbsoluteTimeGetCurrent();
+    BOOL parsed = [self parseData:data error:error];
+    self.parseDuration += CFAbsoluteTimeGetCurrent() - parseStart;
+    return parsed;
+}
+
+- (BOOL)parseData:(NSData *)data error:(NSError *__autoreleasing *)error
+{
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSUInteger captureStart = 0;
+    NSUInteger i = 0;
+
+    while (i < length && _state != BDBStreamingParserStateError)
+    {
+        uint8_t c = bytes[i];
+
+        if (_state == BDBStreamingParserStateCapture)
+        {
+            BOOL finished = NO;
+            NSUInteger captureEnd = 0;
+
+            if (!_captureStarted)
+            {
+                _captureStarted = YES;
+                if (c == '"')
+                    _inString = YES;
+                else if (c == '{' || c == '[')
+                    _captureDepth = 1;
+                else
+                    _scalar = YES;
+                i++;
+            }
+            else if (_scalar)
+            {
+                // Scalars end at the next delimiter, which belongs to the enclosing structure.
+                if (c == ',' || c == '}' || c == ']' || BDBStreamingParserIsWhitespace(c))
+                {
+                    finished = YES;
+                    captureEnd = i;
+                }
+                else
+                    i++;
+            }
+            else if (_inString)
+            {
+                if (_escaped)
+                    _escaped = NO;
+                else if (c == '\\')
+                    _escaped = YES;
+                else if (c == '"')
+                {
+                    _inString = NO;
+                    if (_captureDepth == 0)
+                    {
+                        finished = YES;
+                        captureEnd = i + 1;
+                    }
+                }
+                i++;
+            }
+            else
+            {
+                if (c == '"')
+                    _inString = YES;
+                else if (c == '{' || c == '[')
+                    _captureDepth++;
+                else if (c == '}' || c == ']')
+                {
+                    _captureDepth--;
+                    if (_captureDepth == 0)
+                    {
+                        finished = YES;
+                        captureEnd = i + 1;
+                    }
+                }
+                i++;
+            }
+
+            if (finished)
+            {
+                [_buffer appendBytes:bytes + captureStart length:captureEnd - captureStart];
+                if (![self finishCapture])
+                    _state = BDBStreamingParserStateError;
+            }
+            continue;
+        }
+
+        if (BDBStreamingParserIsWhitespace(c))
+        {
+            i++;
+            continue;
+        }
+
+        switch (_state)
+        {
+            case BDBStreamingParserStateBegin:
+            {
+                _state = (c == '{') ? BDBStreamingParserStateExpectKey : BDBStreamingParserStateError;
+                i++;
+                break;
+            }
+            case BDBStreamingParserStateExpectKey:
+            {
+                if (c == '"')
+                {
+                    captureStart = i;
+                    [self beginCapture:BDBStreamingParserCaptureKey];
+                }
+                else
+                {
+                    _state = (c == '}') ? BDBStreamingParserStateEnd : BDBStreamingParserStateError;
+                    i++;
+                }
+                break;
+            }
+            case BDBStreamingParserStateExpectColon:
+            {
+                _state = (c == ':') ? BDBStreamingParserStateExpectValue : BDBStreamingParserStateError;
+                i++;
+                break;
+            }
+            case BDBStreamingParserStateExpectValue:
+            {
+                if (c == '[' && [_currentKey isEqualToString:BDBStreamingParserDataKey])
+                {
+                    _state = BDBStreamingParserStateExpectElement;
+                    i++;
+                }
+                else
+                {
+                    captureStart = i;
+                    [self beginCapture:BDBStreamingParserCaptureValue];
+                }
+                break;
+            }
+            case BDBStreamingParserStateAfterValue:
+            {
+                if (c == ',')
+                    _state = BDBStreamingParserStateExpectKey;
+                else if (c == '}')
+                    _state = BDBStreamingParserStateEnd;
+                else
+                    _state = BDBStreamingParserStateError;
+                i++;
+                break;
+            }
+            case BDBStreamingParserStateExpectElement:
+            {
+                if (c == ']')
+                {
+                    _state = BDBStreamingParserStateAfterValue;
+                    i++;
+                }
+                else
+                {
+                    captureStart = i;
+                    [self beginCapture:BDBStreamingParserCaptureElement];
+                }
+                break;
+            }
+            case BDBStreamingParserStateAfterElement:
+            {
+                if (c == ',')
+                    _state = BDBStreamingParserStateExpectElement;
+                else if (c == ']')
+                    _state = BDBStreamingParserStateAfterValue;
+                else
+                    _state = BDBStreamingParserStateError;
+                i++;
+                break;
+            }
+            case BDBStreamingParserStateEnd:
+            case BDBStreamingParserStateCapture:
+            case BDBStreamingParserStateError:
+            default:
+            {
+                _state = BDBStreamingParserStateError;
+                break;
+            }
+        }
+    }
+
+    if (_state == BDBStreamingParserStateCapture && length > captureStart)
+        [_buffer appendBytes:bytes + captureStart length:length - captureStart];
+
+    if (_state == BDBStreamingParserStateError)
+    {
+        if (error)
+            *error = [NSError errorWithDomain:BreweryDBErrorDomain
+                                         code:BDB_ERRNO_BAD_API_RESPONSE
+                                     userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_BAD_API_RESPONSE}];
+        return NO;
+    }
+
+    return YES;
+}
+
+- (void)beginCapture:(BDBStreamingParserCapture)capture
+{
+    _state = BDBStreamingParserStateCapture;
+    _capture = capture;
+    _captureDepth = 0;
+    _captureStarted = NO;
+    _inString = NO;
+    _escaped = NO;
+    _scalar = NO;
+    [_buffer setLength:0];
+}
+
+- (BOOL)finishCapture
+{
+    BOOL succeeded = YES;
+    @autoreleasepool
+    {
+        id object = [NSJSONSerialization JSONObjectWithData:_buffer options:NSJSONReadingAllowFragments error:NULL];
+        [_buffer setLength:0];
+        if (!object)
+            return NO;
+
+        switch (_capture)
+        {
+            case BDBStreamingParserCaptureKey:
+            {
+                _currentKey = [object isKindOfClass:[NSString class]] ? object : nil;
+                _state = BDBStreamingParserStateExpectColon;
+                succeeded = (_currentKey != nil);
+                break;
+            }
+            case BDBStreamingParserCaptureValue:
+            {
+                _envelope[_currentKey] = object;
+                _state = BDBStreamingParserStateAfterValue;
+                break;
+            }
+            case BDBStreamingParserCaptureElement:
+            {
+                self.elementCount++;
+                _state = BDBStreamingParserStateAfterElement;
+                succeeded = _elementHandler(object);
+                break;
+            }
+        }
+    }
+    return succeeded;
+}
+
+@end
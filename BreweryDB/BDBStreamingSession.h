@@ -0,0 +1,89 @@
+//
+//  BDBStreamingSession.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequestMetrics.h"
+
+@class BDBStreamingResponseParser;
+
+
+#pragma mark -
+@interface BDBStreamingSession : NSObject
+
+/**
+ *  Create a session that hands response bytes to a parser as they arrive
+ *  instead of buffering the whole body.
+ *
+ *  @param configuration Configuration for the underlying NSURLSession.
+ *
+ *  @return A new streaming session.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration;
+
+/**
+ *  Start a data task whose body is fed to a streaming parser. The parser and
+ *  the completion block both run on the session's private serial queue.
+ *
+ *  @param request    The request to perform.
+ *  @param parser     Parser receiving each chunk of the response body.
+ *  @param progress   Optional, called after each chunk with the bytes received and expected.
+ *  @param completion Called once the task finishes, with the parser's error if it rejected the body, or an
+ *                    NSURLErrorBadServerResponse error if the status was not 2xx.
+ *
+ *  @return The running data task.
+ *
+ *  @since 1.1.0
+ */
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                       parser:(BDBStreamingResponseParser *)parser
+                                     progress:(void (^)(int64_t bytesReceived, int64_t bytesExpected))progress
+                                   completion:(void (^)(NSHTTPURLResponse *response, NSError *error))completion;
+
+#if BDB_CAN_USE_TASK_METRICS
+/**
+ *  Called on the session's private queue with each task's metrics, before
+ *  the task's completion block.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic, copy) void (^taskMetricsHandler)(NSURLSessionTask *task, NSURLSessionTaskMetrics *taskMetrics) NS_AVAILABLE(10_12, 10_0);
+#endif
+
+/**
+ *  Cancel outstanding tasks and release the session.
+ *
+ *  @since 1.1.0
+ */
+- (void)invalidate;
+
+/**
+ *  Let outstanding tasks finish, then release the session.
+ *
+ *  @since 1.1.0
+ */
+- (void)finishTasksAndInvalidate;
+
+@end
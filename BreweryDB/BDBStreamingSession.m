@@ -0,0 +1,193 @@
+//
+//  BDBStreamingSession.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBStreamingSession.h"
+#import "BDBStreamingResponseParser.h"
+
+
+#pragma mark -
+@interface BDBStreamingTask : NSObject
+
+@property (nonatomic) BDBStreamingResponseParser *parser;
+@property (nonatomic, copy) void (^progress)(int64_t bytesReceived, int64_t bytesExpected);
+@property (nonatomic, copy) void (^completion)(NSHTTPURLResponse *response, NSError *error);
+@property (nonatomic) NSError *parseError;
+
+@end
+
+
+#pragma mark -
+@implementation BDBStreamingTask
+@end
+
+
+#pragma mark -
+@interface BDBStreamingSession () <NSURLSessionDataDelegate>
+{
+    NSURLSession *_session;
+    NSMutableDictionary *_tasks;
+}
+
+@end
+
+
+#pragma mark -
+@implementation BDBStreamingSession
+
+- (id)initWithSessionConfiguration:(NSURLSessionConfiguration *)configuration
+{
+    self = [super init];
+    if (self)
+    {
+        NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.name = @"com.brewerydb.streaming";
+        delegateQueue.maxConcurrentOperationCount = 1;
+
+        _session = [NSURLSession sessionWithConfiguration:(configuration ?: [NSURLSessionConfiguration defaultSessionConfiguration])
+                                                 delegate:self
+                                            delegateQueue:delegateQueue];
+        _tasks = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark Tasks
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                       parser:(BDBStreamingResponseParser *)parser
+                                     progress:(void (^)(int64_t, int64_t))progress
+                                   completion:(void (^)(NSHTTPURLResponse *, NSError *))completion
+{
+    NSParameterAssert(request);
+    NSParameterAssert(parser);
+    NSParameterAssert(completion);
+
+    BDBStreamingTask *streamingTask = [[BDBStreamingTask alloc] init];
+    streamingTask.parser = parser;
+    streamingTask.progress = progress;
+    streamingTask.completion = completion;
+
+    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+    @synchronized(self)
+    {
+        _tasks[@(task.taskIdentifier)] = streamingTask;
+    }
+    [task resume];
+    return task;
+}
+
+- (void)invalidate
+{
+    [_session invalidateAndCancel];
+}
+
+- (void)finishTasksAndInvalidate
+{
+    [_session finishTasksAndInvalidate];
+}
+
+#pragma mark NSURLSessionDataDelegate
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler
+{
+    // An error status carries no list to stream, so the task fails before its body reaches the parser.
+    NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse *)response statusCode] : 200;
+    if (statusCode >= 200 && statusCode < 300)
+    {
+        completionHandler(NSURLSessionResponseAllow);
+        return;
+    }
+
+    BDBStreamingTask *streamingTask = nil;
+    @synchronized(self)
+    {
+        streamingTask = _tasks[@(dataTask.taskIdentifier)];
+    }
+    NSString *description = [NSString stringWithFormat:@"Request failed: %@ (%ld)",
+                             [NSHTTPURLResponse localizedStringForStatusCode:statusCode], (long)statusCode];
+    streamingTask.parseError = [NSError errorWithDomain:NSURLErrorDomain
+                                                   code:NSURLErrorBadServerResponse
+                                               userInfo:@{NSLocalizedDescriptionKey:description}];
+    completionHandler(NSURLSessionResponseCancel);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data
+{
+    BDBStreamingTask *streamingTask = nil;
+    @synchronized(self)
+    {
+        streamingTask = _tasks[@(dataTask.taskIdentifier)];
+    }
+
+    if (!streamingTask || streamingTask.parseError)
+        return;
+
+    // NSURLSession may hand over a discontiguous dispatch_data; the parser walks each region in place.
+    __block NSError *parseError = nil;
+    [data enumerateByteRangesUsingBlock:^(const void *bytes, NSRange byteRange, BOOL *stop) {
+        NSData *region = [NSData dataWithBytesNoCopy:(void *)bytes length:byteRange.length freeWhenDone:NO];
+        NSError *error = nil;
+        if (![streamingTask.parser appendData:region error:&error])
+        {
+            parseError = error;
+            *stop = YES;
+        }
+    }];
+
+    if (parseError)
+    {
+        streamingTask.parseError = parseError;
+        [dataTask cancel];
+    }
+    else if (streamingTask.progress)
+        streamingTask.progress(dataTask.countOfBytesReceived, dataTask.countOfBytesExpectedToReceive);
+}
+
+#if BDB_CAN_USE_TASK_METRICS
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    void (^taskMetricsHandler)(NSURLSessionTask *, NSURLSessionTaskMetrics *) = self.taskMetricsHandler;
+    if (taskMetricsHandler)
+        taskMetricsHandler(task, metrics);
+}
+#endif
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error
+{
+    BDBStreamingTask *streamingTask = nil;
+    @synchronized(self)
+    {
+        streamingTask = _tasks[@(task.taskIdentifier)];
+        [_tasks removeObjectForKey:@(task.taskIdentifier)];
+    }
+
+    NSHTTPURLResponse *response = nil;
+    if ([task.response isKindOfClass:[NSHTTPURLResponse class]])
+        response = (NSHTTPURLResponse *)task.response;
+
+    if (streamingTask.completion)
+        streamingTask.completion(response, streamingTask.parseError ?: error);
+}
+
+@end
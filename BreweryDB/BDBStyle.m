@@ -21,11 +21,29 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBStyle.h"
+#import "BDBGeneratedDecoders.h"
 #import "BDBCategory.h"
 
+
+#pragma mark -
+@interface BDBStyle ()
+{
+    // In lazy mode, the category and the trimmed description are decoded on first access from the parts of
+    // the dictionary kept here, each released once decoded. Otherwise they are decoded up front and _lazy
+    // is cleared, so the accessors take no lock.
+    BOOL _lazy;
+    NSMutableDictionary *_lazyValues;
+}
+
+@end
+
+
 #pragma mark -
 @implementation BDBStyle
 
+@synthesize descriptionString = _descriptionString;
+@synthesize category = _category;
+
 - (id)initWithDictionary:(NSDictionary *)dictionary
 {
     self = [super init];
@@ -35,37 +53,90 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _styleId            = dictionary[@"id"];
-        
-        NSDictionary* categoryDictionary = dictionary[NSStringFromSelector(@selector(category))];
-        _category = [[BDBCategory alloc] initWithDictionary:categoryDictionary];
-
-        _srmMax             = dictionary[NSStringFromSelector(@selector(srmMax))];
-        _ibuMax             = dictionary[NSStringFromSelector(@selector(ibuMax))];
-        _srmMin             = dictionary[NSStringFromSelector(@selector(srmMin))];
-        _descriptionString  = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-        _fgMin              = dictionary[NSStringFromSelector(@selector(fgMin))];
-        _ibuMin             = dictionary[NSStringFromSelector(@selector(ibuMin))];
-        _createDate         = dictionary[NSStringFromSelector(@selector(createDate))];
-        _fgMax              = dictionary[NSStringFromSelector(@selector(fgMax))];
-        _abvMax             = dictionary[NSStringFromSelector(@selector(abvMax))];
-        _ogMin              = dictionary[NSStringFromSelector(@selector(ogMin))];
-        _ogMax              = dictionary[NSStringFromSelector(@selector(ogMax))];
-        _abvMin             = dictionary[NSStringFromSelector(@selector(abvMin))];
-        _name               = dictionary[NSStringFromSelector(@selector(name))];
-        _categoryId         = dictionary[NSStringFromSelector(@selector(categoryId))];
-
-        _status             = dictionary[NSStringFromSelector(@selector(status))];
+        NSLog(@"Could not parse style: %@", dictionary);
+        return nil;
     }
-    @catch (NSException *exception)
+
+    BDB_DECODE_STYLE(dictionary);
+
+    _lazy = YES;
+    _lazyValues = [[dictionary dictionaryWithValuesForKeys:BDB_LAZY_KEYS_STYLE] mutableCopy];
+    if (!BDBLazyDecodingEnabled)
     {
-        NSLog(@"Could not parse style: %@", exception);
-        return nil;
+        [self descriptionString];
+        [self category];
+        _lazy = NO;
     }
 
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_STYLE(dictionary);
+    return dictionary;
+}
+
+#pragma mark Lazy Decoding
+- (NSString *)descriptionString
+{
+    if (!_lazy)
+        return _descriptionString;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        if (value)
+            _descriptionString = BDBTrimmedStringValue(value);
+        return _descriptionString;
+    }
+}
+
+- (void)setDescriptionString:(NSString *)descriptionString
+{
+    if (!_lazy)
+    {
+        _descriptionString = [descriptionString copy];
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyDescription);
+        _descriptionString = [descriptionString copy];
+    }
+}
+
+- (BDBCategory *)category
+{
+    if (!_lazy)
+        return _category;
+
+    @synchronized(self)
+    {
+        id value = BDBTakeLazyValue(&_lazyValues, BDBModelKeyCategory);
+        if (value)
+            _category = [[BDBIdentityMap sharedMap] objectOfClass:[BDBCategory class] withDictionary:BDBDictionaryValue(value)];
+        return _category;
+    }
+}
+
+- (void)setCategory:(BDBCategory *)category
+{
+    if (!_lazy)
+    {
+        _category = category;
+        return;
+    }
+
+    @synchronized(self)
+    {
+        BDBTakeLazyValue(&_lazyValues, BDBModelKeyCategory);
+        _category = category;
+    }
+}
+
 @end
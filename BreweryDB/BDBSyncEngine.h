@@ -0,0 +1,100 @@
+//
+//  BDBSyncEngine.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import <Foundation/Foundation.h>
+
+#import "BDBRequest.h"
+
+@class BreweryDB;
+
+
+#pragma mark -
+@interface BDBSyncEngine : NSObject
+
+/**
+ *  Create a sync engine that keeps the client's store up to date.
+ *
+ *  @param client The client requests are made with. Its store is synced.
+ *
+ *  @return A new sync engine.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithClient:(BreweryDB *)client;
+
+/**
+ *  Create a sync engine for +[BreweryDB defaultClient].
+ *
+ *  @since 1.1.0
+ */
+- (id)init;
+
+/**
+ *  The model classes synced, in order. Any of BDBBrewery, BDBLocation and
+ *  BDBBeer; defaults to all three.
+ *
+ *  @since 1.1.0
+ */
+@property (nonatomic, copy) NSArray *modelClasses;
+
+/**
+ *  Time the last completed sync of a model class started, or nil if it has
+ *  never completed.
+ *
+ *  @param modelClass One of modelClasses.
+ *
+ *  @since 1.1.0
+ */
+- (NSDate *)lastSyncDateForClass:(Class)modelClass;
+
+/**
+ *  Forget every sync mark, so the next sync pulls every object again.
+ *
+ *  @since 1.1.0
+ */
+- (void)reset;
+
+/**
+ *  Pull the objects changed since each class last synced, a page at a time,
+ *  and merge them into the store by ID. Objects whose status is "deleted" are
+ *  removed. A class that has never synced, or last synced longer ago than the
+ *  API's since filter reaches, is pulled in full.
+ *
+ *  Progress is committed with each page, so a sync that fails or is cancelled
+ *  resumes from the next page when it is started again.
+ *
+ *  @param callbackQueue Queue progress, success and failure are performed on.
+ *  @param progress      Optional callback performed as each page is merged.
+ *  @param success       Called once with the number of objects stored and removed.
+ *  @param failure       Called once with the first error, or with NSURLErrorCancelled after -cancel.
+ *
+ *  @return A handle that cancels the sync.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)syncWithCallbackQueue:(dispatch_queue_t)callbackQueue
+                             progress:(void (^)(Class modelClass, NSUInteger completedPages, NSUInteger numberOfPages))progress
+                              success:(void (^)(NSUInteger storedCount, NSUInteger removedCount))success
+                              failure:(void (^)(NSError *error))failure;
+
+@end
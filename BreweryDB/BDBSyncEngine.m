@@ -0,0 +1,327 @@
+//
+//  BDBSyncEngine.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#import "BDBSyncEngine.h"
+#import "BDBErrors.h"
+#import "BDBRequest_Private.h"
+#import "BreweryDB.h"
+
+
+// Marks come from the device clock, so each delta reaches back a little before
+// the previous sync started; merging a record twice is harmless.
+static NSTimeInterval const BDBSyncEngineOverlap = 10 * 60;
+// The API only accepts since values up to 30 days old.
+static NSTimeInterval const BDBSyncEngineMaximumSinceAge = 30 * 24 * 60 * 60;
+static NSString * const BDBSyncEngineDeletedStatus = @"deleted";
+
+static NSString *BDBSyncEngineEndpointForClass(Class modelClass)
+{
+    if (modelClass == [BDBBrewery class])
+        return @"breweries";
+    if (modelClass == [BDBLocation class])
+        return @"locations";
+    if (modelClass == [BDBBeer class])
+        return @"beers";
+    return nil;
+}
+
+static NSString *BDBSyncEngineMarkKey(Class modelClass)
+{
+    return [NSString stringWithFormat:@"sync.%@.mark", BDBSyncEngineEndpointForClass(modelClass)];
+}
+
+static NSString *BDBSyncEnginePassKey(Class modelClass)
+{
+    return [NSString stringWithFormat:@"sync.%@.pass", BDBSyncEngineEndpointForClass(modelClass)];
+}
+
+
+#pragma mark -
+@interface BDBSyncEngine ()
+{
+    BreweryDB *_client;
+
+    // Everything below is only touched on _queue.
+    dispatch_queue_t _queue;
+    BDBRequest *_request;
+    BDBStore *_store;
+    NSArray *_syncClasses;
+    dispatch_queue_t _callbackQueue;
+    void (^_progress)(Class, NSUInteger, NSUInteger);
+    void (^_success)(NSUInteger, NSUInteger);
+    void (^_failure)(NSError *);
+
+    NSUInteger _classIndex;
+    NSTimeInterval _passStarted;
+    NSNumber *_passSince;
+    NSUInteger _completedPages;
+    NSUInteger _storedCount;
+    NSUInteger _removedCount;
+}
+
+- (void)syncNextClass;
+- (void)requestNextPage;
+- (void)mergePage:(NSArray *)objects currentPage:(NSUInteger)currentPage numberOfPages:(NSUInteger)numberOfPages;
+- (void)finishWithError:(NSError *)error;
+
+@end
+
+
+#pragma mark -
+@implementation BDBSyncEngine
+
+- (id)init
+{
+    return [self initWithClient:[BreweryDB defaultClient]];
+}
+
+- (id)initWithClient:(BreweryDB *)client
+{
+    NSParameterAssert(client);
+
+    self = [super init];
+    if (self)
+    {
+        _client = client;
+        _modelClasses = @[[BDBBrewery class], [BDBLocation class], [BDBBeer class]];
+        _queue = dispatch_queue_create("com.brewerydb.sync", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (NSDate *)lastSyncDateForClass:(Class)modelClass
+{
+    NSParameterAssert(BDBSyncEngineEndpointForClass(modelClass));
+
+    NSString *mark = [_client.store metadataValueForKey:BDBSyncEngineMarkKey(modelClass)];
+    return mark ? [NSDate dateWithTimeIntervalSince1970:mark.doubleValue] : nil;
+}
+
+- (void)reset
+{
+    BDBStore *store = _client.store;
+    for (Class modelClass in self.modelClasses)
+    {
+        [store setMetadataValue:nil forKey:BDBSyncEngineMarkKey(modelClass)];
+        [store setMetadataValue:nil forKey:BDBSyncEnginePassKey(modelClass)];
+    }
+}
+
+- (BDBRequest *)syncWithCallbackQueue:(dispatch_queue_t)callbackQueue
+                             progress:(void (^)(Class, NSUInteger, NSUInteger))progress
+                              success:(void (^)(NSUInteger, NSUInteger))success
+                              failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(callbackQueue);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    BDBRequest *request = [[BDBRequest alloc] initWithPriority:BDBRequestPriorityBulk];
+    [request addCancellationHandler:^{
+        dispatch_async(callbackQueue, ^{
+            failure([NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil]);
+        });
+    }];
+
+    NSArray *modelClasses = self.modelClasses;
+    for (Class modelClass in modelClasses)
+        NSAssert(BDBSyncEngineEndpointForClass(modelClass), @"%@ cannot be synced", modelClass);
+
+    dispatch_async(_queue, ^{
+        NSAssert(!_request || _request.isFinished || _request.isCancelled, @"A sync engine runs one sync at a time");
+
+        _request = request;
+        _store = _client.store;
+        _syncClasses = modelClasses;
+        _callbackQueue = callbackQueue;
+        _progress = [progress copy];
+        _success = [success copy];
+        _failure = [failure copy];
+        _classIndex = 0;
+        _storedCount = 0;
+        _removedCount = 0;
+
+        if (!_store)
+        {
+            [self finishWithError:[NSError errorWithDomain:BreweryDBErrorDomain
+                                                      code:BDB_ERRNO_MISSING_STORE
+                                                  userInfo:@{NSLocalizedDescriptionKey:BDB_ERROR_MISSING_STORE}]];
+            return;
+        }
+        [self syncNextClass];
+    });
+
+    return request;
+}
+
+#pragma mark Syncing
+- (void)syncNextClass
+{
+    if (_request.isCancelled)
+        return;
+
+    if (_classIndex >= _syncClasses.count)
+    {
+        if (![_request markFinished])
+            return;
+
+        NSUInteger storedCount = _storedCount;
+        NSUInteger removedCount = _removedCount;
+        void (^success)(NSUInteger, NSUInteger) = _success;
+        dispatch_async(_callbackQueue, ^{
+            success(storedCount, removedCount);
+        });
+        return;
+    }
+
+    // A pass that was interrupted carries on from its last committed page with the same
+    // since value. The objects matching that filter only grow while the pass runs, so
+    // pages can only shift later and no object is skipped.
+    Class modelClass = _syncClasses[_classIndex];
+    NSData *passData = [[_store metadataValueForKey:BDBSyncEnginePassKey(modelClass)] dataUsingEncoding:NSUTF8StringEncoding];
+    NSDictionary *pass = passData ? [NSJSONSerialization JSONObjectWithData:passData options:0 error:NULL] : nil;
+    if ([pass isKindOfClass:[NSDictionary class]] && [pass[@"started"] isKindOfClass:[NSNumber class]])
+    {
+        _passStarted = [pass[@"started"] doubleValue];
+        _passSince = [pass[@"since"] isKindOfClass:[NSNumber class]] ? pass[@"since"] : nil;
+        _completedPages = [pass[@"page"] unsignedIntegerValue];
+    }
+    else
+    {
+        NSString *mark = [_store metadataValueForKey:BDBSyncEngineMarkKey(modelClass)];
+        _passStarted = [[NSDate date] timeIntervalSince1970];
+        _passSince = nil;
+        if (mark && _passStarted - mark.doubleValue < BDBSyncEngineMaximumSinceAge - BDBSyncEngineOverlap)
+            _passSince = @((long long)floor(mark.doubleValue - BDBSyncEngineOverlap));
+        _completedPages = 0;
+    }
+
+    [self requestNextPage];
+}
+
+- (void)requestNextPage
+{
+    Class modelClass = _syncClasses[_classIndex];
+    NSMutableDictionary *parameters = [@{BreweryDBRequestOptionCallbackQueueKey: _queue,
+                                         BreweryDBRequestOptionPriorityKey: @(BDBRequestPriorityBulk)} mutableCopy];
+    if (_passSince)
+        parameters[@"since"] = _passSince;
+
+    BDBPageRequestBlock pageRequest = nil;
+    if (modelClass == [BDBBrewery class])
+        pageRequest = [_client pageRequestForBreweriesWithParameters:parameters];
+    else if (modelClass == [BDBLocation class])
+        pageRequest = [_client pageRequestForLocationsWithParameters:parameters];
+    else
+        pageRequest = [_client pageRequestForBeersWithParameters:parameters withBreweryInfo:YES];
+
+    // Callbacks from a sync that has since been cancelled or replaced are ignored.
+    BDBRequest *request = _request;
+    [request addChildRequest:pageRequest(_completedPages + 1,
+                                         ^(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                             if (request == _request && !request.isCancelled)
+                                                 [self mergePage:objects currentPage:currentPage numberOfPages:numberOfPages];
+                                         },
+                                         ^(NSError *error) {
+                                             if (request == _request)
+                                                 [self finishWithError:error];
+                                         })];
+}
+
+- (void)mergePage:(NSArray *)objects currentPage:(NSUInteger)currentPage numberOfPages:(NSUInteger)numberOfPages
+{
+    Class modelClass = _syncClasses[_classIndex];
+
+    // The client has already queued every object of a page fetched from the network for storing, and
+    // a page answered from the response cache was stored when it was fetched; deletes queue behind them.
+    NSMutableArray *removedIds = [NSMutableArray array];
+    for (id object in objects)
+    {
+        if (![[object status] isEqual:BDBSyncEngineDeletedStatus])
+            continue;
+
+        NSString *identifier = nil;
+        if ([object isKindOfClass:[BDBBrewery class]])
+            identifier = [object breweryId];
+        else if ([object isKindOfClass:[BDBLocation class]])
+            identifier = [object locationId];
+        else if ([object isKindOfClass:[BDBBeer class]])
+            identifier = [object beerId];
+        if (identifier)
+            [removedIds addObject:identifier];
+    }
+    [_store removeObjectsOfClass:modelClass withIds:removedIds];
+    _removedCount += removedIds.count;
+    _storedCount += objects.count - removedIds.count;
+
+    _completedPages = MAX(currentPage, _completedPages + 1);
+    BOOL passFinished = (_completedPages >= numberOfPages || objects.count == 0);
+
+    // Checkpoints queue behind the page's writes, so they never get ahead of the stored objects.
+    if (passFinished)
+    {
+        [_store setMetadataValue:[NSString stringWithFormat:@"%.0f", _passStarted] forKey:BDBSyncEngineMarkKey(modelClass)];
+        [_store setMetadataValue:nil forKey:BDBSyncEnginePassKey(modelClass)];
+    }
+    else
+    {
+        NSMutableDictionary *pass = [@{@"started": @(_passStarted), @"page": @(_completedPages)} mutableCopy];
+        if (_passSince)
+            pass[@"since"] = _passSince;
+        NSData *passData = [NSJSONSerialization dataWithJSONObject:pass options:0 error:NULL];
+        [_store setMetadataValue:[[NSString alloc] initWithData:passData encoding:NSUTF8StringEncoding]
+                          forKey:BDBSyncEnginePassKey(modelClass)];
+    }
+
+    if (_progress)
+    {
+        void (^progress)(Class, NSUInteger, NSUInteger) = _progress;
+        NSUInteger completedPages = _completedPages;
+        dispatch_async(_callbackQueue, ^{
+            progress(modelClass, completedPages, MAX(numberOfPages, completedPages));
+        });
+    }
+
+    if (passFinished)
+    {
+        _classIndex++;
+        [self syncNextClass];
+    }
+    else
+    {
+        [self requestNextPage];
+    }
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (![_request markFinished])
+        return;
+
+    void (^failure)(NSError *) = _failure;
+    dispatch_async(_callbackQueue, ^{
+        failure(error);
+    });
+}
+
+@end
@@ -21,6 +21,7 @@
 //  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #import "BDBYeast.h"
+#import "BDBGeneratedDecoders.h"
 
 #pragma mark -
 @implementation BDBYeast
@@ -34,37 +35,22 @@
     if (!dictionary)
         return self;
 
-    @try
+    if (![dictionary isKindOfClass:[NSDictionary class]])
     {
-        _yeastId = dictionary[@"id"];
-        _name = dictionary[NSStringFromSelector(@selector(name))];
-        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-
-        _yeastType = dictionary[NSStringFromSelector(@selector(yeastType))];
-
-        _attenuationMin = dictionary[NSStringFromSelector(@selector(attenuationMin))];
-        _attenuationMax = dictionary[NSStringFromSelector(@selector(attenuationMax))];
-        _fermentTempMin = dictionary[NSStringFromSelector(@selector(fermentTempMin))];
-        _fermentTempMax = dictionary[NSStringFromSelector(@selector(fermentTempMax))];
-        _alcoholToleranceMin = dictionary[NSStringFromSelector(@selector(alcoholToleranceMin))];
-        _alcoholToleranceMax = dictionary[NSStringFromSelector(@selector(alcoholToleranceMax))];
-
-        _productId = dictionary[NSStringFromSelector(@selector(productId))];
-        _supplier = dictionary[NSStringFromSelector(@selector(supplier))];
-        _yeastFormat = dictionary[NSStringFromSelector(@selector(yeastFormat))];
-        
-        _category = dictionary[NSStringFromSelector(@selector(category))];
-        _categoryDisplay = dictionary[NSStringFromSelector(@selector(categoryDisplay))];
-
-        _status = dictionary[NSStringFromSelector(@selector(status))];
-    }
-    @catch (NSException *exception)
-    {
-        NSLog(@"Could not parse beer: %@", exception);
+        NSLog(@"Could not parse yeast: %@", dictionary);
         return nil;
     }
 
+    BDB_DECODE_YEAST(dictionary);
+
     return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    BDB_ENCODE_YEAST(dictionary);
+    return dictionary;
+}
+
 @end
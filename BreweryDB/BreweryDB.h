@@ -31,6 +31,34 @@
 #import "BDBFermentable.h"
 #import "BDBHop.h"
 #import "BDBYeast.h"
+#import "BDBResponseCache.h"
+#import "BDBStore.h"
+#import "BDBIdentityMap.h"
+#import "BDBPageFetcher.h"
+#import "BDBPageCursor.h"
+#import "BDBPagedCollection.h"
+#import "BDBColumnarResultSet.h"
+#import "BDBBatchLoader.h"
+#import "BDBHydrator.h"
+#import "BDBSyncEngine.h"
+#import "BDBImagePipeline.h"
+#import "BDBRequestScheduler.h"
+#import "BDBKeyPool.h"
+#import "BDBRetryPolicy.h"
+#import "BDBRequest.h"
+#import "BDBRequestMetrics.h"
+#import "BDBMetricsCollector.h"
+
+
+/**
+ *  Request options travel in the parameters dictionary of any fetch or search
+ *  method and are stripped before the request is sent.
+ */
+FOUNDATION_EXPORT NSString * const BreweryDBRequestOptionCallbackQueueKey;  // dispatch_queue_t for this call's success/failure blocks
+FOUNDATION_EXPORT NSString * const BreweryDBRequestOptionStreamingKey;      // NSNumber BOOL; decode list results as the response streams in
+FOUNDATION_EXPORT NSString * const BreweryDBRequestOptionItemHandlerKey;    // void (^)(id object) performed in order for each streamed result, before success; implies streaming
+FOUNDATION_EXPORT NSString * const BreweryDBRequestOptionPriorityKey;       // NSNumber BDBRequestPriority; defaults to BDBRequestPriorityInteractive
+FOUNDATION_EXPORT NSString * const BreweryDBRequestOptionPreferLocalKey;    // NSNumber BOOL; answer searches from the store, using the network only when nothing matches
 
 
 typedef NS_ENUM(NSInteger, BreweryDBSearchType)
@@ -51,20 +79,247 @@ typedef NS_ENUM(NSInteger, BreweryDBSearchType)
 @interface BreweryDB : NSObject
 
 #pragma mark Instantiation
+/**
+ *  The client the class methods perform their requests with.
+ *
+ *  @since 1.1.0
+ */
++ (instancetype)defaultClient;
+
 /**
  *  Create and start the BreweryDB client.
  *
  *  @param apiKey Your application's unique API key.
  *
- *  @return BreweryDB singelton
+ *  @return The default client, now using apiKey.
  *
  *  @since 1.0.0
  */
 + (instancetype)brew:(NSString *)apiKey;
 
+/**
+ *  Create a client of its own, e.g. to keep background sync from competing
+ *  with interactive requests. Each client has its own sessions, scheduler,
+ *  coalescing and callback queue; the response cache and store are shared
+ *  unless replaced.
+ *
+ *  @param apiKey               The API key requests are made with, or nil to use keyPool.
+ *  @param sessionConfiguration Tunes the client's URL sessions, e.g.
+ *                              HTTPMaximumConnectionsPerHost, timeoutIntervalForRequest
+ *                              or requestCachePolicy; HTTP/2 is negotiated automatically.
+ *                              Pass nil for the default configuration.
+ *
+ *  @return A new client.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithAPIKey:(NSString *)apiKey sessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration;
+
+@property (atomic, copy) NSString *apiKey;
+
+/**
+ *  Keys to spread requests over, by the quota each has left, instead of
+ *  apiKey. The scheduler then paces requests against the pool's combined
+ *  quota.
+ *
+ *  @since 1.1.0
+ */
+@property (atomic) BDBKeyPool *keyPool;
+
+#pragma mark Decoding
+/**
+ *  When enabled, models decoded from then on keep only the parts of their
+ *  source dictionary behind nested objects and descriptions (a beer's
+ *  breweries, style and ingredients; a brewery's locations; a style's
+ *  category) and decode each on first access, releasing that part as it is
+ *  decoded or set. Applies to every client and to models created directly.
+ *  Disabled by default: models decode every field up front and keep no
+ *  dictionary.
+ *
+ *  @since 1.1.0
+ */
++ (void)setLazyDecodingEnabled:(BOOL)lazyDecodingEnabled;
+
+/**
+ *  @return Whether models defer decoding nested objects until first access.
+ *
+ *  @since 1.1.0
+ */
++ (BOOL)isLazyDecodingEnabled;
+
+#pragma mark Callbacks
+/**
+ *  Set the queue success and failure blocks are performed on. Responses are
+ *  always decoded into model objects on a private background queue first. Use
+ *  BreweryDBRequestOptionCallbackQueueKey in a call's parameters to override
+ *  the queue for that call only.
+ *
+ *  @param callbackQueue The queue to deliver results on. Defaults to the main queue.
+ *
+ *  @since 1.1.0
+ */
+- (void)setCallbackQueue:(dispatch_queue_t)callbackQueue;
+
+/**
+ *  The queue success and failure blocks are performed on.
+ *
+ *  @since 1.1.0
+ */
+- (dispatch_queue_t)callbackQueue;
+
+/**
+ *  Observe how long each request spent waiting on the network (including JSON
+ *  deserialization, but not time queued in the request scheduler) and building
+ *  model objects. The observer is called on the private processing queue.
+ *
+ *  @param timingObserver Block receiving the request path and both durations, or nil.
+ *
+ *  @since 1.1.0
+ */
+- (void)setTimingObserver:(void (^)(NSString *path, NSTimeInterval networkDuration, NSTimeInterval decodeDuration))timingObserver;
+
+/**
+ *  Observe where each fetch and search request spent its time: scheduler
+ *  wait, network phases, JSON deserialization and model decoding, along with
+ *  status, size, item count and whether it was answered from the cache or
+ *  shared with an identical request. Pass the metrics to a
+ *  BDBMetricsCollector to keep per-endpoint histograms. Metrics are only
+ *  gathered while an observer is set. The observer is called on a private
+ *  queue before the request's own callbacks run.
+ *
+ *  @param metricsObserver Block receiving each finished request's metrics, or nil.
+ *
+ *  @since 1.1.0
+ */
+- (void)setMetricsObserver:(void (^)(BDBRequestMetrics *metrics))metricsObserver;
+
+#pragma mark Networking
+/**
+ *  Replace the URL session configuration requests are made with, e.g. to add
+ *  protocol classes such as BDBReplayURLProtocol or to change timeouts.
+ *
+ *  @param sessionConfiguration The configuration to use, or nil for the default configuration.
+ *
+ *  @since 1.1.0
+ */
+- (void)setSessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration;
+
+#pragma mark Caching
+/**
+ *  Set the cache consulted by every fetch and search request. Responses are
+ *  keyed on endpoint path and parameters, and revalidated with their ETag once
+ *  they expire. Defaults to [BDBResponseCache sharedCache].
+ *
+ *  @param responseCache The cache to use, or nil to always go to the network.
+ *
+ *  @since 1.1.0
+ */
+- (void)setResponseCache:(BDBResponseCache *)responseCache;
+
+/**
+ *  The cache currently used for API responses.
+ *
+ *  @return The response cache, or nil if caching is disabled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBResponseCache *)responseCache;
+
+#pragma mark Storage
+/**
+ *  Set the store every fetched beer, brewery, location, style, category, hop,
+ *  yeast, fermentable and guild is written into, once per response that came
+ *  from the network. Responses answered from the response cache are not written
+ *  again. Query it directly to render from disk while a fetch refreshes the
+ *  data. Defaults to [BDBStore sharedStore].
+ *
+ *  @param store The store to write to, or nil to stop writing results.
+ *
+ *  @since 1.1.0
+ */
+- (void)setStore:(BDBStore *)store;
+
+/**
+ *  @return The store fetched objects are written into.
+ *
+ *  @since 1.1.0
+ */
+- (BDBStore *)store;
+
+#pragma mark Batching
+/**
+ *  Configure the loaders behind -loadBeerWithId:withBreweryInfo:success:failure:
+ *  and -loadBreweryWithId:success:failure:.
+ *
+ *  @param batchWindow  How long the first lookup waits for others. Defaults to 10 milliseconds.
+ *  @param maxBatchSize Number of IDs that sends a batch immediately. Defaults to and is at most 50.
+ *
+ *  @since 1.1.0
+ */
+- (void)setBatchWindow:(NSTimeInterval)batchWindow maxBatchSize:(NSUInteger)maxBatchSize;
+
+#pragma mark Scheduling
+/**
+ *  Set the scheduler network requests wait in before they start. Requests are
+ *  started in priority order (see BreweryDBRequestOptionPriorityKey) as its
+ *  token bucket, per-priority limits and the remaining API quota allow.
+ *  Responses served from the cache never wait. Defaults to nil, which starts
+ *  every request immediately.
+ *
+ *  @param requestScheduler The scheduler to use.
+ *
+ *  @since 1.1.0
+ */
+- (void)setRequestScheduler:(BDBRequestScheduler *)requestScheduler;
+
+/**
+ *  @return The scheduler network requests wait in.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequestScheduler *)requestScheduler;
+
+#pragma mark Retries
+/**
+ *  Set the policy that retries transient failures with jittered backoff and
+ *  hedges slow requests with a duplicate once they outlast their endpoint's
+ *  recent latencies. Only plain GETs are covered; streamed responses are
+ *  never retried or hedged. Defaults to nil, which sends each request once.
+ *
+ *  @param retryPolicy The policy to use.
+ *
+ *  @since 1.1.0
+ */
+- (void)setRetryPolicy:(BDBRetryPolicy *)retryPolicy;
+
+/**
+ *  @return The policy failed and slow requests are retried with.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRetryPolicy *)retryPolicy;
+
+#pragma mark Coalescing
+/**
+ *  Number of requests that joined an identical request already in flight
+ *  instead of starting their own network task.
+ *
+ *  @since 1.1.0
+ */
+- (NSUInteger)coalescedRequestCount;
+
+/**
+ *  Number of requests that started their own network task.
+ *
+ *  @since 1.1.0
+ */
+- (NSUInteger)startedRequestCount;
+
 #pragma mark Search
 /**
- *  Perform a search query on the BreweryDB.
+ *  Perform a search query on the BreweryDB. With BreweryDBRequestOptionPreferLocalKey
+ *  set, beer, brewery and guild searches are answered from the store's full-text
+ *  index in pages of 50, and only go to the network when nothing matches locally.
  *
  *  @param queryString   What you're searching for.
  *  @param type          The type of result you're searching for.
@@ -72,14 +327,16 @@ typedef NS_ENUM(NSInteger, BreweryDBSearchType)
  *  @param success       Callback function performed on successful retrieval of results.
  *  @param failure       Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)search:(NSString *)queryString
-          type:(BreweryDBSearchType)type
-withBreweryInfo:(BOOL)withBreweryInfo
-    parameters:(NSDictionary *)parameters
-       success:(void (^)(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages))success
-       failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)search:(NSString *)queryString
+                  type:(BreweryDBSearchType)type
+       withBreweryInfo:(BOOL)withBreweryInfo
+            parameters:(NSDictionary *)parameters
+               success:(void (^)(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages))success
+               failure:(void (^)(NSError *error))failure;
 
 #pragma mark Beers
 /**
@@ -89,12 +346,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchBeersWithParameters:(NSDictionary *)parameters
-                 withBreweryInfo:(BOOL)withBreweryInfo
-                         success:(void (^)(NSArray *beers, NSUInteger currentPage, NSUInteger numberOfPages))success
-                         failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchBeersWithParameters:(NSDictionary *)parameters
+                         withBreweryInfo:(BOOL)withBreweryInfo
+                                 success:(void (^)(NSArray *beers, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                 failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single beer object specified by the beerId.
@@ -104,13 +363,35 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchBeerWithId:(NSString *)beerId
-        withBreweryInfo:(BOOL)withBreweryInfo
-             parameters:(NSDictionary *)parameters
-                success:(void (^)(BDBBeer *beer))success
-                failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchBeerWithId:(NSString *)beerId
+                withBreweryInfo:(BOOL)withBreweryInfo
+                     parameters:(NSDictionary *)parameters
+                        success:(void (^)(BDBBeer *beer))success
+                        failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch a single beer like -fetchBeerWithId:withBreweryInfo:parameters:success:failure:,
+ *  but batched: lookups made within a short window are sent together as one
+ *  beers?ids=... request, and each caller receives its own beer.
+ *
+ *  @param beerId          Unique ID describing the beer.
+ *  @param withBreweryInfo Include the breweries of the beer.
+ *  @param success         Callback function performed on successful retrieval of the beer.
+ *  @param failure         Callback function performed when an error occurs, or with
+ *                         BDB_ERRNO_OBJECT_NOT_FOUND if the batch did not contain the beer.
+ *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)loadBeerWithId:(NSString *)beerId
+               withBreweryInfo:(BOOL)withBreweryInfo
+                       success:(void (^)(BDBBeer *beer))success
+                       failure:(void (^)(NSError *error))failure;
 
 #pragma mark Breweries
 /**
@@ -120,11 +401,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchBreweriesWithParameters:(NSDictionary *)parameters
-                             success:(void (^)(NSArray *breweries, NSUInteger currentPage, NSUInteger numberOfPages))success
-                             failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchBreweriesWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *breweries, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                     failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single brewery object specified by the breweryId.
@@ -134,12 +417,31 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchBreweryWithId:(NSString *)breweryId
-                parameters:(NSDictionary *)parameters
-                   success:(void (^)(BDBBrewery *brewery))success
-                   failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchBreweryWithId:(NSString *)breweryId
+                        parameters:(NSDictionary *)parameters
+                           success:(void (^)(BDBBrewery *brewery))success
+                           failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch a single brewery, batched with other lookups made within a short
+ *  window into one breweries?ids=... request.
+ *
+ *  @param breweryId Unique ID describing the brewery.
+ *  @param success   Callback function performed on successful retrieval of the brewery.
+ *  @param failure   Callback function performed when an error occurs, or with
+ *                   BDB_ERRNO_OBJECT_NOT_FOUND if the batch did not contain the brewery.
+ *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)loadBreweryWithId:(NSString *)breweryId
+                          success:(void (^)(BDBBrewery *brewery))success
+                          failure:(void (^)(NSError *error))failure;
 
 #pragma mark Styles
 /**
@@ -149,11 +451,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchStylesWithParameters:(NSDictionary *)parameters
-                          success:(void (^)(NSArray *styles, NSUInteger currentPage, NSUInteger numberOfPages))success
-                          failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchStylesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *styles, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single style object specified by the styleId.
@@ -163,12 +467,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchStyleWithId:(NSString *)styleId
-              parameters:(NSDictionary *)parameters
-                 success:(void (^)(BDBStyle *style))success
-                 failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchStyleWithId:(NSString *)styleId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBStyle *style))success
+                         failure:(void (^)(NSError *error))failure;
 
 #pragma mark Categories
 /**
@@ -178,11 +484,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchCategoriesWithParameters:(NSDictionary *)parameters
-                              success:(void (^)(NSArray *categories, NSUInteger currentPage, NSUInteger numberOfPages))success
-                              failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchCategoriesWithParameters:(NSDictionary *)parameters
+                                      success:(void (^)(NSArray *categories, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                      failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single category object specified by the categoryId.
@@ -192,12 +500,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchCategoryWithId:(NSString *)categoryId
-                 parameters:(NSDictionary *)parameters
-                    success:(void (^)(BDBCategory *category))success
-                    failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchCategoryWithId:(NSString *)categoryId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBCategory *category))success
+                            failure:(void (^)(NSError *error))failure;
 
 #pragma mark Fermentables
 /**
@@ -207,11 +517,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchFermentablesWithParameters:(NSDictionary *)parameters
-                          success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
-                          failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchFermentablesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch an array of fermentables for a specific beer pertaining to the specified parameters.
@@ -220,12 +532,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchFermentablesForBeerId:(NSString *)beerId
-                    withParameters:(NSDictionary *)parameters
-                           success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
-                           failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchFermentablesForBeerId:(NSString *)beerId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                   failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single fermentable object specified by the fermentableId.
@@ -235,12 +549,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success       Callback function performed on successful retrieval of results.
  *  @param failure       Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchFermentableWithId:(NSString *)fermentableId
-                    parameters:(NSDictionary *)parameters
-                       success:(void (^)(BDBFermentable *fermentable))success
-                       failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchFermentableWithId:(NSString *)fermentableId
+                            parameters:(NSDictionary *)parameters
+                               success:(void (^)(BDBFermentable *fermentable))success
+                               failure:(void (^)(NSError *error))failure;
 
 #pragma mark Hops
 /**
@@ -250,11 +566,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchHopsWithParameters:(NSDictionary *)parameters
-                        success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
-                        failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchHopsWithParameters:(NSDictionary *)parameters
+                                success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch an array of hops for a specific beer pertaining to the specified parameters.
@@ -263,12 +581,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchHopsForBeerId:(NSString *)beerId
-            withParameters:(NSDictionary *)parameters
-                   success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
-                   failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchHopsForBeerId:(NSString *)beerId
+                    withParameters:(NSDictionary *)parameters
+                           success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
+                           failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single hop object specified by the hopId.
@@ -278,12 +598,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchHopWithId:(NSString *)hopId
-            parameters:(NSDictionary *)parameters
-               success:(void (^)(BDBHop *hop))success
-               failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchHopWithId:(NSString *)hopId
+                    parameters:(NSDictionary *)parameters
+                       success:(void (^)(BDBHop *hop))success
+                       failure:(void (^)(NSError *error))failure;
 
 #pragma mark Yeasts
 /**
@@ -293,11 +615,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchYeastsWithParameters:(NSDictionary *)parameters
-                          success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
-                          failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchYeastsWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch an array of yeasts for a specific beer pertaining to the specified parameters.
@@ -306,12 +630,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchYeastsForBeerId:(NSString *)beerId
-              withParameters:(NSDictionary *)parameters
-                     success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
-                     failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchYeastsForBeerId:(NSString *)beerId
+                      withParameters:(NSDictionary *)parameters
+                             success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
+                             failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single yeast object specified by the yeastId.
@@ -321,12 +647,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchYeastWithId:(NSString *)yeastId
-              parameters:(NSDictionary *)parameters
-                 success:(void (^)(BDBYeast *yeast))success
-                 failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchYeastWithId:(NSString *)yeastId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBYeast *yeast))success
+                         failure:(void (^)(NSError *error))failure;
 
 #pragma mark Locations
 /**
@@ -336,11 +664,13 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchLocationsWithParameters:(NSDictionary *)parameters
-                             success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
-                             failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchLocationsWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                     failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch an array of locations for a specific brewery pertaining to the specified parameters.
@@ -349,12 +679,14 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchLocationsForBreweryId:(NSString *)breweryId
-                    withParameters:(NSDictionary *)parameters
-                           success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
-                           failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchLocationsForBreweryId:(NSString *)breweryId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                   failure:(void (^)(NSError *error))failure;
 
 /**
  *  Fetch a single location object specified by the locationId.
@@ -364,11 +696,560 @@ withBreweryInfo:(BOOL)withBreweryInfo
  *  @param success    Callback function performed on successful retrieval of results.
  *  @param failure    Callback function performed when an error occurs.
  *
+ *  @return A handle that can cancel or reprioritize the request, or nil if no API key is set.
+ *
  *  @since 1.0.0
  */
-+ (void)fetchLocationWithId:(NSString *)locationId
-                 parameters:(NSDictionary *)parameters
-                    success:(void (^)(BDBLocation *location))success
+- (BDBRequest *)fetchLocationWithId:(NSString *)locationId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBLocation *location))success
+                            failure:(void (^)(NSError *error))failure;
+
+#pragma mark Page Requests
+/**
+ *  Build a block that requests one page of search results. Page requests
+ *  drive BDBPageFetcher and the other paging helpers.
+ *
+ *  @param queryString     What you're searching for.
+ *  @param type            The type of result you're searching for.
+ *  @param withBreweryInfo Whether or not to return brewery information with the results.
+ *  @param parameters      Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForSearch:(NSString *)queryString
+                                       type:(BreweryDBSearchType)type
+                            withBreweryInfo:(BOOL)withBreweryInfo
+                                 parameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of beers.
+ *
+ *  @param parameters      Filtering parameters. The page parameter is filled in per request.
+ *  @param withBreweryInfo Whether or not to return brewery information with the results.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForBeersWithParameters:(NSDictionary *)parameters withBreweryInfo:(BOOL)withBreweryInfo;
+
+/**
+ *  Build a block that requests one page of breweries.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForBreweriesWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of styles.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForStylesWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of categories.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForCategoriesWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of fermentables.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForFermentablesWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of hops.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForHopsWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of yeasts.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForYeastsWithParameters:(NSDictionary *)parameters;
+
+/**
+ *  Build a block that requests one page of locations.
+ *
+ *  @param parameters Filtering parameters. The page parameter is filled in per request.
+ *
+ *  @return A page request block.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageRequestBlock)pageRequestForLocationsWithParameters:(NSDictionary *)parameters;
+
+#pragma mark Fetch All
+/**
+ *  Fetch every page of a list endpoint. Page 1 is requested first to learn
+ *  numberOfPages, then the remaining pages are requested concurrently and the
+ *  results are merged in page order.
+ *
+ *  @param pageRequest           Block that requests a single page.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default of 4.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all results.
+ *  @param failure               Callback function performed when an error occurs or the fetch is cancelled.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllPagesWithRequest:(BDBPageRequestBlock)pageRequest
+                       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                    progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                     success:(void (^)(NSArray *results))success
+                                     failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of beers pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param withBreweryInfo       Whether or not to return brewery information with the results.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all beers.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllBeersWithParameters:(NSDictionary *)parameters
+                                withBreweryInfo:(BOOL)withBreweryInfo
+                          maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                       progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                        success:(void (^)(NSArray *beers))success
+                                        failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of breweries pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all breweries.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllBreweriesWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                            success:(void (^)(NSArray *breweries))success
+                                            failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of styles pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all styles.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllStylesWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                         success:(void (^)(NSArray *styles))success
+                                         failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of categories pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all categories.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllCategoriesWithParameters:(NSDictionary *)parameters
+                               maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                            progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                             success:(void (^)(NSArray *categories))success
+                                             failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of fermentables pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all fermentables.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllFermentablesWithParameters:(NSDictionary *)parameters
+                                 maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                              progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                               success:(void (^)(NSArray *fermentables))success
+                                               failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of hops pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all hops.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllHopsWithParameters:(NSDictionary *)parameters
+                         maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                      progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                       success:(void (^)(NSArray *hops))success
+                                       failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of yeasts pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all yeasts.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllYeastsWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                         success:(void (^)(NSArray *yeasts))success
+                                         failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Fetch every page of locations pertaining to the specified parameters.
+ *
+ *  @param parameters            Filtering parameters.
+ *  @param maxConcurrentRequests Maximum pages in flight at once. Pass 0 for the default.
+ *  @param progress              Optional callback performed as each page arrives.
+ *  @param success               Callback function performed with all locations.
+ *  @param failure               Callback function performed when an error occurs.
+ *
+ *  @return The running fetcher, which can be cancelled.
+ *
+ *  @since 1.1.0
+ */
+- (BDBPageFetcher *)fetchAllLocationsWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                            success:(void (^)(NSArray *locations))success
+                                            failure:(void (^)(NSError *error))failure;
+
+#pragma mark Hydration
+/**
+ *  Fetch the ingredients of beers and the locations of their breweries in one
+ *  step. Requests run concurrently, each beer and brewery is fetched once, and
+ *  the results are attached to the beers' hops, fermentables and yeasts and
+ *  their breweries' locations.
+ *
+ *  @param beers                 BDBBeer objects, or beer IDs to load first.
+ *  @param options               What to fetch, e.g. BDBHydrationAll.
+ *  @param maxConcurrentRequests Maximum requests in flight at once. Pass 0 for the default of 4.
+ *  @param success               Callback function performed with the hydrated beers and the
+ *                               errors of any requests that failed, keyed by API path.
+ *  @param failure               Callback function performed when the hydration is cancelled.
+ *
+ *  @return A handle that cancels every request of the hydration.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)hydrateBeers:(NSArray *)beers
+                     options:(BDBHydrationOptions)options
+       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                     success:(void (^)(NSArray *beers, NSDictionary *errors))success
+                     failure:(void (^)(NSError *error))failure;
+
+/**
+ *  Hydrate a single beer like -hydrateBeers:options:maxConcurrentRequests:success:failure:.
+ *
+ *  @param beer    A BDBBeer object or beer ID.
+ *  @param options What to fetch, e.g. BDBHydrationAll.
+ *  @param success Callback function performed with the hydrated beer, or nil if it could not
+ *                 be loaded, and the errors of any requests that failed.
+ *  @param failure Callback function performed when the hydration is cancelled.
+ *
+ *  @return A handle that cancels every request of the hydration.
+ *
+ *  @since 1.1.0
+ */
+- (BDBRequest *)hydrateBeer:(id)beer
+                    options:(BDBHydrationOptions)options
+                    success:(void (^)(BDBBeer *beer, NSDictionary *errors))success
+                    failure:(void (^)(NSError *error))failure;
+
+@end
+
+
+#pragma mark -
+@interface BreweryDB (DefaultClient)
+
+/**
+ *  Each class method performs the instance method of the same name on
+ *  +defaultClient.
+ */
+
+#pragma mark Callbacks
++ (void)setCallbackQueue:(dispatch_queue_t)callbackQueue;
++ (dispatch_queue_t)callbackQueue;
++ (void)setTimingObserver:(void (^)(NSString *path, NSTimeInterval networkDuration, NSTimeInterval decodeDuration))timingObserver;
++ (void)setMetricsObserver:(void (^)(BDBRequestMetrics *metrics))metricsObserver;
+
+#pragma mark Networking
++ (void)setSessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration;
+
+#pragma mark Caching
++ (void)setResponseCache:(BDBResponseCache *)responseCache;
++ (BDBResponseCache *)responseCache;
+
+#pragma mark Storage
++ (void)setStore:(BDBStore *)store;
++ (BDBStore *)store;
+
+#pragma mark Batching
++ (void)setBatchWindow:(NSTimeInterval)batchWindow maxBatchSize:(NSUInteger)maxBatchSize;
+
+#pragma mark Scheduling
++ (void)setRequestScheduler:(BDBRequestScheduler *)requestScheduler;
++ (BDBRequestScheduler *)requestScheduler;
+
+#pragma mark Retries
++ (void)setRetryPolicy:(BDBRetryPolicy *)retryPolicy;
++ (BDBRetryPolicy *)retryPolicy;
+
+#pragma mark Coalescing
++ (NSUInteger)coalescedRequestCount;
++ (NSUInteger)startedRequestCount;
+
+#pragma mark Search
++ (BDBRequest *)search:(NSString *)queryString
+                  type:(BreweryDBSearchType)type
+       withBreweryInfo:(BOOL)withBreweryInfo
+            parameters:(NSDictionary *)parameters
+               success:(void (^)(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages))success
+               failure:(void (^)(NSError *error))failure;
+
+#pragma mark Beers
++ (BDBRequest *)fetchBeersWithParameters:(NSDictionary *)parameters
+                         withBreweryInfo:(BOOL)withBreweryInfo
+                                 success:(void (^)(NSArray *beers, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                 failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchBeerWithId:(NSString *)beerId
+                withBreweryInfo:(BOOL)withBreweryInfo
+                     parameters:(NSDictionary *)parameters
+                        success:(void (^)(BDBBeer *beer))success
+                        failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)loadBeerWithId:(NSString *)beerId
+               withBreweryInfo:(BOOL)withBreweryInfo
+                       success:(void (^)(BDBBeer *beer))success
+                       failure:(void (^)(NSError *error))failure;
+
+#pragma mark Breweries
++ (BDBRequest *)fetchBreweriesWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *breweries, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                     failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchBreweryWithId:(NSString *)breweryId
+                        parameters:(NSDictionary *)parameters
+                           success:(void (^)(BDBBrewery *brewery))success
+                           failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)loadBreweryWithId:(NSString *)breweryId
+                          success:(void (^)(BDBBrewery *brewery))success
+                          failure:(void (^)(NSError *error))failure;
+
+#pragma mark Styles
++ (BDBRequest *)fetchStylesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *styles, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchStyleWithId:(NSString *)styleId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBStyle *style))success
+                         failure:(void (^)(NSError *error))failure;
+
+#pragma mark Categories
++ (BDBRequest *)fetchCategoriesWithParameters:(NSDictionary *)parameters
+                                      success:(void (^)(NSArray *categories, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                      failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchCategoryWithId:(NSString *)categoryId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBCategory *category))success
+                            failure:(void (^)(NSError *error))failure;
+
+#pragma mark Fermentables
++ (BDBRequest *)fetchFermentablesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchFermentablesForBeerId:(NSString *)beerId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                   failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchFermentableWithId:(NSString *)fermentableId
+                            parameters:(NSDictionary *)parameters
+                               success:(void (^)(BDBFermentable *fermentable))success
+                               failure:(void (^)(NSError *error))failure;
+
+#pragma mark Hops
++ (BDBRequest *)fetchHopsWithParameters:(NSDictionary *)parameters
+                                success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchHopsForBeerId:(NSString *)beerId
+                    withParameters:(NSDictionary *)parameters
+                           success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
+                           failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchHopWithId:(NSString *)hopId
+                    parameters:(NSDictionary *)parameters
+                       success:(void (^)(BDBHop *hop))success
+                       failure:(void (^)(NSError *error))failure;
+
+#pragma mark Yeasts
++ (BDBRequest *)fetchYeastsWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchYeastsForBeerId:(NSString *)beerId
+                      withParameters:(NSDictionary *)parameters
+                             success:(void (^)(NSArray *yeasts, NSUInteger currentPage, NSUInteger numberOfPages))success
+                             failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchYeastWithId:(NSString *)yeastId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBYeast *yeast))success
+                         failure:(void (^)(NSError *error))failure;
+
+#pragma mark Locations
++ (BDBRequest *)fetchLocationsWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                     failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchLocationsForBreweryId:(NSString *)breweryId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                   failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)fetchLocationWithId:(NSString *)locationId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBLocation *location))success
+                            failure:(void (^)(NSError *error))failure;
+
+#pragma mark Page Requests
++ (BDBPageRequestBlock)pageRequestForSearch:(NSString *)queryString
+                                       type:(BreweryDBSearchType)type
+                            withBreweryInfo:(BOOL)withBreweryInfo
+                                 parameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForBeersWithParameters:(NSDictionary *)parameters withBreweryInfo:(BOOL)withBreweryInfo;
++ (BDBPageRequestBlock)pageRequestForBreweriesWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForStylesWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForCategoriesWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForFermentablesWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForHopsWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForYeastsWithParameters:(NSDictionary *)parameters;
++ (BDBPageRequestBlock)pageRequestForLocationsWithParameters:(NSDictionary *)parameters;
+
+#pragma mark Fetch All
++ (BDBPageFetcher *)fetchAllPagesWithRequest:(BDBPageRequestBlock)pageRequest
+                       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                    progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                     success:(void (^)(NSArray *results))success
+                                     failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllBeersWithParameters:(NSDictionary *)parameters
+                                withBreweryInfo:(BOOL)withBreweryInfo
+                          maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                       progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                        success:(void (^)(NSArray *beers))success
+                                        failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllBreweriesWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                            success:(void (^)(NSArray *breweries))success
+                                            failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllStylesWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                         success:(void (^)(NSArray *styles))success
+                                         failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllCategoriesWithParameters:(NSDictionary *)parameters
+                               maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                            progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                             success:(void (^)(NSArray *categories))success
+                                             failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllFermentablesWithParameters:(NSDictionary *)parameters
+                                 maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                              progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                               success:(void (^)(NSArray *fermentables))success
+                                               failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllHopsWithParameters:(NSDictionary *)parameters
+                         maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                      progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                       success:(void (^)(NSArray *hops))success
+                                       failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllYeastsWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                         success:(void (^)(NSArray *yeasts))success
+                                         failure:(void (^)(NSError *error))failure;
++ (BDBPageFetcher *)fetchAllLocationsWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger completedPages, NSUInteger numberOfPages))progress
+                                            success:(void (^)(NSArray *locations))success
+                                            failure:(void (^)(NSError *error))failure;
+
+#pragma mark Hydration
++ (BDBRequest *)hydrateBeers:(NSArray *)beers
+                     options:(BDBHydrationOptions)options
+       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                     success:(void (^)(NSArray *beers, NSDictionary *errors))success
+                     failure:(void (^)(NSError *error))failure;
++ (BDBRequest *)hydrateBeer:(id)beer
+                    options:(BDBHydrationOptions)options
+                    success:(void (^)(BDBBeer *beer, NSDictionary *errors))success
                     failure:(void (^)(NSError *error))failure;
 
 @end
@@ -24,6 +24,17 @@
 
 #import "BreweryDB.h"
 #import "BDBErrors.h"
+#import "BDBResponseCache.h"
+#import "BDBStore.h"
+#import "BDBModelCoercion.h"
+#import "BDBRequestCoalescer.h"
+#import "BDBPageFetcher.h"
+#import "BDBBatchLoader.h"
+#import "BDBRequestScheduler.h"
+#import "BDBRequest_Private.h"
+#import "BDBRequestMetrics_Private.h"
+#import "BDBStreamingResponseParser.h"
+#import "BDBStreamingSession.h"
 
 
 NSString * const BreweryDBErrorDomain = @"com.brewerydb.api.error";
@@ -35,17 +46,119 @@ NSString * const BreweryDBResponseDataKey           = @"data";
 NSString * const BreweryDBResponseNumberOfPagesKey  = @"numberOfPages";
 NSString * const BreweryDBResponseCurrentPageKey    = @"currentPage";
 
+NSString * const BreweryDBRequestOptionPrefix               = @"BreweryDBRequestOption";
+NSString * const BreweryDBRequestOptionCallbackQueueKey     = @"BreweryDBRequestOptionCallbackQueue";
+NSString * const BreweryDBRequestOptionStreamingKey         = @"BreweryDBRequestOptionStreaming";
+NSString * const BreweryDBRequestOptionItemHandlerKey       = @"BreweryDBRequestOptionItemHandler";
+NSString * const BreweryDBRequestOptionPriorityKey          = @"BreweryDBRequestOptionPriority";
+NSString * const BreweryDBRequestOptionPreferLocalKey       = @"BreweryDBRequestOptionPreferLocal";
+
+static NSUInteger const BreweryDBResultsPerPage = 50;
+
+typedef id (^BDBObjectDecoder)(NSDictionary *dictionary, NSError *__autoreleasing *error);
+
 #pragma mark -
 @interface BreweryDB ()
 
-@property (nonatomic) AFHTTPSessionManager *networkManager;
+@property (atomic) AFHTTPSessionManager *networkManager;
+@property (atomic) BDBStreamingSession *streamingSession;
+
+@property (atomic) BDBResponseCache *responseCache;
+@property (atomic) BDBStore *store;
+@property (nonatomic) BDBRequestCoalescer *requestCoalescer;
+@property (atomic) BDBRequestScheduler *requestScheduler;
+@property (atomic) BDBRetryPolicy *retryPolicy;
+@property (nonatomic) BDBBatchLoader *beerLoader;
+@property (nonatomic) BDBBatchLoader *beerWithBreweriesLoader;
+@property (nonatomic) BDBBatchLoader *breweryLoader;
 
-@property (nonatomic, copy) NSString *apiKey;
+@property (atomic) dispatch_queue_t callbackQueue;
+@property (atomic, copy) void (^timingObserver)(NSString *path, NSTimeInterval networkDuration, NSTimeInterval decodeDuration);
+@property (atomic, copy) void (^metricsObserver)(BDBRequestMetrics *metrics);
+@property (nonatomic) NSMapTable *taskMetrics;
 
-+ (instancetype)sharedInstance;
 - (BOOL)readyToBrew;
+- (NSString *)nextAPIKey;
 
 - (NSError *)errorWithCode:(NSInteger)code description:(NSString *)description;
+- (NSError *)cancellationError;
+- (void)failWithMissingAPIKeyForParameters:(NSDictionary *)parameters failure:(void (^)(NSError *error))failure;
+
+- (void)prepareNetworkManager:(AFHTTPSessionManager *)networkManager streamingSession:(BDBStreamingSession *)streamingSession;
+- (dispatch_queue_t)processingQueue;
+- (void)GET:(NSString *)path
+ parameters:(NSDictionary *)parameters
+    request:(BDBRequest *)request
+    success:(void (^)(id responseObject, BOOL fromNetwork))success
+    failure:(void (^)(NSError *error))failure;
+- (void)dataTaskWithPath:(NSString *)path
+              parameters:(NSDictionary *)parameters
+                    ETag:(NSString *)ETag
+                 request:(BDBRequest *)request
+              completion:(void (^)(NSHTTPURLResponse *response, id responseObject, NSError *error))completion;
+- (void)attemptWithPath:(NSString *)path
+             parameters:(NSDictionary *)parameters
+                   ETag:(NSString *)ETag
+                request:(BDBRequest *)request
+                started:(void (^)(void))started
+             completion:(void (^)(NSHTTPURLResponse *response, id responseObject, NSError *error))completion;
+- (void)scheduleRequest:(BDBRequest *)request
+                  start:(BDBScheduledRequestBlock)start
+                   drop:(void (^)(NSError *error))drop;
+- (void)attachTask:(NSURLSessionTask *)task toRequest:(BDBRequest *)request;
+- (void)updateRateLimitFromResponse:(NSHTTPURLResponse *)response;
+- (NSMutableURLRequest *)requestWithPath:(NSString *)path
+                              parameters:(NSDictionary *)parameters
+                                   error:(NSError *__autoreleasing *)error;
+
+- (BDBRequestMetrics *)metricsForPath:(NSString *)path;
+- (void)reportMetrics:(BDBRequestMetrics *)metrics results:(id)results error:(NSError *)error;
+
+- (BDBRequest *)fetchObjectsAtPath:(NSString *)path
+                        parameters:(NSDictionary *)parameters
+                           decoder:(BDBObjectDecoder)decoder
+                           success:(void (^)(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages))success
+                           failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchObjectAtPath:(NSString *)path
+                       parameters:(NSDictionary *)parameters
+                          decoder:(BDBObjectDecoder)decoder
+                          success:(void (^)(id object))success
+                          failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)fetchPath:(NSString *)path
+               parameters:(NSDictionary *)parameters
+               collection:(BOOL)collection
+                  decoder:(BDBObjectDecoder)decoder
+                  success:(BDBResultsBlock)success
+                  failure:(void (^)(NSError *error))failure;
+- (BDBRequest *)searchStoreWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages))success
+                                  failure:(void (^)(NSError *error))failure;
+- (void)streamPath:(NSString *)path
+        parameters:(NSDictionary *)parameters
+           decoder:(BDBObjectDecoder)decoder
+       itemHandler:(void (^)(id object))itemHandler
+     callbackQueue:(dispatch_queue_t)callbackQueue
+           request:(BDBRequest *)request
+           success:(BDBResultsBlock)success
+           failure:(void (^)(NSError *error))failure;
+- (id)resultsFromResponse:(id)responseObject
+               collection:(BOOL)collection
+                  decoder:(BDBObjectDecoder)decoder
+              currentPage:(NSUInteger *)currentPage
+            numberOfPages:(NSUInteger *)numberOfPages
+                    error:(NSError *__autoreleasing *)error;
+
+- (BDBBatchLoader *)batchLoaderForPath:(NSString *)path
+                            parameters:(NSDictionary *)parameters
+                               decoder:(BDBObjectDecoder)decoder
+                   identifierForObject:(NSString *(^)(id object))identifierForObject;
+
+- (BDBObjectDecoder)decoderForClass:(Class)modelClass;
+- (BDBObjectDecoder)searchResultDecoder;
+- (void)storeObjects:(NSArray *)objects dictionaries:(NSArray *)dictionaries;
+
++ (NSDictionary *)requestParametersFromParameters:(NSDictionary *)parameters options:(NSDictionary *__autoreleasing *)options;
++ (NSDictionary *)parameters:(NSDictionary *)parameters forPage:(NSUInteger)page;
 
 @end
 
@@ -53,1170 +166,2453 @@ NSString * const BreweryDBResponseCurrentPageKey    = @"currentPage";
 #pragma mark -
 @implementation BreweryDB
 
-#pragma mark Private Instantiation
-+ (instancetype)sharedInstance
+@synthesize callbackQueue = _callbackQueue;
+
+#pragma mark Instantiation
++ (instancetype)defaultClient
 {
-    static BreweryDB *_sharedInstance = nil;
+    static BreweryDB *_defaultClient = nil;
     static dispatch_once_t onceToken;
     dispatch_once(&onceToken, ^{
-        _sharedInstance = [[[self class] alloc] init];
+        _defaultClient = [[[self class] alloc] init];
     });
-    return _sharedInstance;
+    return _defaultClient;
+}
+
++ (instancetype)brew:(NSString *)apiKey
+{
+    BreweryDB *defaultClient = [[self class] defaultClient];
+    defaultClient.apiKey = apiKey;
+    return defaultClient;
 }
 
 - (id)init
+{
+    return [self initWithAPIKey:nil sessionConfiguration:nil];
+}
+
+- (id)initWithAPIKey:(NSString *)apiKey sessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration
 {
     self = [super init];
     if (self)
     {
-        _networkManager = [[AFHTTPSessionManager alloc] initWithBaseURL:[NSURL URLWithString:BreweryDBAPIURL]];
-        _apiKey = nil;
+        _networkManager = [[AFHTTPSessionManager alloc] initWithBaseURL:[NSURL URLWithString:BreweryDBAPIURL]
+                                                   sessionConfiguration:sessionConfiguration];
+        _networkManager.completionQueue = dispatch_queue_create("com.brewerydb.processing", DISPATCH_QUEUE_CONCURRENT);
+        _streamingSession = [[BDBStreamingSession alloc] initWithSessionConfiguration:sessionConfiguration];
+        _taskMetrics = [NSMapTable weakToStrongObjectsMapTable];
+        [self prepareNetworkManager:_networkManager streamingSession:_streamingSession];
+        _callbackQueue = dispatch_get_main_queue();
+        _apiKey = [apiKey copy];
+        _responseCache = [BDBResponseCache sharedCache];
+        _store = [BDBStore sharedStore];
+        _requestCoalescer = [[BDBRequestCoalescer alloc] init];
+
+        NSString *(^beerIdentifier)(id) = ^NSString *(BDBBeer *beer) {
+            return beer.beerId;
+        };
+        _beerLoader = [self batchLoaderForPath:@"beers"
+                                    parameters:nil
+                                       decoder:[self decoderForClass:[BDBBeer class]]
+                           identifierForObject:beerIdentifier];
+        _beerWithBreweriesLoader = [self batchLoaderForPath:@"beers"
+                                                 parameters:@{@"withBreweries":@"Y"}
+                                                    decoder:[self decoderForClass:[BDBBeer class]]
+                                        identifierForObject:beerIdentifier];
+        _breweryLoader = [self batchLoaderForPath:@"breweries"
+                                       parameters:nil
+                                          decoder:[self decoderForClass:[BDBBrewery class]]
+                              identifierForObject:^NSString *(BDBBrewery *brewery) {
+                                  return brewery.breweryId;
+                              }];
     }
     return self;
 }
 
-#pragma mark Public Instantiation
-+ (instancetype)brew:(NSString *)apiKey
+- (BOOL)readyToBrew
 {
-    [[[self class] sharedInstance] setApiKey:apiKey];
-    return [[self class] sharedInstance];
+    return (self.apiKey != nil || self.keyPool.keys.count > 0);
 }
 
-- (BOOL)readyToBrew
+- (NSString *)nextAPIKey
 {
-    return (self.apiKey != nil);
+    return [self.keyPool nextKey] ?: self.apiKey;
 }
 
 #pragma mark Errors
 - (NSError *)errorWithCode:(NSInteger)code description:(NSString *)description
 {
-    return [NSError errorWithDomain:BreweryDBErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey:description}];
+    return [NSError errorWithDomain:BreweryDBErrorDomain code:code userInfo:@{NSLocalizedDescriptionKey:(description ?: BDB_ERROR_BAD_API_RESPONSE)}];
 }
 
-#pragma mark Search
-+ (void)search:(NSString *)queryString
-          type:(BreweryDBSearchType)type
-withBreweryInfo:(BOOL)withBreweryInfo
-    parameters:(NSDictionary *)parameters
-       success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
-       failure:(void (^)(NSError *))failure
+- (NSError *)cancellationError
 {
-    NSParameterAssert(queryString);
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    mutableParameters[@"q"] = queryString;
-    
-    if (withBreweryInfo)
-        mutableParameters[@"withBreweries"] = @"Y";
-    
-    switch (type)
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:nil];
+}
+
+- (void)failWithMissingAPIKeyForParameters:(NSDictionary *)parameters failure:(void (^)(NSError *))failure
+{
+    // Failures are delivered asynchronously on the callback queue like every other outcome.
+    dispatch_queue_t callbackQueue = parameters[BreweryDBRequestOptionCallbackQueueKey] ?: self.callbackQueue;
+    NSError *error = [self errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY];
+    dispatch_async(callbackQueue, ^{
+        failure(error);
+    });
+}
+
+#pragma mark Callbacks
+- (void)setCallbackQueue:(dispatch_queue_t)callbackQueue
+{
+    callbackQueue = (callbackQueue ?: dispatch_get_main_queue());
+    @synchronized(self)
     {
-        case BreweryDBSearchTypeBrewery:
+        _callbackQueue = callbackQueue;
+    }
+    for (BDBBatchLoader *loader in @[self.beerLoader, self.beerWithBreweriesLoader, self.breweryLoader])
+        loader.callbackQueue = callbackQueue;
+}
+
+- (dispatch_queue_t)callbackQueue
+{
+    @synchronized(self)
+    {
+        return _callbackQueue;
+    }
+}
+
+#pragma mark Networking
+- (void)setSessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration
+{
+    AFHTTPSessionManager *networkManager = [[AFHTTPSessionManager alloc] initWithBaseURL:[NSURL URLWithString:BreweryDBAPIURL]
+                                                                    sessionConfiguration:sessionConfiguration];
+    BDBStreamingSession *streamingSession = [[BDBStreamingSession alloc] initWithSessionConfiguration:sessionConfiguration];
+    [self prepareNetworkManager:networkManager streamingSession:streamingSession];
+
+    // Responses keep being decoded on the same processing queue, and tasks already running finish on the old sessions.
+    @synchronized(self)
+    {
+        networkManager.completionQueue = self.networkManager.completionQueue;
+        [self.networkManager invalidateSessionCancelingTasks:NO];
+        [self.streamingSession finishTasksAndInvalidate];
+        self.networkManager = networkManager;
+        self.streamingSession = streamingSession;
+    }
+}
+
+#pragma mark Batching
+- (void)setBatchWindow:(NSTimeInterval)batchWindow maxBatchSize:(NSUInteger)maxBatchSize
+{
+    for (BDBBatchLoader *loader in @[self.beerLoader, self.beerWithBreweriesLoader, self.breweryLoader])
+    {
+        loader.batchWindow = batchWindow;
+        loader.maxBatchSize = maxBatchSize;
+    }
+}
+
+- (BDBBatchLoader *)batchLoaderForPath:(NSString *)path
+                            parameters:(NSDictionary *)parameters
+                               decoder:(BDBObjectDecoder)decoder
+                   identifierForObject:(NSString *(^)(id))identifierForObject
+{
+    __weak BreweryDB *weakSelf = self;
+    return [[BDBBatchLoader alloc] initWithBatchRequest:^BDBRequest *(NSArray *identifiers, void (^success)(NSArray *), void (^failure)(NSError *)) {
+        NSMutableDictionary *batchParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+        batchParameters[@"ids"] = [identifiers componentsJoinedByString:@","];
+
+        return [weakSelf fetchObjectsAtPath:path
+                                 parameters:batchParameters
+                                    decoder:decoder
+                                    success:^(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                        success(objects);
+                                    }
+                                    failure:failure];
+    }
+                                    identifierForObject:identifierForObject];
+}
+
+#pragma mark Coalescing
+- (NSUInteger)coalescedRequestCount
+{
+    return [self.requestCoalescer coalescedRequestCount];
+}
+
+- (NSUInteger)startedRequestCount
+{
+    return [self.requestCoalescer startedRequestCount];
+}
+
+#pragma mark Requests
+- (void)prepareNetworkManager:(AFHTTPSessionManager *)networkManager streamingSession:(BDBStreamingSession *)streamingSession
+{
+    // Bodies arrive as data and are deserialized in -dataTaskWithPath:..., where the time it takes can be measured.
+    networkManager.responseSerializer = [AFHTTPResponseSerializer serializer];
+
+#if BDB_CAN_USE_TASK_METRICS
+    __weak BreweryDB *weakSelf = self;
+    void (^recordTaskMetrics)(NSURLSession *, NSURLSessionTask *, NSURLSessionTaskMetrics *) = ^(NSURLSession *session, NSURLSessionTask *task, NSURLSessionTaskMetrics *taskMetrics) {
+        BreweryDB *strongSelf = weakSelf;
+        if (!strongSelf)
+            return;
+
+        BDBRequestMetrics *metrics = nil;
+        @synchronized(strongSelf.taskMetrics)
         {
-            mutableParameters[@"type"] = @"brewery";
-            break;
+            metrics = [strongSelf.taskMetrics objectForKey:task];
+            [strongSelf.taskMetrics removeObjectForKey:task];
         }
-        case BreweryDBSearchTypeBeer:
+        [metrics recordTaskMetrics:taskMetrics];
+    };
+
+    // AFNetworking only forwards task metrics from 3.2 on.
+#if defined(AF_CAN_INCLUDE_SESSION_TASK_METRICS) && AF_CAN_INCLUDE_SESSION_TASK_METRICS
+    [networkManager setTaskDidFinishCollectingMetricsBlock:recordTaskMetrics];
+#endif
+    streamingSession.taskMetricsHandler = ^(NSURLSessionTask *task, NSURLSessionTaskMetrics *taskMetrics) {
+        recordTaskMetrics(nil, task, taskMetrics);
+    };
+#endif
+}
+
+- (dispatch_queue_t)processingQueue
+{
+    return self.networkManager.completionQueue;
+}
+
+- (void)GET:(NSString *)path
+ parameters:(NSDictionary *)parameters
+    request:(BDBRequest *)request
+    success:(void (^)(id responseObject, BOOL fromNetwork))success
+    failure:(void (^)(NSError *error))failure
+{
+    BDBResponseCache *responseCache = self.responseCache;
+    NSString *endpoint = [BDBResponseCache endpointForPath:path];
+
+    if (!responseCache || [responseCache timeToLiveForEndpoint:endpoint] <= 0.0)
+    {
+        [self dataTaskWithPath:path
+                    parameters:parameters
+                          ETag:nil
+                       request:request
+                    completion:^(NSHTTPURLResponse *response, id responseObject, NSError *error) {
+                        if (error)
+                            failure(error);
+                        else
+                            success(responseObject, YES);
+                    }];
+        return;
+    }
+
+    NSString *cacheKey = [BDBResponseCache keyForPath:path parameters:parameters];
+    [responseCache fetchCachedResponseForKey:cacheKey completion:^(BDBCachedResponse *cachedResponse) {
+        BOOL answeredFromCache = NO;
+        if (cachedResponse && (!cachedResponse.isExpired || [responseCache canServeStaleResponse:cachedResponse]))
         {
-            mutableParameters[@"type"] = @"beer";
-            break;
+            request.metrics.source = (cachedResponse.isExpired ? BDBRequestMetricsSourceStaleCache : BDBRequestMetricsSourceCache);
+            dispatch_async([self processingQueue], ^{
+                success(cachedResponse.responseObject, NO);
+            });
+
+            // Fresh responses are done; stale ones are revalidated in the background.
+            if (!cachedResponse.isExpired)
+                return;
+            answeredFromCache = YES;
         }
-        case BreweryDBSearchTypeGuild:
+
+        // Background revalidation never competes with interactive requests, and
+        // outlives the caller's request, which the cached response already answered.
+        BDBRequest *revalidationRequest = request;
+        if (answeredFromCache)
+            revalidationRequest = [[BDBRequest alloc] initWithPriority:MAX(request.priority, BDBRequestPriorityPrefetch)];
+
+        [self dataTaskWithPath:path
+                    parameters:parameters
+                          ETag:cachedResponse.ETag
+                       request:revalidationRequest
+                    completion:^(NSHTTPURLResponse *response, id responseObject, NSError *error) {
+                        if (cachedResponse && response.statusCode == 304)
+                        {
+                            [responseCache recordNotModified];
+                            [responseCache refreshCachedResponse:cachedResponse forKey:cacheKey endpoint:endpoint];
+                            if (!answeredFromCache)
+                            {
+                                request.metrics.source = BDBRequestMetricsSourceNotModified;
+                                success(cachedResponse.responseObject, NO);
+                            }
+                            return;
+                        }
+
+                        if (error)
+                        {
+                            if (!answeredFromCache)
+                                failure(error);
+                            return;
+                        }
+
+                        if ([responseObject isKindOfClass:[NSDictionary class]] &&
+                            [responseObject[BreweryDBResponseStatusKey] isEqual:@"success"])
+                        {
+                            NSString *ETag = response.allHeaderFields[@"ETag"] ?: response.allHeaderFields[@"Etag"];
+                            [responseCache storeResponseObject:responseObject ETag:ETag forKey:cacheKey endpoint:endpoint];
+                        }
+
+                        if (!answeredFromCache)
+                            success(responseObject, YES);
+                    }];
+    }];
+}
+
+- (void)dataTaskWithPath:(NSString *)path
+              parameters:(NSDictionary *)parameters
+                    ETag:(NSString *)ETag
+                 request:(BDBRequest *)request
+              completion:(void (^)(NSHTTPURLResponse *, id, NSError *))completion
+{
+    BDBRetryPolicy *retryPolicy = self.retryPolicy;
+    if (!retryPolicy)
+    {
+        [self attemptWithPath:path parameters:parameters ETag:ETag request:request started:nil completion:completion];
+        return;
+    }
+
+    // Every attempt is a child of the request, so cancelling it or changing its priority reaches them all.
+    // The first attempt to succeed wins; failures wait for any attempt still running before being retried.
+    NSString *endpoint = [BDBResponseCache endpointForPath:path];
+    NSTimeInterval hedgeDelay = [retryPolicy hedgeDelayForEndpoint:endpoint];
+    NSMutableSet *liveAttempts = [NSMutableSet set];
+    __block BOOL finished = NO;
+    __block BOOL hedged = NO;
+    __block NSUInteger retryCount = 0;
+    __block void (^startAttempt)(BOOL primary) = nil;
+
+    void (^finish)(NSHTTPURLResponse *, id, NSError *) = ^(NSHTTPURLResponse *response, id responseObject, NSError *error) {
+        BDBRequestMetrics *metrics = request.metrics;
+        metrics.retryCount = retryCount;
+        metrics.hedged = hedged;
+        @synchronized(liveAttempts)
         {
-            mutableParameters[@"type"] = @"guild";
-            break;
+            startAttempt = nil;
         }
-        case BreweryDBSearchTypeEvent:
+        completion(response, responseObject, error);
+    };
+
+    startAttempt = ^(BOOL primary) {
+        BDBRequest *attempt = [[BDBRequest alloc] initWithPriority:request.priority];
+        attempt.metrics = request.metrics;
+        __weak BDBRequest *weakAttempt = attempt;
+        [request addPriorityHandler:^(BDBRequestPriority priority) {
+            weakAttempt.priority = priority;
+        }];
+        [request addChildRequest:attempt];
+        @synchronized(liveAttempts)
         {
-            mutableParameters[@"type"] = @"event";
-            break;
+            [liveAttempts addObject:attempt];
         }
-        case BreweryDBSearchTypeAll:
-        default:
-            break;
-    }
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"search"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *searchResults = [NSMutableArray array];
-                                                            for (NSDictionary *resultDictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                if ([resultDictionary[@"type"] isEqualToString:@"beer"])
-                                                                {
-                                                                    BDBBeer *beer = [[BDBBeer alloc] initWithDictionary:resultDictionary];
-                                                                    if (beer)
-                                                                        [searchResults addObject:beer];
-                                                                    else
-                                                                    {
-                                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                                 description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                        break;
-                                                                    }
-                                                                }
-                                                                else if ([resultDictionary[@"type"] isEqualToString:@"brewery"])
-                                                                {
-                                                                    BDBBrewery *brewery = [[BDBBrewery alloc] initWithDictionary:resultDictionary];
-                                                                    if (brewery)
-                                                                        [searchResults addObject:brewery];
-                                                                    else
-                                                                    {
-                                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_GUILD_OBJECT_CREATION_FAILED
-                                                                                                                 description:BDB_ERROR_GUILD_OBJECT_CREATION_FAILED]);
-                                                                        break;
-                                                                    }
-                                                                }
-                                                                else if ([resultDictionary[@"type"] isEqualToString:@"guild"])
-                                                                {
-                                                                    BDBGuild *guild = [[BDBGuild alloc] initWithDictionary:resultDictionary];
-                                                                    if (guild)
-                                                                        [searchResults addObject:guild];
-                                                                    else
-                                                                    {
-                                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_GUILD_OBJECT_CREATION_FAILED
-                                                                                                                 description:BDB_ERROR_GUILD_OBJECT_CREATION_FAILED]);
-                                                                        break;
-                                                                    }
-                                                                }
-                                                                else
-                                                                    [searchResults addObject:resultDictionary];
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(searchResults, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
 
-#pragma mark Beers
-+ (void)fetchBeersWithParameters:(NSDictionary *)parameters
-                 withBreweryInfo:(BOOL)withBreweryInfo
-                         success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
-                         failure:(void (^)(NSError *))failure
-{
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
+        __block CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        void (^started)(void) = ^{
+            startTime = CFAbsoluteTimeGetCurrent();
+            if (!primary)
+                return;
 
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+            request.startTime = startTime;
+            if (hedgeDelay < 0.0)
+                return;
 
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(hedgeDelay * NSEC_PER_SEC)), [self processingQueue], ^{
+                void (^startHedge)(BOOL) = nil;
+                @synchronized(liveAttempts)
+                {
+                    if (finished || hedged || liveAttempts.count != 1 || request.isCancelled || ![retryPolicy beginHedge])
+                        return;
+                    hedged = YES;
+                    startHedge = startAttempt;
+                }
+                if (startHedge)
+                    startHedge(NO);
+            });
+        };
 
-    if (withBreweryInfo)
-        mutableParameters[@"withBreweries"] = @"Y";
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"beers"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *beers = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBBeer *beer = [[BDBBeer alloc] initWithDictionary:dictionary];
-                                                                if (beer)
-                                                                    [beers addObject:beer];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(beers, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchBeerWithId:(NSString *)beerId
-        withBreweryInfo:(BOOL)withBreweryInfo
+        [self attemptWithPath:path
+                   parameters:parameters
+                         ETag:ETag
+                      request:attempt
+                      started:started
+                   completion:^(NSHTTPURLResponse *response, id responseObject, NSError *error) {
+                       NSArray *losingAttempts = nil;
+                       NSTimeInterval retryDelay = -1.0;
+                       @synchronized(liveAttempts)
+                       {
+                           [liveAttempts removeObject:attempt];
+                           if (finished || (error && liveAttempts.count > 0))
+                               return;
+
+                           if (error)
+                               retryDelay = [retryPolicy delayBeforeRetry:retryCount response:response error:error];
+                           if (retryDelay < 0.0)
+                           {
+                               finished = YES;
+                               losingAttempts = [liveAttempts allObjects];
+                               [liveAttempts removeAllObjects];
+                           }
+                           else
+                           {
+                               retryCount++;
+                           }
+                       }
+
+                       if (retryDelay < 0.0)
+                       {
+                           for (BDBRequest *losingAttempt in losingAttempts)
+                               [losingAttempt cancel];
+                           if (!error)
+                               [retryPolicy recordLatency:CFAbsoluteTimeGetCurrent() - startTime forEndpoint:endpoint];
+                           finish(response, responseObject, error);
+                           return;
+                       }
+
+                       dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(retryDelay * NSEC_PER_SEC)), [self processingQueue], ^{
+                           void (^startRetry)(BOOL) = nil;
+                           @synchronized(liveAttempts)
+                           {
+                               if (request.isCancelled)
+                                   finished = YES;
+                               else
+                                   startRetry = startAttempt;
+                           }
+                           if (startRetry)
+                               startRetry(NO);
+                           else
+                               finish(nil, nil, [self cancellationError]);
+                       });
+                   }];
+    };
+    startAttempt(YES);
+}
+
+- (void)attemptWithPath:(NSString *)path
              parameters:(NSDictionary *)parameters
-                success:(void (^)(BDBBeer *))success
-                failure:(void (^)(NSError *))failure
+                   ETag:(NSString *)ETag
+                request:(BDBRequest *)request
+                started:(void (^)(void))started
+             completion:(void (^)(NSHTTPURLResponse *, id, NSError *))completion
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
+    NSError *serializationError = nil;
+    NSMutableURLRequest *URLRequest = [self requestWithPath:path parameters:parameters error:&serializationError];
+    if (!URLRequest)
+    {
+        dispatch_async([self processingQueue], ^{
+            completion(nil, nil, serializationError);
+        });
+        return;
+    }
 
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+    if (ETag)
+        [URLRequest setValue:ETag forHTTPHeaderField:@"If-None-Match"];
 
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
+    [self scheduleRequest:request
+                    start:^(void (^finish)(void)) {
+                        NSURLSessionDataTask *task = [self.networkManager dataTaskWithRequest:URLRequest
+                                                                               uploadProgress:nil
+                                                                             downloadProgress:^(NSProgress *downloadProgress) {
+                                                                                 [request updateProgressWithBytesReceived:downloadProgress.completedUnitCount
+                                                                                                            bytesExpected:downloadProgress.totalUnitCount];
+                                                                             }
+                                                                            completionHandler:^(NSURLResponse *response, NSData *data, NSError *error) {
+                                                                                NSHTTPURLResponse *HTTPResponse = nil;
+                                                                                if ([response isKindOfClass:[NSHTTPURLResponse class]])
+                                                                                    HTTPResponse = (NSHTTPURLResponse *)response;
+                                                                                [self updateRateLimitFromResponse:HTTPResponse];
+                                                                                finish();
 
-    if (withBreweryInfo)
-        mutableParameters[@"withBreweries"] = @"Y";
+                                                                                // A cancelled attempt shares its metrics with the attempt that replaced it.
+                                                                                BDBRequestMetrics *metrics = request.isCancelled ? nil : request.metrics;
+                                                                                metrics.statusCode = HTTPResponse.statusCode;
+                                                                                metrics.responseBytes = (int64_t)data.length;
 
-    [[[[self class] sharedInstance] networkManager] GET:[@"beer" stringByAppendingFormat:@"/%@", beerId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBBeer *beer = [[BDBBeer alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (beer)
-                                                                success(beer);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+                                                                                // Not Modified has no body to deserialize.
+                                                                                id responseObject = nil;
+                                                                                if (!error && data.length > 0 && HTTPResponse.statusCode != 304)
+                                                                                {
+                                                                                    CFAbsoluteTime deserializationStart = CFAbsoluteTimeGetCurrent();
+                                                                                    responseObject = [NSJSONSerialization JSONObjectWithData:data options:0 error:&error];
+                                                                                    metrics.deserializationDuration = CFAbsoluteTimeGetCurrent() - deserializationStart;
+                                                                                }
+                                                                                completion(HTTPResponse, responseObject, error);
+                                                                            }];
+                        [self attachTask:task toRequest:request];
+                        [task resume];
+                        if (started)
+                            started();
+                    }
+                     drop:^(NSError *error) {
+                         dispatch_async([self processingQueue], ^{
+                             completion(nil, nil, error);
+                         });
+                     }];
 }
 
-#pragma mark Breweries
-+ (void)fetchBreweriesWithParameters:(NSDictionary *)parameters
-                             success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
-                             failure:(void (^)(NSError *))failure
+- (void)scheduleRequest:(BDBRequest *)request
+                  start:(BDBScheduledRequestBlock)start
+                   drop:(void (^)(NSError *))drop
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
+    // A request cancelled while queued never starts; one cancelled before its task exists is dropped here.
+    __weak BDBRequest *weakRequest = request;
+    CFAbsoluteTime scheduleTime = CFAbsoluteTimeGetCurrent();
+    BDBScheduledRequestBlock cancellableStart = ^(void (^finish)(void)) {
+        if (weakRequest.isCancelled)
+        {
+            finish();
+            drop([self cancellationError]);
+            return;
+        }
+        CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+        weakRequest.startTime = startTime;
+        weakRequest.metrics.queueDuration = startTime - scheduleTime;
+        start(finish);
+    };
 
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+    BDBRequestScheduler *requestScheduler = self.requestScheduler;
+    if (!requestScheduler)
+    {
+        cancellableStart(^{});
+        return;
+    }
 
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-
-    [[[[self class] sharedInstance] networkManager] GET:@"breweries"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *breweries = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBBrewery *brewery = [[BDBBrewery alloc] initWithDictionary:dictionary];
-                                                                if (brewery)
-                                                                    [breweries addObject:brewery];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BREWERY_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BREWERY_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(breweries, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchBreweryWithId:(NSString *)breweryId
-                parameters:(NSDictionary *)parameters
-                   success:(void (^)(BDBBrewery *))success
-                   failure:(void (^)(NSError *))failure
+    id scheduledRequest = [requestScheduler scheduleRequestWithPriority:request.priority start:cancellableStart drop:drop];
+    [request addPriorityHandler:^(BDBRequestPriority priority) {
+        [requestScheduler setPriority:priority forScheduledRequest:scheduledRequest];
+    }];
+    [request addCancellationHandler:^{
+        [requestScheduler cancelScheduledRequest:scheduledRequest];
+    }];
+}
+
+- (void)attachTask:(NSURLSessionTask *)task toRequest:(BDBRequest *)request
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
+    BDBRequestMetrics *metrics = request.metrics;
+    if (metrics)
+    {
+        @synchronized(self.taskMetrics)
+        {
+            [self.taskMetrics setObject:metrics forKey:task];
+        }
+    }
 
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+    // A cancelled task's network phases do not belong to the request's metrics.
+    __weak BreweryDB *weakSelf = self;
+    [request addCancellationHandler:^{
+        NSMapTable *taskMetrics = weakSelf.taskMetrics;
+        @synchronized(taskMetrics)
+        {
+            [taskMetrics removeObjectForKey:task];
+        }
+        [task cancel];
+    }];
 
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-
-    [[[[self class] sharedInstance] networkManager] GET:[@"breweries" stringByAppendingFormat:@"/%@", breweryId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBBrewery *brewery = [[BDBBrewery alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (brewery)
-                                                                success(brewery);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BREWERY_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BREWERY_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+    if (![task respondsToSelector:@selector(setPriority:)])
+        return;
+
+    void (^updateTaskPriority)(BDBRequestPriority) = ^(BDBRequestPriority priority) {
+        if (priority == BDBRequestPriorityInteractive)
+            task.priority = NSURLSessionTaskPriorityHigh;
+        else if (priority == BDBRequestPriorityPrefetch)
+            task.priority = NSURLSessionTaskPriorityDefault;
+        else
+            task.priority = NSURLSessionTaskPriorityLow;
+    };
+    updateTaskPriority(request.priority);
+    [request addPriorityHandler:updateTaskPriority];
 }
 
-#pragma mark Styles
-+ (void)fetchStylesWithParameters:(NSDictionary *)parameters
-                          success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
-                          failure:(void (^)(NSError *))failure
+- (void)updateRateLimitFromResponse:(NSHTTPURLResponse *)response
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"styles"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *styles = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBStyle *style = [[BDBStyle alloc] initWithDictionary:dictionary];
-                                                                if (style)
-                                                                    [styles addObject:style];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(styles, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchStyleWithId:(NSString *)styleId
-              parameters:(NSDictionary *)parameters
-                 success:(void (^)(BDBBeer *))success
-                 failure:(void (^)(NSError *))failure
-{
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"style" stringByAppendingFormat:@"/%@", styleId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBStyle *style = [[BDBStyle alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (style)
-                                                                success(style);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+    NSDictionary *headers = response.allHeaderFields;
+    NSString *rateLimit = headers[@"X-Ratelimit-Limit"] ?: headers[@"X-RateLimit-Limit"];
+    NSString *remaining = headers[@"X-Ratelimit-Remaining"] ?: headers[@"X-RateLimit-Remaining"];
+    if (!rateLimit || !remaining)
+        return;
+
+    NSUInteger keyRateLimit = (NSUInteger)MAX([rateLimit integerValue], 0);
+    NSUInteger keyRemaining = (NSUInteger)MAX([remaining integerValue], 0);
+    BDBKeyPool *keyPool = self.keyPool;
+    if (!keyPool)
+    {
+        [self.requestScheduler updateRateLimit:keyRateLimit remaining:keyRemaining];
+        return;
+    }
+
+    // The quota belongs to whichever pooled key the request went out with.
+    for (NSString *queryItem in [response.URL.query componentsSeparatedByString:@"&"])
+    {
+        if ([queryItem hasPrefix:@"key="])
+            [keyPool updateKey:[[queryItem substringFromIndex:4] stringByRemovingPercentEncoding] rateLimit:keyRateLimit remaining:keyRemaining];
+    }
+
+    // The scheduler paces against the pool as a whole once every key has reported.
+    NSUInteger poolRateLimit = 0;
+    NSUInteger poolRemaining = 0;
+    if ([keyPool getRateLimit:&poolRateLimit remaining:&poolRemaining])
+        [self.requestScheduler updateRateLimit:poolRateLimit remaining:poolRemaining];
 }
 
-#pragma mark Categories
-+ (void)fetchCategoriesWithParameters:(NSDictionary *)parameters
-                              success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
-                              failure:(void (^)(NSError *))failure
+- (NSMutableURLRequest *)requestWithPath:(NSString *)path
+                              parameters:(NSDictionary *)parameters
+                                   error:(NSError *__autoreleasing *)error
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"categories"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *categories = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBCategory *category = [[BDBCategory alloc] initWithDictionary:dictionary];
-                                                                if (category)
-                                                                    [categories addObject:category];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(categories, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchCategoryWithId:(NSString *)categoryId
-                 parameters:(NSDictionary *)parameters
-                    success:(void (^)(BDBBeer *))success
-                    failure:(void (^)(NSError *))failure
+    NSMutableDictionary *requestParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+    requestParameters[@"key"] = [self nextAPIKey];
+
+    NSString *URLString = [[NSURL URLWithString:path relativeToURL:self.networkManager.baseURL] absoluteString];
+    return [self.networkManager.requestSerializer requestWithMethod:@"GET"
+                                                          URLString:URLString
+                                                         parameters:requestParameters
+                                                              error:error];
+}
+
+#pragma mark Metrics
+- (BDBRequestMetrics *)metricsForPath:(NSString *)path
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"category" stringByAppendingFormat:@"/%@", categoryId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBCategory *category = [[BDBCategory alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (category)
-                                                                success(category);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+    if (!self.metricsObserver)
+        return nil;
+    return [[BDBRequestMetrics alloc] initWithPath:path endpoint:[BDBResponseCache endpointForPath:path]];
 }
 
-#pragma mark Fermentables
-+ (void)fetchFermentablesWithParameters:(NSDictionary *)parameters
-                                success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
-                                failure:(void (^)(NSError *error))failure
+- (void)reportMetrics:(BDBRequestMetrics *)metrics results:(id)results error:(NSError *)error
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"fermentables"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *fermentables = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBFermentable *fermentable = [[BDBFermentable alloc] initWithDictionary:dictionary];
-                                                                if (fermentable)
-                                                                    [fermentables addObject:fermentable];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(fermentables, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchFermentablesForBeerId:(NSString *)beerId
-                    withParameters:(NSDictionary *)parameters
-                           success:(void (^)(NSArray *fermentables, NSUInteger currentPage, NSUInteger numberOfPages))success
-                           failure:(void (^)(NSError *error))failure
+    void (^metricsObserver)(BDBRequestMetrics *) = self.metricsObserver;
+    if (!metrics || !metricsObserver)
+        return;
+
+    metrics.totalDuration = CFAbsoluteTimeGetCurrent() - metrics.startTime;
+    metrics.error = error;
+    if (results)
+        metrics.itemCount = ([results isKindOfClass:[NSArray class]] ? [results count] : 1);
+    metricsObserver(metrics);
+}
+
+#pragma mark Decoding
++ (void)setLazyDecodingEnabled:(BOOL)lazyDecodingEnabled
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"beer" stringByAppendingFormat:@"/%@/fermentables", beerId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *fermentables = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBFermentable *fermentable = [[BDBFermentable alloc] initWithDictionary:dictionary];
-                                                                if (fermentable)
-                                                                    [fermentables addObject:fermentable];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(fermentables, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchFermentableWithId:(NSString *)fermentableId
-                    parameters:(NSDictionary *)parameters
-                       success:(void (^)(BDBFermentable *fermentable))success
-                       failure:(void (^)(NSError *error))failure
+    BDBLazyDecodingEnabled = lazyDecodingEnabled;
+}
+
++ (BOOL)isLazyDecodingEnabled
 {
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"fermentable" stringByAppendingFormat:@"/%@", fermentableId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBFermentable *fermentable = [[BDBFermentable alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (fermentable)
-                                                                success(fermentable);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+    return BDBLazyDecodingEnabled;
 }
 
-#pragma mark Hops
-+ (void)fetchHopsWithParameters:(NSDictionary *)parameters
-                        success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
-                        failure:(void (^)(NSError *error))failure
+- (BDBRequest *)fetchObjectsAtPath:(NSString *)path
+                        parameters:(NSDictionary *)parameters
+                           decoder:(BDBObjectDecoder)decoder
+                           success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                           failure:(void (^)(NSError *))failure
 {
-    NSParameterAssert(success);
+    return [self fetchPath:path parameters:parameters collection:YES decoder:decoder success:success failure:failure];
+}
+
+- (BDBRequest *)fetchObjectAtPath:(NSString *)path
+                       parameters:(NSDictionary *)parameters
+                          decoder:(BDBObjectDecoder)decoder
+                          success:(void (^)(id))success
+                          failure:(void (^)(NSError *))failure
+{
+    return [self fetchPath:path
+                parameters:parameters
+                collection:NO
+                   decoder:decoder
+                   success:^(id results, NSUInteger currentPage, NSUInteger numberOfPages) {
+                       success(results);
+                   }
+                   failure:failure];
+}
+
+- (BDBRequest *)fetchPath:(NSString *)path
+               parameters:(NSDictionary *)parameters
+               collection:(BOOL)collection
+                  decoder:(BDBObjectDecoder)decoder
+                  success:(BDBResultsBlock)success
+                  failure:(void (^)(NSError *))failure
+{
+    NSDictionary *options = nil;
+    parameters = [[self class] requestParametersFromParameters:parameters options:&options];
+
+    BDBRequestPriority priority = BDBRequestPriorityInteractive;
+    if (options[BreweryDBRequestOptionPriorityKey])
+        priority = [options[BreweryDBRequestOptionPriorityKey] integerValue];
+    BDBRequest *request = [[BDBRequest alloc] initWithPriority:priority];
+    BDBRequestMetrics *metrics = [self metricsForPath:path];
+
+    // Decoding happens on the processing queue; only the caller's blocks hop to its callback queue.
+    // Whichever of completion and cancellation comes first decides which block the caller sees.
+    dispatch_queue_t callbackQueue = options[BreweryDBRequestOptionCallbackQueueKey] ?: self.callbackQueue;
+    BDBResultsBlock queuedSuccess = ^(id results, NSUInteger currentPage, NSUInteger numberOfPages) {
+        if (![request markFinished])
+            return;
+        [self reportMetrics:metrics results:results error:nil];
+        dispatch_async(callbackQueue, ^{
+            success(results, currentPage, numberOfPages);
+        });
+    };
+    void (^queuedFailure)(NSError *) = ^(NSError *error) {
+        if (![request markFinished])
+            return;
+        [self reportMetrics:metrics results:nil error:error];
+        dispatch_async(callbackQueue, ^{
+            failure(error);
+        });
+    };
+    [request addCancellationHandler:^{
+        dispatch_async(callbackQueue, ^{
+            failure([self cancellationError]);
+        });
+    }];
+
+    // Streamed lists are decoded element by element as bytes arrive, so they skip the
+    // response cache and coalescing, both of which need the complete response object.
+    void (^itemHandler)(id) = options[BreweryDBRequestOptionItemHandlerKey];
+    if (collection && (itemHandler || [options[BreweryDBRequestOptionStreamingKey] boolValue]))
+    {
+        request.metrics = metrics;
+        [self streamPath:path
+              parameters:parameters
+                 decoder:decoder
+             itemHandler:itemHandler
+           callbackQueue:callbackQueue
+                 request:request
+                 success:queuedSuccess
+                 failure:queuedFailure];
+        return request;
+    }
+
+    // Identical requests already in flight share one network task and one decoding pass. The
+    // shared task belongs to its own request, cancelled only once every caller has cancelled.
+    NSString *requestKey = [BDBResponseCache keyForPath:path parameters:parameters];
+    BDBRequest *networkRequest = [[BDBRequest alloc] initWithPriority:priority];
+    BOOL startsRequest = [self.requestCoalescer addRequest:request
+                                                    forKey:requestKey
+                                            networkRequest:networkRequest
+                                                   success:queuedSuccess
+                                                   failure:queuedFailure];
+    if (startsRequest)
+        networkRequest.metrics = metrics;
+    else
+    {
+        metrics.source = BDBRequestMetricsSourceCoalesced;
+        networkRequest = [self.requestCoalescer networkRequestForKey:requestKey];
+    }
+
+    __weak BDBRequest *weakRequest = request;
+    [networkRequest addProgressHandler:^(int64_t bytesReceived, int64_t bytesExpected) {
+        [weakRequest updateProgressWithBytesReceived:bytesReceived bytesExpected:bytesExpected];
+    }];
+    [request addPriorityHandler:^(BDBRequestPriority newPriority) {
+        [self.requestCoalescer updatePriorityForKey:requestKey];
+    }];
+    [request addCancellationHandler:^{
+        [[self.requestCoalescer removeRequest:weakRequest forKey:requestKey] cancel];
+    }];
+
+    if (!startsRequest)
+        return request;
+
+    [self GET:path
+   parameters:parameters
+      request:networkRequest
+      success:^(id responseObject, BOOL fromNetwork) {
+          // Nobody is left waiting for a cancelled request, so its response is not decoded.
+          if (networkRequest.isCancelled)
+              return;
+
+          CFAbsoluteTime decodeStart = CFAbsoluteTimeGetCurrent();
+
+          // Time spent waiting in the scheduler is not network time; cached responses never left for the network.
+          CFAbsoluteTime networkStart = networkRequest.startTime;
+          NSTimeInterval networkDuration = (networkStart > 0.0) ? decodeStart - networkStart : 0.0;
+
+          NSError *error = nil;
+          NSUInteger currentPage = 0;
+          NSUInteger numberOfPages = 0;
+          id results = [self resultsFromResponse:responseObject
+                                      collection:collection
+                                         decoder:decoder
+                                     currentPage:&currentPage
+                                   numberOfPages:&numberOfPages
+                                           error:&error];
+
+          metrics.decodeDuration = CFAbsoluteTimeGetCurrent() - decodeStart;
+          void (^timingObserver)(NSString *, NSTimeInterval, NSTimeInterval) = self.timingObserver;
+          if (timingObserver)
+              timingObserver(path, networkDuration, CFAbsoluteTimeGetCurrent() - decodeStart);
+
+          // Only bodies fresh from the network are written through; the store already saw cached ones,
+          // and a stale one would overwrite newer rows.
+          if (results && fromNetwork)
+          {
+              id data = responseObject[BreweryDBResponseDataKey];
+              [self storeObjects:(collection ? results : @[results]) dictionaries:(collection ? data : @[data])];
+          }
+
+          if (results)
+              [self.requestCoalescer finishRequestForKey:requestKey results:results currentPage:currentPage numberOfPages:numberOfPages];
+          else
+              [self.requestCoalescer failRequestForKey:requestKey error:error];
+      }
+      failure:^(NSError *error) {
+          if (!networkRequest.isCancelled)
+              [self.requestCoalescer failRequestForKey:requestKey error:error];
+      }];
+
+    return request;
+}
+
+- (BDBRequest *)searchStoreWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
+{
+    NSDictionary *options = nil;
+    NSDictionary *searchParameters = [[self class] requestParametersFromParameters:parameters options:&options];
+
+    BDBRequestPriority priority = BDBRequestPriorityInteractive;
+    if (options[BreweryDBRequestOptionPriorityKey])
+        priority = [options[BreweryDBRequestOptionPriorityKey] integerValue];
+    BDBRequest *request = [[BDBRequest alloc] initWithPriority:priority];
+
+    dispatch_queue_t callbackQueue = options[BreweryDBRequestOptionCallbackQueueKey] ?: self.callbackQueue;
+    [request addCancellationHandler:^{
+        dispatch_async(callbackQueue, ^{
+            failure([self cancellationError]);
+        });
+    }];
+
+    BDBStore *store = self.store;
+    BDBRequestMetrics *metrics = [self metricsForPath:@"search"];
+    dispatch_async([self processingQueue], ^{
+        if (request.isCancelled)
+            return;
+
+        // Local pages mirror the API's: 1-based, 50 results each.
+        NSUInteger page = MAX([searchParameters[@"p"] integerValue], 1);
+        NSUInteger totalCount = 0;
+        NSArray *results = [store objectsMatchingSearch:searchParameters[@"q"]
+                                                   type:searchParameters[@"type"]
+                                                  range:NSMakeRange((page - 1) * BreweryDBResultsPerPage, BreweryDBResultsPerPage)
+                                             totalCount:&totalCount];
+        if (totalCount > 0)
+        {
+            if (![request markFinished])
+                return;
+            metrics.source = BDBRequestMetricsSourceStore;
+            [self reportMetrics:metrics results:results error:nil];
+            dispatch_async(callbackQueue, ^{
+                success(results, page, (totalCount + BreweryDBResultsPerPage - 1) / BreweryDBResultsPerPage);
+            });
+            return;
+        }
+
+        if (![self readyToBrew])
+        {
+            if (![request markFinished])
+                return;
+            dispatch_async(callbackQueue, ^{
+                failure([self errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+            });
+            return;
+        }
+
+        // Nothing matched locally, so the network answers on the caller's handle.
+        NSMutableDictionary *networkParameters = [parameters mutableCopy];
+        [networkParameters removeObjectForKey:BreweryDBRequestOptionPreferLocalKey];
+        networkParameters[BreweryDBRequestOptionCallbackQueueKey] = callbackQueue;
+        networkParameters[BreweryDBRequestOptionPriorityKey] = @(request.priority);
+        BDBRequest *networkRequest = [self fetchObjectsAtPath:@"search"
+                                                   parameters:networkParameters
+                                                      decoder:[self searchResultDecoder]
+                                                      success:^(NSArray *objects, NSUInteger currentPage, NSUInteger numberOfPages) {
+                                                          if ([request markFinished])
+                                                              success(objects, currentPage, numberOfPages);
+                                                      }
+                                                      failure:^(NSError *error) {
+                                                          if ([request markFinished])
+                                                              failure(error);
+                                                      }];
+        [request addChildRequest:networkRequest];
+    });
+
+    return request;
+}
+
+- (void)streamPath:(NSString *)path
+        parameters:(NSDictionary *)parameters
+           decoder:(BDBObjectDecoder)decoder
+       itemHandler:(void (^)(id))itemHandler
+     callbackQueue:(dispatch_queue_t)callbackQueue
+           request:(BDBRequest *)request
+           success:(BDBResultsBlock)success
+           failure:(void (^)(NSError *))failure
+{
+    NSError *serializationError = nil;
+    NSURLRequest *URLRequest = [self requestWithPath:path parameters:parameters error:&serializationError];
+    if (!URLRequest)
+    {
+        failure(serializationError);
+        return;
+    }
+
+    // The callback queue may be concurrent; a serial queue targeting it delivers items in order, and the
+    // final success or failure only after the last item.
+    dispatch_queue_t itemQueue = dispatch_queue_create("com.brewerydb.items", DISPATCH_QUEUE_SERIAL);
+    dispatch_set_target_queue(itemQueue, callbackQueue);
+
+    NSMutableArray *objects = [NSMutableArray array];
+    NSMutableArray *elements = [NSMutableArray array];
+    __block NSError *decodeError = nil;
+    __block CFAbsoluteTime decodeDuration = 0.0;
+    __block int64_t responseBytes = 0;
+
+    BDBStreamingResponseParser *parser = [[BDBStreamingResponseParser alloc] initWithElementHandler:^BOOL(id element) {
+        if (request.isCancelled)
+            return NO;
+
+        CFAbsoluteTime decodeStart = CFAbsoluteTimeGetCurrent();
+        NSError *error = nil;
+        id object = decoder(element, &error);
+        decodeDuration += CFAbsoluteTimeGetCurrent() - decodeStart;
+
+        if (!object)
+        {
+            decodeError = error;
+            return NO;
+        }
+
+        [objects addObject:object];
+        [elements addObject:element];
+        if (itemHandler)
+        {
+            dispatch_async(itemQueue, ^{
+                itemHandler(object);
+            });
+        }
+        return YES;
+    }];
+
+    void (^completion)(NSHTTPURLResponse *, NSError *) = ^(NSHTTPURLResponse *response, NSError *error) {
+        dispatch_async(itemQueue, ^{
+            if (decodeError || error)
+            {
+                failure(decodeError ?: error);
+                return;
+            }
+
+            NSDictionary *envelope = parser.envelope;
+            if (!parser.isComplete)
+                failure([self errorWithCode:BDB_ERRNO_BAD_API_RESPONSE description:BDB_ERROR_BAD_API_RESPONSE]);
+            else if (![envelope[BreweryDBResponseStatusKey] isEqual:@"success"])
+                failure([self errorWithCode:BDB_ERRNO_API_ERROR description:envelope[BreweryDBResponseErrorKey]]);
+            else
+            {
+                [self storeObjects:objects dictionaries:elements];
+                success(objects,
+                        [envelope[BreweryDBResponseCurrentPageKey] unsignedIntegerValue],
+                        [envelope[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue]);
+            }
+        });
+    };
+
+    [self scheduleRequest:request
+                    start:^(void (^finish)(void)) {
+                        CFAbsoluteTime requestStart = CFAbsoluteTimeGetCurrent();
+                        NSURLSessionDataTask *task = [self.streamingSession dataTaskWithRequest:URLRequest
+                                                                                         parser:parser
+                                                                                       progress:^(int64_t bytesReceived, int64_t bytesExpected) {
+                                                                                           responseBytes = bytesReceived;
+                                                                                           [request updateProgressWithBytesReceived:bytesReceived bytesExpected:bytesExpected];
+                                                                                       }
+                                                                                     completion:^(NSHTTPURLResponse *response, NSError *error) {
+                                                                                         [self updateRateLimitFromResponse:response];
+                                                                                         finish();
+
+                                                                                         // The parser's time includes decoding each element it hands out.
+                                                                                         BDBRequestMetrics *metrics = request.metrics;
+                                                                                         metrics.statusCode = response.statusCode;
+                                                                                         metrics.responseBytes = responseBytes;
+                                                                                         metrics.deserializationDuration = MAX(parser.parseDuration - decodeDuration, 0.0);
+                                                                                         metrics.decodeDuration = decodeDuration;
+
+                                                                                         // Decoding overlaps the transfer, so the network share is what remains.
+                                                                                         void (^timingObserver)(NSString *, NSTimeInterval, NSTimeInterval) = self.timingObserver;
+                                                                                         if (timingObserver)
+                                                                                             timingObserver(path, CFAbsoluteTimeGetCurrent() - requestStart - decodeDuration, decodeDuration);
+
+                                                                                         completion(response, error);
+                                                                                     }];
+                        [self attachTask:task toRequest:request];
+                    }
+                     drop:^(NSError *error) {
+                         completion(nil, error);
+                     }];
+}
+
+- (id)resultsFromResponse:(id)responseObject
+               collection:(BOOL)collection
+                  decoder:(BDBObjectDecoder)decoder
+              currentPage:(NSUInteger *)currentPage
+            numberOfPages:(NSUInteger *)numberOfPages
+                    error:(NSError *__autoreleasing *)error
+{
+    if (![responseObject isKindOfClass:[NSDictionary class]])
+    {
+        *error = [self errorWithCode:BDB_ERRNO_BAD_API_RESPONSE description:BDB_ERROR_BAD_API_RESPONSE];
+        return nil;
+    }
+
+    NSDictionary *response = responseObject;
+    if (![response[BreweryDBResponseStatusKey] isEqual:@"success"])
+    {
+        *error = [self errorWithCode:BDB_ERRNO_API_ERROR description:response[BreweryDBResponseErrorKey]];
+        return nil;
+    }
+
+    if (!collection)
+        return decoder(response[BreweryDBResponseDataKey], error);
+
+    NSMutableArray *objects = [NSMutableArray array];
+    for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
+    {
+        id object = decoder(dictionary, error);
+        if (!object)
+            return nil;
+        [objects addObject:object];
+    }
+
+    *currentPage = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
+    *numberOfPages = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
+    return objects;
+}
+
+- (BDBObjectDecoder)decoderForClass:(Class)modelClass
+{
+    __weak BreweryDB *weakSelf = self;
+    return ^id(NSDictionary *dictionary, NSError *__autoreleasing *error) {
+        id object = [[modelClass alloc] initWithDictionary:dictionary];
+        if (object)
+            return object;
+
+        if (modelClass == [BDBBrewery class])
+            *error = [weakSelf errorWithCode:BDB_ERRNO_BREWERY_OBJECT_CREATION_FAILED
+                                 description:BDB_ERROR_BREWERY_OBJECT_CREATION_FAILED];
+        else if (modelClass == [BDBGuild class])
+            *error = [weakSelf errorWithCode:BDB_ERRNO_GUILD_OBJECT_CREATION_FAILED
+                                 description:BDB_ERROR_GUILD_OBJECT_CREATION_FAILED];
+        else
+            *error = [weakSelf errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
+                                 description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED];
+        return nil;
+    };
+}
+
+- (BDBObjectDecoder)searchResultDecoder
+{
+    BDBObjectDecoder beerDecoder = [self decoderForClass:[BDBBeer class]];
+    BDBObjectDecoder breweryDecoder = [self decoderForClass:[BDBBrewery class]];
+    BDBObjectDecoder guildDecoder = [self decoderForClass:[BDBGuild class]];
+
+    return ^id(NSDictionary *dictionary, NSError *__autoreleasing *error) {
+        NSString *type = dictionary[@"type"];
+        if ([type isEqual:@"beer"])
+            return beerDecoder(dictionary, error);
+        else if ([type isEqual:@"brewery"])
+            return breweryDecoder(dictionary, error);
+        else if ([type isEqual:@"guild"])
+            return guildDecoder(dictionary, error);
+        else
+            return dictionary;
+    };
+}
+
+- (void)storeObjects:(NSArray *)objects dictionaries:(NSArray *)dictionaries
+{
+    BDBStore *store = self.store;
+    if (!store || objects.count != dictionaries.count)
+        return;
+
+    // Results are written through once per response, so screens can render from the store next time.
+    // Search results mix classes, and whatever decoded to a plain dictionary has no table.
+    NSMutableDictionary *dictionariesByClass = [NSMutableDictionary dictionary];
+    [objects enumerateObjectsUsingBlock:^(id object, NSUInteger index, BOOL *stop) {
+        if ([object isKindOfClass:[NSDictionary class]])
+            return;
+
+        NSString *className = NSStringFromClass([object class]);
+        NSMutableArray *classDictionaries = dictionariesByClass[className];
+        if (!classDictionaries)
+        {
+            classDictionaries = [NSMutableArray array];
+            dictionariesByClass[className] = classDictionaries;
+        }
+        [classDictionaries addObject:dictionaries[index]];
+    }];
+    [dictionariesByClass enumerateKeysAndObjectsUsingBlock:^(NSString *className, NSArray *classDictionaries, BOOL *stop) {
+        [store storeObjectDictionaries:classDictionaries ofClass:NSClassFromString(className)];
+    }];
+}
+
+#pragma mark Search
+- (BDBRequest *)search:(NSString *)queryString
+                  type:(BreweryDBSearchType)type
+       withBreweryInfo:(BOOL)withBreweryInfo
+            parameters:(NSDictionary *)parameters
+               success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+               failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(queryString);
+    NSParameterAssert(success);
     NSParameterAssert(failure);
     
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+    // The store only indexes the types the search API returns as model objects.
+    BOOL preferLocal = ([parameters[BreweryDBRequestOptionPreferLocalKey] boolValue] &&
+                        (type == BreweryDBSearchTypeAll || type == BreweryDBSearchTypeBeer ||
+                         type == BreweryDBSearchTypeBrewery || type == BreweryDBSearchTypeGuild));
+    if (!preferLocal && ![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
     
     NSMutableDictionary *mutableParameters = parameters.mutableCopy;
     if (!mutableParameters)
         mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
+    mutableParameters[@"q"] = queryString;
     
-    [[[[self class] sharedInstance] networkManager] GET:@"hops"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *hops = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBHop *hop = [[BDBHop alloc] initWithDictionary:dictionary];
-                                                                if (hop)
-                                                                    [hops addObject:hop];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(hops, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchHopsForBeerId:(NSString *)beerId
-            withParameters:(NSDictionary *)parameters
-                   success:(void (^)(NSArray *hops, NSUInteger currentPage, NSUInteger numberOfPages))success
-                   failure:(void (^)(NSError *error))failure
-{
-    NSParameterAssert(success);
-    NSParameterAssert(failure);
+    if (withBreweryInfo)
+        mutableParameters[@"withBreweries"] = @"Y";
     
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
+    switch (type)
+    {
+        case BreweryDBSearchTypeBrewery:
+        {
+            mutableParameters[@"type"] = @"brewery";
+            break;
+        }
+        case BreweryDBSearchTypeBeer:
+        {
+            mutableParameters[@"type"] = @"beer";
+            break;
+        }
+        case BreweryDBSearchTypeGuild:
+        {
+            mutableParameters[@"type"] = @"guild";
+            break;
+        }
+        case BreweryDBSearchTypeEvent:
+        {
+            mutableParameters[@"type"] = @"event";
+            break;
+        }
+        case BreweryDBSearchTypeAll:
+        default:
+            break;
+    }
     
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
+    if (preferLocal)
+        return [self searchStoreWithParameters:mutableParameters success:success failure:failure];
     
-    [[[[self class] sharedInstance] networkManager] GET:[@"beer" stringByAppendingFormat:@"/%@/hops", beerId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *hops = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBHop *hop = [[BDBHop alloc] initWithDictionary:dictionary];
-                                                                if (hop)
-                                                                    [hops addObject:hop];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(hops, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchHopWithId:(NSString *)hopId
-            parameters:(NSDictionary *)parameters
-               success:(void (^)(BDBHop *hop))success
-               failure:(void (^)(NSError *error))failure
+    return [self fetchObjectsAtPath:@"search"
+                         parameters:mutableParameters
+                            decoder:[self searchResultDecoder]
+                            success:success
+                            failure:failure];
+}
+
+#pragma mark Beers
+- (BDBRequest *)fetchBeersWithParameters:(NSDictionary *)parameters
+                         withBreweryInfo:(BOOL)withBreweryInfo
+                                 success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                 failure:(void (^)(NSError *))failure
 {
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"hop" stringByAppendingFormat:@"/%@", hopId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBHop *hop = [[BDBHop alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (hop)
-                                                                success(hop);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    if (withBreweryInfo)
+    {
+        NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+        mutableParameters[@"withBreweries"] = @"Y";
+        parameters = mutableParameters;
+    }
+
+    return [self fetchObjectsAtPath:@"beers"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBBeer class]]
+                            success:success
+                            failure:failure];
 }
 
-#pragma mark Yeasts
-+ (void)fetchYeastsWithParameters:(NSDictionary *)parameters
-                          success:(void (^)(NSArray *yeast, NSUInteger currentPage, NSUInteger numberOfPages))success
-                          failure:(void (^)(NSError *error))failure
+- (BDBRequest *)fetchBeerWithId:(NSString *)beerId
+                withBreweryInfo:(BOOL)withBreweryInfo
+                     parameters:(NSDictionary *)parameters
+                        success:(void (^)(BDBBeer *))success
+                        failure:(void (^)(NSError *))failure
 {
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"yeasts"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *yeasts = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBYeast *yeast = [[BDBYeast alloc] initWithDictionary:dictionary];
-                                                                if (yeast)
-                                                                    [yeasts addObject:yeast];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(yeasts, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchYeastsForBeerId:(NSString *)beerId
-              withParameters:(NSDictionary *)parameters
-                     success:(void (^)(NSArray *yeast, NSUInteger currentPage, NSUInteger numberOfPages))success
-                     failure:(void (^)(NSError *error))failure
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    if (withBreweryInfo)
+    {
+        NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+        mutableParameters[@"withBreweries"] = @"Y";
+        parameters = mutableParameters;
+    }
+
+    return [self fetchObjectAtPath:[@"beer" stringByAppendingFormat:@"/%@", beerId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBBeer class]]
+                           success:success
+                           failure:failure];
+}
+
+- (BDBRequest *)loadBeerWithId:(NSString *)beerId
+               withBreweryInfo:(BOOL)withBreweryInfo
+                       success:(void (^)(BDBBeer *))success
+                       failure:(void (^)(NSError *))failure
 {
+    NSParameterAssert(beerId);
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"beer" stringByAppendingFormat:@"/%@/yeasts", beerId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *yeasts = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBYeast *yeast = [[BDBYeast alloc] initWithDictionary:dictionary];
-                                                                if (yeast)
-                                                                    [yeasts addObject:yeast];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(yeasts, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchYeastWithId:(NSString *)yeastId
-              parameters:(NSDictionary *)parameters
-                 success:(void (^)(BDBYeast *yeast))success
-                 failure:(void (^)(NSError *error))failure
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:nil failure:failure];
+        return nil;
+    }
+
+    BDBBatchLoader *loader = withBreweryInfo ? self.beerWithBreweriesLoader : self.beerLoader;
+    return [loader loadObjectWithId:beerId success:success failure:failure];
+}
+
+#pragma mark Breweries
+- (BDBRequest *)fetchBreweriesWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                     failure:(void (^)(NSError *))failure
 {
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"yeast" stringByAppendingFormat:@"/%@", yeastId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBYeast *yeast = [[BDBYeast alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (yeast)
-                                                                success(yeast);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"breweries"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBBrewery class]]
+                            success:success
+                            failure:failure];
 }
 
-#pragma mark Locations
-+ (void)fetchLocationsWithParameters:(NSDictionary *)parameters
-                             success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
-                             failure:(void (^)(NSError *error))failure
+- (BDBRequest *)fetchBreweryWithId:(NSString *)breweryId
+                        parameters:(NSDictionary *)parameters
+                           success:(void (^)(BDBBrewery *))success
+                           failure:(void (^)(NSError *))failure
 {
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:@"locations"
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *locations = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBLocation *location = [[BDBLocation alloc] initWithDictionary:dictionary];
-                                                                if (location)
-                                                                    [locations addObject:location];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(locations, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchLocationsForBreweryId:(NSString *)breweryId
-                    withParameters:(NSDictionary *)parameters
-                           success:(void (^)(NSArray *locations, NSUInteger currentPage, NSUInteger numberOfPages))success
-                           failure:(void (^)(NSError *error))failure
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"breweries" stringByAppendingFormat:@"/%@", breweryId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBBrewery class]]
+                           success:success
+                           failure:failure];
+}
+
+- (BDBRequest *)loadBreweryWithId:(NSString *)breweryId
+                          success:(void (^)(BDBBrewery *))success
+                          failure:(void (^)(NSError *))failure
 {
+    NSParameterAssert(breweryId);
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"location" stringByAppendingFormat:@"/%@/locations", breweryId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            NSMutableArray *locations = [NSMutableArray array];
-                                                            for (NSDictionary *dictionary in response[BreweryDBResponseDataKey])
-                                                            {
-                                                                BDBLocation *location = [[BDBLocation alloc] initWithDictionary:dictionary];
-                                                                if (location)
-                                                                    [locations addObject:location];
-                                                                else
-                                                                {
-                                                                    failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                             description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                                    break;
-                                                                }
-                                                            }
-                                                            NSUInteger  numberOfPages   = [response[BreweryDBResponseNumberOfPagesKey] unsignedIntegerValue];
-                                                            NSUInteger  currentPage     = [response[BreweryDBResponseCurrentPageKey] unsignedIntegerValue];
-                                                            success(locations, currentPage, numberOfPages);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
-}
-
-+ (void)fetchLocationWithId:(NSString *)locationId
-                 parameters:(NSDictionary *)parameters
-                    success:(void (^)(BDBLocation *location))success
-                    failure:(void (^)(NSError *error))failure
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:nil failure:failure];
+        return nil;
+    }
+
+    return [[self breweryLoader] loadObjectWithId:breweryId success:success failure:failure];
+}
+
+#pragma mark Styles
+- (BDBRequest *)fetchStylesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
 {
     NSParameterAssert(success);
     NSParameterAssert(failure);
-    
-    if (![[[self class] sharedInstance] readyToBrew])
-        return failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_MISSING_API_KEY description:BDB_ERROR_MISSING_API_KEY]);
-    
-    NSMutableDictionary *mutableParameters = parameters.mutableCopy;
-    if (!mutableParameters)
-        mutableParameters = [NSMutableDictionary dictionary];
-    mutableParameters[@"key"] = [[[self class] sharedInstance] apiKey];
-    
-    [[[[self class] sharedInstance] networkManager] GET:[@"location" stringByAppendingFormat:@"/%@", locationId]
-                                             parameters:mutableParameters
-                                                success:^(NSURLSessionDataTask *task, id responseObject) {
-                                                    if ([responseObject isKindOfClass:[NSDictionary class]])
-                                                    {
-                                                        NSDictionary *response = responseObject;
-                                                        if ([response[BreweryDBResponseStatusKey] isEqualToString:@"success"])
-                                                        {
-                                                            BDBLocation *location = [[BDBLocation alloc] initWithDictionary:response[BreweryDBResponseDataKey]];
-                                                            if (location)
-                                                                success(location);
-                                                            else
-                                                                failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BEER_OBJECT_CREATION_FAILED
-                                                                                                         description:BDB_ERROR_BEER_OBJECT_CREATION_FAILED]);
-                                                        }
-                                                        else
-                                                            failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_API_ERROR
-                                                                                                     description:response[BreweryDBResponseErrorKey]]);
-                                                    }
-                                                    else
-                                                        failure([[[self class] sharedInstance] errorWithCode:BDB_ERRNO_BAD_API_RESPONSE
-                                                                                                 description:BDB_ERROR_BAD_API_RESPONSE]);
-                                                }
-                                                failure:^(NSURLSessionDataTask *task, NSError *error) {
-                                                    failure(error);
-                                                }];
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"styles"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBStyle class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchStyleWithId:(NSString *)styleId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBStyle *))success
+                         failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"style" stringByAppendingFormat:@"/%@", styleId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBStyle class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Categories
+- (BDBRequest *)fetchCategoriesWithParameters:(NSDictionary *)parameters
+                                      success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                      failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"categories"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBCategory class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchCategoryWithId:(NSString *)categoryId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBCategory *))success
+                            failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"category" stringByAppendingFormat:@"/%@", categoryId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBCategory class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Fermentables
+- (BDBRequest *)fetchFermentablesWithParameters:(NSDictionary *)parameters
+                                        success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                        failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"fermentables"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBFermentable class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchFermentablesForBeerId:(NSString *)beerId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                   failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:[@"beer" stringByAppendingFormat:@"/%@/fermentables", beerId]
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBFermentable class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchFermentableWithId:(NSString *)fermentableId
+                            parameters:(NSDictionary *)parameters
+                               success:(void (^)(BDBFermentable *))success
+                               failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"fermentable" stringByAppendingFormat:@"/%@", fermentableId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBFermentable class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Hops
+- (BDBRequest *)fetchHopsWithParameters:(NSDictionary *)parameters
+                                success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"hops"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBHop class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchHopsForBeerId:(NSString *)beerId
+                    withParameters:(NSDictionary *)parameters
+                           success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                           failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:[@"beer" stringByAppendingFormat:@"/%@/hops", beerId]
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBHop class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchHopWithId:(NSString *)hopId
+                    parameters:(NSDictionary *)parameters
+                       success:(void (^)(BDBHop *))success
+                       failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"hop" stringByAppendingFormat:@"/%@", hopId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBHop class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Yeasts
+- (BDBRequest *)fetchYeastsWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"yeasts"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBYeast class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchYeastsForBeerId:(NSString *)beerId
+                      withParameters:(NSDictionary *)parameters
+                             success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                             failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:[@"beer" stringByAppendingFormat:@"/%@/yeasts", beerId]
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBYeast class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchYeastWithId:(NSString *)yeastId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBYeast *))success
+                         failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"yeast" stringByAppendingFormat:@"/%@", yeastId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBYeast class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Locations
+- (BDBRequest *)fetchLocationsWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                     failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:@"locations"
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBLocation class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchLocationsForBreweryId:(NSString *)breweryId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                   failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectsAtPath:[@"brewery" stringByAppendingFormat:@"/%@/locations", breweryId]
+                         parameters:parameters
+                            decoder:[self decoderForClass:[BDBLocation class]]
+                            success:success
+                            failure:failure];
+}
+
+- (BDBRequest *)fetchLocationWithId:(NSString *)locationId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBLocation *))success
+                            failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:parameters failure:failure];
+        return nil;
+    }
+
+    return [self fetchObjectAtPath:[@"location" stringByAppendingFormat:@"/%@", locationId]
+                        parameters:parameters
+                           decoder:[self decoderForClass:[BDBLocation class]]
+                           success:success
+                           failure:failure];
+}
+
+#pragma mark Parameters
++ (NSDictionary *)requestParametersFromParameters:(NSDictionary *)parameters options:(NSDictionary *__autoreleasing *)options
+{
+    NSMutableDictionary *requestParameters = [NSMutableDictionary dictionary];
+    NSMutableDictionary *requestOptions = [NSMutableDictionary dictionary];
+    [parameters enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+        if ([key isKindOfClass:[NSString class]] && [key hasPrefix:BreweryDBRequestOptionPrefix])
+            requestOptions[key] = obj;
+        else
+            requestParameters[key] = obj;
+    }];
+
+    if (options)
+        *options = requestOptions;
+    return requestParameters;
+}
+
+#pragma mark Page Requests
++ (NSDictionary *)parameters:(NSDictionary *)parameters forPage:(NSUInteger)page
+{
+    NSMutableDictionary *mutableParameters = [NSMutableDictionary dictionaryWithDictionary:parameters];
+    mutableParameters[@"p"] = @(page);
+    return mutableParameters;
+}
+
+- (BDBPageRequestBlock)pageRequestForSearch:(NSString *)queryString
+                                       type:(BreweryDBSearchType)type
+                            withBreweryInfo:(BOOL)withBreweryInfo
+                                 parameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self search:queryString
+                       type:type
+            withBreweryInfo:withBreweryInfo
+                 parameters:[[self class] parameters:parameters forPage:page]
+                    success:success
+                    failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForBeersWithParameters:(NSDictionary *)parameters withBreweryInfo:(BOOL)withBreweryInfo
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchBeersWithParameters:[[self class] parameters:parameters forPage:page]
+                              withBreweryInfo:withBreweryInfo
+                                      success:success
+                                      failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForBreweriesWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchBreweriesWithParameters:[[self class] parameters:parameters forPage:page]
+                                          success:success
+                                          failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForStylesWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchStylesWithParameters:[[self class] parameters:parameters forPage:page]
+                                       success:success
+                                       failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForCategoriesWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchCategoriesWithParameters:[[self class] parameters:parameters forPage:page]
+                                           success:success
+                                           failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForFermentablesWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchFermentablesWithParameters:[[self class] parameters:parameters forPage:page]
+                                             success:success
+                                             failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForHopsWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchHopsWithParameters:[[self class] parameters:parameters forPage:page]
+                                     success:success
+                                     failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForYeastsWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchYeastsWithParameters:[[self class] parameters:parameters forPage:page]
+                                       success:success
+                                       failure:failure];
+    };
+}
+
+- (BDBPageRequestBlock)pageRequestForLocationsWithParameters:(NSDictionary *)parameters
+{
+    return ^BDBRequest *(NSUInteger page, BDBPageSuccessBlock success, void (^failure)(NSError *)) {
+        return [self fetchLocationsWithParameters:[[self class] parameters:parameters forPage:page]
+                                          success:success
+                                          failure:failure];
+    };
+}
+
+#pragma mark Fetch All
+- (BDBPageFetcher *)fetchAllPagesWithRequest:(BDBPageRequestBlock)pageRequest
+                       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                    progress:(void (^)(NSUInteger, NSUInteger))progress
+                                     success:(void (^)(NSArray *))success
+                                     failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(pageRequest);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    BDBPageFetcher *pageFetcher = [[BDBPageFetcher alloc] initWithPageRequest:pageRequest];
+    if (maxConcurrentRequests > 0)
+        pageFetcher.maxConcurrentRequests = maxConcurrentRequests;
+    pageFetcher.progress = progress;
+    [pageFetcher startWithSuccess:success failure:failure];
+    return pageFetcher;
+}
+
+- (BDBPageFetcher *)fetchAllBeersWithParameters:(NSDictionary *)parameters
+                                withBreweryInfo:(BOOL)withBreweryInfo
+                          maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                       progress:(void (^)(NSUInteger, NSUInteger))progress
+                                        success:(void (^)(NSArray *))success
+                                        failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForBeersWithParameters:parameters withBreweryInfo:withBreweryInfo]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllBreweriesWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger, NSUInteger))progress
+                                            success:(void (^)(NSArray *))success
+                                            failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForBreweriesWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllStylesWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger, NSUInteger))progress
+                                         success:(void (^)(NSArray *))success
+                                         failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForStylesWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllCategoriesWithParameters:(NSDictionary *)parameters
+                               maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                            progress:(void (^)(NSUInteger, NSUInteger))progress
+                                             success:(void (^)(NSArray *))success
+                                             failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForCategoriesWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllFermentablesWithParameters:(NSDictionary *)parameters
+                                 maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                              progress:(void (^)(NSUInteger, NSUInteger))progress
+                                               success:(void (^)(NSArray *))success
+                                               failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForFermentablesWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllHopsWithParameters:(NSDictionary *)parameters
+                         maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                      progress:(void (^)(NSUInteger, NSUInteger))progress
+                                       success:(void (^)(NSArray *))success
+                                       failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForHopsWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllYeastsWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger, NSUInteger))progress
+                                         success:(void (^)(NSArray *))success
+                                         failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForYeastsWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+- (BDBPageFetcher *)fetchAllLocationsWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger, NSUInteger))progress
+                                            success:(void (^)(NSArray *))success
+                                            failure:(void (^)(NSError *))failure
+{
+    return [self fetchAllPagesWithRequest:[self pageRequestForLocationsWithParameters:parameters]
+                    maxConcurrentRequests:maxConcurrentRequests
+                                 progress:progress
+                                  success:success
+                                  failure:failure];
+}
+
+#pragma mark Hydration
+- (BDBRequest *)hydrateBeers:(NSArray *)beers
+                     options:(BDBHydrationOptions)options
+       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                     success:(void (^)(NSArray *, NSDictionary *))success
+                     failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(beers);
+    NSParameterAssert(success);
+    NSParameterAssert(failure);
+
+    if (![self readyToBrew])
+    {
+        [self failWithMissingAPIKeyForParameters:nil failure:failure];
+        return nil;
+    }
+
+    BDBHydrator *hydrator = [[BDBHydrator alloc] initWithClient:self
+                                                        options:options
+                                      maximumConcurrentRequests:(maxConcurrentRequests > 0 ? maxConcurrentRequests : 4)];
+    return [hydrator hydrateBeers:beers callbackQueue:[self callbackQueue] success:success failure:failure];
+}
+
+- (BDBRequest *)hydrateBeer:(id)beer
+                    options:(BDBHydrationOptions)options
+                    success:(void (^)(BDBBeer *, NSDictionary *))success
+                    failure:(void (^)(NSError *))failure
+{
+    NSParameterAssert(beer);
+    NSParameterAssert(success);
+
+    return [self hydrateBeers:@[beer]
+                      options:options
+        maxConcurrentRequests:0
+                      success:^(NSArray *beers, NSDictionary *errors) {
+                          success(beers.firstObject, errors);
+                      }
+                      failure:failure];
+}
+
+@end
+
+
+#pragma mark -
+@implementation BreweryDB (DefaultClient)
+
+#pragma mark Callbacks
++ (void)setCallbackQueue:(dispatch_queue_t)callbackQueue
+{
+    [[self defaultClient] setCallbackQueue:callbackQueue];
+}
+
++ (dispatch_queue_t)callbackQueue
+{
+    return [[self defaultClient] callbackQueue];
+}
+
++ (void)setTimingObserver:(void (^)(NSString *, NSTimeInterval, NSTimeInterval))timingObserver
+{
+    [[self defaultClient] setTimingObserver:timingObserver];
+}
+
++ (void)setMetricsObserver:(void (^)(BDBRequestMetrics *))metricsObserver
+{
+    [[self defaultClient] setMetricsObserver:metricsObserver];
+}
+
+#pragma mark Networking
++ (void)setSessionConfiguration:(NSURLSessionConfiguration *)sessionConfiguration
+{
+    [[self defaultClient] setSessionConfiguration:sessionConfiguration];
+}
+
+#pragma mark Caching
++ (void)setResponseCache:(BDBResponseCache *)responseCache
+{
+    [[self defaultClient] setResponseCache:responseCache];
+}
+
++ (BDBResponseCache *)responseCache
+{
+    return [[self defaultClient] responseCache];
+}
+
+#pragma mark Storage
++ (void)setStore:(BDBStore *)store
+{
+    [[self defaultClient] setStore:store];
+}
+
++ (BDBStore *)store
+{
+    return [[self defaultClient] store];
+}
+
+#pragma mark Batching
++ (void)setBatchWindow:(NSTimeInterval)batchWindow maxBatchSize:(NSUInteger)maxBatchSize
+{
+    [[self defaultClient] setBatchWindow:batchWindow maxBatchSize:maxBatchSize];
+}
+
+#pragma mark Scheduling
++ (void)setRequestScheduler:(BDBRequestScheduler *)requestScheduler
+{
+    [[self defaultClient] setRequestScheduler:requestScheduler];
+}
+
++ (BDBRequestScheduler *)requestScheduler
+{
+    return [[self defaultClient] requestScheduler];
+}
+
+#pragma mark Retries
++ (void)setRetryPolicy:(BDBRetryPolicy *)retryPolicy
+{
+    [[self defaultClient] setRetryPolicy:retryPolicy];
+}
+
++ (BDBRetryPolicy *)retryPolicy
+{
+    return [[self defaultClient] retryPolicy];
+}
+
+#pragma mark Coalescing
++ (NSUInteger)coalescedRequestCount
+{
+    return [[self defaultClient] coalescedRequestCount];
+}
+
++ (NSUInteger)startedRequestCount
+{
+    return [[self defaultClient] startedRequestCount];
+}
+
+#pragma mark Search
++ (BDBRequest *)search:(NSString *)queryString
+                  type:(BreweryDBSearchType)type
+       withBreweryInfo:(BOOL)withBreweryInfo
+            parameters:(NSDictionary *)parameters
+               success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+               failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] search:queryString
+                                   type:type
+                        withBreweryInfo:withBreweryInfo
+                             parameters:parameters
+                                success:success
+                                failure:failure];
+}
+
+#pragma mark Beers
++ (BDBRequest *)fetchBeersWithParameters:(NSDictionary *)parameters
+                         withBreweryInfo:(BOOL)withBreweryInfo
+                                 success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                 failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchBeersWithParameters:parameters
+                                          withBreweryInfo:withBreweryInfo
+                                                  success:success
+                                                  failure:failure];
+}
+
++ (BDBRequest *)fetchBeerWithId:(NSString *)beerId
+                withBreweryInfo:(BOOL)withBreweryInfo
+                     parameters:(NSDictionary *)parameters
+                        success:(void (^)(BDBBeer *))success
+                        failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchBeerWithId:beerId
+                                 withBreweryInfo:withBreweryInfo
+                                      parameters:parameters
+                                         success:success
+                                         failure:failure];
+}
+
++ (BDBRequest *)loadBeerWithId:(NSString *)beerId
+               withBreweryInfo:(BOOL)withBreweryInfo
+                       success:(void (^)(BDBBeer *))success
+                       failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] loadBeerWithId:beerId
+                                withBreweryInfo:withBreweryInfo
+                                        success:success
+                                        failure:failure];
+}
+
+#pragma mark Breweries
++ (BDBRequest *)fetchBreweriesWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                     failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchBreweriesWithParameters:parameters
+                                                      success:success
+                                                      failure:failure];
+}
+
++ (BDBRequest *)fetchBreweryWithId:(NSString *)breweryId
+                        parameters:(NSDictionary *)parameters
+                           success:(void (^)(BDBBrewery *))success
+                           failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchBreweryWithId:breweryId
+                                         parameters:parameters
+                                            success:success
+                                            failure:failure];
+}
+
++ (BDBRequest *)loadBreweryWithId:(NSString *)breweryId
+                          success:(void (^)(BDBBrewery *))success
+                          failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] loadBreweryWithId:breweryId
+                                           success:success
+                                           failure:failure];
+}
+
+#pragma mark Styles
++ (BDBRequest *)fetchStylesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchStylesWithParameters:parameters
+                                                   success:success
+                                                   failure:failure];
+}
+
++ (BDBRequest *)fetchStyleWithId:(NSString *)styleId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBStyle *))success
+                         failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchStyleWithId:styleId
+                                       parameters:parameters
+                                          success:success
+                                          failure:failure];
+}
+
+#pragma mark Categories
++ (BDBRequest *)fetchCategoriesWithParameters:(NSDictionary *)parameters
+                                      success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                      failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchCategoriesWithParameters:parameters
+                                                       success:success
+                                                       failure:failure];
+}
+
++ (BDBRequest *)fetchCategoryWithId:(NSString *)categoryId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBCategory *))success
+                            failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchCategoryWithId:categoryId
+                                          parameters:parameters
+                                             success:success
+                                             failure:failure];
+}
+
+#pragma mark Fermentables
++ (BDBRequest *)fetchFermentablesWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchFermentablesWithParameters:parameters
+                                                         success:success
+                                                         failure:failure];
+}
+
++ (BDBRequest *)fetchFermentablesForBeerId:(NSString *)beerId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                   failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchFermentablesForBeerId:beerId
+                                             withParameters:parameters
+                                                    success:success
+                                                    failure:failure];
+}
+
++ (BDBRequest *)fetchFermentableWithId:(NSString *)fermentableId
+                            parameters:(NSDictionary *)parameters
+                               success:(void (^)(BDBFermentable *))success
+                               failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchFermentableWithId:fermentableId
+                                             parameters:parameters
+                                                success:success
+                                                failure:failure];
+}
+
+#pragma mark Hops
++ (BDBRequest *)fetchHopsWithParameters:(NSDictionary *)parameters
+                                success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchHopsWithParameters:parameters
+                                                 success:success
+                                                 failure:failure];
+}
+
++ (BDBRequest *)fetchHopsForBeerId:(NSString *)beerId
+                    withParameters:(NSDictionary *)parameters
+                           success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                           failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchHopsForBeerId:beerId
+                                     withParameters:parameters
+                                            success:success
+                                            failure:failure];
+}
+
++ (BDBRequest *)fetchHopWithId:(NSString *)hopId
+                    parameters:(NSDictionary *)parameters
+                       success:(void (^)(BDBHop *))success
+                       failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchHopWithId:hopId
+                                     parameters:parameters
+                                        success:success
+                                        failure:failure];
+}
+
+#pragma mark Yeasts
++ (BDBRequest *)fetchYeastsWithParameters:(NSDictionary *)parameters
+                                  success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                  failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchYeastsWithParameters:parameters
+                                                   success:success
+                                                   failure:failure];
+}
+
++ (BDBRequest *)fetchYeastsForBeerId:(NSString *)beerId
+                      withParameters:(NSDictionary *)parameters
+                             success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                             failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchYeastsForBeerId:beerId
+                                       withParameters:parameters
+                                              success:success
+                                              failure:failure];
+}
+
++ (BDBRequest *)fetchYeastWithId:(NSString *)yeastId
+                      parameters:(NSDictionary *)parameters
+                         success:(void (^)(BDBYeast *))success
+                         failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchYeastWithId:yeastId
+                                       parameters:parameters
+                                          success:success
+                                          failure:failure];
+}
+
+#pragma mark Locations
++ (BDBRequest *)fetchLocationsWithParameters:(NSDictionary *)parameters
+                                     success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                     failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchLocationsWithParameters:parameters
+                                                      success:success
+                                                      failure:failure];
+}
+
++ (BDBRequest *)fetchLocationsForBreweryId:(NSString *)breweryId
+                            withParameters:(NSDictionary *)parameters
+                                   success:(void (^)(NSArray *, NSUInteger, NSUInteger))success
+                                   failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchLocationsForBreweryId:breweryId
+                                             withParameters:parameters
+                                                    success:success
+                                                    failure:failure];
+}
+
++ (BDBRequest *)fetchLocationWithId:(NSString *)locationId
+                         parameters:(NSDictionary *)parameters
+                            success:(void (^)(BDBLocation *))success
+                            failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchLocationWithId:locationId
+                                          parameters:parameters
+                                             success:success
+                                             failure:failure];
+}
+
+#pragma mark Page Requests
++ (BDBPageRequestBlock)pageRequestForSearch:(NSString *)queryString
+                                       type:(BreweryDBSearchType)type
+                            withBreweryInfo:(BOOL)withBreweryInfo
+                                 parameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForSearch:queryString
+                                                 type:type
+                                      withBreweryInfo:withBreweryInfo
+                                           parameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForBeersWithParameters:(NSDictionary *)parameters withBreweryInfo:(BOOL)withBreweryInfo
+{
+    return [[self defaultClient] pageRequestForBeersWithParameters:parameters withBreweryInfo:withBreweryInfo];
+}
+
++ (BDBPageRequestBlock)pageRequestForBreweriesWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForBreweriesWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForStylesWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForStylesWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForCategoriesWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForCategoriesWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForFermentablesWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForFermentablesWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForHopsWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForHopsWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForYeastsWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForYeastsWithParameters:parameters];
+}
+
++ (BDBPageRequestBlock)pageRequestForLocationsWithParameters:(NSDictionary *)parameters
+{
+    return [[self defaultClient] pageRequestForLocationsWithParameters:parameters];
+}
+
+#pragma mark Fetch All
++ (BDBPageFetcher *)fetchAllPagesWithRequest:(BDBPageRequestBlock)pageRequest
+                       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                    progress:(void (^)(NSUInteger, NSUInteger))progress
+                                     success:(void (^)(NSArray *))success
+                                     failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllPagesWithRequest:pageRequest
+                                    maxConcurrentRequests:maxConcurrentRequests
+                                                 progress:progress
+                                                  success:success
+                                                  failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllBeersWithParameters:(NSDictionary *)parameters
+                                withBreweryInfo:(BOOL)withBreweryInfo
+                          maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                       progress:(void (^)(NSUInteger, NSUInteger))progress
+                                        success:(void (^)(NSArray *))success
+                                        failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllBeersWithParameters:parameters
+                                             withBreweryInfo:withBreweryInfo
+                                       maxConcurrentRequests:maxConcurrentRequests
+                                                    progress:progress
+                                                     success:success
+                                                     failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllBreweriesWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger, NSUInteger))progress
+                                            success:(void (^)(NSArray *))success
+                                            failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllBreweriesWithParameters:parameters
+                                           maxConcurrentRequests:maxConcurrentRequests
+                                                        progress:progress
+                                                         success:success
+                                                         failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllStylesWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger, NSUInteger))progress
+                                         success:(void (^)(NSArray *))success
+                                         failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllStylesWithParameters:parameters
+                                        maxConcurrentRequests:maxConcurrentRequests
+                                                     progress:progress
+                                                      success:success
+                                                      failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllCategoriesWithParameters:(NSDictionary *)parameters
+                               maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                            progress:(void (^)(NSUInteger, NSUInteger))progress
+                                             success:(void (^)(NSArray *))success
+                                             failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllCategoriesWithParameters:parameters
+                                            maxConcurrentRequests:maxConcurrentRequests
+                                                         progress:progress
+                                                          success:success
+                                                          failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllFermentablesWithParameters:(NSDictionary *)parameters
+                                 maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                              progress:(void (^)(NSUInteger, NSUInteger))progress
+                                               success:(void (^)(NSArray *))success
+                                               failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllFermentablesWithParameters:parameters
+                                              maxConcurrentRequests:maxConcurrentRequests
+                                                           progress:progress
+                                                            success:success
+                                                            failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllHopsWithParameters:(NSDictionary *)parameters
+                         maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                      progress:(void (^)(NSUInteger, NSUInteger))progress
+                                       success:(void (^)(NSArray *))success
+                                       failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllHopsWithParameters:parameters
+                                      maxConcurrentRequests:maxConcurrentRequests
+                                                   progress:progress
+                                                    success:success
+                                                    failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllYeastsWithParameters:(NSDictionary *)parameters
+                           maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                        progress:(void (^)(NSUInteger, NSUInteger))progress
+                                         success:(void (^)(NSArray *))success
+                                         failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllYeastsWithParameters:parameters
+                                        maxConcurrentRequests:maxConcurrentRequests
+                                                     progress:progress
+                                                      success:success
+                                                      failure:failure];
+}
+
++ (BDBPageFetcher *)fetchAllLocationsWithParameters:(NSDictionary *)parameters
+                              maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                                           progress:(void (^)(NSUInteger, NSUInteger))progress
+                                            success:(void (^)(NSArray *))success
+                                            failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] fetchAllLocationsWithParameters:parameters
+                                           maxConcurrentRequests:maxConcurrentRequests
+                                                        progress:progress
+                                                         success:success
+                                                         failure:failure];
+}
+
+#pragma mark Hydration
++ (BDBRequest *)hydrateBeers:(NSArray *)beers
+                     options:(BDBHydrationOptions)options
+       maxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                     success:(void (^)(NSArray *, NSDictionary *))success
+                     failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] hydrateBeers:beers
+                                      options:options
+                        maxConcurrentRequests:maxConcurrentRequests
+                                      success:success
+                                      failure:failure];
+}
+
++ (BDBRequest *)hydrateBeer:(id)beer
+                    options:(BDBHydrationOptions)options
+                    success:(void (^)(BDBBeer *, NSDictionary *))success
+                    failure:(void (^)(NSError *))failure
+{
+    return [[self defaultClient] hydrateBeer:beer
+                                     options:options
+                                     success:success
+                                     failure:failure];
 }
 
 @end
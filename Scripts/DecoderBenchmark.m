@@ -0,0 +1,556 @@
+//
+//  DecoderBenchmark.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+//
+//  Compares the schema-generated model decoders with the hand-written decoders
+//  they replaced (reproduced below as BDBLegacy* classes). Build and run on a Mac:
+//
+//      clang -fobjc-arc -O2 -framework Foundation -IBreweryDB \
+//          Scripts/DecoderBenchmark.m \
+//          BreweryDB/BDB{Beer,Brewery,Location,Style,Category,Hop,Fermentable,Yeast,IdentityMap,ModelCoercion}.m \
+//          -o /tmp/DecoderBenchmark && /tmp/DecoderBenchmark [iterations]
+//
+//  Generated decoders are timed in both the default eager mode and lazy mode.
+//  Record the output in README.md when the decoders change.
+
+#import <Foundation/Foundation.h>
+
+#import "BDBBeer.h"
+#import "BDBBrewery.h"
+#import "BDBLocation.h"
+#import "BDBStyle.h"
+#import "BDBCategory.h"
+#import "BDBIdentityMap.h"
+#import "BDBModelCoercion.h"
+
+@class BDBLegacyBrewery, BDBLegacyStyle;
+
+
+#pragma mark -
+@interface BDBLegacyCategory : NSObject
+
+@property (nonatomic, copy, readonly) NSString *categoryId;
+@property (nonatomic) NSNumber *createDate;
+@property (nonatomic, copy) NSString *name;
+
+@property (nonatomic, copy, readonly) NSString *status;
+
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLegacyCategory
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    if (!dictionary)
+        return self;
+
+    @try
+    {
+        _categoryId         = dictionary[@"id"];
+        _createDate         = dictionary[NSStringFromSelector(@selector(createDate))];
+        _name               = dictionary[NSStringFromSelector(@selector(name))];
+
+        _status             = dictionary[NSStringFromSelector(@selector(status))];
+    }
+    @catch (NSException *exception)
+    {
+        NSLog(@"Could not parse category: %@", exception);
+        return nil;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBLegacyStyle : NSObject
+
+@property (nonatomic, copy, readonly) NSString *styleId;
+@property (nonatomic) BDBLegacyCategory *category;
+@property (nonatomic) NSNumber *srmMax;
+@property (nonatomic) NSNumber *ibuMax;
+@property (nonatomic) NSNumber *srmMin;
+@property (nonatomic, copy) NSString *descriptionString;
+@property (nonatomic) NSNumber *fgMin;
+@property (nonatomic) NSNumber *ibuMin;
+@property (nonatomic) NSNumber *createDate;
+@property (nonatomic) NSNumber *fgMax;
+@property (nonatomic) NSNumber *abvMax;
+@property (nonatomic) NSNumber *ogMin;
+@property (nonatomic) NSNumber *ogMax;
+@property (nonatomic) NSNumber *abvMin;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic) NSNumber *categoryId;
+
+@property (nonatomic, copy, readonly) NSString *status;
+
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLegacyStyle
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    if (!dictionary)
+        return self;
+
+    @try
+    {
+        _styleId            = dictionary[@"id"];
+        
+        NSDictionary* categoryDictionary = dictionary[NSStringFromSelector(@selector(category))];
+        _category = [[BDBLegacyCategory alloc] initWithDictionary:categoryDictionary];
+
+        _srmMax             = dictionary[NSStringFromSelector(@selector(srmMax))];
+        _ibuMax             = dictionary[NSStringFromSelector(@selector(ibuMax))];
+        _srmMin             = dictionary[NSStringFromSelector(@selector(srmMin))];
+        _descriptionString  = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+        _fgMin              = dictionary[NSStringFromSelector(@selector(fgMin))];
+        _ibuMin             = dictionary[NSStringFromSelector(@selector(ibuMin))];
+        _createDate         = dictionary[NSStringFromSelector(@selector(createDate))];
+        _fgMax              = dictionary[NSStringFromSelector(@selector(fgMax))];
+        _abvMax             = dictionary[NSStringFromSelector(@selector(abvMax))];
+        _ogMin              = dictionary[NSStringFromSelector(@selector(ogMin))];
+        _ogMax              = dictionary[NSStringFromSelector(@selector(ogMax))];
+        _abvMin             = dictionary[NSStringFromSelector(@selector(abvMin))];
+        _name               = dictionary[NSStringFromSelector(@selector(name))];
+        _categoryId         = dictionary[NSStringFromSelector(@selector(categoryId))];
+
+        _status             = dictionary[NSStringFromSelector(@selector(status))];
+    }
+    @catch (NSException *exception)
+    {
+        NSLog(@"Could not parse style: %@", exception);
+        return nil;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBLegacyLocation : NSObject
+
+@property (nonatomic, copy, readonly) NSString *locationId;
+@property (nonatomic, copy) NSString *name;
+
+@property (nonatomic, copy) NSString *streetAddress;
+@property (nonatomic, copy) NSString *extendedAddress;
+@property (nonatomic, copy) NSString *locality;
+@property (nonatomic, copy) NSString *region;
+@property (nonatomic, copy) NSString *postalCode;
+@property (nonatomic, copy) NSString *phone;
+@property (nonatomic, copy) NSString *website;
+@property (nonatomic, copy) NSString *hoursOfOperation;
+@property (nonatomic, copy) NSString *hoursOfOperationExplicit;
+@property (nonatomic, copy) NSString *hoursOfOperationNotes;
+@property (nonatomic, copy) NSString *tourInfo;
+@property (nonatomic, copy) NSString *timezone;
+
+@property (nonatomic)       NSNumber *latitude;
+@property (nonatomic)       NSNumber *longitude;
+
+@property (nonatomic) BDBLegacyBrewery *brewery;
+
+@property (nonatomic, assign, getter = isPrimary)       BOOL primary;
+@property (nonatomic, assign, getter = inPlanning)      BOOL planning;
+@property (nonatomic, assign, getter = isClosed)        BOOL closed;
+@property (nonatomic, assign, getter = isOpenToPublic)  BOOL openToPublic;
+
+@property (nonatomic, copy) NSString *locationType;
+@property (nonatomic, copy) NSString *locationTypeDisplay;
+@property (nonatomic, copy) NSString *countryIsoCode;
+
+@property (nonatomic, copy) NSDictionary *country;
+
+@property (nonatomic)       NSNumber *yearOpened;
+@property (nonatomic)       NSNumber *yearClosed;
+
+@property (nonatomic, copy, readonly) NSString *status;
+
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLegacyLocation
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    if (!dictionary)
+        return self;
+
+    @try
+    {
+        _locationId = dictionary[@"id"];
+        _name = dictionary[NSStringFromSelector(@selector(name))];
+
+        _streetAddress = dictionary[NSStringFromSelector(@selector(streetAddress))];
+        _extendedAddress = dictionary[NSStringFromSelector(@selector(extendedAddress))];
+        _locality = dictionary[NSStringFromSelector(@selector(locality))];
+        _region = dictionary[NSStringFromSelector(@selector(region))];
+        _postalCode = dictionary[NSStringFromSelector(@selector(postalCode))];
+        _phone = dictionary[NSStringFromSelector(@selector(phone))];
+        _website = dictionary[NSStringFromSelector(@selector(website))];
+        _hoursOfOperation = dictionary[NSStringFromSelector(@selector(hoursOfOperation))];
+        _hoursOfOperationExplicit = dictionary[NSStringFromSelector(@selector(hoursOfOperationExplicit))];
+        _hoursOfOperationNotes = dictionary[NSStringFromSelector(@selector(hoursOfOperationNotes))];
+        _tourInfo = dictionary[NSStringFromSelector(@selector(tourInfo))];
+        _timezone = dictionary[NSStringFromSelector(@selector(timezone))];
+
+        _latitude = dictionary[NSStringFromSelector(@selector(latitude))];
+        _longitude = dictionary[NSStringFromSelector(@selector(longitude))];
+
+        NSDictionary* breweryDictionary = dictionary[NSStringFromSelector(@selector(brewery))];
+        _brewery = [[BDBLegacyBrewery alloc] initWithDictionary:breweryDictionary];
+
+        _primary = [dictionary[NSStringFromSelector(@selector(isPrimary))] boolValue];
+        _planning = [dictionary[NSStringFromSelector(@selector(inPlanning))] boolValue];
+        _closed = [dictionary[NSStringFromSelector(@selector(isClosed))] boolValue];
+        _openToPublic = [dictionary[NSStringFromSelector(@selector(openToPublic))] boolValue];
+        
+        _locationType = dictionary[NSStringFromSelector(@selector(locationType))];
+        _locationTypeDisplay = dictionary[NSStringFromSelector(@selector(locationTypeDisplay))];
+        _countryIsoCode = dictionary[NSStringFromSelector(@selector(countryIsoCode))];
+        
+        _country = dictionary[NSStringFromSelector(@selector(country))];
+        _yearOpened = dictionary[NSStringFromSelector(@selector(yearOpened))];
+        _yearClosed = dictionary[NSStringFromSelector(@selector(yearClosed))];
+
+        _status = dictionary[NSStringFromSelector(@selector(status))];
+    }
+    @catch (NSException *exception)
+    {
+        NSLog(@"Could not parse beer: %@", exception);
+        return nil;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBLegacyBrewery : NSObject
+
+@property (nonatomic, copy, readonly) NSString *breweryId;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSString *descriptionString;
+@property (nonatomic, copy) NSString *website;
+@property (nonatomic) NSNumber *established;
+@property (nonatomic, copy) NSString *mailingListURL;
+@property (nonatomic, assign, getter = isOrganic) BOOL organic;
+@property (nonatomic) NSDictionary *images;
+@property (nonatomic) NSArray *locations;
+
+@property (nonatomic, copy, readonly) NSString *status;
+
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLegacyBrewery
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    if (!dictionary)
+        return self;
+
+    @try
+    {
+        _breweryId = dictionary[@"id"];
+        _name = dictionary[NSStringFromSelector(@selector(name))];
+        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+        _website = dictionary[NSStringFromSelector(@selector(website))];
+        _established = dictionary[NSStringFromSelector(@selector(established))];
+        _mailingListURL = dictionary[NSStringFromSelector(@selector(mailingListURL))];
+        _organic = [dictionary[NSStringFromSelector(@selector(isOrganic))] boolValue];
+        _images = dictionary[NSStringFromSelector(@selector(images))];
+
+        NSMutableArray *mutableLocations = [NSMutableArray array];
+        for (NSDictionary *locationDictionary in dictionary[NSStringFromSelector(@selector(locations))])
+        {
+            BDBLegacyLocation *location = [[BDBLegacyLocation alloc] initWithDictionary:locationDictionary];
+            if (location)
+                [mutableLocations addObject:location];
+            else
+                NSLog(@"Could not parse location: %@", location);
+        }
+        _locations = mutableLocations;
+
+        _status = dictionary[NSStringFromSelector(@selector(status))];
+    }
+    @catch (NSException *exception)
+    {
+        NSLog(@"Could not parse brewery: %@", exception);
+        return nil;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBLegacyBeer : NSObject
+
+@property (nonatomic, copy, readonly) NSString *beerId;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSString *descriptionString;
+@property (nonatomic) NSArray *breweries;
+@property (nonatomic, copy) NSString *foodPairings;
+@property (nonatomic, copy) NSString *originalGravity;
+@property (nonatomic) NSNumber *abv;
+@property (nonatomic) NSNumber *ibu;
+@property (nonatomic) NSNumber *glasswareId;
+@property (nonatomic) NSDictionary *glass;
+@property (nonatomic) NSNumber *styleId;
+@property (nonatomic) BDBLegacyStyle *style;
+@property (nonatomic, assign, getter = isOrganic) BOOL organic;
+@property (nonatomic) NSDictionary *labels;
+@property (nonatomic) NSNumber *servingTemperature;
+@property (nonatomic, copy) NSString *servingTemperatureDisplay;
+@property (nonatomic) NSNumber *availableId;
+@property (nonatomic) NSDictionary *available;
+@property (nonatomic) NSString *beerVariationId;
+@property (nonatomic) NSNumber *year;
+
+@property (nonatomic, copy, readonly) NSString *status;
+
+- (id)initWithDictionary:(NSDictionary *)dictionary;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLegacyBeer
+
+- (id)initWithDictionary:(NSDictionary *)dictionary
+{
+    self = [super init];
+    if (!self)
+        return nil;
+
+    if (!dictionary)
+        return self;
+
+    @try
+    {
+        _beerId = dictionary[@"id"];
+        _name = dictionary[NSStringFromSelector(@selector(name))];
+        _descriptionString = [dictionary[@"description"] stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+
+        NSMutableArray *mutableBreweries = [NSMutableArray array];
+        for (NSDictionary *breweryDictionary in dictionary[NSStringFromSelector(@selector(breweries))])
+        {
+            BDBLegacyBrewery *brewery = [[BDBLegacyBrewery alloc] initWithDictionary:breweryDictionary];
+            if (brewery)
+                [mutableBreweries addObject:brewery];
+            else
+                NSLog(@"Could not parse brewery: %@", brewery);
+        }
+        _breweries = mutableBreweries;
+
+        _foodPairings = dictionary[NSStringFromSelector(@selector(foodPairings))];
+        _originalGravity = dictionary[NSStringFromSelector(@selector(originalGravity))];
+        _abv = dictionary[NSStringFromSelector(@selector(abv))];
+        _ibu = dictionary[NSStringFromSelector(@selector(ibu))];
+        _glasswareId = dictionary[NSStringFromSelector(@selector(glasswareId))];
+        _glass = dictionary[NSStringFromSelector(@selector(glass))];
+        _styleId = dictionary[NSStringFromSelector(@selector(styleId))];
+
+        NSDictionary* styleDictionary = dictionary[NSStringFromSelector(@selector(style))];
+        _style = [[BDBLegacyStyle alloc] initWithDictionary:styleDictionary];
+
+        _organic = [dictionary[NSStringFromSelector(@selector(isOrganic))] boolValue];
+        _labels = dictionary[NSStringFromSelector(@selector(labels))];
+        _servingTemperature = dictionary[NSStringFromSelector(@selector(servingTemperature))];
+        _servingTemperatureDisplay = dictionary[NSStringFromSelector(@selector(servingTemperatureDisplay))];
+        _availableId = dictionary[NSStringFromSelector(@selector(availableId))];
+        _available = dictionary[NSStringFromSelector(@selector(available))];
+        _beerVariationId = dictionary[NSStringFromSelector(@selector(beerVariationId))];
+        _year = dictionary[NSStringFromSelector(@selector(year))];
+
+        _status = dictionary[NSStringFromSelector(@selector(status))];
+    }
+    @catch (NSException *exception)
+    {
+        NSLog(@"Could not parse beer: %@", exception);
+        return nil;
+    }
+
+    return self;
+}
+
+@end
+
+
+#pragma mark - Fixture
+static NSDictionary *BDBBenchmarkLocation(NSUInteger index)
+{
+    return @{@"id": [NSString stringWithFormat:@"loc%lu", (unsigned long)index],
+             @"name": @"Main Brewery",
+             @"streetAddress": @"1 Main Street",
+             @"locality": @"Portland",
+             @"region": @"Oregon",
+             @"postalCode": @"97201",
+             @"latitude": @45.5231,
+             @"longitude": @-122.6765,
+             @"isPrimary": @"Y",
+             @"inPlanning": @"N",
+             @"isClosed": @"N",
+             @"openToPublic": @"Y",
+             @"locationType": @"micro",
+             @"locationTypeDisplay": @"Micro Brewery",
+             @"countryIsoCode": @"US",
+             @"country": @{@"isoCode": @"US", @"name": @"UNITED STATES"},
+             @"yearOpened": @"1995",
+             @"status": @"verified"};
+}
+
+static NSDictionary *BDBBenchmarkBeer(NSUInteger index)
+{
+    NSDictionary *category = @{@"id": @3, @"name": @"North American Origin Ales", @"createDate": @"2012-03-21 20:06:45"};
+    NSDictionary *style = @{@"id": @25, @"categoryId": @3, @"category": category, @"name": @"American-Style Pale Ale",
+                            @"description": @"  American pale ales range from deep golden to copper in color.  ",
+                            @"ibuMin": @"30", @"ibuMax": @"42", @"abvMin": @"4.5", @"abvMax": @"5.6",
+                            @"srmMin": @"6", @"srmMax": @"14", @"ogMin": @"1.044", @"fgMin": @"1.008", @"fgMax": @"1.014",
+                            @"createDate": @"2012-03-21 20:06:45"};
+    NSDictionary *brewery = @{@"id": @"brew1", @"name": @"Example Brewing Company",
+                              @"description": @"  A brewery that exists only in this benchmark.  ",
+                              @"website": @"http://www.example.com", @"established": @"1995", @"isOrganic": @"N",
+                              @"images": @{@"icon": @"https://example.com/icon.png"},
+                              @"locations": @[BDBBenchmarkLocation(1), BDBBenchmarkLocation(2)],
+                              @"status": @"verified"};
+
+    return @{@"id": [NSString stringWithFormat:@"beer%lu", (unsigned long)index],
+             @"name": @"Example Pale Ale",
+             @"description": @"  A hoppy pale ale brewed with Cascade and Centennial.  ",
+             @"abv": @"5.4",
+             @"ibu": @"38",
+             @"glasswareId": @5,
+             @"glass": @{@"id": @5, @"name": @"Pint"},
+             @"styleId": @25,
+             @"style": style,
+             @"isOrganic": @"N",
+             @"labels": @{@"icon": @"https://example.com/label.png"},
+             @"servingTemperature": @"cool",
+             @"servingTemperatureDisplay": @"Cool - (8-12C/45-54F)",
+             @"availableId": @1,
+             @"available": @{@"id": @1, @"name": @"Year Round"},
+             @"year": @"2013",
+             @"breweries": @[brewery],
+             @"status": @"verified"};
+}
+
+
+#pragma mark - Benchmark
+static double BDBBenchmarkMeasure(NSArray *dictionaries, NSUInteger iterations, void (^decode)(NSDictionary *dictionary))
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++)
+    {
+        @autoreleasepool
+        {
+            for (NSDictionary *dictionary in dictionaries)
+                decode(dictionary);
+        }
+    }
+    return (CFAbsoluteTimeGetCurrent() - start) / (double)(iterations * dictionaries.count) * 1e6;
+}
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool
+    {
+        NSUInteger iterations = (argc > 1) ? (NSUInteger)strtoul(argv[1], NULL, 10) : 200;
+
+        // One page of beers with brewery info, as returned by beers?withBreweries=Y.
+        NSMutableArray *page = [NSMutableArray array];
+        for (NSUInteger i = 0; i < 50; i++)
+            [page addObject:BDBBenchmarkBeer(i)];
+
+        __block NSUInteger sink = 0;
+        double legacy = BDBBenchmarkMeasure(page, iterations, ^(NSDictionary *dictionary) {
+            BDBLegacyBeer *beer = [[BDBLegacyBeer alloc] initWithDictionary:dictionary];
+            sink += beer.name.length + beer.breweries.count;
+        });
+        void (^readList)(NSDictionary *) = ^(NSDictionary *dictionary) {
+            BDBBeer *beer = [[BDBBeer alloc] initWithDictionary:dictionary];
+            sink += beer.name.length + (beer.abv.doubleValue > 0.0);
+        };
+        void (^readGraph)(NSDictionary *) = ^(NSDictionary *dictionary) {
+            BDBBeer *beer = [[BDBBeer alloc] initWithDictionary:dictionary];
+            sink += beer.name.length + beer.style.category.name.length + beer.descriptionString.length;
+            for (BDBBrewery *brewery in beer.breweries)
+                sink += brewery.locations.count + brewery.descriptionString.length;
+        };
+
+        BDBLazyDecodingEnabled = NO;
+        double eagerList = BDBBenchmarkMeasure(page, iterations, readList);
+        double eagerGraph = BDBBenchmarkMeasure(page, iterations, readGraph);
+
+        BDBLazyDecodingEnabled = YES;
+        double lazyList = BDBBenchmarkMeasure(page, iterations, readList);
+        double lazyGraph = BDBBenchmarkMeasure(page, iterations, readGraph);
+
+        printf("legacy decoders, eager graph       %8.2f us/beer\n", legacy);
+        printf("generated, eager, name + abv       %8.2f us/beer (%.1fx)\n", eagerList, legacy / eagerList);
+        printf("generated, eager, full graph       %8.2f us/beer (%.1fx)\n", eagerGraph, legacy / eagerGraph);
+        printf("generated, lazy, name + abv        %8.2f us/beer (%.1fx)\n", lazyList, legacy / lazyList);
+        printf("generated, lazy, full graph        %8.2f us/beer (%.1fx)\n", lazyGraph, legacy / lazyGraph);
+        printf("(%lu)\n", (unsigned long)sink);
+    }
+    return 0;
+}
@@ -0,0 +1,385 @@
+//
+//  LoadTest.m
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+//
+//  Drives concurrent fetch and search requests through the SDK and reports
+//  throughput and latency percentiles. Responses come from BDBReplayURLProtocol,
+//  so runs are repeatable and never touch the rate-limited live API once a
+//  recording exists. Build and run on a Mac:
+//
+//      clang -fobjc-arc -O2 -framework Foundation -framework CoreLocation -lsqlite3 \
+//          -F Pod/Frameworks -framework AFNetworking -IBreweryDB \
+//          Scripts/LoadTest.m BreweryDB/*.m -o /tmp/LoadTest
+//
+//      /tmp/LoadTest --record --key API_KEY --recordings /tmp/bdb-recordings --requests 30
+//      /tmp/LoadTest --recordings /tmp/bdb-recordings --latency 0.08 --jitter 0.03 --bandwidth 250000
+//      /tmp/LoadTest --synthetic 200 --requests 1000 --concurrency 16 --error-rate 0.02
+//
+//  Replays of recordings need the same requests as the recording run, so keep
+//  --requests no higher than when recording. Synthetic runs answer every list
+//  endpoint with generated pages and need no recordings.
+
+#import <Foundation/Foundation.h>
+
+#import "BreweryDB.h"
+#import "BDBReplayURLProtocol.h"
+
+
+/**
+ *  One unit of load: start a request for the given iteration and call
+ *  completion with its error, or nil, when it finishes.
+ */
+typedef BDBRequest *(^BDBLoadTestWorkload)(NSUInteger iteration, void (^completion)(NSError *error));
+
+
+#pragma mark -
+@interface BDBLoadTestResult : NSObject
+
+@property (nonatomic, readonly) NSUInteger requestCount;
+@property (nonatomic, readonly) NSUInteger failureCount;
+@property (nonatomic, readonly) NSTimeInterval duration;
+@property (nonatomic, readonly) double throughput;              // completed requests per second
+
+@property (nonatomic, readonly) NSTimeInterval meanLatency;
+@property (nonatomic, readonly) NSTimeInterval p50Latency;
+@property (nonatomic, readonly) NSTimeInterval p95Latency;
+@property (nonatomic, readonly) NSTimeInterval p99Latency;
+@property (nonatomic, readonly) NSTimeInterval maximumLatency;
+
+@end
+
+
+#pragma mark -
+@interface BDBLoadTest : NSObject
+
+#pragma mark Instantiation
+/**
+ *  Create a load test. Pair it with BDBReplayURLProtocol to measure the SDK
+ *  against recorded or synthetic responses instead of the live API, and set
+ *  the response cache to nil unless cache hits are what is being measured.
+ *
+ *  @param workload Block starting one request per iteration.
+ *
+ *  @return A new load test.
+ *
+ *  @since 1.1.0
+ */
+- (id)initWithWorkload:(BDBLoadTestWorkload)workload;
+
+/**
+ *  A workload alternating beer, brewery and search requests over distinct
+ *  pages, so responses are not served by coalescing.
+ *
+ *  @param searchQuery Query used by the search requests.
+ *
+ *  @since 1.1.0
+ */
++ (BDBLoadTestWorkload)fetchAndSearchWorkloadWithQuery:(NSString *)searchQuery;
+
+@property (nonatomic, assign) NSUInteger requestCount;          // defaults to 200
+@property (nonatomic, assign) NSUInteger concurrency;           // requests in flight at once, defaults to 8
+
+#pragma mark Running
+/**
+ *  Run the workload requestCount times, keeping concurrency requests in flight.
+ *
+ *  @param completion Called on the main queue with the measurements.
+ *
+ *  @since 1.1.0
+ */
+- (void)runWithCompletion:(void (^)(BDBLoadTestResult *result))completion;
+
+@end
+
+
+static NSTimeInterval BDBLoadTestPercentile(const NSTimeInterval *sortedLatencies, NSUInteger count, double percentile)
+{
+    if (count == 0)
+        return 0.0;
+    NSUInteger rank = (NSUInteger)ceil(percentile * count);
+    return sortedLatencies[MIN(MAX(rank, 1), count) - 1];
+}
+
+static int BDBLoadTestCompareLatencies(const void *a, const void *b)
+{
+    NSTimeInterval latencyA = *(const NSTimeInterval *)a;
+    NSTimeInterval latencyB = *(const NSTimeInterval *)b;
+    return (latencyA > latencyB) - (latencyA < latencyB);
+}
+
+
+#pragma mark -
+@interface BDBLoadTestResult ()
+
+@property (nonatomic, readwrite) NSUInteger requestCount;
+@property (nonatomic, readwrite) NSUInteger failureCount;
+@property (nonatomic, readwrite) NSTimeInterval duration;
+@property (nonatomic, readwrite) double throughput;
+
+@property (nonatomic, readwrite) NSTimeInterval meanLatency;
+@property (nonatomic, readwrite) NSTimeInterval p50Latency;
+@property (nonatomic, readwrite) NSTimeInterval p95Latency;
+@property (nonatomic, readwrite) NSTimeInterval p99Latency;
+@property (nonatomic, readwrite) NSTimeInterval maximumLatency;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLoadTestResult
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"%lu requests (%lu failed) in %.2f s, %.1f req/s, latency mean %.1f ms, p50 %.1f ms, p95 %.1f ms, p99 %.1f ms, max %.1f ms",
+            (unsigned long)self.requestCount, (unsigned long)self.failureCount, self.duration, self.throughput,
+            self.meanLatency * 1000.0, self.p50Latency * 1000.0, self.p95Latency * 1000.0, self.p99Latency * 1000.0, self.maximumLatency * 1000.0];
+}
+
+@end
+
+
+#pragma mark -
+@interface BDBLoadTest ()
+{
+    BDBLoadTestWorkload _workload;
+
+    NSUInteger _startedCount;
+    NSUInteger _completedCount;
+    NSUInteger _failureCount;
+    NSMutableData *_latencies;
+    CFAbsoluteTime _startTime;
+    void (^_completion)(BDBLoadTestResult *);
+}
+
+- (void)startNextRequest;
+- (BDBLoadTestResult *)result;
+
+@end
+
+
+#pragma mark -
+@implementation BDBLoadTest
+
+#pragma mark Instantiation
+- (id)initWithWorkload:(BDBLoadTestWorkload)workload
+{
+    NSParameterAssert(workload);
+
+    self = [super init];
+    if (self)
+    {
+        _workload = [workload copy];
+        _requestCount = 200;
+        _concurrency = 8;
+    }
+    return self;
+}
+
++ (BDBLoadTestWorkload)fetchAndSearchWorkloadWithQuery:(NSString *)searchQuery
+{
+    NSParameterAssert(searchQuery);
+
+    return ^BDBRequest *(NSUInteger iteration, void (^completion)(NSError *)) {
+        NSDictionary *parameters = @{@"p": @(iteration / 3 + 1)};
+        void (^success)(NSArray *, NSUInteger, NSUInteger) = ^(NSArray *results, NSUInteger currentPage, NSUInteger numberOfPages) {
+            completion(nil);
+        };
+
+        switch (iteration % 3)
+        {
+            case 0:
+                return [BreweryDB fetchBeersWithParameters:parameters withBreweryInfo:NO success:success failure:completion];
+            case 1:
+                return [BreweryDB fetchBreweriesWithParameters:parameters success:success failure:completion];
+            default:
+                return [BreweryDB search:searchQuery type:BreweryDBSearchTypeAll withBreweryInfo:NO parameters:parameters success:success failure:completion];
+        }
+    };
+}
+
+#pragma mark Running
+- (void)runWithCompletion:(void (^)(BDBLoadTestResult *))completion
+{
+    NSParameterAssert(completion);
+
+    NSUInteger concurrency = 0;
+    @synchronized(self)
+    {
+        NSAssert(!_completion, @"A load test is already running");
+        _completion = [completion copy];
+        _startedCount = 0;
+        _completedCount = 0;
+        _failureCount = 0;
+        _latencies = [NSMutableData dataWithCapacity:self.requestCount * sizeof(NSTimeInterval)];
+        _startTime = CFAbsoluteTimeGetCurrent();
+        concurrency = MIN(MAX(self.concurrency, 1), self.requestCount);
+    }
+
+    if (self.requestCount == 0)
+    {
+        BDBLoadTestResult *result = [self result];
+        _completion = nil;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(result);
+        });
+        return;
+    }
+
+    for (NSUInteger i = 0; i < concurrency; i++)
+        [self startNextRequest];
+}
+
+- (void)startNextRequest
+{
+    NSUInteger iteration;
+    @synchronized(self)
+    {
+        if (_startedCount >= self.requestCount)
+            return;
+        iteration = _startedCount++;
+    }
+
+    // Each request's latency runs from when the workload starts it to when its completion fires.
+    CFAbsoluteTime requestStart = CFAbsoluteTimeGetCurrent();
+    __block BOOL completed = NO;
+    _workload(iteration, ^(NSError *error) {
+        BDBLoadTestResult *result = nil;
+        void (^completion)(BDBLoadTestResult *) = nil;
+        @synchronized(self)
+        {
+            if (completed)
+                return;
+            completed = YES;
+
+            NSTimeInterval latency = CFAbsoluteTimeGetCurrent() - requestStart;
+            [_latencies appendBytes:&latency length:sizeof(latency)];
+            _completedCount++;
+            if (error)
+                _failureCount++;
+
+            if (_completedCount == self.requestCount)
+            {
+                result = [self result];
+                completion = _completion;
+                _completion = nil;
+            }
+        }
+
+        if (completion)
+        {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(result);
+            });
+            return;
+        }
+        [self startNextRequest];
+    });
+}
+
+- (BDBLoadTestResult *)result
+{
+    NSUInteger count = _latencies.length / sizeof(NSTimeInterval);
+    NSTimeInterval *latencies = _latencies.mutableBytes;
+    qsort(latencies, count, sizeof(NSTimeInterval), BDBLoadTestCompareLatencies);
+
+    NSTimeInterval totalLatency = 0.0;
+    for (NSUInteger i = 0; i < count; i++)
+        totalLatency += latencies[i];
+
+    BDBLoadTestResult *result = [[BDBLoadTestResult alloc] init];
+    result.requestCount = _completedCount;
+    result.failureCount = _failureCount;
+    result.duration = CFAbsoluteTimeGetCurrent() - _startTime;
+    result.throughput = result.duration > 0.0 ? _completedCount / result.duration : 0.0;
+    result.meanLatency = count > 0 ? totalLatency / count : 0.0;
+    result.p50Latency = BDBLoadTestPercentile(latencies, count, 0.50);
+    result.p95Latency = BDBLoadTestPercentile(latencies, count, 0.95);
+    result.p99Latency = BDBLoadTestPercentile(latencies, count, 0.99);
+    result.maximumLatency = count > 0 ? latencies[count - 1] : 0.0;
+    return result;
+}
+
+@end
+
+
+#pragma mark -
+static NSDictionary *LoadTestSyntheticObject(NSString *type, NSUInteger index)
+{
+    return @{@"id": [NSString stringWithFormat:@"%@%06lu", type, (unsigned long)index],
+             @"name": [NSString stringWithFormat:@"Synthetic %@ %lu", type, (unsigned long)index],
+             @"description": @"Generated by LoadTest.m for offline load testing.",
+             @"type": type,
+             @"status": @"verified"};
+}
+
+int main(int argc, const char *argv[])
+{
+    @autoreleasepool
+    {
+        NSArray *argumentList = [[NSProcessInfo processInfo] arguments];
+        NSString *(^option)(NSString *) = ^NSString *(NSString *name) {
+            NSUInteger index = [argumentList indexOfObject:[@"--" stringByAppendingString:name]];
+            return (index != NSNotFound && index + 1 < argumentList.count) ? argumentList[index + 1] : nil;
+        };
+
+        BOOL record = [argumentList containsObject:@"--record"];
+        NSString *recordings = option(@"recordings") ?: [NSTemporaryDirectory() stringByAppendingPathComponent:@"BreweryDBRecordings"];
+        NSUInteger syntheticPages = (NSUInteger)[option(@"synthetic") integerValue];
+
+        [BDBReplayURLProtocol setRecordingsDirectoryURL:[NSURL fileURLWithPath:recordings isDirectory:YES]];
+        [BDBReplayURLProtocol setMode:(record ? BDBReplayModeRecord : BDBReplayModeReplay)];
+        [BDBReplayURLProtocol setLatency:[option(@"latency") doubleValue] jitter:[option(@"jitter") doubleValue]];
+        [BDBReplayURLProtocol setBandwidth:[option(@"bandwidth") doubleValue]];
+        [BDBReplayURLProtocol setErrorRate:[option(@"error-rate") doubleValue] error:nil];
+        if (syntheticPages > 0)
+        {
+            NSDictionary *types = @{@"beers": @"beer", @"breweries": @"brewery", @"search": @"beer"};
+            [types enumerateKeysAndObjectsUsingBlock:^(NSString *path, NSString *type, BOOL *stop) {
+                [BDBReplayURLProtocol registerSyntheticListAtPath:path numberOfPages:syntheticPages resultsPerPage:50 generator:^NSDictionary *(NSUInteger index) {
+                    return LoadTestSyntheticObject(type, index);
+                }];
+            }];
+        }
+
+        // Measure the network and decoding path, not the response cache or store.
+        [BreweryDB setSessionConfiguration:[BDBReplayURLProtocol sessionConfiguration]];
+        [BreweryDB setResponseCache:nil];
+        [BreweryDB setStore:nil];
+        [BreweryDB setRequestScheduler:nil];
+        [BreweryDB setCallbackQueue:dispatch_queue_create("LoadTest.callbacks", DISPATCH_QUEUE_CONCURRENT)];
+        [BreweryDB brew:(option(@"key") ?: @"replay")];
+
+        BDBLoadTest *loadTest = [[BDBLoadTest alloc] initWithWorkload:[BDBLoadTest fetchAndSearchWorkloadWithQuery:(option(@"query") ?: @"ale")]];
+        if (option(@"requests"))
+            loadTest.requestCount = (NSUInteger)[option(@"requests") integerValue];
+        if (option(@"concurrency"))
+            loadTest.concurrency = (NSUInteger)[option(@"concurrency") integerValue];
+
+        [loadTest runWithCompletion:^(BDBLoadTestResult *result) {
+            printf("%s\n", result.description.UTF8String);
+            exit(result.failureCount > 0 && !option(@"error-rate") ? 1 : 0);
+        }];
+        [[NSRunLoop mainRunLoop] run];
+    }
+    return 0;
+}
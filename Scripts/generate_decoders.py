@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+#  generate_decoders.py
+#
+#  Copyright (c) 2013 Bradley David Bergeron
+#
+#  Permission is hereby granted, free of charge, to any person obtaining a copy of
+#  this software and associated documentation files (the "Software"), to deal in
+#  the Software without restriction, including without limitation the rights to
+#  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+#  the Software, and to permit persons to whom the Software is furnished to do so,
+#  subject to the following conditions:
+#
+#  The above copyright notice and this permission notice shall be included in all
+#  copies or substantial portions of the Software.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+#  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+#  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+#  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+#  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+"""Generate BreweryDB/BDBGeneratedDecoders.h from BreweryDB/Schema/Models.json.
+
+Usage:
+    Scripts/generate_decoders.py           # rewrite the header
+    Scripts/generate_decoders.py --check   # exit 1 if the header is out of date
+"""
+
+import json
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SCHEMA_PATH = os.path.join(ROOT, 'BreweryDB', 'Schema', 'Models.json')
+OUTPUT_PATH = os.path.join(ROOT, 'BreweryDB', 'BDBGeneratedDecoders.h')
+
+COERCIONS = {
+    'string': 'BDBStringValue',
+    'internedString': 'BDBInternedStringValue',
+    'trimmedString': 'BDBTrimmedStringValue',
+    'number': 'BDBNumberValue',
+    'bool': 'BDBBoolValue',
+    'dictionary': 'BDBDictionaryValue',
+    'array': 'BDBArrayValue',
+    'object': 'BDBDictionaryValue',
+    'any': 'BDBObjectValue',
+}
+
+# How each type is turned back into an API value by the encoders. Types not
+# listed here are stored as they are.
+REPRESENTATIONS = {
+    'bool': 'BDBBoolRepresentation',
+    'object': 'BDBObjectRepresentation',
+    'array': 'BDBArrayRepresentation',
+}
+
+LICENSE = """//
+//  BDBGeneratedDecoders.h
+//
+//  Copyright (c) 2013 Bradley David Bergeron
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of
+//  this software and associated documentation files (the "Software"), to deal in
+//  the Software without restriction, including without limitation the rights to
+//  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+//  the Software, and to permit persons to whom the Software is furnished to do so,
+//  subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+//  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+//  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+//  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+//  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//  Generated by Scripts/generate_decoders.py from BreweryDB/Schema/Models.json.
+//  Do not edit by hand; change the schema and run the script instead.
+"""
+
+
+def key_constant(key):
+    return 'BDBModelKey' + key[0].upper() + key[1:]
+
+
+def validate(schema):
+    for model, spec in schema.items():
+        if 'macro' not in spec or 'fields' not in spec:
+            raise ValueError('%s: "macro" and "fields" are required' % model)
+        for field in spec['fields']:
+            if field.get('type') not in COERCIONS:
+                raise ValueError('%s.%s: unknown type %r' % (model, field.get('property'), field.get('type')))
+            if field['type'] in ('object', 'array') and field.get('lazy') and 'class' not in field:
+                raise ValueError('%s.%s: lazy nested fields need a "class"' % (model, field['property']))
+
+
+def macro_lines(macro, statements):
+    body = ['    do', '    {'] + ['        ' + statement for statement in statements] + ['    } while (0)']
+    column = max(len(macro), max(len(line) for line in body)) + 1
+    lines = ['#define %s' % macro.ljust(column - len('#define ')) + '\\']
+    for line in body[:-1]:
+        lines.append(line.ljust(column) + '\\')
+    lines.append(body[-1])
+    return lines
+
+
+def encode_statement(field):
+    value = 'self.%s' % field['property']
+    representation = REPRESENTATIONS.get(field['type'])
+    if representation:
+        value = '%s(%s)' % (representation, value)
+    return 'BDBSetRepresentedValue((dictionary), %s, %s);' % (key_constant(field['key']), value)
+
+
+def render(schema):
+    lines = [LICENSE, '#ifndef __BDBGENERATEDDECODERS__', '#define __BDBGENERATEDDECODERS__', '',
+             '#import "BDBModelCoercion.h"', '', '']
+
+    keys = sorted({field['key'] for spec in schema.values() for field in spec['fields']})
+    width = max(len(key_constant(key)) for key in keys)
+    lines.append('// Keys')
+    for key in keys:
+        lines.append('static NSString * const %s = @"%s";' % (key_constant(key).ljust(width), key))
+    lines.append('')
+
+    for model, spec in schema.items():
+        eager = [field for field in spec['fields'] if not field.get('lazy')]
+        lazy = [field for field in spec['fields'] if field.get('lazy')]
+
+        lines.append('')
+        lines.append('// %s' % model)
+        if lazy:
+            lines.append('// Decoded by the model, on first access in lazy mode: %s' % ', '.join(field['property'] for field in lazy))
+
+        statements = ['_%s = %s((dictionary)[%s]);' % (field['property'], COERCIONS[field['type']], key_constant(field['key']))
+                      for field in eager]
+        lines.extend(macro_lines('BDB_DECODE_%s(dictionary)' % spec['macro'], statements))
+        lines.append('')
+
+        # Encoders go through the getters, so lazy fields are decoded first.
+        statements = [encode_statement(field) for field in spec['fields']]
+        lines.extend(macro_lines('BDB_ENCODE_%s(dictionary)' % spec['macro'], statements))
+        lines.append('')
+
+        # The keys lazy fields are decoded from, which is all a lazy model keeps of its dictionary.
+        if lazy:
+            keys = ', '.join(key_constant(field['key']) for field in lazy)
+            lines.append('#define BDB_LAZY_KEYS_%s @[%s]' % (spec['macro'], keys))
+            lines.append('')
+
+    lines.append('')
+    lines.append('#endif')
+    return '\n'.join(lines) + '\n'
+
+
+def main(argv):
+    with open(SCHEMA_PATH) as schema_file:
+        schema = json.load(schema_file)
+    validate(schema)
+    output = render(schema)
+
+    if '--check' in argv:
+        with open(OUTPUT_PATH) as header_file:
+            if header_file.read() != output:
+                sys.stderr.write('%s is out of date; run Scripts/generate_decoders.py\n' % os.path.relpath(OUTPUT_PATH, ROOT))
+                return 1
+        return 0
+
+    with open(OUTPUT_PATH, 'w') as header_file:
+        header_file.write(output)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
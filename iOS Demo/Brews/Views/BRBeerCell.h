@@ -8,6 +8,8 @@
 
 #import <UIKit/UIKit.h>
 
+#import "BreweryDB.h"
+
 
 #pragma mark -
 @interface BRBeerCell : UITableViewCell
@@ -16,4 +18,6 @@
 @property (nonatomic, weak) IBOutlet UILabel *breweryLabel;
 @property (nonatomic, weak) IBOutlet UIImageView *labelImageView;
 
+- (void)configureWithBeer:(BDBBeer *)beer;
+
 @end
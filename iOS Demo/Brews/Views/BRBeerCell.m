@@ -9,17 +9,22 @@
 #import "BRBeerCell.h"
 
 
+#pragma mark -
+@interface BRBeerCell ()
+
+@property (nonatomic) BDBRequest *labelRequest;
+
+@end
+
+
 #pragma mark -
 @implementation BRBeerCell
 
 - (void)awakeFromNib
 {
+    // Labels arrive already cropped to a circle, so the image view needs no mask or rasterization.
     self.labelImageView.autoresizingMask = UIViewAutoresizingFlexibleLeftMargin | UIViewAutoresizingFlexibleRightMargin;
-    self.labelImageView.layer.masksToBounds = YES;
-    self.labelImageView.layer.cornerRadius = self.labelImageView.frame.size.width / 2.0;
-    self.labelImageView.layer.rasterizationScale = [[UIScreen mainScreen] scale];
-    self.labelImageView.layer.shouldRasterize = YES;
-    self.labelImageView.clipsToBounds = YES;
+    self.labelImageView.contentMode = UIViewContentModeScaleAspectFill;
 
     [self prepareForReuse];
 
@@ -27,9 +32,39 @@
 
 - (void)prepareForReuse
 {
+    [self.labelRequest cancel];
+    self.labelRequest = nil;
+
     self.nameLabel.text = nil;
     self.breweryLabel.text = nil;
     self.labelImageView.image = nil;
 }
 
+- (void)configureWithBeer:(BDBBeer *)beer
+{
+    self.nameLabel.text = beer.name;
+    self.breweryLabel.text = [beer.breweries.firstObject name];
+
+    BDBImagePipeline *pipeline = [BDBImagePipeline sharedPipeline];
+    CGSize size = self.labelImageView.bounds.size;
+    CGFloat scale = [[UIScreen mainScreen] scale];
+    self.labelImageView.image = [pipeline cachedImageForVariants:beer.labels size:size scale:scale options:BDBImageOptionCircular];
+    if (self.labelImageView.image)
+        return;
+
+    // A label that finishes loading after the cell was reused belongs to another beer.
+    __weak BRBeerCell *weakSelf = self;
+    __block BDBRequest *labelRequest = nil;
+    labelRequest = [pipeline loadImageForVariants:beer.labels
+                                             size:size
+                                            scale:scale
+                                          options:BDBImageOptionCircular
+                                    callbackQueue:dispatch_get_main_queue()
+                                       completion:^(UIImage *image, NSError *error) {
+                                           if (image && weakSelf.labelRequest == labelRequest)
+                                               weakSelf.labelImageView.image = image;
+                                       }];
+    self.labelRequest = labelRequest;
+}
+
 @end